@@ -60,6 +60,7 @@ struct RTC_EXPORT EchoCanceller3Config {
     AlignmentMixing render_alignment_mixing = {false, true, 10000.f, true};
     AlignmentMixing capture_alignment_mixing = {false, true, 10000.f, false};
     bool detect_pre_echo = true;
+    bool coarse_lag_search = false;
   } delay;
 
   struct Filter {
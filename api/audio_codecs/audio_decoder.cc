@@ -54,6 +54,14 @@ bool AudioDecoder::EncodedAudioFrame::IsDtxPacket() const {
   return false;
 }
 
+std::vector<AudioDecoder::ParseResult>
+AudioDecoder::EncodedAudioFrame::ParseRedundancy(
+    uint32_t timestamp,
+    uint32_t begin_timestamp,
+    uint32_t recovery_timestamp_offset) const {
+  return {};
+}
+
 AudioDecoder::ParseResult::ParseResult() = default;
 AudioDecoder::ParseResult::ParseResult(ParseResult&& b) = default;
 AudioDecoder::ParseResult::ParseResult(uint32_t timestamp,
@@ -85,6 +93,14 @@ std::vector<AudioDecoder::ParseResult> AudioDecoder::ParsePayloadRedundancy(
   return ParsePayload(std::move(payload), timestamp);
 }
 
+std::vector<AudioDecoder::ParseResult> AudioDecoder::ParseDred(
+    rtc::ArrayView<const uint8_t> payload,
+    uint32_t timestamp,
+    uint32_t begin_timestamp,
+    uint32_t recovery_timestamp_offset) {
+  return {};
+}
+
 int AudioDecoder::DecodeDred(const uint8_t *encoded,
                              size_t encoded_len,
                              uint32_t primary_timestamp,
@@ -39,6 +39,8 @@ class AudioDecoder {
   AudioDecoder(const AudioDecoder&) = delete;
   AudioDecoder& operator=(const AudioDecoder&) = delete;
 
+  struct ParseResult;
+
   class EncodedAudioFrame {
    public:
     struct DecodeResult {
@@ -63,6 +65,17 @@ class AudioDecoder {
     // absl::optional. Decode may be called at most once per frame object.
     virtual absl::optional<DecodeResult> Decode(
         rtc::ArrayView<int16_t> decoded) const = 0;
+
+    // Parses redundancy carried by this frame, which starts at `timestamp`,
+    // and returns frames recovering at most `recovery_timestamp_offset`
+    // samples preceding it. Only frames starting before `begin_timestamp` are
+    // returned, so that audio already available from other frames is not
+    // recovered again. This lets the caller defer the parsing until a loss
+    // has been confirmed. The default implementation returns no frames.
+    virtual std::vector<ParseResult> ParseRedundancy(
+        uint32_t timestamp,
+        uint32_t begin_timestamp,
+        uint32_t recovery_timestamp_offset) const;
   };
 
   struct ParseResult {
@@ -97,6 +110,18 @@ class AudioDecoder {
                                                           uint32_t timestamp,
                                                           uint32_t recovery_timestamp_offset);
 
+  // Parses the deep redundancy (DRED) carried in `payload`, which starts at
+  // `timestamp`, and returns frames recovering at most
+  // `recovery_timestamp_offset` samples preceding it. Only frames starting
+  // before `begin_timestamp` are returned; in particular, no frame is
+  // returned for the primary payload itself. The default implementation
+  // returns no frames.
+  virtual std::vector<ParseResult> ParseDred(
+      rtc::ArrayView<const uint8_t> payload,
+      uint32_t timestamp,
+      uint32_t begin_timestamp,
+      uint32_t recovery_timestamp_offset);
+
   int DecodeDred(const uint8_t *encoded,
                  size_t encoded_len,
                  uint32_t primary_timestamp,
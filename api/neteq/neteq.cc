@@ -30,7 +30,8 @@ std::string NetEq::Config::ToString() const {
      << ", min_delay_ms=" << min_delay_ms << ", enable_fast_accelerate="
      << (enable_fast_accelerate ? "true" : "false")
      << ", enable_muted_state=" << (enable_muted_state ? "true" : "false")
-     << ", enable_rtx_handling=" << (enable_rtx_handling ? "true" : "false");
+     << ", enable_rtx_handling=" << (enable_rtx_handling ? "true" : "false")
+     << ", enable_lazy_dred=" << (enable_lazy_dred ? "true" : "false");
   return ss.str();
 }
 
@@ -137,6 +137,10 @@ class NetEq {
     bool enable_fast_accelerate = false;
     bool enable_muted_state = false;
     bool enable_rtx_handling = false;
+    // Defers parsing of deep redundancy (DRED) until a packet is confirmed
+    // missing at playout time, instead of parsing it whenever a gap is seen
+    // at insert time.
+    bool enable_lazy_dred = false;
     absl::optional<AudioCodecPairId> codec_pair_id;
     bool for_test_no_time_stretching = false;  // Use only for testing.
   };
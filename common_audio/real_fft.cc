@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/real_fft.h"
+
+#include "common_audio/stockham_fft.h"
+#include "common_audio/third_party/ooura/fft_size_128/ooura_fft.h"
+#include "common_audio/third_party/ooura/fft_size_256/fft4g.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+
+namespace {
+
+bool IsSse2Available() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  return GetCPUInfo(kSSE2) != 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
+RealFftBackend GetDefaultRealFftBackend() {
+#if defined(WEBRTC_AUDIO_STOCKHAM_FFT)
+  return RealFftBackend::kStockham;
+#else
+  return RealFftBackend::kOoura;
+#endif
+}
+
+template <size_t kLength>
+RealFft<kLength>::RealFft(RealFftBackend backend) : backend_(backend) {
+  if (backend_ == RealFftBackend::kStockham) {
+    stockham_fft_ = std::make_unique<StockhamRealFft>(kLength);
+  } else if (kLength == 128) {
+    ooura_fft_ = std::make_unique<OouraFft>(IsSse2Available());
+  } else {
+    // Setting ooura_ip_[0] to 0 triggers the initialization of the work areas.
+    ooura_ip_[0] = 0;
+    std::array<float, kLength> tmp_buffer;
+    tmp_buffer.fill(0.f);
+    WebRtc_rdft(kLength, 1, tmp_buffer.data(), ooura_ip_.data(),
+                ooura_w_.data());
+  }
+}
+
+template <size_t kLength>
+RealFft<kLength>::~RealFft() = default;
+
+template <size_t kLength>
+void RealFft<kLength>::Forward(rtc::ArrayView<float, kLength> x) const {
+  if (stockham_fft_) {
+    std::array<float, StockhamRealFft::ScratchSize(kLength)> scratch;
+    stockham_fft_->Forward(x.data(), scratch.data());
+  } else if (ooura_fft_) {
+    ooura_fft_->Fft(x.data());
+  } else {
+    WebRtc_rdft(kLength, 1, x.data(), ooura_ip_.data(), ooura_w_.data());
+  }
+}
+
+template <size_t kLength>
+void RealFft<kLength>::Inverse(rtc::ArrayView<float, kLength> x) const {
+  if (stockham_fft_) {
+    std::array<float, StockhamRealFft::ScratchSize(kLength)> scratch;
+    stockham_fft_->Inverse(x.data(), scratch.data());
+  } else if (ooura_fft_) {
+    ooura_fft_->InverseFft(x.data());
+  } else {
+    WebRtc_rdft(kLength, -1, x.data(), ooura_ip_.data(), ooura_w_.data());
+  }
+}
+
+template class RealFft<128>;
+template class RealFft<256>;
+template class RealFft<512>;
+
+}  // namespace webrtc
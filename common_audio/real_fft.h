@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_REAL_FFT_H_
+#define COMMON_AUDIO_REAL_FFT_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <memory>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+class OouraFft;
+class StockhamRealFft;
+
+enum class RealFftBackend {
+  // The Ooura FFTs used by the audio processing module so far.
+  kOoura,
+  // SIMD Stockham FFT, see StockhamRealFft.
+  kStockham,
+};
+
+// Returns the backend selected with the `rtc_audio_use_stockham_fft` build
+// flag, kOoura by default.
+RealFftBackend GetDefaultRealFftBackend();
+
+// Real valued FFT of `kLength` points, for `kLength` 128, 256 or 512. The
+// spectrum uses the packed format of the Ooura FFT: x[0] and x[1] hold the
+// real valued bins 0 and `kLength` / 2, and x[2 * k] and x[2 * k + 1] the real
+// part and the negated imaginary part of bin k.
+//
+// The Ooura backend matches the FFTs previously used by the callers
+// bit-exactly, while the Stockham backend matches them up to rounding.
+template <size_t kLength>
+class RealFft {
+ public:
+  static_assert(kLength == 128 || kLength == 256 || kLength == 512,
+                "Unsupported FFT length");
+
+  explicit RealFft(RealFftBackend backend = GetDefaultRealFftBackend());
+  RealFft(const RealFft&) = delete;
+  RealFft& operator=(const RealFft&) = delete;
+  ~RealFft();
+
+  // Computes the FFT of `x` in place.
+  void Forward(rtc::ArrayView<float, kLength> x) const;
+
+  // Computes the inverse FFT of `x` in place. The output is scaled by
+  // `kLength` / 2.
+  void Inverse(rtc::ArrayView<float, kLength> x) const;
+
+  RealFftBackend backend() const { return backend_; }
+
+ private:
+  const RealFftBackend backend_;
+  // Set for the Ooura backend with `kLength` 128.
+  std::unique_ptr<OouraFft> ooura_fft_;
+  // Work areas of WebRtc_rdft(), used for the Ooura backend with other
+  // lengths. They are initialized at construction and only read afterwards.
+  mutable std::array<size_t, kLength / 2> ooura_ip_;
+  mutable std::array<float, kLength / 2> ooura_w_;
+  // Set for the Stockham backend.
+  std::unique_ptr<StockhamRealFft> stockham_fft_;
+};
+
+extern template class RealFft<128>;
+extern template class RealFft<256>;
+extern template class RealFft<512>;
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_REAL_FFT_H_
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/real_fft.h"
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "common_audio/stockham_fft.h"
+#include "common_audio/third_party/ooura/fft_size_256/fft4g.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<StockhamRealFft::Implementation> GetAvailableImplementations() {
+  std::vector<StockhamRealFft::Implementation> implementations = {
+      StockhamRealFft::Implementation::kC};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kSSE2)) {
+    implementations.push_back(StockhamRealFft::Implementation::kSse2);
+  }
+  if (GetCPUInfo(kAVX2) && GetCPUInfo(kFMA3)) {
+    implementations.push_back(StockhamRealFft::Implementation::kAvx2);
+  }
+#endif
+  return implementations;
+}
+
+std::vector<float> CreateInput(size_t length) {
+  std::vector<float> x(length);
+  srand(42);
+  for (float& v : x) {
+    v = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+  }
+  return x;
+}
+
+// Computes the DFT of `x` in the packed format of the Ooura FFT.
+std::vector<float> ReferenceFft(const std::vector<float>& x) {
+  const size_t length = x.size();
+  std::vector<float> y(length);
+  for (size_t k = 0; k <= length / 2; ++k) {
+    double re = 0.0;
+    double im = 0.0;
+    for (size_t n = 0; n < length; ++n) {
+      const double angle = -2.0 * kPi * static_cast<double>(k * n) / length;
+      re += x[n] * std::cos(angle);
+      im += x[n] * std::sin(angle);
+    }
+    if (k == 0) {
+      y[0] = re;
+    } else if (k == length / 2) {
+      y[1] = re;
+    } else {
+      y[2 * k] = re;
+      y[2 * k + 1] = -im;
+    }
+  }
+  return y;
+}
+
+template <size_t kLength>
+void VerifyForwardAndInverse(RealFftBackend backend) {
+  const std::vector<float> input = CreateInput(kLength);
+  const std::vector<float> expected = ReferenceFft(input);
+  const RealFft<kLength> fft(backend);
+  EXPECT_EQ(fft.backend(), backend);
+
+  std::array<float, kLength> x;
+  std::copy(input.begin(), input.end(), x.begin());
+  fft.Forward(x);
+  for (size_t k = 0; k < kLength; ++k) {
+    EXPECT_NEAR(expected[k], x[k], 1e-4f) << k;
+  }
+
+  fft.Inverse(x);
+  for (size_t n = 0; n < kLength; ++n) {
+    EXPECT_NEAR(input[n], x[n] * 2.f / kLength, 1e-5f) << n;
+  }
+}
+
+}  // namespace
+
+TEST(RealFftTest, OouraBackendMatchesReference) {
+  VerifyForwardAndInverse<128>(RealFftBackend::kOoura);
+  VerifyForwardAndInverse<256>(RealFftBackend::kOoura);
+  VerifyForwardAndInverse<512>(RealFftBackend::kOoura);
+}
+
+TEST(RealFftTest, StockhamBackendMatchesReference) {
+  VerifyForwardAndInverse<128>(RealFftBackend::kStockham);
+  VerifyForwardAndInverse<256>(RealFftBackend::kStockham);
+  VerifyForwardAndInverse<512>(RealFftBackend::kStockham);
+}
+
+// The Ooura backend must not change the output of the callers that used
+// WebRtc_rdft() directly.
+TEST(RealFftTest, OouraBackendIsBitExactWithRdft) {
+  constexpr size_t kLength = 256;
+  const std::vector<float> input = CreateInput(kLength);
+  std::vector<size_t> ip(kLength / 2);
+  std::vector<float> w(kLength / 2);
+  std::vector<float> expected = input;
+  WebRtc_rdft(kLength, 1, expected.data(), ip.data(), w.data());
+
+  const RealFft<kLength> fft(RealFftBackend::kOoura);
+  std::array<float, kLength> x;
+  std::copy(input.begin(), input.end(), x.begin());
+  fft.Forward(x);
+  for (size_t k = 0; k < kLength; ++k) {
+    EXPECT_EQ(expected[k], x[k]) << k;
+  }
+
+  WebRtc_rdft(kLength, -1, expected.data(), ip.data(), w.data());
+  fft.Inverse(x);
+  for (size_t n = 0; n < kLength; ++n) {
+    EXPECT_EQ(expected[n], x[n]) << n;
+  }
+}
+
+// Verifies that the SIMD implementations match the C one for lengths beyond
+// the ones used by RealFft.
+TEST(StockhamRealFftTest, ImplementationsMatchC) {
+  for (size_t length = 64; length <= 4096; length *= 2) {
+    const std::vector<float> input = CreateInput(length);
+    const StockhamRealFft reference(length,
+                                    StockhamRealFft::Implementation::kC);
+    std::vector<float> scratch(StockhamRealFft::ScratchSize(length));
+    std::vector<float> expected = input;
+    reference.Forward(expected.data(), scratch.data());
+    std::vector<float> expected_inverse = expected;
+    reference.Inverse(expected_inverse.data(), scratch.data());
+
+    for (auto implementation : GetAvailableImplementations()) {
+      SCOPED_TRACE(static_cast<int>(implementation));
+      SCOPED_TRACE(length);
+      const StockhamRealFft fft(length, implementation);
+      std::vector<float> x = input;
+      fft.Forward(x.data(), scratch.data());
+      for (size_t k = 0; k < length; ++k) {
+        EXPECT_NEAR(expected[k], x[k], 1e-5f * length) << k;
+      }
+      fft.Inverse(x.data(), scratch.data());
+      for (size_t n = 0; n < length; ++n) {
+        EXPECT_NEAR(expected_inverse[n], x[n], 1e-5f * length) << n;
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -10,6 +10,10 @@
 
 #include "common_audio/real_fourier.h"
 
+#include <algorithm>
+
+#include "api/array_view.h"
+#include "common_audio/real_fft.h"
 #include "common_audio/real_fourier_ooura.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "rtc_base/checks.h"
@@ -18,9 +22,66 @@ namespace webrtc {
 
 using std::complex;
 
+namespace {
+
+// RealFourier for the lengths supported by RealFft, with the same conversions
+// of the packed spectrum as RealFourierOoura.
+template <size_t kLength>
+class RealFourierFixedLength : public RealFourier {
+ public:
+  static constexpr size_t kComplexLength = kLength / 2 + 1;
+
+  explicit RealFourierFixedLength(RealFftBackend backend) : fft_(backend) {}
+
+  void Forward(const float* src, complex<float>* dest) const override {
+    auto* dest_float = reinterpret_cast<float*>(dest);
+    std::copy(src, src + kLength, dest_float);
+    fft_.Forward(rtc::ArrayView<float, kLength>(dest_float, kLength));
+    dest[kComplexLength - 1] = complex<float>(dest[0].imag(), 0.0f);
+    dest[0] = complex<float>(dest[0].real(), 0.0f);
+    for (size_t k = 0; k < kComplexLength; ++k) {
+      dest[k] = std::conj(dest[k]);
+    }
+  }
+
+  void Inverse(const complex<float>* src, float* dest) const override {
+    auto* dest_complex = reinterpret_cast<complex<float>*>(dest);
+    for (size_t k = 0; k < kComplexLength - 1; ++k) {
+      dest_complex[k] = std::conj(src[k]);
+    }
+    dest_complex[0] =
+        complex<float>(src[0].real(), src[kComplexLength - 1].real());
+    fft_.Inverse(rtc::ArrayView<float, kLength>(dest, kLength));
+    const float scale = 2.0f / kLength;
+    std::for_each(dest, dest + kLength, [scale](float& v) { v *= scale; });
+  }
+
+  int order() const override { return FftOrder(kLength); }
+
+ private:
+  const RealFft<kLength> fft_;
+};
+
+}  // namespace
+
 const size_t RealFourier::kFftBufferAlignment = 32;
 
 std::unique_ptr<RealFourier> RealFourier::Create(int fft_order) {
+  // The Ooura backend of RealFft is not bit-exact with RealFourierOoura for
+  // length 128, so RealFft is only used when the Stockham FFT is selected.
+  const RealFftBackend backend = GetDefaultRealFftBackend();
+  if (backend == RealFftBackend::kStockham) {
+    switch (fft_order) {
+      case 7:
+        return std::make_unique<RealFourierFixedLength<128>>(backend);
+      case 8:
+        return std::make_unique<RealFourierFixedLength<256>>(backend);
+      case 9:
+        return std::make_unique<RealFourierFixedLength<512>>(backend);
+      default:
+        break;
+    }
+  }
   return std::unique_ptr<RealFourier>(new RealFourierOoura(fft_order));
 }
 
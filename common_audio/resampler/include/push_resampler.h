@@ -16,9 +16,12 @@
 
 namespace webrtc {
 
+class PolyphaseResampler;
 class PushSincResampler;
 
-// Wraps PushSincResampler to provide stereo support.
+// Wraps PushSincResampler to provide stereo support. Builds with the
+// `rtc_audio_use_polyphase_resampler` GN arg use PolyphaseResampler instead
+// for the sample rates it supports.
 // TODO(ajm): add support for an arbitrary number of channels.
 template <typename T>
 class PushResampler {
@@ -47,7 +50,9 @@ class PushResampler {
   std::vector<T*> channel_data_array_;
 
   struct ChannelResampler {
+    // Exactly one of the two resamplers is set.
     std::unique_ptr<PushSincResampler> resampler;
+    std::unique_ptr<PolyphaseResampler> polyphase_resampler;
     std::vector<T> source;
     std::vector<T> destination;
   };
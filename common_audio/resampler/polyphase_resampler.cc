@@ -0,0 +1,248 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// MSVC++ requires this to be set before any other includes to get M_PI.
+#define _USE_MATH_DEFINES
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <map>
+#include <numeric>
+#include <tuple>
+
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr size_t kTaps = PolyphaseFilterBank::kTaps;
+
+// Number of filter banks kept by GetPolyphaseFilterBank(). Filter banks for
+// further ratios are computed for each request.
+constexpr size_t kMaxCachedFilterBanks = 32;
+
+// Returns the number of samples by which the first output sample of a block
+// can precede the block, rounded up.
+int ComputeLeadingSamples(int interpolation, int phase) {
+  return (phase + interpolation - 1) / interpolation;
+}
+
+// Returns floor(`a` / `b`) for `b` > 0.
+int FloorDiv(int a, int b) {
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+std::vector<int> ComputeOffsets(int interpolation, int decimation, int phase) {
+  const int leading_samples = ComputeLeadingSamples(interpolation, phase);
+  std::vector<int> offsets(interpolation);
+  for (int n = 0; n < interpolation; ++n) {
+    offsets[n] =
+        leading_samples + FloorDiv(n * decimation - phase, interpolation);
+  }
+  return offsets;
+}
+
+// Computes the filters with the windowed sinc kernels of
+// SincResampler::InitializeKernel().
+std::unique_ptr<float[], AlignedFreeDeleter> ComputeFilters(int interpolation,
+                                                            int decimation,
+                                                            int phase) {
+  // Blackman window parameters.
+  constexpr double kAlpha = 0.16;
+  constexpr double kA0 = 0.5 * (1.0 - kAlpha);
+  constexpr double kA1 = 0.5;
+  constexpr double kA2 = 0.5 * kAlpha;
+
+  // See SincScaleFactor() in sinc_resampler.cc.
+  const double io_ratio = static_cast<double>(decimation) / interpolation;
+  const double sinc_scale_factor =
+      0.9 * (io_ratio > 1.0 ? 1.0 / io_ratio : 1.0);
+
+  std::unique_ptr<float[], AlignedFreeDeleter> filters(static_cast<float*>(
+      AlignedMalloc(sizeof(float) * interpolation * kTaps, 32)));
+  for (int n = 0; n < interpolation; ++n) {
+    const int position = n * decimation - phase;
+    const double subsample_offset =
+        static_cast<double>(position -
+                            FloorDiv(position, interpolation) * interpolation) /
+        interpolation;
+    for (size_t i = 0; i < kTaps; ++i) {
+      const double pre_sinc =
+          M_PI * (static_cast<int>(i) - static_cast<int>(kTaps / 2) -
+                  subsample_offset);
+      const double x = (i - subsample_offset) / kTaps;
+      const double window =
+          kA0 - kA1 * cos(2.0 * M_PI * x) + kA2 * cos(4.0 * M_PI * x);
+      filters[n * kTaps + i] = static_cast<float>(
+          window * (pre_sinc == 0 ? sinc_scale_factor
+                                  : sin(sinc_scale_factor * pre_sinc) /
+                                        pre_sinc));
+    }
+  }
+  return filters;
+}
+
+// Computes the dot product of `kTaps` samples.
+float Convolve(const float* input, const float* filter) {
+  float sum = 0.f;
+  for (size_t i = 0; i < kTaps; ++i) {
+    sum += input[i] * filter[i];
+  }
+  return sum;
+}
+
+// Returns the filter bank for blocks of `source_frames` and
+// `destination_frames` samples with the delay of PushSincResampler. The latter
+// primes SincResampler with a block of zeros and discards the first
+// SincResampler::ChunkSize() output samples, which delays the output by
+// `kTaps` / 2 input samples plus the fraction of an output period left over
+// at the end of the priming block.
+std::shared_ptr<const PolyphaseFilterBank> GetFilterBank(
+    size_t source_frames,
+    size_t destination_frames) {
+  RTC_DCHECK_GT(source_frames, kTaps);
+  const size_t divisor = std::gcd(source_frames, destination_frames);
+  const int interpolation = static_cast<int>(destination_frames / divisor);
+  const int decimation = static_cast<int>(source_frames / divisor);
+  const int phase = static_cast<int>(
+      ((source_frames - kTaps / 2) * interpolation) % decimation);
+  return GetPolyphaseFilterBank(interpolation, decimation, phase);
+}
+
+}  // namespace
+
+PolyphaseFilterBank::PolyphaseFilterBank(int interpolation,
+                                         int decimation,
+                                         int phase)
+    : interpolation(interpolation),
+      decimation(decimation),
+      phase(phase),
+      history_size(kTaps + ComputeLeadingSamples(interpolation, phase)),
+      offsets(ComputeOffsets(interpolation, decimation, phase)),
+      filters(ComputeFilters(interpolation, decimation, phase)) {
+  RTC_DCHECK_GT(interpolation, 0);
+  RTC_DCHECK_GT(decimation, 0);
+  RTC_DCHECK_GE(phase, 0);
+  RTC_DCHECK_LT(phase, decimation);
+}
+
+PolyphaseFilterBank::~PolyphaseFilterBank() = default;
+
+std::shared_ptr<const PolyphaseFilterBank> GetPolyphaseFilterBank(
+    int interpolation,
+    int decimation,
+    int phase) {
+  RTC_DCHECK_EQ(std::gcd(interpolation, decimation), 1);
+  static Mutex* const mutex = new Mutex();
+  static auto* const cache =
+      new std::map<std::tuple<int, int, int>,
+                   std::shared_ptr<const PolyphaseFilterBank>>();
+  const auto key = std::make_tuple(interpolation, decimation, phase);
+  MutexLock lock(mutex);
+  auto it = cache->find(key);
+  if (it != cache->end()) {
+    return it->second;
+  }
+  auto bank = std::make_shared<const PolyphaseFilterBank>(interpolation,
+                                                          decimation, phase);
+  if (cache->size() < kMaxCachedFilterBanks) {
+    cache->emplace(key, bank);
+  }
+  return bank;
+}
+
+void PolyphaseResample(const PolyphaseFilterBank& bank,
+                       const float* input,
+                       size_t num_blocks,
+                       float* output) {
+  for (size_t b = 0; b < num_blocks; ++b) {
+    for (int n = 0; n < bank.interpolation; ++n) {
+      *output++ = Convolve(&input[bank.offsets[n]], bank.filter(n));
+    }
+    input += bank.decimation;
+  }
+}
+
+bool PolyphaseResampler::IsSupported(size_t source_frames,
+                                     size_t destination_frames) {
+  if (source_frames <= kTaps || destination_frames == 0) {
+    return false;
+  }
+  const size_t divisor = std::gcd(source_frames, destination_frames);
+  return destination_frames / divisor <= kMaxInterpolation;
+}
+
+PolyphaseResampler::PolyphaseResampler(size_t source_frames,
+                                       size_t destination_frames)
+    : source_frames_(source_frames),
+      destination_frames_(destination_frames),
+      bank_(GetFilterBank(source_frames, destination_frames)),
+      resample_([] {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+        if (GetCPUInfo(kAVX2) && GetCPUInfo(kFMA3)) {
+          return PolyphaseResampleAvx2;
+        }
+        if (GetCPUInfo(kSSE2)) {
+          return PolyphaseResampleSse2;
+        }
+        return PolyphaseResample;
+#else
+        return PolyphaseResample;
+#endif
+      }()),
+      input_(bank_->history_size + source_frames, 0.f) {
+  RTC_DCHECK(IsSupported(source_frames, destination_frames));
+}
+
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+size_t PolyphaseResampler::Resample(const int16_t* source,
+                                    size_t source_frames,
+                                    int16_t* destination,
+                                    size_t destination_capacity) {
+  RTC_CHECK_EQ(source_frames, source_frames_);
+  RTC_CHECK_GE(destination_capacity, destination_frames_);
+  if (float_buffer_.empty()) {
+    float_buffer_.resize(destination_frames_);
+  }
+  for (size_t i = 0; i < source_frames; ++i) {
+    input_[bank_->history_size + i] = static_cast<float>(source[i]);
+  }
+  ResampleInput(float_buffer_.data());
+  FloatS16ToS16(float_buffer_.data(), destination_frames_, destination);
+  return destination_frames_;
+}
+
+size_t PolyphaseResampler::Resample(const float* source,
+                                    size_t source_frames,
+                                    float* destination,
+                                    size_t destination_capacity) {
+  RTC_CHECK_EQ(source_frames, source_frames_);
+  RTC_CHECK_GE(destination_capacity, destination_frames_);
+  memcpy(&input_[bank_->history_size], source, source_frames * sizeof(float));
+  ResampleInput(destination);
+  return destination_frames_;
+}
+
+void PolyphaseResampler::ResampleInput(float* destination) {
+  resample_(*bank_, input_.data(), source_frames_ / bank_->decimation,
+            destination);
+  memmove(input_.data(), &input_[source_frames_],
+          bank_->history_size * sizeof(float));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
+#define COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/memory/aligned_malloc.h"
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// Filters of a resampler by the rational factor `interpolation` /
+// `decimation`. Output sample n of a block of `interpolation` output samples
+// is computed from the `kTaps` input samples starting at `offsets[n]` with the
+// filter `filter(n)`, and is located at (n * `decimation` - `phase`) /
+// `interpolation` - `kTaps` / 2 input samples from the start of the block.
+// Each block consumes `decimation` input samples.
+//
+// The filters are the windowed sinc kernels of SincResampler, evaluated at the
+// exact sub-sample offset of each output sample rather than interpolated
+// between 33 precomputed kernels. The filter bank is immutable and can be
+// shared between resamplers, see GetPolyphaseFilterBank().
+struct PolyphaseFilterBank {
+  static constexpr size_t kTaps = 32;
+
+  PolyphaseFilterBank(int interpolation, int decimation, int phase);
+  PolyphaseFilterBank(const PolyphaseFilterBank&) = delete;
+  PolyphaseFilterBank& operator=(const PolyphaseFilterBank&) = delete;
+  ~PolyphaseFilterBank();
+
+  // Returns the `kTaps` taps of the filter of output sample n in a block.
+  const float* filter(int n) const { return &filters[n * kTaps]; }
+
+  const int interpolation;
+  const int decimation;
+  const int phase;
+  // Number of input samples preceding a block which the filters read.
+  const size_t history_size;
+  const std::vector<int> offsets;
+  // `interpolation` filters of `kTaps` taps, back to back, with the taps in the
+  // order of the input samples. 32-byte aligned.
+  const std::unique_ptr<float[], AlignedFreeDeleter> filters;
+};
+
+// Returns the filter bank for resampling by `interpolation` / `decimation`,
+// which must be coprime, with `phase` in [0, `decimation`). The filter banks
+// are computed once and cached for the lifetime of the process, so that
+// resamplers can be created without recomputing them when the sample rates
+// change. Thread safe.
+std::shared_ptr<const PolyphaseFilterBank> GetPolyphaseFilterBank(
+    int interpolation,
+    int decimation,
+    int phase);
+
+// Resamples `num_blocks` blocks of `bank.decimation` input samples into
+// `bank.interpolation` output samples each. `input` must start with
+// `bank.history_size` samples of history.
+void PolyphaseResample(const PolyphaseFilterBank& bank,
+                       const float* input,
+                       size_t num_blocks,
+                       float* output);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void PolyphaseResampleSse2(const PolyphaseFilterBank& bank,
+                           const float* input,
+                           size_t num_blocks,
+                           float* output);
+void PolyphaseResampleAvx2(const PolyphaseFilterBank& bank,
+                           const float* input,
+                           size_t num_blocks,
+                           float* output);
+#endif
+
+// Single channel resampler with the same interface and delay as
+// PushSincResampler, for the ratios with a small enough filter bank. The filter
+// bank is shared with all other resamplers with the same ratio and block size.
+class PolyphaseResampler {
+ public:
+  // Largest supported `interpolation` factor. Together with the 10 ms blocks
+  // used in WebRTC this covers, e.g., all conversions between 8, 16, 32, 44.1
+  // and 48 kHz.
+  static constexpr int kMaxInterpolation = 512;
+
+  // Returns whether a resampler can be created for blocks of `source_frames`
+  // and `destination_frames` samples.
+  static bool IsSupported(size_t source_frames, size_t destination_frames);
+
+  // Provide the size of the source and destination blocks in samples. These
+  // must correspond to the same time duration (typically 10 ms) as the sample
+  // ratio is inferred from them.
+  PolyphaseResampler(size_t source_frames, size_t destination_frames);
+  ~PolyphaseResampler();
+
+  PolyphaseResampler(const PolyphaseResampler&) = delete;
+  PolyphaseResampler& operator=(const PolyphaseResampler&) = delete;
+
+  // Resamples `source_frames` samples from `source` into `destination`, which
+  // must hold at least `destination_frames` samples. Returns the number of
+  // samples written, i.e., `destination_frames`.
+  size_t Resample(const int16_t* source,
+                  size_t source_frames,
+                  int16_t* destination,
+                  size_t destination_capacity);
+  size_t Resample(const float* source,
+                  size_t source_frames,
+                  float* destination,
+                  size_t destination_capacity);
+
+ private:
+  using ResampleFunction = void (*)(const PolyphaseFilterBank& bank,
+                                    const float* input,
+                                    size_t num_blocks,
+                                    float* output);
+
+  // Resamples the samples in `input_` and keeps the last
+  // `bank_->history_size` of them as history.
+  void ResampleInput(float* destination);
+
+  const size_t source_frames_;
+  const size_t destination_frames_;
+  const std::shared_ptr<const PolyphaseFilterBank> bank_;
+  const ResampleFunction resample_;
+  // History of `bank_->history_size` samples followed by the current source
+  // block.
+  std::vector<float> input_;
+  std::vector<float> float_buffer_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
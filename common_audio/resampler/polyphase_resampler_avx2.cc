@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+namespace webrtc {
+
+void PolyphaseResampleAvx2(const PolyphaseFilterBank& bank,
+                           const float* input,
+                           size_t num_blocks,
+                           float* output) {
+  static_assert(PolyphaseFilterBank::kTaps % 16 == 0, "");
+  for (size_t b = 0; b < num_blocks; ++b) {
+    for (int n = 0; n < bank.interpolation; ++n) {
+      const float* x = &input[bank.offsets[n]];
+      const float* h = bank.filter(n);
+      // Two accumulators to hide the latency of the multiply-adds.
+      __m256 sums0 = _mm256_setzero_ps();
+      __m256 sums1 = _mm256_setzero_ps();
+      for (size_t i = 0; i < PolyphaseFilterBank::kTaps; i += 16) {
+        sums0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i]), _mm256_load_ps(&h[i]),
+                                sums0);
+        sums1 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i + 8]),
+                                _mm256_load_ps(&h[i + 8]), sums1);
+      }
+      sums0 = _mm256_add_ps(sums0, sums1);
+      __m128 sums = _mm_add_ps(_mm256_extractf128_ps(sums0, 0),
+                               _mm256_extractf128_ps(sums0, 1));
+      sums = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+      sums = _mm_add_ss(sums, _mm_shuffle_ps(sums, sums, 1));
+      _mm_store_ss(output++, sums);
+    }
+    input += bank.decimation;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+namespace webrtc {
+
+void PolyphaseResampleSse2(const PolyphaseFilterBank& bank,
+                           const float* input,
+                           size_t num_blocks,
+                           float* output) {
+  static_assert(PolyphaseFilterBank::kTaps % 4 == 0, "");
+  for (size_t b = 0; b < num_blocks; ++b) {
+    for (int n = 0; n < bank.interpolation; ++n) {
+      const float* x = &input[bank.offsets[n]];
+      const float* h = bank.filter(n);
+      __m128 sums = _mm_setzero_ps();
+      for (size_t i = 0; i < PolyphaseFilterBank::kTaps; i += 4) {
+        sums = _mm_add_ps(
+            sums, _mm_mul_ps(_mm_loadu_ps(&x[i]), _mm_load_ps(&h[i])));
+      }
+      sums = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+      sums = _mm_add_ss(sums, _mm_shuffle_ps(sums, sums, 1));
+      _mm_store_ss(output++, sums);
+    }
+    input += bank.decimation;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// MSVC++ requires this to be set before any other includes to get M_PI.
+#define _USE_MATH_DEFINES
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "common_audio/resampler/push_sinc_resampler.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Fills `x` with the sum of two sines well within the pass band of a resampler
+// from or to `min_sample_rate_hz`, starting at sample `offset`.
+void GenerateSines(int min_sample_rate_hz,
+                   size_t offset,
+                   std::vector<float>& x) {
+  for (size_t i = 0; i < x.size(); ++i) {
+    const double t = static_cast<double>(offset + i) / min_sample_rate_hz;
+    x[i] = static_cast<float>(
+        8000.0 * sin(2.0 * M_PI * 0.05 * min_sample_rate_hz * t) +
+        4000.0 * sin(2.0 * M_PI * 0.31 * min_sample_rate_hz * t));
+  }
+}
+
+}  // namespace
+
+class PolyphaseResamplerTest
+    : public ::testing::TestWithParam<std::tuple<int, int>> {};
+
+// Checks that the output matches that of PushSincResampler, with the same
+// delay.
+TEST_P(PolyphaseResamplerTest, MatchesPushSincResampler) {
+  const int input_rate = std::get<0>(GetParam());
+  const int output_rate = std::get<1>(GetParam());
+  const size_t input_frames = input_rate / 100;
+  const size_t output_frames = output_rate / 100;
+  ASSERT_TRUE(PolyphaseResampler::IsSupported(input_frames, output_frames));
+  PolyphaseResampler polyphase_resampler(input_frames, output_frames);
+  PushSincResampler sinc_resampler(input_frames, output_frames);
+
+  std::vector<float> input(input_frames);
+  std::vector<float> polyphase_output(output_frames);
+  std::vector<float> sinc_output(output_frames);
+  float max_error = 0.f;
+  for (size_t k = 0; k < 50; ++k) {
+    GenerateSines(std::min(input_rate, output_rate), k * input_frames, input);
+    EXPECT_EQ(output_frames,
+              polyphase_resampler.Resample(input.data(), input_frames,
+                                           polyphase_output.data(),
+                                           output_frames));
+    sinc_resampler.Resample(input.data(), input_frames, sinc_output.data(),
+                            output_frames);
+    for (size_t i = 0; i < output_frames; ++i) {
+      max_error =
+          std::max(max_error, std::abs(polyphase_output[i] - sinc_output[i]));
+    }
+  }
+  // The sines have a peak amplitude of 12000.
+  EXPECT_LT(max_error, 12000.f * 1e-3f);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    PolyphaseResamplerTest,
+    PolyphaseResamplerTest,
+    ::testing::Values(std::make_tuple(48000, 16000),
+                      std::make_tuple(48000, 32000),
+                      std::make_tuple(44100, 48000),
+                      std::make_tuple(48000, 44100),
+                      std::make_tuple(16000, 48000),
+                      std::make_tuple(8000, 44100)));
+
+// Checks that the SIMD implementations match the C implementation.
+TEST(PolyphaseResamplerTest, ImplementationsMatch) {
+  auto bank = GetPolyphaseFilterBank(/*interpolation=*/160,
+                                     /*decimation=*/147, /*phase=*/73);
+  constexpr size_t kNumBlocks = 3;
+  std::vector<float> input(bank->history_size + kNumBlocks * 147);
+  GenerateSines(44100, 0, input);
+  std::vector<float> expected(kNumBlocks * 160);
+  PolyphaseResample(*bank, input.data(), kNumBlocks, expected.data());
+
+  std::vector<float> output(expected.size());
+  auto expect_near = [&] {
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_NEAR(expected[i], output[i], 1e-2f) << i;
+    }
+  };
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kSSE2)) {
+    PolyphaseResampleSse2(*bank, input.data(), kNumBlocks, output.data());
+    expect_near();
+  }
+  if (GetCPUInfo(kAVX2) && GetCPUInfo(kFMA3)) {
+    PolyphaseResampleAvx2(*bank, input.data(), kNumBlocks, output.data());
+    expect_near();
+  }
+#endif
+}
+
+// Checks that the filter banks are shared.
+TEST(PolyphaseResamplerTest, FilterBanksAreCached) {
+  auto bank = GetPolyphaseFilterBank(/*interpolation=*/1, /*decimation=*/3,
+                                     /*phase=*/2);
+  EXPECT_EQ(bank, GetPolyphaseFilterBank(1, 3, 2));
+  EXPECT_NE(bank, GetPolyphaseFilterBank(2, 3, 2));
+  EXPECT_NE(bank, GetPolyphaseFilterBank(1, 3, 0));
+}
+
+TEST(PolyphaseResamplerTest, IsSupported) {
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(480, 160));
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(441, 480));
+  EXPECT_TRUE(PolyphaseResampler::IsSupported(80, 441));
+  EXPECT_FALSE(PolyphaseResampler::IsSupported(480, 0));
+  EXPECT_FALSE(PolyphaseResampler::IsSupported(16, 48));
+  // Interpolation by 1111 / 480.
+  EXPECT_FALSE(PolyphaseResampler::IsSupported(480, 1111));
+}
+
+}  // namespace webrtc
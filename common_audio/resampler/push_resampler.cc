@@ -16,11 +16,22 @@
 #include <memory>
 
 #include "common_audio/include/audio_util.h"
+#include "common_audio/resampler/polyphase_resampler.h"
 #include "common_audio/resampler/push_sinc_resampler.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
+namespace {
+
+#if defined(WEBRTC_AUDIO_POLYPHASE_RESAMPLER)
+constexpr bool kUsePolyphaseResampler = true;
+#else
+constexpr bool kUsePolyphaseResampler = false;
+#endif
+
+}  // namespace
+
 template <typename T>
 PushResampler<T>::PushResampler()
     : src_sample_rate_hz_(0), dst_sample_rate_hz_(0), num_channels_(0) {}
@@ -57,12 +68,23 @@ int PushResampler<T>::InitializeIfNeeded(int src_sample_rate_hz,
       static_cast<size_t>(src_sample_rate_hz / 100);
   const size_t dst_size_10ms_mono =
       static_cast<size_t>(dst_sample_rate_hz / 100);
+  const bool use_polyphase_resampler =
+      kUsePolyphaseResampler &&
+      PolyphaseResampler::IsSupported(src_size_10ms_mono, dst_size_10ms_mono);
   channel_resamplers_.clear();
   for (size_t i = 0; i < num_channels; ++i) {
     channel_resamplers_.push_back(ChannelResampler());
     auto channel_resampler = channel_resamplers_.rbegin();
-    channel_resampler->resampler = std::make_unique<PushSincResampler>(
-        src_size_10ms_mono, dst_size_10ms_mono);
+    if (use_polyphase_resampler) {
+      // The filters are shared with all other resamplers for the same rates,
+      // so this does not recompute them.
+      channel_resampler->polyphase_resampler =
+          std::make_unique<PolyphaseResampler>(src_size_10ms_mono,
+                                               dst_size_10ms_mono);
+    } else {
+      channel_resampler->resampler = std::make_unique<PushSincResampler>(
+          src_size_10ms_mono, dst_size_10ms_mono);
+    }
     channel_resampler->source.resize(src_size_10ms_mono);
     channel_resampler->destination.resize(dst_size_10ms_mono);
   }
@@ -103,9 +125,15 @@ int PushResampler<T>::Resample(const T* src,
   size_t dst_length_mono = 0;
 
   for (auto& resampler : channel_resamplers_) {
-    dst_length_mono = resampler.resampler->Resample(
-        resampler.source.data(), src_length_mono, resampler.destination.data(),
-        dst_capacity_mono);
+    if (resampler.polyphase_resampler) {
+      dst_length_mono = resampler.polyphase_resampler->Resample(
+          resampler.source.data(), src_length_mono,
+          resampler.destination.data(), dst_capacity_mono);
+    } else {
+      dst_length_mono = resampler.resampler->Resample(
+          resampler.source.data(), src_length_mono,
+          resampler.destination.data(), dst_capacity_mono);
+    }
   }
 
   for (size_t ch = 0; ch < num_channels_; ++ch) {
@@ -0,0 +1,235 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/stockham_fft.h"
+
+#include <cmath>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kSSE2, kAVX2
+#endif
+
+namespace webrtc {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+bool IsPowerOfTwo(size_t n) {
+  return n > 0 && (n & (n - 1)) == 0;
+}
+
+// Runs the stages of the complex FFT of `size` points. `x` and `y` hold
+// `size` real parts followed by `size` imaginary parts; `x` is the input and
+// both are overwritten. Returns the buffer holding the output.
+float* Stages(size_t size, const float* twiddles, float* x, float* y) {
+  const size_t quarter = size / 4;
+  size_t s = 1;
+  for (; 4 * s <= size; s *= 4) {
+    const float* x_re = x;
+    const float* x_im = x + size;
+    float* y_re = y;
+    float* y_im = y + size;
+    for (size_t j = 0; j < quarter; ++j) {
+      // Butterfly p = j / s, q = j % s of the stage, which writes to
+      // s * (4p + m) + q for m = 0, 1, 2, 3.
+      const size_t k = 4 * j - 3 * (j & (s - 1));
+      const float apc_re = x_re[j] + x_re[j + 2 * quarter];
+      const float apc_im = x_im[j] + x_im[j + 2 * quarter];
+      const float amc_re = x_re[j] - x_re[j + 2 * quarter];
+      const float amc_im = x_im[j] - x_im[j + 2 * quarter];
+      const float bpd_re = x_re[j + quarter] + x_re[j + 3 * quarter];
+      const float bpd_im = x_im[j + quarter] + x_im[j + 3 * quarter];
+      const float bmd_re = x_re[j + quarter] - x_re[j + 3 * quarter];
+      const float bmd_im = x_im[j + quarter] - x_im[j + 3 * quarter];
+      const float y1_re = amc_re + bmd_im;
+      const float y1_im = amc_im - bmd_re;
+      const float y2_re = apc_re - bpd_re;
+      const float y2_im = apc_im - bpd_im;
+      const float y3_re = amc_re - bmd_im;
+      const float y3_im = amc_im + bmd_re;
+      const float* w = &twiddles[j];
+      y_re[k] = apc_re + bpd_re;
+      y_im[k] = apc_im + bpd_im;
+      y_re[k + s] = y1_re * w[0] - y1_im * w[quarter];
+      y_im[k + s] = y1_re * w[quarter] + y1_im * w[0];
+      y_re[k + 2 * s] = y2_re * w[2 * quarter] - y2_im * w[3 * quarter];
+      y_im[k + 2 * s] = y2_re * w[3 * quarter] + y2_im * w[2 * quarter];
+      y_re[k + 3 * s] = y3_re * w[4 * quarter] - y3_im * w[5 * quarter];
+      y_im[k + 3 * s] = y3_re * w[5 * quarter] + y3_im * w[4 * quarter];
+    }
+    twiddles += 6 * quarter;
+    std::swap(x, y);
+  }
+  if (s < size) {
+    // Final radix-2 stage, which has no twiddle factors.
+    RTC_DCHECK_EQ(2 * s, size);
+    for (size_t j = 0; j < s; ++j) {
+      y[j] = x[j] + x[j + s];
+      y[j + s] = x[j] - x[j + s];
+      y[size + j] = x[size + j] + x[size + j + s];
+      y[size + j + s] = x[size + j] - x[size + j + s];
+    }
+    std::swap(x, y);
+  }
+  return x;
+}
+
+}  // namespace
+
+StockhamFftTables::StockhamFftTables(size_t length)
+    : length(length), cos(length / 2), sin(length / 2) {
+  RTC_CHECK(IsPowerOfTwo(length));
+  RTC_CHECK_GE(length, 64);
+
+  const size_t size = length / 2;
+  const size_t quarter = size / 4;
+  for (size_t s = 1; 4 * s <= size; s *= 4) {
+    const size_t offset = twiddles.size();
+    twiddles.resize(offset + 6 * quarter);
+    for (size_t m = 1; m < 4; ++m) {
+      float* w_re = &twiddles[offset + 2 * (m - 1) * quarter];
+      float* w_im = w_re + quarter;
+      for (size_t j = 0; j < quarter; ++j) {
+        const double angle =
+            -2.0 * kPi * static_cast<double>(m * (j / s) * s) / size;
+        w_re[j] = static_cast<float>(std::cos(angle));
+        w_im[j] = static_cast<float>(std::sin(angle));
+      }
+    }
+  }
+
+  for (size_t k = 0; k < size; ++k) {
+    const double angle = kPi * static_cast<double>(k) / size;
+    cos[k] = static_cast<float>(std::cos(angle));
+    sin[k] = static_cast<float>(std::sin(angle));
+  }
+}
+
+StockhamFftTables::~StockhamFftTables() = default;
+
+void StockhamSplitSpectrum(const StockhamFftTables& tables,
+                           size_t first,
+                           const float* z,
+                           float* x) {
+  // With E and O the spectra of the even and odd samples, the output is
+  // X[k] = E[k] + exp(-i * pi * k / size) * O[k]. The imaginary parts are
+  // negated to match the Ooura FFT.
+  const size_t size = tables.length / 2;
+  const float* z_re = z;
+  const float* z_im = z + size;
+  RTC_DCHECK_GE(first, 1);
+  for (size_t k = first; k < size; ++k) {
+    const float e_re = 0.5f * (z_re[k] + z_re[size - k]);
+    const float e_im = 0.5f * (z_im[k] - z_im[size - k]);
+    const float d_re = 0.5f * (z_re[k] - z_re[size - k]);
+    const float d_im = 0.5f * (z_im[k] + z_im[size - k]);
+    x[2 * k] = e_re + tables.cos[k] * d_im - tables.sin[k] * d_re;
+    x[2 * k + 1] = -e_im + tables.cos[k] * d_re + tables.sin[k] * d_im;
+  }
+}
+
+void StockhamMergeSpectrum(const StockhamFftTables& tables,
+                           size_t first,
+                           const float* x,
+                           float* z) {
+  const size_t size = tables.length / 2;
+  float* z_re = z;
+  float* z_im = z + size;
+  RTC_DCHECK_GE(first, 1);
+  for (size_t k = first; k < size; ++k) {
+    const float p_re = x[2 * k];
+    const float p_im = -x[2 * k + 1];
+    const float q_re = x[2 * (size - k)];
+    const float q_im = x[2 * (size - k) + 1];
+    const float e_re = 0.5f * (p_re + q_re);
+    const float e_im = 0.5f * (p_im + q_im);
+    const float d_re = 0.5f * (p_re - q_re);
+    const float d_im = 0.5f * (p_im - q_im);
+    z_re[k] = e_re - tables.cos[k] * d_im - tables.sin[k] * d_re;
+    z_im[k] = -(e_im + tables.cos[k] * d_re - tables.sin[k] * d_im);
+  }
+}
+
+void StockhamRealForward(const StockhamFftTables& tables,
+                         float* x,
+                         float* scratch) {
+  const size_t size = tables.length / 2;
+  float* z = scratch;
+  for (size_t n = 0; n < size; ++n) {
+    z[n] = x[2 * n];
+    z[size + n] = x[2 * n + 1];
+  }
+  z = Stages(size, tables.twiddles.data(), z, scratch + tables.length);
+  x[0] = z[0] + z[size];
+  x[1] = z[0] - z[size];
+  StockhamSplitSpectrum(tables, 1, z, x);
+}
+
+void StockhamRealInverse(const StockhamFftTables& tables,
+                         float* x,
+                         float* scratch) {
+  // The complex FFT of the conjugated input gives the conjugated inverse FFT.
+  const size_t size = tables.length / 2;
+  float* z = scratch;
+  z[0] = 0.5f * (x[0] + x[1]);
+  z[size] = -0.5f * (x[0] - x[1]);
+  StockhamMergeSpectrum(tables, 1, x, z);
+  z = Stages(size, tables.twiddles.data(), z, scratch + tables.length);
+  for (size_t n = 0; n < size; ++n) {
+    x[2 * n] = z[n];
+    x[2 * n + 1] = -z[size + n];
+  }
+}
+
+StockhamRealFft::Implementation StockhamRealFft::GetBestImplementation() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) && GetCPUInfo(kFMA3)) {
+    return Implementation::kAvx2;
+  }
+  if (GetCPUInfo(kSSE2)) {
+    return Implementation::kSse2;
+  }
+#endif
+  return Implementation::kC;
+}
+
+StockhamRealFft::StockhamRealFft(size_t length)
+    : StockhamRealFft(length, GetBestImplementation()) {}
+
+StockhamRealFft::StockhamRealFft(size_t length, Implementation implementation)
+    : tables_(length),
+      forward_(StockhamRealForward),
+      inverse_(StockhamRealInverse) {
+  switch (implementation) {
+    case Implementation::kC:
+      break;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Implementation::kSse2:
+      forward_ = StockhamRealForwardSse2;
+      inverse_ = StockhamRealInverseSse2;
+      break;
+    case Implementation::kAvx2:
+      forward_ = StockhamRealForwardAvx2;
+      inverse_ = StockhamRealInverseAvx2;
+      break;
+#endif
+    default:
+      RTC_DCHECK_NOTREACHED();
+  }
+}
+
+StockhamRealFft::~StockhamRealFft() = default;
+
+}  // namespace webrtc
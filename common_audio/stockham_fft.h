@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_STOCKHAM_FFT_H_
+#define COMMON_AUDIO_STOCKHAM_FFT_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// Twiddle factors of a real valued FFT of `length` points computed with a
+// complex Stockham FFT of `length` / 2 points.
+struct StockhamFftTables {
+  explicit StockhamFftTables(size_t length);
+  ~StockhamFftTables();
+
+  const size_t length;
+  // Twiddle factors of each radix-4 stage of the complex FFT. For a stage with
+  // stride s, the factors exp(-2 * pi * i * m * (j / s) * s / (`length` / 2))
+  // for m = 1, 2, 3 are stored as real parts followed by imaginary parts, for
+  // j < `length` / 8.
+  std::vector<float> twiddles;
+  // cos(pi * k / (`length` / 2)) and sin(pi * k / (`length` / 2)), used to
+  // split the complex FFT output into the real FFT output.
+  std::vector<float> cos;
+  std::vector<float> sin;
+};
+
+// Computes the real valued FFT of the `tables.length` samples in `x` in place,
+// in the packed format of the Ooura FFT. `scratch` must hold
+// StockhamRealFft::ScratchSize(`tables.length`) floats.
+//
+// The even and odd samples are transformed as the real and imaginary parts of
+// a complex signal of half the length, using radix-4 stages of the Stockham
+// autosort algorithm and a final radix-2 stage if needed. Every stage reads its
+// inputs at fixed distances, so the loads are contiguous in all stages and only
+// the stores of the first stage need shuffles, which makes it a good fit for
+// SIMD.
+void StockhamRealForward(const StockhamFftTables& tables,
+                         float* x,
+                         float* scratch);
+
+// Computes the inverse of StockhamRealForward(). As for the Ooura FFT, the
+// output is scaled by `tables.length` / 2.
+void StockhamRealInverse(const StockhamFftTables& tables,
+                         float* x,
+                         float* scratch);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void StockhamRealForwardSse2(const StockhamFftTables& tables,
+                             float* x,
+                             float* scratch);
+void StockhamRealInverseSse2(const StockhamFftTables& tables,
+                             float* x,
+                             float* scratch);
+void StockhamRealForwardAvx2(const StockhamFftTables& tables,
+                             float* x,
+                             float* scratch);
+void StockhamRealInverseAvx2(const StockhamFftTables& tables,
+                             float* x,
+                             float* scratch);
+#endif
+
+// Splits the output `z` of the complex FFT into bins `first` and up of the
+// real FFT output `x`. Used by the SIMD versions for the bins that do not fill
+// a whole register.
+void StockhamSplitSpectrum(const StockhamFftTables& tables,
+                           size_t first,
+                           const float* z,
+                           float* x);
+
+// Inverse of StockhamSplitSpectrum(): merges bins `first` and up of the real
+// FFT output `x` into the conjugated input `z` of the complex FFT.
+void StockhamMergeSpectrum(const StockhamFftTables& tables,
+                           size_t first,
+                           const float* x,
+                           float* z);
+
+// Real valued FFT based on a complex Stockham FFT of half the length. The
+// input and output use the packed format of the Ooura FFT, see RealFft.
+class StockhamRealFft {
+ public:
+  enum class Implementation { kC, kSse2, kAvx2 };
+
+  // Returns the fastest implementation available on the CPU.
+  static Implementation GetBestImplementation();
+
+  // Creates an FFT of `length` points, a power of two of at least 64.
+  explicit StockhamRealFft(size_t length);
+  StockhamRealFft(size_t length, Implementation implementation);
+  StockhamRealFft(const StockhamRealFft&) = delete;
+  StockhamRealFft& operator=(const StockhamRealFft&) = delete;
+  ~StockhamRealFft();
+
+  // Number of floats of the `scratch` buffer needed by Forward() and Inverse().
+  static constexpr size_t ScratchSize(size_t length) { return 2 * length; }
+
+  // Computes the FFT of the `length` samples in `x` in place.
+  void Forward(float* x, float* scratch) const {
+    forward_(tables_, x, scratch);
+  }
+
+  // Computes the inverse FFT of `x` in place. As for the Ooura FFT, the output
+  // is scaled by `length` / 2.
+  void Inverse(float* x, float* scratch) const {
+    inverse_(tables_, x, scratch);
+  }
+
+ private:
+  using TransformFunction = void (*)(const StockhamFftTables& tables,
+                                     float* x,
+                                     float* scratch);
+
+  const StockhamFftTables tables_;
+  TransformFunction forward_;
+  TransformFunction inverse_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_STOCKHAM_FFT_H_
@@ -0,0 +1,243 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include <utility>
+
+#include "common_audio/stockham_fft.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+__m256 Reverse(__m256 v) {
+  return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+// Returns the even and odd elements of the 16 values in `v0` and `v1`.
+void Deinterleave(__m256 v0, __m256 v1, __m256* even, __m256* odd) {
+  // The shuffles work within 128 bit lanes, which leaves the 64 bit pairs of
+  // the result in the order 0, 2, 1, 3.
+  *even = _mm256_castpd_ps(_mm256_permute4x64_pd(
+      _mm256_castps_pd(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0))),
+      _MM_SHUFFLE(3, 1, 2, 0)));
+  *odd = _mm256_castpd_ps(_mm256_permute4x64_pd(
+      _mm256_castps_pd(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1))),
+      _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+// Stores the elements of `even` and `odd` interleaved to `dst`.
+void StoreInterleaved(__m256 even, __m256 odd, float* dst) {
+  const __m256 lo = _mm256_unpacklo_ps(even, odd);
+  const __m256 hi = _mm256_unpackhi_ps(even, odd);
+  _mm256_storeu_ps(dst, _mm256_permute2f128_ps(lo, hi, 0x20));
+  _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+}
+
+// Computes `a` * `w` for complex vectors given as real and imaginary parts.
+void Multiply(__m256 a_re,
+              __m256 a_im,
+              const float* w_re,
+              const float* w_im,
+              __m256* y_re,
+              __m256* y_im) {
+  const __m256 t_re = _mm256_loadu_ps(w_re);
+  const __m256 t_im = _mm256_loadu_ps(w_im);
+  *y_re = _mm256_fmsub_ps(a_re, t_re, _mm256_mul_ps(a_im, t_im));
+  *y_im = _mm256_fmadd_ps(a_re, t_im, _mm256_mul_ps(a_im, t_re));
+}
+
+// Stores `v0`, ..., `v3` to `dst` with their blocks of `block` values
+// interleaved, for `block` 1 or 4.
+void StoreInterleaved4(__m256 v0,
+                       __m256 v1,
+                       __m256 v2,
+                       __m256 v3,
+                       size_t block,
+                       float* dst) {
+  if (block == 1) {
+    // Transpose the 4x4 blocks within each 128 bit lane.
+    const __m256 t0 = _mm256_unpacklo_ps(v0, v1);
+    const __m256 t1 = _mm256_unpacklo_ps(v2, v3);
+    const __m256 t2 = _mm256_unpackhi_ps(v0, v1);
+    const __m256 t3 = _mm256_unpackhi_ps(v2, v3);
+    v0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    v1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    v2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    v3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  }
+  _mm256_storeu_ps(dst, _mm256_permute2f128_ps(v0, v1, 0x20));
+  _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(v2, v3, 0x20));
+  _mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(v0, v1, 0x31));
+  _mm256_storeu_ps(dst + 24, _mm256_permute2f128_ps(v2, v3, 0x31));
+}
+
+// See Stages() in stockham_fft.cc.
+float* Stages(size_t size, const float* twiddles, float* x, float* y) {
+  const size_t quarter = size / 4;
+  RTC_DCHECK_EQ(quarter % 8, 0);
+  size_t s = 1;
+  for (; 4 * s <= size; s *= 4) {
+    const float* x_re = x;
+    const float* x_im = x + size;
+    float* y_re = y;
+    float* y_im = y + size;
+    for (size_t j = 0; j < quarter; j += 8) {
+      const __m256 a_re = _mm256_loadu_ps(&x_re[j]);
+      const __m256 a_im = _mm256_loadu_ps(&x_im[j]);
+      const __m256 b_re = _mm256_loadu_ps(&x_re[j + quarter]);
+      const __m256 b_im = _mm256_loadu_ps(&x_im[j + quarter]);
+      const __m256 c_re = _mm256_loadu_ps(&x_re[j + 2 * quarter]);
+      const __m256 c_im = _mm256_loadu_ps(&x_im[j + 2 * quarter]);
+      const __m256 d_re = _mm256_loadu_ps(&x_re[j + 3 * quarter]);
+      const __m256 d_im = _mm256_loadu_ps(&x_im[j + 3 * quarter]);
+      const __m256 apc_re = _mm256_add_ps(a_re, c_re);
+      const __m256 apc_im = _mm256_add_ps(a_im, c_im);
+      const __m256 amc_re = _mm256_sub_ps(a_re, c_re);
+      const __m256 amc_im = _mm256_sub_ps(a_im, c_im);
+      const __m256 bpd_re = _mm256_add_ps(b_re, d_re);
+      const __m256 bpd_im = _mm256_add_ps(b_im, d_im);
+      const __m256 bmd_re = _mm256_sub_ps(b_re, d_re);
+      const __m256 bmd_im = _mm256_sub_ps(b_im, d_im);
+      const __m256 y0_re = _mm256_add_ps(apc_re, bpd_re);
+      const __m256 y0_im = _mm256_add_ps(apc_im, bpd_im);
+      __m256 y1_re, y1_im, y2_re, y2_im, y3_re, y3_im;
+      const float* w = &twiddles[j];
+      Multiply(_mm256_add_ps(amc_re, bmd_im), _mm256_sub_ps(amc_im, bmd_re), w,
+               w + quarter, &y1_re, &y1_im);
+      Multiply(_mm256_sub_ps(apc_re, bpd_re), _mm256_sub_ps(apc_im, bpd_im),
+               w + 2 * quarter, w + 3 * quarter, &y2_re, &y2_im);
+      Multiply(_mm256_sub_ps(amc_re, bmd_im), _mm256_add_ps(amc_im, bmd_re),
+               w + 4 * quarter, w + 5 * quarter, &y3_re, &y3_im);
+      if (s < 8) {
+        // The outputs of each butterfly are blocks of `s` < 8 values.
+        StoreInterleaved4(y0_re, y1_re, y2_re, y3_re, s, &y_re[4 * j]);
+        StoreInterleaved4(y0_im, y1_im, y2_im, y3_im, s, &y_im[4 * j]);
+      } else {
+        const size_t k = 4 * j - 3 * (j & (s - 1));
+        _mm256_storeu_ps(&y_re[k], y0_re);
+        _mm256_storeu_ps(&y_im[k], y0_im);
+        _mm256_storeu_ps(&y_re[k + s], y1_re);
+        _mm256_storeu_ps(&y_im[k + s], y1_im);
+        _mm256_storeu_ps(&y_re[k + 2 * s], y2_re);
+        _mm256_storeu_ps(&y_im[k + 2 * s], y2_im);
+        _mm256_storeu_ps(&y_re[k + 3 * s], y3_re);
+        _mm256_storeu_ps(&y_im[k + 3 * s], y3_im);
+      }
+    }
+    twiddles += 6 * quarter;
+    std::swap(x, y);
+  }
+  if (s < size) {
+    for (size_t j = 0; j < 2 * size; j += 2 * s) {
+      for (size_t n = j; n < j + s; n += 8) {
+        const __m256 a = _mm256_loadu_ps(&x[n]);
+        const __m256 b = _mm256_loadu_ps(&x[n + s]);
+        _mm256_storeu_ps(&y[n], _mm256_add_ps(a, b));
+        _mm256_storeu_ps(&y[n + s], _mm256_sub_ps(a, b));
+      }
+    }
+    std::swap(x, y);
+  }
+  return x;
+}
+
+}  // namespace
+
+void StockhamRealForwardAvx2(const StockhamFftTables& tables,
+                             float* x,
+                             float* scratch) {
+  const size_t size = tables.length / 2;
+  float* z = scratch;
+  for (size_t n = 0; n < size; n += 8) {
+    __m256 re, im;
+    Deinterleave(_mm256_loadu_ps(&x[2 * n]), _mm256_loadu_ps(&x[2 * n + 8]),
+                 &re, &im);
+    _mm256_storeu_ps(&z[n], re);
+    _mm256_storeu_ps(&z[size + n], im);
+  }
+  z = Stages(size, tables.twiddles.data(), z, scratch + tables.length);
+  const float* z_re = z;
+  const float* z_im = z + size;
+  x[0] = z_re[0] + z_im[0];
+  x[1] = z_re[0] - z_im[0];
+
+  // See StockhamSplitSpectrum().
+  const __m256 one_half = _mm256_set1_ps(0.5f);
+  size_t k = 1;
+  for (; k + 8 <= size; k += 8) {
+    const __m256 a_re = _mm256_loadu_ps(&z_re[k]);
+    const __m256 a_im = _mm256_loadu_ps(&z_im[k]);
+    const __m256 b_re = Reverse(_mm256_loadu_ps(&z_re[size - k - 7]));
+    const __m256 b_im = Reverse(_mm256_loadu_ps(&z_im[size - k - 7]));
+    const __m256 e_re = _mm256_mul_ps(one_half, _mm256_add_ps(a_re, b_re));
+    const __m256 e_im = _mm256_mul_ps(one_half, _mm256_sub_ps(a_im, b_im));
+    const __m256 d_re = _mm256_mul_ps(one_half, _mm256_sub_ps(a_re, b_re));
+    const __m256 d_im = _mm256_mul_ps(one_half, _mm256_add_ps(a_im, b_im));
+    const __m256 c = _mm256_loadu_ps(&tables.cos[k]);
+    const __m256 s = _mm256_loadu_ps(&tables.sin[k]);
+    const __m256 re = _mm256_fnmadd_ps(s, d_re, _mm256_fmadd_ps(c, d_im, e_re));
+    const __m256 im = _mm256_fmadd_ps(s, d_im, _mm256_fmsub_ps(c, d_re, e_im));
+    StoreInterleaved(re, im, &x[2 * k]);
+  }
+  StockhamSplitSpectrum(tables, k, z, x);
+}
+
+void StockhamRealInverseAvx2(const StockhamFftTables& tables,
+                             float* x,
+                             float* scratch) {
+  const size_t size = tables.length / 2;
+  float* z = scratch;
+  float* z_re = z;
+  float* z_im = z + size;
+  z_re[0] = 0.5f * (x[0] + x[1]);
+  z_im[0] = -0.5f * (x[0] - x[1]);
+
+  // See StockhamMergeSpectrum().
+  const __m256 one_half = _mm256_set1_ps(0.5f);
+  const __m256 sign_bit = _mm256_set1_ps(-0.f);
+  size_t k = 1;
+  for (; k + 8 <= size; k += 8) {
+    __m256 p_re, p_im, q_re, q_im;
+    Deinterleave(_mm256_loadu_ps(&x[2 * k]), _mm256_loadu_ps(&x[2 * k + 8]),
+                 &p_re, &p_im);
+    Deinterleave(_mm256_loadu_ps(&x[2 * (size - k - 7)]),
+                 _mm256_loadu_ps(&x[2 * (size - k - 7) + 8]), &q_re, &q_im);
+    p_im = _mm256_xor_ps(sign_bit, p_im);
+    q_re = Reverse(q_re);
+    q_im = Reverse(q_im);
+    const __m256 e_re = _mm256_mul_ps(one_half, _mm256_add_ps(p_re, q_re));
+    const __m256 e_im = _mm256_mul_ps(one_half, _mm256_add_ps(p_im, q_im));
+    const __m256 d_re = _mm256_mul_ps(one_half, _mm256_sub_ps(p_re, q_re));
+    const __m256 d_im = _mm256_mul_ps(one_half, _mm256_sub_ps(p_im, q_im));
+    const __m256 c = _mm256_loadu_ps(&tables.cos[k]);
+    const __m256 s = _mm256_loadu_ps(&tables.sin[k]);
+    _mm256_storeu_ps(
+        &z_re[k], _mm256_fnmadd_ps(s, d_re, _mm256_fnmadd_ps(c, d_im, e_re)));
+    _mm256_storeu_ps(
+        &z_im[k],
+        _mm256_xor_ps(sign_bit, _mm256_fnmadd_ps(
+                                    s, d_im, _mm256_fmadd_ps(c, d_re, e_im))));
+  }
+  StockhamMergeSpectrum(tables, k, x, z);
+
+  z = Stages(size, tables.twiddles.data(), z, scratch + tables.length);
+  z_re = z;
+  z_im = z + size;
+  for (size_t n = 0; n < size; n += 8) {
+    StoreInterleaved(_mm256_loadu_ps(&z_re[n]),
+                     _mm256_xor_ps(sign_bit, _mm256_loadu_ps(&z_im[n])),
+                     &x[2 * n]);
+  }
+}
+
+}  // namespace webrtc
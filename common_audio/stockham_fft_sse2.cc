@@ -0,0 +1,216 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+#include <utility>
+
+#include "common_audio/stockham_fft.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+__m128 Reverse(__m128 v) {
+  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+// Computes `a` * `w` for complex vectors given as real and imaginary parts.
+void Multiply(__m128 a_re,
+              __m128 a_im,
+              const float* w_re,
+              const float* w_im,
+              __m128* y_re,
+              __m128* y_im) {
+  const __m128 t_re = _mm_loadu_ps(w_re);
+  const __m128 t_im = _mm_loadu_ps(w_im);
+  *y_re = _mm_sub_ps(_mm_mul_ps(a_re, t_re), _mm_mul_ps(a_im, t_im));
+  *y_im = _mm_add_ps(_mm_mul_ps(a_re, t_im), _mm_mul_ps(a_im, t_re));
+}
+
+// Stores the 4x4 transpose of `v0`, ..., `v3` to `dst`.
+void StoreTransposed(__m128 v0, __m128 v1, __m128 v2, __m128 v3, float* dst) {
+  const __m128 t0 = _mm_unpacklo_ps(v0, v1);
+  const __m128 t1 = _mm_unpacklo_ps(v2, v3);
+  const __m128 t2 = _mm_unpackhi_ps(v0, v1);
+  const __m128 t3 = _mm_unpackhi_ps(v2, v3);
+  _mm_storeu_ps(dst, _mm_movelh_ps(t0, t1));
+  _mm_storeu_ps(dst + 4, _mm_movehl_ps(t1, t0));
+  _mm_storeu_ps(dst + 8, _mm_movelh_ps(t2, t3));
+  _mm_storeu_ps(dst + 12, _mm_movehl_ps(t3, t2));
+}
+
+// See Stages() in stockham_fft.cc.
+float* Stages(size_t size, const float* twiddles, float* x, float* y) {
+  const size_t quarter = size / 4;
+  RTC_DCHECK_EQ(quarter % 4, 0);
+  size_t s = 1;
+  for (; 4 * s <= size; s *= 4) {
+    const float* x_re = x;
+    const float* x_im = x + size;
+    float* y_re = y;
+    float* y_im = y + size;
+    for (size_t j = 0; j < quarter; j += 4) {
+      const __m128 a_re = _mm_loadu_ps(&x_re[j]);
+      const __m128 a_im = _mm_loadu_ps(&x_im[j]);
+      const __m128 b_re = _mm_loadu_ps(&x_re[j + quarter]);
+      const __m128 b_im = _mm_loadu_ps(&x_im[j + quarter]);
+      const __m128 c_re = _mm_loadu_ps(&x_re[j + 2 * quarter]);
+      const __m128 c_im = _mm_loadu_ps(&x_im[j + 2 * quarter]);
+      const __m128 d_re = _mm_loadu_ps(&x_re[j + 3 * quarter]);
+      const __m128 d_im = _mm_loadu_ps(&x_im[j + 3 * quarter]);
+      const __m128 apc_re = _mm_add_ps(a_re, c_re);
+      const __m128 apc_im = _mm_add_ps(a_im, c_im);
+      const __m128 amc_re = _mm_sub_ps(a_re, c_re);
+      const __m128 amc_im = _mm_sub_ps(a_im, c_im);
+      const __m128 bpd_re = _mm_add_ps(b_re, d_re);
+      const __m128 bpd_im = _mm_add_ps(b_im, d_im);
+      const __m128 bmd_re = _mm_sub_ps(b_re, d_re);
+      const __m128 bmd_im = _mm_sub_ps(b_im, d_im);
+      const __m128 y0_re = _mm_add_ps(apc_re, bpd_re);
+      const __m128 y0_im = _mm_add_ps(apc_im, bpd_im);
+      __m128 y1_re, y1_im, y2_re, y2_im, y3_re, y3_im;
+      const float* w = &twiddles[j];
+      Multiply(_mm_add_ps(amc_re, bmd_im), _mm_sub_ps(amc_im, bmd_re), w,
+               w + quarter, &y1_re, &y1_im);
+      Multiply(_mm_sub_ps(apc_re, bpd_re), _mm_sub_ps(apc_im, bpd_im),
+               w + 2 * quarter, w + 3 * quarter, &y2_re, &y2_im);
+      Multiply(_mm_sub_ps(amc_re, bmd_im), _mm_add_ps(amc_im, bmd_re),
+               w + 4 * quarter, w + 5 * quarter, &y3_re, &y3_im);
+      if (s == 1) {
+        // The outputs of each butterfly are adjacent.
+        StoreTransposed(y0_re, y1_re, y2_re, y3_re, &y_re[4 * j]);
+        StoreTransposed(y0_im, y1_im, y2_im, y3_im, &y_im[4 * j]);
+      } else {
+        const size_t k = 4 * j - 3 * (j & (s - 1));
+        _mm_storeu_ps(&y_re[k], y0_re);
+        _mm_storeu_ps(&y_im[k], y0_im);
+        _mm_storeu_ps(&y_re[k + s], y1_re);
+        _mm_storeu_ps(&y_im[k + s], y1_im);
+        _mm_storeu_ps(&y_re[k + 2 * s], y2_re);
+        _mm_storeu_ps(&y_im[k + 2 * s], y2_im);
+        _mm_storeu_ps(&y_re[k + 3 * s], y3_re);
+        _mm_storeu_ps(&y_im[k + 3 * s], y3_im);
+      }
+    }
+    twiddles += 6 * quarter;
+    std::swap(x, y);
+  }
+  if (s < size) {
+    for (size_t j = 0; j < 2 * size; j += 2 * s) {
+      for (size_t n = j; n < j + s; n += 4) {
+        const __m128 a = _mm_loadu_ps(&x[n]);
+        const __m128 b = _mm_loadu_ps(&x[n + s]);
+        _mm_storeu_ps(&y[n], _mm_add_ps(a, b));
+        _mm_storeu_ps(&y[n + s], _mm_sub_ps(a, b));
+      }
+    }
+    std::swap(x, y);
+  }
+  return x;
+}
+
+}  // namespace
+
+void StockhamRealForwardSse2(const StockhamFftTables& tables,
+                             float* x,
+                             float* scratch) {
+  const size_t size = tables.length / 2;
+  float* z = scratch;
+  for (size_t n = 0; n < size; n += 4) {
+    const __m128 v0 = _mm_loadu_ps(&x[2 * n]);
+    const __m128 v1 = _mm_loadu_ps(&x[2 * n + 4]);
+    _mm_storeu_ps(&z[n], _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(&z[size + n],
+                  _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+  z = Stages(size, tables.twiddles.data(), z, scratch + tables.length);
+  const float* z_re = z;
+  const float* z_im = z + size;
+  x[0] = z_re[0] + z_im[0];
+  x[1] = z_re[0] - z_im[0];
+
+  // See StockhamSplitSpectrum().
+  const __m128 one_half = _mm_set1_ps(0.5f);
+  size_t k = 1;
+  for (; k + 4 <= size; k += 4) {
+    const __m128 a_re = _mm_loadu_ps(&z_re[k]);
+    const __m128 a_im = _mm_loadu_ps(&z_im[k]);
+    const __m128 b_re = Reverse(_mm_loadu_ps(&z_re[size - k - 3]));
+    const __m128 b_im = Reverse(_mm_loadu_ps(&z_im[size - k - 3]));
+    const __m128 e_re = _mm_mul_ps(one_half, _mm_add_ps(a_re, b_re));
+    const __m128 e_im = _mm_mul_ps(one_half, _mm_sub_ps(a_im, b_im));
+    const __m128 d_re = _mm_mul_ps(one_half, _mm_sub_ps(a_re, b_re));
+    const __m128 d_im = _mm_mul_ps(one_half, _mm_add_ps(a_im, b_im));
+    const __m128 c = _mm_loadu_ps(&tables.cos[k]);
+    const __m128 s = _mm_loadu_ps(&tables.sin[k]);
+    const __m128 re =
+        _mm_sub_ps(_mm_add_ps(e_re, _mm_mul_ps(c, d_im)), _mm_mul_ps(s, d_re));
+    const __m128 im =
+        _mm_add_ps(_mm_sub_ps(_mm_mul_ps(c, d_re), e_im), _mm_mul_ps(s, d_im));
+    _mm_storeu_ps(&x[2 * k], _mm_unpacklo_ps(re, im));
+    _mm_storeu_ps(&x[2 * k + 4], _mm_unpackhi_ps(re, im));
+  }
+  StockhamSplitSpectrum(tables, k, z, x);
+}
+
+void StockhamRealInverseSse2(const StockhamFftTables& tables,
+                             float* x,
+                             float* scratch) {
+  const size_t size = tables.length / 2;
+  float* z = scratch;
+  float* z_re = z;
+  float* z_im = z + size;
+  z_re[0] = 0.5f * (x[0] + x[1]);
+  z_im[0] = -0.5f * (x[0] - x[1]);
+
+  // See StockhamMergeSpectrum().
+  const __m128 one_half = _mm_set1_ps(0.5f);
+  const __m128 sign_bit = _mm_set1_ps(-0.f);
+  size_t k = 1;
+  for (; k + 4 <= size; k += 4) {
+    const __m128 p0 = _mm_loadu_ps(&x[2 * k]);
+    const __m128 p1 = _mm_loadu_ps(&x[2 * k + 4]);
+    const __m128 q0 = _mm_loadu_ps(&x[2 * (size - k - 3)]);
+    const __m128 q1 = _mm_loadu_ps(&x[2 * (size - k - 3) + 4]);
+    const __m128 p_re = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 p_im =
+        _mm_xor_ps(sign_bit, _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1)));
+    const __m128 q_re = _mm_shuffle_ps(q1, q0, _MM_SHUFFLE(0, 2, 0, 2));
+    const __m128 q_im = _mm_shuffle_ps(q1, q0, _MM_SHUFFLE(1, 3, 1, 3));
+    const __m128 e_re = _mm_mul_ps(one_half, _mm_add_ps(p_re, q_re));
+    const __m128 e_im = _mm_mul_ps(one_half, _mm_add_ps(p_im, q_im));
+    const __m128 d_re = _mm_mul_ps(one_half, _mm_sub_ps(p_re, q_re));
+    const __m128 d_im = _mm_mul_ps(one_half, _mm_sub_ps(p_im, q_im));
+    const __m128 c = _mm_loadu_ps(&tables.cos[k]);
+    const __m128 s = _mm_loadu_ps(&tables.sin[k]);
+    _mm_storeu_ps(&z_re[k], _mm_sub_ps(_mm_sub_ps(e_re, _mm_mul_ps(c, d_im)),
+                                       _mm_mul_ps(s, d_re)));
+    _mm_storeu_ps(
+        &z_im[k],
+        _mm_xor_ps(sign_bit, _mm_sub_ps(_mm_add_ps(e_im, _mm_mul_ps(c, d_re)),
+                                        _mm_mul_ps(s, d_im))));
+  }
+  StockhamMergeSpectrum(tables, k, x, z);
+
+  z = Stages(size, tables.twiddles.data(), z, scratch + tables.length);
+  z_re = z;
+  z_im = z + size;
+  for (size_t n = 0; n < size; n += 4) {
+    const __m128 re = _mm_loadu_ps(&z_re[n]);
+    const __m128 im = _mm_xor_ps(sign_bit, _mm_loadu_ps(&z_im[n]));
+    _mm_storeu_ps(&x[2 * n], _mm_unpacklo_ps(re, im));
+    _mm_storeu_ps(&x[2 * n + 4], _mm_unpackhi_ps(re, im));
+  }
+}
+
+}  // namespace webrtc
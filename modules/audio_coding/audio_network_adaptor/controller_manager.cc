@@ -19,6 +19,7 @@
 #include "modules/audio_coding/audio_network_adaptor/bitrate_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/channel_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/debug_dump_writer.h"
+#include "modules/audio_coding/audio_network_adaptor/dred_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/dtx_controller.h"
 #include "modules/audio_coding/audio_network_adaptor/fec_controller_plr_based.h"
 #include "modules/audio_coding/audio_network_adaptor/frame_length_controller.h"
@@ -180,6 +181,24 @@ std::unique_ptr<DtxController> CreateDtxController(
       dtx_config.dtx_disabling_bandwidth_bps())));
 }
 
+std::unique_ptr<DredController> CreateDredController(
+    const audio_network_adaptor::config::DredController& config) {
+  RTC_CHECK(config.has_min_dred_duration_ms());
+  RTC_CHECK(config.has_max_dred_duration_ms());
+  RTC_CHECK(config.has_dred_enabling_packet_loss());
+  RTC_CHECK(config.has_dred_disabling_packet_loss());
+  RTC_CHECK(config.has_max_dred_packet_loss());
+  RTC_CHECK(config.has_min_bandwidth_bps());
+  RTC_CHECK(config.has_max_dred_bandwidth_bps());
+  RTC_CHECK(config.has_time_constant_ms());
+
+  return std::make_unique<DredController>(DredController::Config(
+      config.min_dred_duration_ms(), config.max_dred_duration_ms(),
+      config.dred_enabling_packet_loss(), config.dred_disabling_packet_loss(),
+      config.max_dred_packet_loss(), config.min_bandwidth_bps(),
+      config.max_dred_bandwidth_bps(), config.time_constant_ms()));
+}
+
 using audio_network_adaptor::BitrateController;
 std::unique_ptr<BitrateController> CreateBitrateController(
     const audio_network_adaptor::config::BitrateController& bitrate_config,
@@ -292,6 +311,9 @@ std::unique_ptr<ControllerManager> ControllerManagerImpl::Create(
             controller_config.frame_length_controller_v2(),
             encoder_frame_lengths_ms);
         break;
+      case audio_network_adaptor::config::Controller::kDredController:
+        controller = CreateDredController(controller_config.dred_controller());
+        break;
       default:
         RTC_DCHECK_NOTREACHED();
     }
@@ -135,6 +135,9 @@ void DebugDumpWriterImpl::DumpEncoderRuntimeConfig(
   if (config.num_channels)
     dump_config->set_num_channels(*config.num_channels);
 
+  if (config.dred_duration_ms)
+    dump_config->set_dred_duration_ms(*config.dred_duration_ms);
+
   DumpEventToFile(event, &dump_file_);
 #endif  // WEBRTC_ENABLE_PROTOBUF
 }
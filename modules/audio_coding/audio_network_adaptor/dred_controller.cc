@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/audio_network_adaptor/dred_controller.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// DRED is encoded in units of 10 ms frames.
+constexpr int kDredFrameMs = 10;
+
+float Share(float value, float low, float high) {
+  if (high <= low)
+    return value >= high ? 1.0f : 0.0f;
+  return std::min(std::max((value - low) / (high - low), 0.0f), 1.0f);
+}
+
+}  // namespace
+
+DredController::Config::Config(int min_dred_duration_ms,
+                               int max_dred_duration_ms,
+                               float dred_enabling_packet_loss,
+                               float dred_disabling_packet_loss,
+                               float max_dred_packet_loss,
+                               int min_bandwidth_bps,
+                               int max_dred_bandwidth_bps,
+                               int time_constant_ms)
+    : min_dred_duration_ms(min_dred_duration_ms),
+      max_dred_duration_ms(max_dred_duration_ms),
+      dred_enabling_packet_loss(dred_enabling_packet_loss),
+      dred_disabling_packet_loss(dred_disabling_packet_loss),
+      max_dred_packet_loss(max_dred_packet_loss),
+      min_bandwidth_bps(min_bandwidth_bps),
+      max_dred_bandwidth_bps(max_dred_bandwidth_bps),
+      time_constant_ms(time_constant_ms) {}
+
+DredController::DredController(
+    const Config& config,
+    std::unique_ptr<SmoothingFilter> smoothing_filter)
+    : config_(config), packet_loss_smoother_(std::move(smoothing_filter)) {
+  RTC_DCHECK_GT(config_.min_dred_duration_ms, 0);
+  RTC_DCHECK_LE(config_.min_dred_duration_ms, config_.max_dred_duration_ms);
+  RTC_DCHECK_LE(config_.dred_disabling_packet_loss,
+                config_.dred_enabling_packet_loss);
+}
+
+DredController::DredController(const Config& config)
+    : DredController(config,
+                     std::make_unique<SmoothingFilterImpl>(
+                         config.time_constant_ms)) {}
+
+DredController::~DredController() = default;
+
+void DredController::UpdateNetworkMetrics(
+    const NetworkMetrics& network_metrics) {
+  if (network_metrics.uplink_bandwidth_bps)
+    uplink_bandwidth_bps_ = network_metrics.uplink_bandwidth_bps;
+  if (network_metrics.uplink_packet_loss_fraction) {
+    packet_loss_smoother_->AddSample(
+        *network_metrics.uplink_packet_loss_fraction);
+  }
+}
+
+void DredController::MakeDecision(AudioEncoderRuntimeConfig* config) {
+  // Decision on `dred_duration_ms` should not have been made.
+  RTC_DCHECK(!config->dred_duration_ms);
+
+  const auto packet_loss = packet_loss_smoother_->GetAverage();
+  if (!packet_loss || !uplink_bandwidth_bps_)
+    return;
+
+  if (*uplink_bandwidth_bps_ < config_.min_bandwidth_bps) {
+    dred_enabled_ = false;
+  } else if (dred_enabled_) {
+    dred_enabled_ = *packet_loss >= config_.dred_disabling_packet_loss;
+  } else {
+    dred_enabled_ = *packet_loss >= config_.dred_enabling_packet_loss;
+  }
+
+  config->dred_duration_ms =
+      dred_enabled_ ? DredDurationMs(*packet_loss, *uplink_bandwidth_bps_) : 0;
+}
+
+int DredController::DredDurationMs(float packet_loss,
+                                   int uplink_bandwidth_bps) const {
+  const float loss_share =
+      Share(packet_loss, config_.dred_disabling_packet_loss,
+            config_.max_dred_packet_loss);
+  const float bandwidth_share =
+      Share(static_cast<float>(uplink_bandwidth_bps),
+            static_cast<float>(config_.min_bandwidth_bps),
+            static_cast<float>(config_.max_dred_bandwidth_bps));
+  const int duration_ms =
+      config_.min_dred_duration_ms +
+      static_cast<int>(std::min(loss_share, bandwidth_share) *
+                       (config_.max_dred_duration_ms -
+                        config_.min_dred_duration_ms));
+  return std::max(duration_ms / kDredFrameMs * kDredFrameMs, kDredFrameMs);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_DRED_CONTROLLER_H_
+#define MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_DRED_CONTROLLER_H_
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "common_audio/smoothing_filter.h"
+#include "modules/audio_coding/audio_network_adaptor/controller.h"
+#include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor_config.h"
+
+namespace webrtc {
+
+// Decides how much Deep REDundancy (DRED) the encoder should carry. DRED is
+// switched on when the smoothed uplink packet loss rises above
+// `dred_enabling_packet_loss` and off again when it falls below
+// `dred_disabling_packet_loss`. While on, the duration grows linearly from
+// `min_dred_duration_ms` to `max_dred_duration_ms` with both the packet loss
+// (up to `max_dred_packet_loss`) and the uplink bandwidth (up to
+// `max_dred_bandwidth_bps`), whichever allows less. Below
+// `min_bandwidth_bps` there is no room for DRED and it is switched off.
+class DredController final : public Controller {
+ public:
+  struct Config {
+    Config(int min_dred_duration_ms,
+           int max_dred_duration_ms,
+           float dred_enabling_packet_loss,
+           float dred_disabling_packet_loss,
+           float max_dred_packet_loss,
+           int min_bandwidth_bps,
+           int max_dred_bandwidth_bps,
+           int time_constant_ms);
+    int min_dred_duration_ms;
+    int max_dred_duration_ms;
+    float dred_enabling_packet_loss;
+    float dred_disabling_packet_loss;
+    float max_dred_packet_loss;
+    int min_bandwidth_bps;
+    int max_dred_bandwidth_bps;
+    int time_constant_ms;
+  };
+
+  // Dependency injection for testing.
+  DredController(const Config& config,
+                 std::unique_ptr<SmoothingFilter> smoothing_filter);
+
+  explicit DredController(const Config& config);
+
+  ~DredController() override;
+
+  DredController(const DredController&) = delete;
+  DredController& operator=(const DredController&) = delete;
+
+  void UpdateNetworkMetrics(const NetworkMetrics& network_metrics) override;
+
+  // Leaves `dred_duration_ms` unset until both the uplink bandwidth and the
+  // packet loss are known, so the encoder keeps its configured duration.
+  void MakeDecision(AudioEncoderRuntimeConfig* config) override;
+
+ private:
+  int DredDurationMs(float packet_loss, int uplink_bandwidth_bps) const;
+
+  const Config config_;
+  bool dred_enabled_ = false;
+  absl::optional<int> uplink_bandwidth_bps_;
+  const std::unique_ptr<SmoothingFilter> packet_loss_smoother_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_DRED_CONTROLLER_H_
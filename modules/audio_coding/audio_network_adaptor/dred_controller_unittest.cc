@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/audio_network_adaptor/dred_controller.h"
+
+#include <memory>
+#include <utility>
+
+#include "common_audio/mocks/mock_smoothing_filter.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+
+constexpr int kMinDredDurationMs = 100;
+constexpr int kMaxDredDurationMs = 1000;
+constexpr float kEnablingPacketLoss = 0.05f;
+constexpr float kDisablingPacketLoss = 0.02f;
+constexpr float kMaxDredPacketLoss = 0.2f;
+constexpr int kMinBandwidthBps = 16000;
+constexpr int kMaxDredBandwidthBps = 64000;
+constexpr int kMediumBandwidthBps =
+    (kMinBandwidthBps + kMaxDredBandwidthBps) / 2;
+
+struct DredControllerTestStates {
+  std::unique_ptr<DredController> controller;
+  MockSmoothingFilter* packet_loss_smoother;
+};
+
+DredControllerTestStates CreateDredController() {
+  DredControllerTestStates states;
+  auto mock_smoothing_filter =
+      std::make_unique<NiceMock<MockSmoothingFilter>>();
+  states.packet_loss_smoother = mock_smoothing_filter.get();
+  states.controller = std::make_unique<DredController>(
+      DredController::Config(kMinDredDurationMs, kMaxDredDurationMs,
+                             kEnablingPacketLoss, kDisablingPacketLoss,
+                             kMaxDredPacketLoss, kMinBandwidthBps,
+                             kMaxDredBandwidthBps, 0),
+      std::move(mock_smoothing_filter));
+  return states;
+}
+
+void CheckDecision(DredControllerTestStates* states,
+                   int uplink_bandwidth_bps,
+                   float uplink_packet_loss,
+                   int expected_dred_duration_ms) {
+  Controller::NetworkMetrics network_metrics;
+  network_metrics.uplink_bandwidth_bps = uplink_bandwidth_bps;
+  network_metrics.uplink_packet_loss_fraction = uplink_packet_loss;
+  EXPECT_CALL(*states->packet_loss_smoother, AddSample(uplink_packet_loss));
+  states->controller->UpdateNetworkMetrics(network_metrics);
+  EXPECT_CALL(*states->packet_loss_smoother, GetAverage())
+      .WillOnce(Return(uplink_packet_loss));
+
+  AudioEncoderRuntimeConfig config;
+  states->controller->MakeDecision(&config);
+  EXPECT_EQ(expected_dred_duration_ms, config.dred_duration_ms);
+}
+
+}  // namespace
+
+TEST(DredControllerTest, NoDecisionWhenNetworkMetricsUnknown) {
+  auto states = CreateDredController();
+  AudioEncoderRuntimeConfig config;
+  states.controller->MakeDecision(&config);
+  EXPECT_FALSE(config.dred_duration_ms);
+}
+
+TEST(DredControllerTest, OffForLowPacketLoss) {
+  auto states = CreateDredController();
+  CheckDecision(&states, kMaxDredBandwidthBps, kDisablingPacketLoss, 0);
+}
+
+TEST(DredControllerTest, OnForHighPacketLoss) {
+  auto states = CreateDredController();
+  CheckDecision(&states, kMaxDredBandwidthBps, kMaxDredPacketLoss,
+                kMaxDredDurationMs);
+}
+
+TEST(DredControllerTest, OffForLowBandwidth) {
+  auto states = CreateDredController();
+  CheckDecision(&states, kMinBandwidthBps - 1, kMaxDredPacketLoss, 0);
+}
+
+TEST(DredControllerTest, DurationLimitedByBandwidth) {
+  auto states = CreateDredController();
+  CheckDecision(&states, kMediumBandwidthBps, kMaxDredPacketLoss,
+                (kMinDredDurationMs + kMaxDredDurationMs) / 2);
+}
+
+TEST(DredControllerTest, MinimumDurationWhenJustEnabled) {
+  auto states = CreateDredController();
+  CheckDecision(&states, kMaxDredBandwidthBps, kDisablingPacketLoss, 0);
+  CheckDecision(&states, kMinBandwidthBps, kEnablingPacketLoss,
+                kMinDredDurationMs);
+}
+
+TEST(DredControllerTest, CheckBehaviorOnChangingPacketLoss) {
+  auto states = CreateDredController();
+  CheckDecision(&states, kMaxDredBandwidthBps, 0.04f, 0);
+  CheckDecision(&states, kMaxDredBandwidthBps, kMaxDredPacketLoss,
+                kMaxDredDurationMs);
+  // Stays on until the packet loss drops below the disabling threshold.
+  CheckDecision(&states, kMaxDredBandwidthBps, kDisablingPacketLoss,
+                kMinDredDurationMs);
+  CheckDecision(&states, kMaxDredBandwidthBps, 0.01f, 0);
+}
+
+}  // namespace webrtc
@@ -36,6 +36,10 @@ struct AudioEncoderRuntimeConfig {
   // to encode.
   absl::optional<size_t> num_channels;
 
+  // Amount of Deep REDundancy (DRED) to encode, in milliseconds. Zero disables
+  // DRED.
+  absl::optional<int> dred_duration_ms;
+
   // This is true if the last frame length change was an increase, and otherwise
   // false.
   // The value of this boolean is used to apply a different offset to the
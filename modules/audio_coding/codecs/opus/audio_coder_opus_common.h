@@ -19,8 +19,11 @@
 #include "absl/types/optional.h"
 #include "api/audio_codecs/audio_decoder.h"
 #include "api/audio_codecs/audio_format.h"
-#include "rtc_base/string_to_number.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/string_to_number.h"
 
 namespace webrtc {
 
@@ -38,10 +41,16 @@ absl::optional<std::vector<unsigned char>> GetFormatParameter(
     const SdpAudioFormat& format,
     absl::string_view param);
 
+// Reference counted storage for the DRED state parsed from a single payload.
+// It is shared by all the frames recovered from that payload.
+using OpusDredBuffer = rtc::FinalRefCountedObject<rtc::Buffer>;
+
 class OpusFrame : public AudioDecoder::EncodedAudioFrame {
  public:
+  // All the frames derived from one payload share the same, read-only,
+  // reference counted `payload`.
   OpusFrame(AudioDecoder* decoder,
-            rtc::Buffer&& payload,
+            rtc::CopyOnWriteBuffer payload,
             bool is_primary_payload)
       : decoder_(decoder),
         payload_(std::move(payload)),
@@ -50,12 +59,12 @@ class OpusFrame : public AudioDecoder::EncodedAudioFrame {
         dred_primary_timestamp_(0) {}
 
   OpusFrame(AudioDecoder* decoder,
-            const rtc::CopyOnWriteBuffer& dred_payload,
+            rtc::scoped_refptr<OpusDredBuffer> dred,
             int dred_index,
             uint32_t dred_primary_timestamp)
       : decoder_(decoder),
         is_primary_payload_(false),
-        dred_payload_(dred_payload),
+        dred_(std::move(dred)),
         dred_index_(dred_index),
         dred_primary_timestamp_(dred_primary_timestamp) {}
 
@@ -66,9 +75,10 @@ class OpusFrame : public AudioDecoder::EncodedAudioFrame {
       return decoder_->SampleRateHz() / 100;
     }
     if (is_primary_payload_) {
-      ret = decoder_->PacketDuration(payload_.data(), payload_.size());
+      ret = decoder_->PacketDuration(payload_.cdata(), payload_.size());
     } else {
-      ret = decoder_->PacketDurationRedundant(payload_.data(), payload_.size());
+      ret = decoder_->PacketDurationRedundant(payload_.cdata(),
+                                              payload_.size());
     }
     return (ret < 0) ? 0 : static_cast<size_t>(ret);
   }
@@ -81,13 +91,13 @@ class OpusFrame : public AudioDecoder::EncodedAudioFrame {
     int ret;
     if (is_primary_payload_) {
       ret = decoder_->Decode(
-          payload_.data(), payload_.size(), decoder_->SampleRateHz(),
+          payload_.cdata(), payload_.size(), decoder_->SampleRateHz(),
           decoded.size() * sizeof(int16_t), decoded.data(), &speech_type);
-    } else if (dred_index_ > 0 && dred_payload_.size() > 0) {
-      ret = decoder_->DecodeDred(dred_payload_.data(), dred_payload_.size(), dred_primary_timestamp_, decoded.data(), dred_index_);
+    } else if (dred_index_ > 0 && dred_ && dred_->size() > 0) {
+      ret = decoder_->DecodeDred(dred_->data(), dred_->size(), dred_primary_timestamp_, decoded.data(), dred_index_);
     } else {
       ret = decoder_->DecodeRedundant(
-          payload_.data(), payload_.size(), decoder_->SampleRateHz(),
+          payload_.cdata(), payload_.size(), decoder_->SampleRateHz(),
           decoded.size() * sizeof(int16_t), decoded.data(), &speech_type);
     }
 
@@ -97,12 +107,22 @@ class OpusFrame : public AudioDecoder::EncodedAudioFrame {
     return DecodeResult{static_cast<size_t>(ret), speech_type};
   }
 
+  std::vector<AudioDecoder::ParseResult> ParseRedundancy(
+      uint32_t timestamp,
+      uint32_t begin_timestamp,
+      uint32_t recovery_timestamp_offset) const override {
+    if (!is_primary_payload_) {
+      return {};
+    }
+    return decoder_->ParseDred(payload_, timestamp, begin_timestamp,
+                               recovery_timestamp_offset);
+  }
+
  private:
   AudioDecoder* const decoder_;
-  const rtc::Buffer payload_;
+  const rtc::CopyOnWriteBuffer payload_;
   const bool is_primary_payload_;
-  // TODO(klingm@amazon.com) consider using use a single copy on write buffer for both payload and/or DRED
-  const rtc::CopyOnWriteBuffer dred_payload_;
+  const rtc::scoped_refptr<OpusDredBuffer> dred_;
   const int dred_index_;
   const uint32_t dred_primary_timestamp_;
 };
@@ -89,18 +89,18 @@ std::vector<AudioDecoder::ParseResult>
 AudioDecoderMultiChannelOpusImpl::ParsePayload(rtc::Buffer&& payload,
                                                uint32_t timestamp) {
   std::vector<ParseResult> results;
+  rtc::CopyOnWriteBuffer shared_payload(std::move(payload));
 
-  if (PacketHasFec(payload.data(), payload.size())) {
+  if (PacketHasFec(shared_payload.cdata(), shared_payload.size())) {
     const int duration =
-        PacketDurationRedundant(payload.data(), payload.size());
+        PacketDurationRedundant(shared_payload.cdata(), shared_payload.size());
     RTC_DCHECK_GE(duration, 0);
-    rtc::Buffer payload_copy(payload.data(), payload.size());
     std::unique_ptr<EncodedAudioFrame> fec_frame(
-        new OpusFrame(this, std::move(payload_copy), false));
+        new OpusFrame(this, shared_payload, false));
     results.emplace_back(timestamp - duration, 1, std::move(fec_frame));
   }
   std::unique_ptr<EncodedAudioFrame> frame(
-      new OpusFrame(this, std::move(payload), true));
+      new OpusFrame(this, std::move(shared_payload), true));
   results.emplace_back(timestamp, 0, std::move(frame));
   return results;
 }
@@ -15,8 +15,10 @@
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
+#include "api/make_ref_counted.h"
 #include "modules/audio_coding/codecs/opus/audio_coder_opus_common.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
 
 namespace webrtc {
 
@@ -39,18 +41,19 @@ std::vector<AudioDecoder::ParseResult> AudioDecoderOpusImpl::ParsePayload(
     rtc::Buffer&& payload,
     uint32_t timestamp) {
   std::vector<ParseResult> results;
+  rtc::CopyOnWriteBuffer shared_payload(std::move(payload));
+  MaybeEnableDred(shared_payload);
 
-  if (PacketHasFec(payload.data(), payload.size())) {
+  if (PacketHasFec(shared_payload.cdata(), shared_payload.size())) {
     const int duration =
-        PacketDurationRedundant(payload.data(), payload.size());
+        PacketDurationRedundant(shared_payload.cdata(), shared_payload.size());
     RTC_DCHECK_GE(duration, 0);
-    rtc::Buffer payload_copy(payload.data(), payload.size());
     std::unique_ptr<EncodedAudioFrame> fec_frame(
-        new OpusFrame(this, std::move(payload_copy), false));
+        new OpusFrame(this, shared_payload, false));
     results.emplace_back(timestamp - duration, 1, std::move(fec_frame));
   }
   std::unique_ptr<EncodedAudioFrame> frame(
-      new OpusFrame(this, std::move(payload), true));
+      new OpusFrame(this, std::move(shared_payload), true));
   results.emplace_back(timestamp, 0, std::move(frame));
   return results;
 }
@@ -61,22 +64,47 @@ std::vector<AudioDecoder::ParseResult> AudioDecoderOpusImpl::ParsePayloadRedunda
     uint32_t recovery_timestamp_offset) {
   std::vector<ParseResult> results;
   uint32_t begin_timestamp = timestamp;
-  if (PacketHasFec(payload.data(), payload.size())) {
+  rtc::CopyOnWriteBuffer shared_payload(std::move(payload));
+  MaybeEnableDred(shared_payload);
+  if (PacketHasFec(shared_payload.cdata(), shared_payload.size())) {
     const int duration =
-        PacketDurationRedundant(payload.data(), payload.size());
+        PacketDurationRedundant(shared_payload.cdata(), shared_payload.size());
     RTC_DCHECK_GE(duration, 0);
-    // TODO(klingm@amazon.com) - eliminate this copy with a shared read-only buffer
-    rtc::Buffer payload_copy(payload.data(), payload.size());
     std::unique_ptr<EncodedAudioFrame> fec_frame(
-        new OpusFrame(this, std::move(payload_copy), false));
+        new OpusFrame(this, shared_payload, false));
     results.emplace_back(timestamp - duration, 1, std::move(fec_frame));
     begin_timestamp -= duration;
   }
+  AppendDredFrames(shared_payload, timestamp, begin_timestamp,
+                   recovery_timestamp_offset, &results);
+  std::unique_ptr<EncodedAudioFrame> frame(
+      new OpusFrame(this, std::move(shared_payload), true));
+  results.emplace_back(timestamp, 0, std::move(frame));
+  return results;
+}
+
+std::vector<AudioDecoder::ParseResult> AudioDecoderOpusImpl::ParseDred(
+    rtc::ArrayView<const uint8_t> payload,
+    uint32_t timestamp,
+    uint32_t begin_timestamp,
+    uint32_t recovery_timestamp_offset) {
+  std::vector<ParseResult> results;
+  AppendDredFrames(payload, timestamp, begin_timestamp,
+                   recovery_timestamp_offset, &results);
+  return results;
+}
+
+void AudioDecoderOpusImpl::AppendDredFrames(
+    rtc::ArrayView<const uint8_t> payload,
+    uint32_t timestamp,
+    uint32_t begin_timestamp,
+    uint32_t recovery_timestamp_offset,
+    std::vector<ParseResult>* results) {
   if (recovery_timestamp_offset > 0 ) {
     int32_t dred_end;
-    rtc::CopyOnWriteBuffer dred_data(opus_dred_get_size());
+    rtc::scoped_refptr<OpusDredBuffer> dred_data = GetDredBuffer();
     int samps = WebRtcOpus_DredParse(dec_state_,
-                         dred_data.MutableData(),
+                         dred_data->data(),
                          payload.data(),
                          payload.size(),
                          recovery_timestamp_offset,
@@ -101,16 +129,46 @@ std::vector<AudioDecoder::ParseResult> AudioDecoderOpusImpl::ParsePayloadRedunda
           std::unique_ptr<EncodedAudioFrame> frame(p);
           // Deep REDundancy packets have a priority of 2
           // (LBRR FEC with a priority of 1 will be preferred, if available)
-          results.emplace_back(recovery_timestamp, 2, std::move(frame));
+          results->emplace_back(recovery_timestamp, 2, std::move(frame));
           recovery_timestamp += sample_rate_hz_/100;
         }
       }
     }
   }
-  std::unique_ptr<EncodedAudioFrame> frame(
-      new OpusFrame(this, std::move(payload), true));
-  results.emplace_back(timestamp, 0, std::move(frame));
-  return results;
+}
+
+void AudioDecoderOpusImpl::MaybeEnableDred(
+    const rtc::CopyOnWriteBuffer& payload) {
+  if (dred_seen_ ||
+      !WebRtcOpus_PacketHasDred(payload.cdata(), payload.size())) {
+    return;
+  }
+  dred_seen_ = true;
+  if (WebRtcOpus_DecoderEnableDred(dec_state_) != 0) {
+    RTC_LOG(LS_WARNING) << "Failed to create the Opus DRED decoder.";
+  }
+}
+
+rtc::scoped_refptr<OpusDredBuffer> AudioDecoderOpusImpl::GetDredBuffer() {
+  rtc::scoped_refptr<OpusDredBuffer> dred_buffer;
+  for (const auto& pooled_buffer : dred_buffer_pool_) {
+    // Only the pool holds a reference once all frames using it are gone.
+    if (pooled_buffer->HasOneRef()) {
+      dred_buffer = pooled_buffer;
+      break;
+    }
+  }
+  if (!dred_buffer) {
+    dred_buffer = rtc::make_ref_counted<rtc::Buffer>(opus_dred_get_size());
+    if (dred_buffer_pool_.size() < kMaxDredBufferPoolSize) {
+      dred_buffer_pool_.push_back(dred_buffer);
+    }
+  }
+  // The buffer is about to hold the state of another payload.
+  if (dred_buffer->data() == dred_features_source_) {
+    dred_features_source_ = nullptr;
+  }
+  return dred_buffer;
 }
 
 void AudioDecoderOpusImpl::GeneratePlc(size_t requested_samples_per_channel,
@@ -170,7 +228,21 @@ int AudioDecoderOpusImpl::DecodeDredInternal(const uint8_t *encoded,
                                              uint32_t primary_timestamp,
                                              int16_t* decoded,
                                              int index) {
-  int ret = WebRtcOpus_DecodeDred(dec_state_, encoded, decoded, index);
+  // Frames recovered from the same payload share the same parsed DRED state,
+  // identified by its address and the timestamp of the primary payload.
+  if (encoded != dred_features_source_ ||
+      primary_timestamp != dred_features_timestamp_) {
+    dred_features_.SetSize(encoded_len);
+    if (WebRtcOpus_DredProcess(dec_state_, encoded, dred_features_.data()) !=
+        0) {
+      dred_features_source_ = nullptr;
+      return -1;
+    }
+    dred_features_source_ = encoded;
+    dred_features_timestamp_ = primary_timestamp;
+  }
+  int ret =
+      WebRtcOpus_DecodeDred(dec_state_, dred_features_.data(), decoded, index);
   if (ret > 0)
     ret *= static_cast<int>(channels_);  // Return total number of samples.
   return ret;
@@ -178,6 +250,7 @@ int AudioDecoderOpusImpl::DecodeDredInternal(const uint8_t *encoded,
 
 void AudioDecoderOpusImpl::Reset() {
   WebRtcOpus_DecoderInit(dec_state_);
+  dred_features_source_ = nullptr;
 }
 
 int AudioDecoderOpusImpl::PacketDuration(const uint8_t* encoded,
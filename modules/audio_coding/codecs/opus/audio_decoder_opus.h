@@ -17,6 +17,8 @@
 #include <vector>
 
 #include "api/audio_codecs/audio_decoder.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_coding/codecs/opus/audio_coder_opus_common.h"
 #include "modules/audio_coding/codecs/opus/opus_interface.h"
 #include "rtc_base/buffer.h"
 
@@ -36,6 +38,10 @@ class AudioDecoderOpusImpl final : public AudioDecoder {
   std::vector<ParseResult> ParsePayloadRedundancy(rtc::Buffer&& payload,
                                                   uint32_t timestamp,
                                                   uint32_t recovery_timestamp_offset) override;
+  std::vector<ParseResult> ParseDred(rtc::ArrayView<const uint8_t> payload,
+                                     uint32_t timestamp,
+                                     uint32_t begin_timestamp,
+                                     uint32_t recovery_timestamp_offset) override;
 
   void GeneratePlc(size_t requested_samples_per_channel,
                    rtc::BufferT<int16_t>* concealment_audio) override;
@@ -66,9 +72,36 @@ class AudioDecoderOpusImpl final : public AudioDecoder {
                          int16_t* decoded,
                          int index) override;
  private:
+  // Appends the DRED frames recovered from `payload` to `results`. Only
+  // frames preceding `begin_timestamp` are recovered.
+  void AppendDredFrames(rtc::ArrayView<const uint8_t> payload,
+                        uint32_t timestamp,
+                        uint32_t begin_timestamp,
+                        uint32_t recovery_timestamp_offset,
+                        std::vector<ParseResult>* results);
+
+  // Creates the DRED decoder when the first payload carrying DRED arrives.
+  void MaybeEnableDred(const rtc::CopyOnWriteBuffer& payload);
+
+  // Returns a buffer for the DRED state of a payload which is not referenced
+  // by any frame. Buffers are recycled, to avoid one large allocation per
+  // payload.
+  rtc::scoped_refptr<OpusDredBuffer> GetDredBuffer();
+
   OpusDecInst* dec_state_;
   const size_t channels_;
   const int sample_rate_hz_;
+  // Set once a payload carrying DRED has been seen, whether or not the DRED
+  // decoder could be created.
+  bool dred_seen_ = false;
+  // DRED latents are only entropy decoded when a payload is parsed. The
+  // feature decode is run on first use and cached here, so that all the
+  // 10 ms frames recovered from one payload share a single feature decode.
+  rtc::Buffer dred_features_;
+  const uint8_t* dred_features_source_ = nullptr;
+  uint32_t dred_features_timestamp_ = 0;
+  static constexpr size_t kMaxDredBufferPoolSize = 8;
+  std::vector<rtc::scoped_refptr<OpusDredBuffer>> dred_buffer_pool_;
 };
 
 }  // namespace webrtc
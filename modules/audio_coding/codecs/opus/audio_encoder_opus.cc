@@ -69,6 +69,9 @@ constexpr int kOpusSupportedFrameLengths[] = {10, 20, 40, 60};
 constexpr float kAlphaForPacketLossFractionSmoother = 0.9999f;
 constexpr float kMaxPacketLossFraction = 0.2f;
 
+// DRED is configured in 10 ms frames, up to one second.
+constexpr int kMaxDredFrames = 100;
+
 int CalculateDefaultBitrate(int max_playback_rate, size_t num_channels) {
   const int bitrate = [&] {
     if (max_playback_rate <= 8000) {
@@ -652,9 +655,13 @@ size_t AudioEncoderOpusImpl::SufficientOutputBufferSize() const {
   const size_t approx_encoded_bytes =
       Num10msFramesPerPacket() * 10 * bytes_per_millisecond;
 #if WEBRTC_OPUS_SUPPORT_DRED
-  // reserve 160 additional extra bytes for DRED
-  // assumes a maximum of 64 Kbps of DRED with 20 msec. packets
-  const size_t dred_bytes_per_packet = 160;
+  // Reserve room for up to 64 kbps of DRED on top of the primary encoding,
+  // but only while the encoder is producing DRED.
+  constexpr size_t kMaxDredBitrateBps = 64000;
+  const size_t dred_bytes_per_packet =
+      config_.dred > 0 ? Num10msFramesPerPacket() * 10 * kMaxDredBitrateBps /
+                             (1000 * 8)
+                       : 0;
 #else
   const size_t dred_bytes_per_packet = 0;
 #endif
@@ -747,6 +754,17 @@ void AudioEncoderOpusImpl::SetNumChannelsToEncode(
   num_channels_to_encode_ = num_channels_to_encode;
 }
 
+void AudioEncoderOpusImpl::SetDredDuration(int dred_duration_ms) {
+  const int dred = rtc::SafeClamp(dred_duration_ms / 10, 0, kMaxDredFrames);
+  if (config_.dred == dred)
+    return;
+
+  RTC_CHECK_EQ(0, WebRtcOpus_SetDredDuration(inst_, dred));
+  RTC_LOG(LS_VERBOSE) << "Update Opus DRED from " << config_.dred << " to "
+                      << dred << " 10 msec. frames";
+  config_.dred = dred;
+}
+
 void AudioEncoderOpusImpl::SetProjectedPacketLossRate(float fraction) {
   fraction = std::min(std::max(fraction, 0.0f), kMaxPacketLossFraction);
   if (packet_loss_rate_ != fraction) {
@@ -790,6 +808,8 @@ void AudioEncoderOpusImpl::ApplyAudioNetworkAdaptor() {
     SetDtx(*config.enable_dtx);
   if (config.num_channels)
     SetNumChannelsToEncode(*config.num_channels);
+  if (config.dred_duration_ms)
+    SetDredDuration(*config.dred_duration_ms);
 }
 
 std::unique_ptr<AudioNetworkAdaptor>
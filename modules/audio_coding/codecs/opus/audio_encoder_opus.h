@@ -134,6 +134,7 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   bool RecreateEncoderInstance(const AudioEncoderOpusConfig& config);
   void SetFrameLength(int frame_length_ms);
   void SetNumChannelsToEncode(size_t num_channels_to_encode);
+  void SetDredDuration(int dred_duration_ms);
   void SetProjectedPacketLossRate(float fraction);
 
   void OnReceivedUplinkBandwidth(
@@ -0,0 +1,311 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Micro benchmarks for the Opus wrapper, timing the redundancy and
+// concealment paths separately from plain encoding and decoding: LBRR (inband
+// FEC) encoding and decoding, PLC synthesis at each decoder complexity and,
+// when built with rtc_opus_support_dred, DRED encoding, parsing, latent
+// processing and decoding at each offset.
+//
+// Run through the `benchmarks` target. Pass --benchmark_format=json or
+// --benchmark_out=<file> --benchmark_out_format=json to get machine readable
+// results that can be compared between builds, e.g. with and without
+// rtc_opus_use_codec_plc.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/audio_coding/codecs/opus/opus_interface.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/unused.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kChannels = 1;
+constexpr int kFrameSizeMs = 20;
+constexpr int kFrameSamples = kSampleRateHz / 1000 * kFrameSizeMs;
+constexpr int kBitrateBps = 32000;
+constexpr int kPacketLossPercent = 20;
+constexpr size_t kMaxPayloadBytes = 1500;
+// Enough decoded output for the largest (120 ms) Opus frame.
+constexpr int kMaxDecodedSamples = kSampleRateHz / 1000 * 120;
+#if WEBRTC_OPUS_SUPPORT_DRED
+// One second of redundancy, in 10 ms DRED frames.
+constexpr int kMaxDredFrames = 100;
+#endif
+
+// Returns the speech resource used by the codec speed tests, read once.
+const std::vector<int16_t>& Speech() {
+  static const std::vector<int16_t>* const speech = [] {
+    auto* samples = new std::vector<int16_t>();
+    const std::string file_name =
+        test::ResourcePath("audio_coding/speech_mono_32_48kHz", "pcm");
+    FILE* file = fopen(file_name.c_str(), "rb");
+    RTC_CHECK(file) << "Could not open " << file_name;
+    int16_t buffer[kFrameSamples];
+    size_t read;
+    while ((read = fread(buffer, sizeof(int16_t), kFrameSamples, file)) ==
+           kFrameSamples) {
+      samples->insert(samples->end(), buffer, buffer + read);
+    }
+    fclose(file);
+    RTC_CHECK_GE(samples->size(), kFrameSamples);
+    return samples;
+  }();
+  return *speech;
+}
+
+int NumFrames() {
+  return static_cast<int>(Speech().size() / kFrameSamples);
+}
+
+const int16_t* Frame(int index) {
+  return &Speech()[(index % NumFrames()) * kFrameSamples];
+}
+
+WebRtcOpusEncInst* CreateEncoder(bool fec, int dred_frames) {
+  WebRtcOpusEncInst* encoder = nullptr;
+  RTC_CHECK_EQ(0, WebRtcOpus_EncoderCreate(&encoder, kChannels,
+                                           /*application=*/0, kSampleRateHz));
+  RTC_CHECK_EQ(0, WebRtcOpus_SetBitRate(encoder, kBitrateBps));
+  RTC_CHECK_EQ(0, WebRtcOpus_SetPacketLossRate(encoder, kPacketLossPercent));
+  RTC_CHECK_EQ(0, fec ? WebRtcOpus_EnableFec(encoder)
+                      : WebRtcOpus_DisableFec(encoder));
+  if (dred_frames > 0) {
+    RTC_CHECK_EQ(0, WebRtcOpus_SetDredDuration(encoder, dred_frames));
+  }
+  return encoder;
+}
+
+WebRtcOpusDecInst* CreateDecoder() {
+  WebRtcOpusDecInst* decoder = nullptr;
+  RTC_CHECK_EQ(0, WebRtcOpus_DecoderCreate(&decoder, kChannels, kSampleRateHz));
+  // The DRED benchmarks parse DRED from the first packet on. Without DRED
+  // support this fails, and the DRED benchmarks are not built.
+  WebRtcOpus_DecoderEnableDred(decoder);
+  return decoder;
+}
+
+// Encodes the speech resource once per configuration, so that the decoder
+// benchmarks do not pay for encoding.
+std::vector<std::vector<uint8_t>> EncodeSpeech(bool fec, int dred_frames) {
+  WebRtcOpusEncInst* encoder = CreateEncoder(fec, dred_frames);
+  std::vector<std::vector<uint8_t>> packets(NumFrames());
+  for (int i = 0; i < NumFrames(); ++i) {
+    packets[i].resize(kMaxPayloadBytes);
+    const int bytes = WebRtcOpus_Encode(encoder, Frame(i), kFrameSamples,
+                                        kMaxPayloadBytes, packets[i].data());
+    RTC_CHECK_GT(bytes, 0);
+    packets[i].resize(bytes);
+  }
+  WebRtcOpus_EncoderFree(encoder);
+  return packets;
+}
+
+// Encodes one 20 ms frame per iteration. Arguments are whether LBRR is enabled
+// and the DRED duration in 10 ms frames.
+void BM_OpusEncode(benchmark::State& state) {
+  WebRtcOpusEncInst* encoder = CreateEncoder(state.range(0) != 0,
+                                             static_cast<int>(state.range(1)));
+  uint8_t payload[kMaxPayloadBytes];
+  int frame = 0;
+  int64_t total_bytes = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    const int bytes = WebRtcOpus_Encode(encoder, Frame(frame++), kFrameSamples,
+                                        kMaxPayloadBytes, payload);
+    benchmark::DoNotOptimize(bytes);
+    total_bytes += bytes;
+  }
+  // The bitrate shows what the redundancy costs on the wire.
+  state.counters["bitrate_bps"] =
+      frame > 0 ? 8.0 * total_bytes * 1000 / (frame * kFrameSizeMs) : 0;
+  WebRtcOpus_EncoderFree(encoder);
+}
+BENCHMARK(BM_OpusEncode)
+    ->ArgNames({"fec", "dred_frames"})
+    ->Args({0, 0})
+    ->Args({1, 0})
+#if WEBRTC_OPUS_SUPPORT_DRED
+    ->Args({0, 10})
+    ->Args({0, 50})
+    ->Args({0, kMaxDredFrames})
+#endif
+    ;
+
+// Decodes one received packet per iteration.
+void BM_OpusDecode(benchmark::State& state) {
+  static const auto* const packets =
+      new std::vector<std::vector<uint8_t>>(EncodeSpeech(false, 0));
+  WebRtcOpusDecInst* decoder = CreateDecoder();
+  int16_t decoded[kMaxDecodedSamples];
+  int16_t audio_type;
+  size_t index = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    const std::vector<uint8_t>& packet = (*packets)[index++ % packets->size()];
+    benchmark::DoNotOptimize(WebRtcOpus_Decode(
+        decoder, packet.data(), packet.size(), decoded, &audio_type));
+  }
+  WebRtcOpus_DecoderFree(decoder);
+}
+BENCHMARK(BM_OpusDecode);
+
+// Recovers the previous frame from the LBRR data of one packet per iteration.
+void BM_OpusDecodeLbrr(benchmark::State& state) {
+  static const auto* const packets =
+      new std::vector<std::vector<uint8_t>>(EncodeSpeech(true, 0));
+  WebRtcOpusDecInst* decoder = CreateDecoder();
+  int16_t decoded[kMaxDecodedSamples];
+  int16_t audio_type;
+  size_t index = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    const std::vector<uint8_t>& packet = (*packets)[index++ % packets->size()];
+    benchmark::DoNotOptimize(WebRtcOpus_DecodeFec(
+        decoder, packet.data(), packet.size(), decoded, &audio_type));
+  }
+  WebRtcOpus_DecoderFree(decoder);
+}
+BENCHMARK(BM_OpusDecodeLbrr);
+
+// Conceals one lost 20 ms frame per iteration, after a received packet so that
+// the concealment always starts from a fresh decoder history. The argument is
+// the decoder complexity; complexity 5 and up selects the neural PLC when the
+// library is built with it.
+void BM_OpusPlc(benchmark::State& state) {
+  static const auto* const packets =
+      new std::vector<std::vector<uint8_t>>(EncodeSpeech(false, 0));
+  WebRtcOpusDecInst* decoder = CreateDecoder();
+  RTC_CHECK_EQ(OPUS_OK,
+               opus_decoder_ctl(decoder->decoder,
+                                OPUS_SET_COMPLEXITY(state.range(0))));
+  int16_t decoded[kMaxDecodedSamples];
+  int16_t audio_type;
+  size_t index = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    state.PauseTiming();
+    const std::vector<uint8_t>& packet = (*packets)[index++ % packets->size()];
+    WebRtcOpus_Decode(decoder, packet.data(), packet.size(), decoded,
+                      &audio_type);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(
+        WebRtcOpus_Decode(decoder, nullptr, 0, decoded, &audio_type));
+  }
+  WebRtcOpus_DecoderFree(decoder);
+}
+BENCHMARK(BM_OpusPlc)->ArgName("complexity")->DenseRange(0, 10);
+
+#if WEBRTC_OPUS_SUPPORT_DRED
+// Packets carrying a full second of DRED.
+const std::vector<std::vector<uint8_t>>& DredPackets() {
+  static const auto* const packets = new std::vector<std::vector<uint8_t>>(
+      EncodeSpeech(false, kMaxDredFrames));
+  return *packets;
+}
+
+// Entropy decodes the DRED latents of one packet per iteration, i.e. what
+// NetEq pays for every received packet.
+void BM_OpusDredParse(benchmark::State& state) {
+  const std::vector<std::vector<uint8_t>>& packets = DredPackets();
+  WebRtcOpusDecInst* decoder = CreateDecoder();
+  std::vector<uint8_t> dred(opus_dred_get_size());
+  int32_t dred_end;
+  size_t index = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    const std::vector<uint8_t>& packet = packets[index++ % packets.size()];
+    benchmark::DoNotOptimize(WebRtcOpus_DredParse(
+        decoder, dred.data(), packet.data(), packet.size(),
+        kMaxDredFrames * kSampleRateHz / 100, &dred_end));
+  }
+  WebRtcOpus_DecoderFree(decoder);
+}
+BENCHMARK(BM_OpusDredParse);
+
+// Runs the RDOVAE latent decoder on one parsed packet per iteration, i.e. what
+// is paid once per loss event that is recovered from DRED.
+void BM_OpusDredProcess(benchmark::State& state) {
+  const std::vector<std::vector<uint8_t>>& packets = DredPackets();
+  WebRtcOpusDecInst* decoder = CreateDecoder();
+  std::vector<uint8_t> parsed(opus_dred_get_size());
+  std::vector<uint8_t> processed(opus_dred_get_size());
+  int32_t dred_end;
+  size_t index = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    state.PauseTiming();
+    const std::vector<uint8_t>& packet = packets[index++ % packets.size()];
+    WebRtcOpus_DredParse(decoder, parsed.data(), packet.data(), packet.size(),
+                         kMaxDredFrames * kSampleRateHz / 100, &dred_end);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(
+        WebRtcOpus_DredProcess(decoder, parsed.data(), processed.data()));
+  }
+  WebRtcOpus_DecoderFree(decoder);
+}
+BENCHMARK(BM_OpusDredProcess);
+
+// Synthesizes one 10 ms DRED frame per iteration. The argument is the offset
+// into the redundancy, in 10 ms frames; the FARGAN synthesis has to catch up
+// on the features before the requested offset, so deeper offsets cost more.
+void BM_OpusDredDecode(benchmark::State& state) {
+  const std::vector<std::vector<uint8_t>>& packets = DredPackets();
+  const int offset = static_cast<int>(state.range(0));
+  WebRtcOpusDecInst* decoder = CreateDecoder();
+  std::vector<uint8_t> dred(opus_dred_get_size());
+  int16_t decoded[kMaxDecodedSamples];
+  int16_t audio_type;
+  int32_t dred_end;
+  // Skip the first second, where the encoder has not built up a full second
+  // of history yet.
+  size_t index = kMaxDredFrames * 10 / kFrameSizeMs;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    state.PauseTiming();
+    const std::vector<uint8_t>& packet = packets[index++ % packets.size()];
+    WebRtcOpus_Decode(decoder, packet.data(), packet.size(), decoded,
+                      &audio_type);
+    const int available =
+        WebRtcOpus_DredParse(decoder, dred.data(), packet.data(),
+                             packet.size(),
+                             kMaxDredFrames * kSampleRateHz / 100, &dred_end);
+    WebRtcOpus_DredProcess(decoder, dred.data(), dred.data());
+    state.ResumeTiming();
+    if (available < (offset + 1) * kSampleRateHz / 100) {
+      state.SkipWithError("Not enough DRED in packet for the offset.");
+      break;
+    }
+    benchmark::DoNotOptimize(
+        WebRtcOpus_DecodeDred(decoder, dred.data(), decoded, offset));
+  }
+  WebRtcOpus_DecoderFree(decoder);
+}
+BENCHMARK(BM_OpusDredDecode)
+    ->ArgName("offset")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(5)
+    ->Arg(10)
+    ->Arg(25)
+    ->Arg(50)
+    ->Arg(kMaxDredFrames - 1);
+#endif  // WEBRTC_OPUS_SUPPORT_DRED
+
+}  // namespace
+}  // namespace webrtc
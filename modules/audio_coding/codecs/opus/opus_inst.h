@@ -34,6 +34,8 @@ struct WebRtcOpusDecInst {
   OpusDecoder* decoder;
   OpusMSDecoder* multistream_decoder;
   OpusDREDDecoder *dred_decoder;
+  // Set when creating `dred_decoder` failed, so that it is not retried.
+  bool dred_decoder_failed;
   int prev_decoded_samples;
   bool plc_use_prev_decoded_samples;
   size_t channels;
@@ -12,9 +12,12 @@
 
 #include <cstdlib>
 #include <numeric>
+#include <vector>
 
 #include "api/array_view.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 #include "system_wrappers/include/field_trial.h"
 
 enum {
@@ -486,6 +489,101 @@ int32_t WebRtcOpus_GetInDtx(OpusEncInst* inst) {
   return -1;
 }
 
+namespace {
+
+// Process-wide pool of single stream decoder instances. A pooled instance
+// keeps its Opus decoder allocation, and its DRED decoder if one was created,
+// so handing it to a new stream only requires a state reset.
+class DecoderPool {
+ public:
+  static DecoderPool& Get() {
+    static DecoderPool* const pool = new DecoderPool();
+    return *pool;
+  }
+
+  void SetCapacity(size_t capacity) {
+    std::vector<OpusDecInst*> evicted;
+    {
+      webrtc::MutexLock lock(&mutex_);
+      capacity_ = capacity;
+      while (instances_.size() > capacity_) {
+        evicted.push_back(instances_.back());
+        instances_.pop_back();
+      }
+    }
+    for (OpusDecInst* inst : evicted) {
+      DestroyDecoderInst(inst);
+    }
+  }
+
+  // Returns a pooled instance created for `channels` and `sample_rate_hz`, or
+  // null if there is none.
+  OpusDecInst* Take(size_t channels, int sample_rate_hz) {
+    webrtc::MutexLock lock(&mutex_);
+    for (auto it = instances_.begin(); it != instances_.end(); ++it) {
+      if ((*it)->channels == channels &&
+          (*it)->sample_rate_hz == sample_rate_hz) {
+        OpusDecInst* inst = *it;
+        instances_.erase(it);
+        return inst;
+      }
+    }
+    return nullptr;
+  }
+
+  // Takes ownership of `inst` and returns true, unless the pool is full.
+  bool Put(OpusDecInst* inst) {
+    webrtc::MutexLock lock(&mutex_);
+    if (instances_.size() >= capacity_) {
+      return false;
+    }
+    instances_.push_back(inst);
+    return true;
+  }
+
+  static void DestroyDecoderInst(OpusDecInst* inst) {
+    if (inst->decoder) {
+      opus_decoder_destroy(inst->decoder);
+    } else if (inst->multistream_decoder) {
+      opus_multistream_decoder_destroy(inst->multistream_decoder);
+    }
+    if (inst->dred_decoder) {
+      opus_dred_decoder_destroy(inst->dred_decoder);
+    }
+    free(inst);
+  }
+
+ private:
+  webrtc::Mutex mutex_;
+  size_t capacity_ RTC_GUARDED_BY(mutex_) = 0;
+  std::vector<OpusDecInst*> instances_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace
+
+// Sets up the non-Opus state of a single stream decoder instance.
+static void InitDecoderInst(OpusDecInst* state,
+                            size_t channels,
+                            int sample_rate_hz) {
+  state->channels = channels;
+  state->sample_rate_hz = sample_rate_hz;
+  state->plc_use_prev_decoded_samples =
+      webrtc::field_trial::IsEnabled(kPlcUsePrevDecodedSamplesFieldTrial);
+  if (state->plc_use_prev_decoded_samples) {
+    state->prev_decoded_samples =
+        DefaultFrameSizePerChannel(state->sample_rate_hz);
+  }
+  state->in_dtx_mode = 0;
+  state->dred_decoder_failed = false;
+#if WEBRTC_OPUS_USE_CODEC_PLC && WEBRTC_OPUS_SUPPORT_DRED
+  opus_decoder_ctl(state->decoder, OPUS_SET_COMPLEXITY(5));
+#endif
+}
+
+void WebRtcOpus_SetDecoderPoolCapacity(size_t capacity) {
+  DecoderPool::Get().SetCapacity(capacity);
+}
+
 int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst,
                                  size_t channels,
                                  int sample_rate_hz) {
@@ -493,6 +591,18 @@ int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst,
   OpusDecInst* state;
 
   if (inst != NULL) {
+    state = DecoderPool::Get().Take(channels, sample_rate_hz);
+    if (state) {
+      // Reuse a pooled instance; only its state needs to be reset.
+      if (opus_decoder_init(state->decoder, sample_rate_hz,
+                            static_cast<int>(channels)) == OPUS_OK) {
+        InitDecoderInst(state, channels, sample_rate_hz);
+        *inst = state;
+        return 0;
+      }
+      DecoderPool::DestroyDecoderInst(state);
+    }
+
     // Create Opus decoder state.
     state = reinterpret_cast<OpusDecInst*>(calloc(1, sizeof(OpusDecInst)));
     if (state == NULL) {
@@ -502,33 +612,16 @@ int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst,
     state->decoder =
         opus_decoder_create(sample_rate_hz, static_cast<int>(channels), &error);
     if (error == OPUS_OK && state->decoder) {
-      // Creation of memory all ok.
-      state->channels = channels;
-      state->sample_rate_hz = sample_rate_hz;
-      state->plc_use_prev_decoded_samples =
-          webrtc::field_trial::IsEnabled(kPlcUsePrevDecodedSamplesFieldTrial);
-      if (state->plc_use_prev_decoded_samples) {
-        state->prev_decoded_samples =
-            DefaultFrameSizePerChannel(state->sample_rate_hz);
-      }
-      state->in_dtx_mode = 0;
-#if WEBRTC_OPUS_USE_CODEC_PLC && WEBRTC_OPUS_SUPPORT_DRED
-      opus_decoder_ctl(state->decoder, OPUS_SET_COMPLEXITY(5));
-#endif
+      // Creation of memory all ok. The DRED decoder, which holds the DNN
+      // model, is only created by WebRtcOpus_DecoderEnableDred().
+      InitDecoderInst(state, channels, sample_rate_hz);
       *inst = state;
-      // TODO(klingm@amazon.com): creating the DRED decoder should be made optional
-      state->dred_decoder =
-          opus_dred_decoder_create(&error);
-      if (error == OPUS_OK && state->dred_decoder)
-        return 0;
+      return 0;
     }
     // If memory allocation was unsuccessful, free the entire state.
     if (state->decoder) {
       opus_decoder_destroy(state->decoder);
     }
-    if (state->dred_decoder) {
-      opus_dred_decoder_destroy(state->dred_decoder);
-    }
     free(state);
   }
   return -1;
@@ -578,15 +671,10 @@ int16_t WebRtcOpus_MultistreamDecoderCreate(
 
 int16_t WebRtcOpus_DecoderFree(OpusDecInst* inst) {
   if (inst) {
-    if (inst->decoder) {
-      opus_decoder_destroy(inst->decoder);
-    } else if (inst->multistream_decoder) {
-      opus_multistream_decoder_destroy(inst->multistream_decoder);
-    }
-    if (inst->dred_decoder) {
-      opus_dred_decoder_destroy(inst->dred_decoder);
+    if (inst->decoder && DecoderPool::Get().Put(inst)) {
+      return 0;
     }
-    free(inst);
+    DecoderPool::DestroyDecoderInst(inst);
     return 0;
   } else {
     return -1;
@@ -747,17 +835,46 @@ int WebRtcOpus_DecodeDred(OpusDecInst* inst,
       offset * dred_samples, decoded, dred_samples);
 }
 
+int16_t WebRtcOpus_DecoderEnableDred(OpusDecInst* inst) {
+  if (inst->dred_decoder)
+    return 0;
+  if (!inst->decoder || inst->dred_decoder_failed)
+    return -1;
+  int error;
+  inst->dred_decoder = opus_dred_decoder_create(&error);
+  if (error != OPUS_OK || !inst->dred_decoder) {
+    // Remember the failure, so that it is not retried for every packet.
+    inst->dred_decoder = NULL;
+    inst->dred_decoder_failed = true;
+    return -1;
+  }
+  return 0;
+}
+
 int WebRtcOpus_DredParse(OpusDecInst *inst,
                          uint8_t *dred_data,
                          const uint8_t* encoded,
                          size_t length_bytes,
                          int max_samples,
                          int32_t *dred_end) {
-  if (!inst->dred_decoder)
+  // Streams without DRED never pay for the DRED decoder and its model.
+  if (!inst->decoder || !inst->dred_decoder)
     return 0;
-  // NOTE: processing *not* deferred, RDOVAE data will be decoded
+  // Processing is deferred, the RDOVAE data is decoded by
+  // WebRtcOpus_DredProcess() once the DRED data is known to be needed.
   return opus_dred_parse(inst->dred_decoder, reinterpret_cast<OpusDRED *>(dred_data),
-      encoded, static_cast<opus_int32>(length_bytes), max_samples, inst->sample_rate_hz, dred_end, 0);
+      encoded, static_cast<opus_int32>(length_bytes), max_samples, inst->sample_rate_hz, dred_end, 1);
+}
+
+int WebRtcOpus_DredProcess(OpusDecInst *inst,
+                           const uint8_t *src,
+                           uint8_t *dst) {
+  if (!inst->dred_decoder)
+    return -1;
+  int ret = opus_dred_process(inst->dred_decoder,
+                              reinterpret_cast<const OpusDRED *>(src),
+                              reinterpret_cast<OpusDRED *>(dst));
+  return ret == OPUS_OK ? 0 : -1;
 }
 
 int WebRtcOpus_DurationEst(OpusDecInst* inst,
@@ -893,6 +1010,67 @@ int WebRtcOpus_PacketHasFec(const uint8_t* payload,
   return 0;
 }
 
+// This method is based on Definition of the Opus Audio Codec
+// (https://tools.ietf.org/html/rfc6716) and the Opus extension mechanism
+// (draft-ietf-mlcodec-opus-extension). Extensions, including DRED, are
+// carried in the padding of code 3 packets.
+int WebRtcOpus_PacketHasDred(const uint8_t* payload,
+                             size_t payload_length_bytes) {
+  // Extension ID used by libopus for DRED.
+  constexpr int kDredExtensionId = 126;
+
+  if (payload == NULL || payload_length_bytes < 2)
+    return 0;
+  // Only code 3 packets with the padding flag set carry extensions.
+  if ((payload[0] & 0x03) != 3 || (payload[1] & 0x40) == 0)
+    return 0;
+
+  size_t pos = 2;
+  size_t padding_length = 0;
+  uint8_t length_byte;
+  do {
+    if (pos >= payload_length_bytes)
+      return 0;
+    length_byte = payload[pos++];
+    padding_length += length_byte == 255 ? 254 : length_byte;
+  } while (length_byte == 255);
+  if (padding_length > payload_length_bytes - pos)
+    return 0;
+
+  // The padding is at the end of the packet.
+  const uint8_t* data = payload + payload_length_bytes - padding_length;
+  const uint8_t* const end = payload + payload_length_bytes;
+  while (data < end) {
+    const int id = *data >> 1;
+    const int long_flag = *data & 1;
+    if (id == kDredExtensionId)
+      return 1;
+    if (id == 0) {
+      // Extensions are written before any plain padding.
+      return 0;
+    }
+    if (id < 32) {
+      // Frame separators and short extensions have at most one byte of data.
+      data += 1 + long_flag;
+    } else if (long_flag == 0) {
+      // A long extension without length runs to the end of the padding.
+      return 0;
+    } else {
+      size_t extension_length = 0;
+      do {
+        if (++data >= end)
+          return 0;
+        extension_length += *data;
+      } while (*data == 255);
+      ++data;
+      if (extension_length > static_cast<size_t>(end - data))
+        return 0;
+      data += extension_length;
+    }
+  }
+  return 0;
+}
+
 int WebRtcOpus_PacketHasVoiceActivity(const uint8_t* payload,
                                       size_t payload_length_bytes) {
   if (payload == NULL || payload_length_bytes == 0)
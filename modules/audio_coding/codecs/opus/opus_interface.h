@@ -377,10 +377,42 @@ int32_t WebRtcOpus_GetInDtx(OpusEncInst* inst);
  */
 int16_t WebRtcOpus_SetForceChannels(OpusEncInst* inst, size_t num_channels);
 
+/****************************************************************************
+ * WebRtcOpus_DecoderCreate(...)
+ *
+ * This function creates a single stream Opus decoder. If the decoder pool
+ * holds an instance with the same configuration, that instance is reset and
+ * reused instead of allocating a new one. The DRED decoder is only created
+ * by WebRtcOpus_DecoderEnableDred().
+ *
+ * Input:
+ *      - channels           : number of output channels, 1 or 2.
+ *      - sample_rate_hz     : output sample rate.
+ *
+ * Output:
+ *      - inst               : a pointer to a Decoder context that is created
+ *                             if success.
+ *
+ * Return value              : 0 - Success
+ *                            -1 - Error
+ */
 int16_t WebRtcOpus_DecoderCreate(OpusDecInst** inst,
                                  size_t channels,
                                  int sample_rate_hz);
 
+/****************************************************************************
+ * WebRtcOpus_SetDecoderPoolCapacity(...)
+ *
+ * This function sets how many freed single stream decoder instances are kept
+ * in a process-wide pool for reuse by WebRtcOpus_DecoderCreate(). The default
+ * capacity is 0, which disables pooling. Lowering the capacity frees the
+ * excess pooled instances.
+ *
+ * Input:
+ *      - capacity           : maximum number of pooled instances.
+ */
+void WebRtcOpus_SetDecoderPoolCapacity(size_t capacity);
+
 /****************************************************************************
  * WebRtcOpus_MultistreamDecoderCreate(...)
  *
@@ -483,10 +515,12 @@ int WebRtcOpus_DecodeFec(OpusDecInst* inst,
  * WebRtcOpus_DecodeDred(...)
  *
  * This function decodes the DRED information cached in the decoder
- * into a 10 msec. slice of audio
+ * into a 10 msec. slice of audio. `dred_data` must have been processed with
+ * WebRtcOpus_DredProcess().
  *
  * Input:
  *      - inst               : Decoder context
+ *      - dred_data          : Processed DRED state
  *      - offset             : Which DRED segment to decode, in units of 10 msec.
  *
  * Output:
@@ -500,6 +534,47 @@ int WebRtcOpus_DecodeDred(OpusDecInst* inst,
                           int16_t *decoded,
                           int offset);
 
+/****************************************************************************
+ * WebRtcOpus_DecoderEnableDred(...)
+ *
+ * This function creates the DRED decoder of a single stream decoder, which is
+ * needed to parse DRED data. It is meant to be called when the first packet
+ * carrying DRED arrives, so that streams without DRED never load the DRED
+ * model. If the creation fails, later calls fail without retrying.
+ *
+ * Input:
+ *      - inst               : Decoder context
+ *
+ * Return value              :  0 - Success, DRED data can be parsed
+ *                             -1 - Error
+ */
+int16_t WebRtcOpus_DecoderEnableDred(OpusDecInst* inst);
+
+/****************************************************************************
+ * WebRtcOpus_DredParse(...)
+ *
+ * This function extracts the DRED latents from an Opus packet. Only the
+ * entropy decoding is done here; the latents are turned into features by
+ * WebRtcOpus_DredProcess(), which only needs to be called once the DRED data
+ * is actually used to conceal a loss.
+ *
+ * Input:
+ *      - inst               : Decoder context
+ *      - encoded            : Encoded data
+ *      - length_bytes       : Bytes in encoded vector
+ *      - max_samples        : Maximum number of samples to recover
+ *
+ * Output:
+ *      - dred_data          : DRED state, opus_dred_get_size() bytes
+ *      - dred_end           : Number of non-encoded (silence) samples
+ *                             between the DRED timestamp and the last DRED
+ *                             sample
+ *
+ * Return value              : >0 - Samples of redundancy available
+ *                              0 - No DRED data in the packet, or DRED is
+ *                                  not enabled on the decoder
+ *                             <0 - Error
+ */
 int WebRtcOpus_DredParse(OpusDecInst *inst,
                          uint8_t *dred_data,
                          const uint8_t* encoded,
@@ -507,6 +582,29 @@ int WebRtcOpus_DredParse(OpusDecInst *inst,
                          int max_samples,
                          int32_t *dred_end);
 
+/****************************************************************************
+ * WebRtcOpus_DredProcess(...)
+ *
+ * This function runs the DRED latent decoder on state produced by
+ * WebRtcOpus_DredParse(), so that it can be passed to
+ * WebRtcOpus_DecodeDred(). `src` and `dst` may point to the same state, in
+ * which case the processing is done in place. Processing already processed
+ * state is a no-op.
+ *
+ * Input:
+ *      - inst               : Decoder context
+ *      - src                : Parsed DRED state
+ *
+ * Output:
+ *      - dst                : Processed DRED state
+ *
+ * Return value              :  0 - Success
+ *                             -1 - Error
+ */
+int WebRtcOpus_DredProcess(OpusDecInst *inst,
+                           const uint8_t *src,
+                           uint8_t *dst);
+
 /****************************************************************************
  * WebRtcOpus_DurationEst(...)
  *
@@ -573,6 +671,20 @@ int WebRtcOpus_FecDurationEst(const uint8_t* payload,
 int WebRtcOpus_PacketHasFec(const uint8_t* payload,
                             size_t payload_length_bytes);
 
+/****************************************************************************
+ * WebRtcOpus_PacketHasDred(...)
+ *
+ * This function detects if an opus packet carries Deep Redundancy (DRED).
+ * Input:
+ *        - payload              : Encoded data pointer
+ *        - payload_length_bytes : Bytes of encoded data
+ *
+ * Return value                  : 0 - the packet does NOT contain DRED.
+ *                                 1 - the packet contains DRED.
+ */
+int WebRtcOpus_PacketHasDred(const uint8_t* payload,
+                             size_t payload_length_bytes);
+
 /****************************************************************************
  * WebRtcOpus_PacketHasVoiceActivity(...)
  *
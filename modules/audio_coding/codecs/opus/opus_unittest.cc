@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/audio_coding/codecs/opus/opus_inst.h"
 #include "modules/audio_coding/codecs/opus/opus_interface.h"
@@ -490,6 +491,35 @@ TEST(OpusTest, OpusFreeFail) {
   EXPECT_EQ(-1, WebRtcOpus_DecoderFree(NULL));
 }
 
+// Test that freed decoders are reused through the decoder pool.
+TEST(OpusTest, OpusDecoderPool) {
+  WebRtcOpus_SetDecoderPoolCapacity(1);
+
+  WebRtcOpusDecInst* opus_decoder;
+  ASSERT_EQ(0, WebRtcOpus_DecoderCreate(&opus_decoder, 1, 48000));
+  WebRtcOpusDecInst* const first_decoder = opus_decoder;
+  EXPECT_EQ(0, WebRtcOpus_DecoderFree(opus_decoder));
+
+  // A decoder with a different configuration does not use the pooled one.
+  ASSERT_EQ(0, WebRtcOpus_DecoderCreate(&opus_decoder, 2, 48000));
+  EXPECT_NE(first_decoder, opus_decoder);
+  EXPECT_EQ(2u, WebRtcOpus_DecoderChannels(opus_decoder));
+  WebRtcOpusDecInst* const stereo_decoder = opus_decoder;
+
+  // The pooled instance is reused, and is reset.
+  ASSERT_EQ(0, WebRtcOpus_DecoderCreate(&opus_decoder, 1, 48000));
+  EXPECT_EQ(first_decoder, opus_decoder);
+  EXPECT_EQ(1u, WebRtcOpus_DecoderChannels(opus_decoder));
+  EXPECT_EQ(0, opus_decoder->in_dtx_mode);
+
+  // The pool is full, so only one of the decoders is kept.
+  EXPECT_EQ(0, WebRtcOpus_DecoderFree(opus_decoder));
+  EXPECT_EQ(0, WebRtcOpus_DecoderFree(stereo_decoder));
+
+  // Disabling the pool frees the pooled instance.
+  WebRtcOpus_SetDecoderPoolCapacity(0);
+}
+
 // Test normal Create and Free.
 TEST_P(OpusTest, OpusCreateFree) {
   CreateSingleOrMultiStreamEncoder(&opus_encoder_, channels_, application_,
@@ -976,4 +1006,53 @@ TEST(OpusVadTest, TwoOpusMonoFramesVadOnSecond) {
   EXPECT_TRUE(WebRtcOpus_PacketHasVoiceActivity(twoMonoFrames, 3));
 }
 
+TEST(OpusDredTest, PacketWithoutPadding) {
+  const uint8_t silk20msMono[] = {0x78, 0x80};
+  EXPECT_FALSE(WebRtcOpus_PacketHasDred(silk20msMono, 2));
+}
+
+TEST(OpusDredTest, PaddingWithoutExtensions) {
+  // Code 3 packet with one frame and two bytes of padding.
+  const uint8_t padded[] = {0x78 | 0x3, 0x41, 0x02, 0x80, 0x00, 0x00};
+  EXPECT_FALSE(WebRtcOpus_PacketHasDred(padded, sizeof(padded)));
+}
+
+TEST(OpusDredTest, DredExtension) {
+  // Code 3 packet with one frame and a DRED extension (ID 126) in its
+  // padding.
+  const uint8_t dred[] = {0x78 | 0x3, 0x41, 0x03, 0x80, 126 << 1, 'D', 0x00};
+  EXPECT_TRUE(WebRtcOpus_PacketHasDred(dred, sizeof(dred)));
+}
+
+TEST(OpusDredTest, DredExtensionAfterOtherExtensions) {
+  // A short extension with one byte of data, a frame separator and a long
+  // extension with one byte of data precede the DRED extension.
+  const uint8_t dred[] = {0x78 | 0x3, 0x41, 0x08,   0x80,     (2 << 1) | 1,
+                          0xAA,       1 << 1, (32 << 1) | 1, 0x01,     0xAA,
+                          126 << 1,   'D'};
+  EXPECT_TRUE(WebRtcOpus_PacketHasDred(dred, sizeof(dred)));
+}
+
+TEST(OpusDredTest, TruncatedPadding) {
+  // The padding is longer than the packet.
+  const uint8_t truncated[] = {0x78 | 0x3, 0x41, 0x10, 0x80, 126 << 1};
+  EXPECT_FALSE(WebRtcOpus_PacketHasDred(truncated, sizeof(truncated)));
+}
+
+// Test that DRED is only parsed once the DRED decoder has been enabled.
+TEST(OpusDredTest, ParseRequiresEnabledDred) {
+  const uint8_t dred[] = {0x78 | 0x3, 0x41, 0x03, 0x80, 126 << 1, 'D', 0x00};
+  WebRtcOpusDecInst* opus_decoder;
+  ASSERT_EQ(0, WebRtcOpus_DecoderCreate(&opus_decoder, 1, 48000));
+  EXPECT_EQ(nullptr, opus_decoder->dred_decoder);
+
+  std::vector<uint8_t> dred_data(opus_dred_get_size());
+  int32_t dred_end;
+  EXPECT_EQ(0, WebRtcOpus_DredParse(opus_decoder, dred_data.data(), dred,
+                                    sizeof(dred), 480, &dred_end));
+  EXPECT_EQ(nullptr, opus_decoder->dred_decoder);
+
+  EXPECT_EQ(0, WebRtcOpus_DecoderFree(opus_decoder));
+}
+
 }  // namespace webrtc
@@ -43,6 +43,7 @@
 #include "modules/audio_coding/neteq/sync_buffer.h"
 #include "modules/audio_coding/neteq/time_stretch.h"
 #include "modules/audio_coding/neteq/timestamp_scaler.h"
+#include "modules/include/module_common_types_public.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -128,6 +129,7 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
       reset_decoder_(false),
       first_packet_(true),
       enable_fast_accelerate_(config.enable_fast_accelerate),
+      enable_lazy_dred_(config.enable_lazy_dred),
       nack_enabled_(false),
       enable_muted_state_(config.enable_muted_state),
       expand_uma_logger_("WebRTC.Audio.ExpandRatePercent",
@@ -649,24 +651,30 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
         return new_packet;
       };
 
-      uint32_t previous_timestamp;
-      uint32_t duration = decoder_frame_length_;
-      int result = packet_buffer_->NextLowerTimestamp(packet.sequence_number, packet.timestamp, &previous_timestamp, &duration);
-      if (result == kOK) {
-        // TODO(klingm@amazon.com): remove debugging
-        // RTC_LOG(LS_INFO) << "NextLowerTimestamp found: " << previous_timestamp;
-        previous_timestamp += duration;
-      } else {
-        uint16_t newest_sequence_number, gap;
-        bool have_loss = false;
-        if (packet_buffer_->NewestSequenceNumber(&newest_sequence_number)) {
-          gap = packet.sequence_number - newest_sequence_number;
-          have_loss = gap > 1 && gap <= 0xFFFF/2;
+      // With lazy DRED the redundancy is parsed by ParseDeferredRedundancy()
+      // at playout time instead, so no gap is reported here.
+      uint32_t previous_timestamp = packet.timestamp;
+      if (!enable_lazy_dred_) {
+        uint32_t duration = decoder_frame_length_;
+        int result = packet_buffer_->NextLowerTimestamp(
+            packet.sequence_number, packet.timestamp, &previous_timestamp,
+            &duration);
+        if (result == kOK) {
+          // TODO(klingm@amazon.com): remove debugging
+          // RTC_LOG(LS_INFO) << "NextLowerTimestamp found: " << previous_timestamp;
+          previous_timestamp += duration;
+        } else {
+          uint16_t newest_sequence_number, gap;
+          bool have_loss = false;
+          if (packet_buffer_->NewestSequenceNumber(&newest_sequence_number)) {
+            gap = packet.sequence_number - newest_sequence_number;
+            have_loss = gap > 1 && gap <= 0xFFFF/2;
+          }
+          if (have_loss)
+            previous_timestamp = sync_buffer_->end_timestamp();
+          else
+            previous_timestamp = packet.timestamp;
         }
-        if (have_loss)
-          previous_timestamp = sync_buffer_->end_timestamp();
-        else
-          previous_timestamp = packet.timestamp;
       }
       uint32_t current_gap = packet.timestamp - previous_timestamp;
       // TODO(klingm@amazon.com): sanity check current_gap
@@ -1116,6 +1124,11 @@ int NetEqImpl::GetDecision(Operation* operation,
     }
   }
 
+  if (enable_lazy_dred_ && packet && !new_codec_) {
+    ParseDeferredRedundancy(end_timestamp);
+    packet = packet_buffer_->PeekNextPacket();
+  }
+
   RTC_DCHECK(expand_.get());
   const int samples_left = static_cast<int>(sync_buffer_->FutureLength() -
                                             expand_->overlap_length());
@@ -1356,6 +1369,65 @@ int NetEqImpl::GetDecision(Operation* operation,
   return 0;
 }
 
+void NetEqImpl::ParseDeferredRedundancy(uint32_t end_timestamp) {
+  const Packet* next_packet = packet_buffer_->PeekNextPacket();
+  if (!next_packet ||
+      !IsNewerTimestamp(next_packet->timestamp, end_timestamp)) {
+    return;
+  }
+  // The next packet may be the in-band FEC (LBRR) frame of its primary
+  // packet. The DRED of that primary packet then covers the gap before the
+  // LBRR frame.
+  const Packet* packet = next_packet;
+  if (next_packet->priority.codec_level == 1) {
+    packet = packet_buffer_->FindPrimaryPacket(next_packet->sequence_number);
+  } else if (next_packet->priority.codec_level != 0) {
+    return;
+  }
+  if (!packet || !packet->frame ||
+      last_dred_parse_timestamp_ == packet->timestamp) {
+    return;
+  }
+  // Only parse each packet once, even if it stays at the head of the buffer
+  // during several calls.
+  last_dred_parse_timestamp_ = packet->timestamp;
+  const uint32_t begin_timestamp = next_packet->timestamp;
+  const uint32_t gap = packet->timestamp - end_timestamp;
+  if (gap > static_cast<uint32_t>(5 * fs_hz_)) {
+    return;
+  }
+
+  std::vector<AudioDecoder::ParseResult> results =
+      packet->frame->ParseRedundancy(packet->timestamp, begin_timestamp, gap);
+  if (results.empty()) {
+    return;
+  }
+  PacketList recovered_packets;
+  for (auto& result : results) {
+    RTC_DCHECK(result.frame);
+    RTC_DCHECK_GT(result.priority, 0);
+    Packet recovered_packet;
+    recovered_packet.sequence_number = packet->sequence_number;
+    recovered_packet.payload_type = packet->payload_type;
+    recovered_packet.timestamp = result.timestamp;
+    recovered_packet.priority.codec_level = result.priority;
+    recovered_packet.priority.red_level = packet->priority.red_level;
+    recovered_packet.frame = std::move(result.frame);
+    recovered_packets.push_back(std::move(recovered_packet));
+  }
+  stats_->SecondaryPacketsReceived(recovered_packets.size());
+  // `packet` may not be used after this point.
+  const int ret = packet_buffer_->InsertPacketList(
+      &recovered_packets, *decoder_database_, &current_rtp_payload_type_,
+      &current_cng_rtp_payload_type_);
+  if (ret == PacketBuffer::kFlushed) {
+    // Reset DSP timestamp etc. if packet buffer flushed.
+    new_codec_ = true;
+  } else if (ret != PacketBuffer::kOK) {
+    RTC_LOG(LS_WARNING) << "Failed to insert recovered packets: " << ret;
+  }
+}
+
 int NetEqImpl::Decode(PacketList* packet_list,
                       Operation* operation,
                       int* decoded_length,
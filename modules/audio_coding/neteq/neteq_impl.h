@@ -234,6 +234,14 @@ class NetEqImpl : public webrtc::NetEq {
                   absl::optional<Operation> action_override)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Parses the deep redundancy (DRED) of the next packet in the buffer, if
+  // there is a gap between `end_timestamp` and that packet, and inserts the
+  // recovered frames into the packet buffer. If the next packet is an LBRR
+  // frame, the DRED of its primary packet is parsed for the gap before it.
+  // Only used when lazy DRED is enabled.
+  void ParseDeferredRedundancy(uint32_t end_timestamp)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // Decodes the speech packets in `packet_list`, and writes the results to
   // `decoded_buffer`, which is allocated to hold `decoded_buffer_length`
   // elements. The length of the decoded data is written to `decoded_length`.
@@ -391,6 +399,9 @@ class NetEqImpl : public webrtc::NetEq {
   absl::optional<uint8_t> current_cng_rtp_payload_type_ RTC_GUARDED_BY(mutex_);
   bool first_packet_ RTC_GUARDED_BY(mutex_);
   bool enable_fast_accelerate_ RTC_GUARDED_BY(mutex_);
+  const bool enable_lazy_dred_ RTC_GUARDED_BY(mutex_);
+  // Timestamp of the last packet whose redundancy was parsed at playout time.
+  absl::optional<uint32_t> last_dred_parse_timestamp_ RTC_GUARDED_BY(mutex_);
   std::unique_ptr<NackTracker> nack_ RTC_GUARDED_BY(mutex_);
   bool nack_enabled_ RTC_GUARDED_BY(mutex_);
   const bool enable_muted_state_ RTC_GUARDED_BY(mutex_);
@@ -10,6 +10,7 @@
 
 #include "modules/audio_coding/neteq/neteq_impl.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -34,6 +35,7 @@
 #include "modules/audio_coding/neteq/statistics_calculator.h"
 #include "modules/audio_coding/neteq/sync_buffer.h"
 #include "modules/audio_coding/neteq/timestamp_scaler.h"
+#include "modules/include/module_common_types_public.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "system_wrappers/include/clock.h"
 #include "test/audio_decoder_proxy_factory.h"
@@ -667,6 +669,247 @@ TEST_F(NetEqImplTest, ReorderedPacket) {
   EXPECT_CALL(mock_decoder, Die());
 }
 
+namespace {
+
+// Decoder producing 10 ms frames which record the order in which they are
+// decoded. Each packet carries a primary frame and, optionally, an in-band
+// FEC (LBRR) frame for the preceding 10 ms. Calling ParseRedundancy() on a
+// primary frame recovers up to `kMaxDredFrames` DRED frames before it.
+class RedundancyDecoder : public AudioDecoder {
+ public:
+  static constexpr int kSampleRateHz = 8000;
+  static constexpr size_t kFrameLengthSamples = kSampleRateHz / 100;
+  static constexpr int kMaxDredFrames = 5;
+
+  enum class FrameType { kPrimary, kLbrr, kDred };
+
+  struct DecodedFrame {
+    FrameType type;
+    uint32_t timestamp;
+    bool operator==(const DecodedFrame& other) const {
+      return type == other.type && timestamp == other.timestamp;
+    }
+  };
+
+  struct ParseCall {
+    uint32_t timestamp;
+    uint32_t begin_timestamp;
+    uint32_t recovery_timestamp_offset;
+  };
+
+  class Frame : public EncodedAudioFrame {
+   public:
+    Frame(RedundancyDecoder* decoder, FrameType type, uint32_t timestamp)
+        : decoder_(decoder), type_(type), timestamp_(timestamp) {}
+
+    size_t Duration() const override { return kFrameLengthSamples; }
+
+    absl::optional<DecodeResult> Decode(
+        rtc::ArrayView<int16_t> decoded) const override {
+      decoder_->decoded_frames.push_back({type_, timestamp_});
+      std::fill_n(decoded.data(), kFrameLengthSamples, 0);
+      return DecodeResult{kFrameLengthSamples, kSpeech};
+    }
+
+    std::vector<ParseResult> ParseRedundancy(
+        uint32_t timestamp,
+        uint32_t begin_timestamp,
+        uint32_t recovery_timestamp_offset) const override {
+      std::vector<ParseResult> results;
+      if (type_ != FrameType::kPrimary) {
+        return results;
+      }
+      decoder_->parse_calls.push_back(
+          {timestamp, begin_timestamp, recovery_timestamp_offset});
+      const int count = std::min<int>(
+          kMaxDredFrames, recovery_timestamp_offset / kFrameLengthSamples);
+      for (uint32_t recovery_timestamp =
+               timestamp - count * kFrameLengthSamples;
+           IsNewerTimestamp(begin_timestamp, recovery_timestamp);
+           recovery_timestamp += kFrameLengthSamples) {
+        results.emplace_back(recovery_timestamp, 2,
+                             std::make_unique<Frame>(decoder_, FrameType::kDred,
+                                                     recovery_timestamp));
+      }
+      return results;
+    }
+
+   private:
+    RedundancyDecoder* const decoder_;
+    const FrameType type_;
+    const uint32_t timestamp_;
+  };
+
+  explicit RedundancyDecoder(bool lbrr) : lbrr_(lbrr) {}
+
+  std::vector<ParseResult> ParsePayload(rtc::Buffer&& payload,
+                                        uint32_t timestamp) override {
+    std::vector<ParseResult> results;
+    if (lbrr_) {
+      results.emplace_back(
+          timestamp - kFrameLengthSamples, 1,
+          std::make_unique<Frame>(this, FrameType::kLbrr,
+                                  timestamp - kFrameLengthSamples));
+    }
+    results.emplace_back(
+        timestamp, 0,
+        std::make_unique<Frame>(this, FrameType::kPrimary, timestamp));
+    return results;
+  }
+
+  int DecodeInternal(const uint8_t* encoded,
+                     size_t encoded_len,
+                     int sample_rate_hz,
+                     int16_t* decoded,
+                     SpeechType* speech_type) override {
+    return -1;
+  }
+
+  void Reset() override {}
+
+  int SampleRateHz() const override { return kSampleRateHz; }
+
+  size_t Channels() const override { return 1; }
+
+  std::vector<DecodedFrame> decoded_frames;
+  std::vector<ParseCall> parse_calls;
+
+ private:
+  const bool lbrr_;
+};
+
+}  // namespace
+
+class NetEqImplLazyDredTest : public NetEqImplTest {
+ protected:
+  static constexpr uint8_t kPayloadType = 17;
+  static constexpr uint32_t kFirstTimestamp = 0x12345678;
+  static constexpr size_t kFrameLength =
+      RedundancyDecoder::kFrameLengthSamples;
+
+  void CreateInstance(RedundancyDecoder* decoder) {
+    config_.enable_lazy_dred = true;
+    UseNoMocks();
+    NetEqImplTest::CreateInstance(
+        rtc::make_ref_counted<test::AudioDecoderProxyFactory>(decoder));
+    EXPECT_TRUE(neteq_->RegisterPayloadType(kPayloadType,
+                                            SdpAudioFormat("L16", 8000, 1)));
+  }
+
+  static uint32_t Timestamp(int index) {
+    return kFirstTimestamp + index * kFrameLength;
+  }
+
+  void InsertPacket(int index) {
+    RTPHeader rtp_header;
+    rtp_header.payloadType = kPayloadType;
+    rtp_header.sequenceNumber = 0x1234 + index;
+    rtp_header.timestamp = Timestamp(index);
+    rtp_header.ssrc = 0x87654321;
+    const uint8_t payload[kFrameLength] = {0};
+    EXPECT_EQ(NetEq::kOK, neteq_->InsertPacket(rtp_header, payload));
+  }
+
+  void GetAudio() {
+    AudioFrame output;
+    bool muted;
+    EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+  }
+};
+
+constexpr uint8_t NetEqImplLazyDredTest::kPayloadType;
+constexpr uint32_t NetEqImplLazyDredTest::kFirstTimestamp;
+constexpr size_t NetEqImplLazyDredTest::kFrameLength;
+
+using FrameType = RedundancyDecoder::FrameType;
+using DecodedFrame = RedundancyDecoder::DecodedFrame;
+
+// Verifies that with lazy DRED enabled, no redundancy is parsed when a
+// reordered packet fills the gap before it is played out.
+TEST_F(NetEqImplLazyDredTest, NotParsedForReorderedPacket) {
+  RedundancyDecoder decoder(/*lbrr=*/false);
+  CreateInstance(&decoder);
+
+  InsertPacket(0);
+  GetAudio();
+  // Packet 1 arrives after packet 2, but before it is due for playout.
+  InsertPacket(2);
+  InsertPacket(1);
+  GetAudio();
+  GetAudio();
+
+  EXPECT_THAT(decoder.parse_calls, IsEmpty());
+  EXPECT_THAT(decoder.decoded_frames,
+              ElementsAre(DecodedFrame{FrameType::kPrimary, Timestamp(0)},
+                          DecodedFrame{FrameType::kPrimary, Timestamp(1)},
+                          DecodedFrame{FrameType::kPrimary, Timestamp(2)}));
+}
+
+// Verifies that a loss burst still missing at playout time is filled with the
+// DRED frames recovered from the next packet.
+TEST_F(NetEqImplLazyDredTest, RecoversLossBurstFromDred) {
+  RedundancyDecoder decoder(/*lbrr=*/false);
+  CreateInstance(&decoder);
+
+  InsertPacket(0);
+  GetAudio();
+  InsertPacket(1);
+  GetAudio();
+  // Packets 2 and 3 are lost.
+  InsertPacket(4);
+  for (int i = 0; i < 3; ++i) {
+    GetAudio();
+  }
+
+  ASSERT_THAT(decoder.parse_calls, SizeIs(1));
+  EXPECT_EQ(Timestamp(4), decoder.parse_calls[0].timestamp);
+  EXPECT_EQ(Timestamp(4), decoder.parse_calls[0].begin_timestamp);
+  EXPECT_EQ(2 * kFrameLength,
+            decoder.parse_calls[0].recovery_timestamp_offset);
+  EXPECT_THAT(decoder.decoded_frames,
+              ElementsAre(DecodedFrame{FrameType::kPrimary, Timestamp(0)},
+                          DecodedFrame{FrameType::kPrimary, Timestamp(1)},
+                          DecodedFrame{FrameType::kDred, Timestamp(2)},
+                          DecodedFrame{FrameType::kDred, Timestamp(3)},
+                          DecodedFrame{FrameType::kPrimary, Timestamp(4)}));
+  EXPECT_EQ(0u, neteq_->GetLifetimeStatistics().concealment_events);
+}
+
+// Verifies that when the next packet carries an LBRR frame, the DRED of that
+// packet still fills the rest of a loss burst, without recovering the audio
+// already covered by the LBRR frame.
+TEST_F(NetEqImplLazyDredTest, RecoversLossBurstFromLbrrAndDred) {
+  RedundancyDecoder decoder(/*lbrr=*/true);
+  CreateInstance(&decoder);
+
+  InsertPacket(0);
+  GetAudio();
+  InsertPacket(1);
+  GetAudio();
+  // Packets 2, 3 and 4 are lost. Packet 5 carries the LBRR frame of packet 4.
+  InsertPacket(5);
+  for (int i = 0; i < 5; ++i) {
+    GetAudio();
+  }
+
+  ASSERT_THAT(decoder.parse_calls, SizeIs(1));
+  EXPECT_EQ(Timestamp(5), decoder.parse_calls[0].timestamp);
+  EXPECT_EQ(Timestamp(4), decoder.parse_calls[0].begin_timestamp);
+  EXPECT_EQ(3 * kFrameLength,
+            decoder.parse_calls[0].recovery_timestamp_offset);
+  // The LBRR frame of packet 0 starts the playout, while that of packet 1
+  // arrives too late to be decoded.
+  EXPECT_THAT(decoder.decoded_frames,
+              ElementsAre(DecodedFrame{FrameType::kLbrr, Timestamp(-1)},
+                          DecodedFrame{FrameType::kPrimary, Timestamp(0)},
+                          DecodedFrame{FrameType::kPrimary, Timestamp(1)},
+                          DecodedFrame{FrameType::kDred, Timestamp(2)},
+                          DecodedFrame{FrameType::kDred, Timestamp(3)},
+                          DecodedFrame{FrameType::kLbrr, Timestamp(4)},
+                          DecodedFrame{FrameType::kPrimary, Timestamp(5)}));
+  EXPECT_EQ(0u, neteq_->GetLifetimeStatistics().concealment_events);
+}
+
 // This test verifies that NetEq can handle the situation where the first
 // incoming packet is rejected.
 TEST_F(NetEqImplTest, FirstPacketUnknown) {
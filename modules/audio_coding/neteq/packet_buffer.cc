@@ -8,14 +8,15 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-// This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// This is the implementation of the PacketBuffer class. It is based on a ring
+// buffer of preallocated packet slots. The buffer is kept sorted at all times
+// so that the next packet to decode is at the head of the ring. Packets mostly
+// arrive in order, so that inserting appends to the tail of the ring; the
+// position of a reordered or redundant packet is found with a binary search.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -32,17 +33,6 @@
 
 namespace webrtc {
 namespace {
-// Predicate used when inserting packets in the buffer list.
-// Operator() returns true when `packet` goes before `new_packet`.
-class NewTimestampIsLarger {
- public:
-  explicit NewTimestampIsLarger(const Packet& new_packet)
-      : new_packet_(new_packet) {}
-  bool operator()(const Packet& packet) { return (new_packet_ >= packet); }
-
- private:
-  const Packet& new_packet_;
-};
 
 // Returns true if both payload types are known to the decoder database, and
 // have the same sample rate.
@@ -60,27 +50,28 @@ PacketBuffer::PacketBuffer(size_t max_number_of_packets,
                            const TickTimer* tick_timer,
                            StatisticsCalculator* stats)
     : max_number_of_packets_(max_number_of_packets),
+      slots_(std::max<size_t>(max_number_of_packets, 1)),
       tick_timer_(tick_timer),
       stats_(stats),
       newest_sequence_number_(0),
       insert_count_(0) {}
 
 // Destructor. All packets in the buffer will be destroyed.
-PacketBuffer::~PacketBuffer() {
-  buffer_.clear();
-}
+PacketBuffer::~PacketBuffer() = default;
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush() {
-  for (auto& p : buffer_) {
-    LogPacketDiscarded(p.priority.codec_level);
+  for (size_t i = 0; i < size_; ++i) {
+    LogPacketDiscarded(At(i).priority.codec_level);
+    At(i) = Packet();
   }
-  buffer_.clear();
+  head_ = 0;
+  size_ = 0;
   stats_->FlushedPacketBuffer();
 }
 
 bool PacketBuffer::Empty() const {
-  return buffer_.empty();
+  return size_ == 0;
 }
 
 bool PacketBuffer::NewestSequenceNumber(uint16_t *sequence_number) const {
@@ -111,36 +102,33 @@ int PacketBuffer::InsertPacket(Packet&& packet) {
 
   packet.waiting_time = tick_timer_->GetNewStopwatch();
 
-  if (buffer_.size() >= max_number_of_packets_) {
+  if (size_ >= max_number_of_packets_) {
     // Buffer is full.
     Flush();
     return_val = kFlushed;
     RTC_LOG(LS_WARNING) << "Packet buffer flushed.";
   }
 
-  // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(), NewTimestampIsLarger(packet));
+  // Find the position in the buffer where the new packet should be inserted.
+  const size_t index = UpperBound(packet);
 
-  // The new packet is to be inserted to the right of `rit`. If it has the same
-  // timestamp as `rit`, which has a higher priority, do not insert the new
-  // packet to list.
-  if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
+  // The new packet is to be inserted to the right of `index - 1`. If it has
+  // the same timestamp as that packet, which has a higher priority, do not
+  // insert the new packet to the buffer.
+  if (index > 0 && packet.timestamp == At(index - 1).timestamp) {
     LogPacketDiscarded(packet.priority.codec_level);
     return return_val;
   }
 
-  // The new packet is to be inserted to the left of `it`. If it has the same
-  // timestamp as `it`, which has a lower priority, replace `it` with the new
-  // packet.
-  PacketList::iterator it = rit.base();
-  if (it != buffer_.end() && packet.timestamp == it->timestamp) {
-    LogPacketDiscarded(it->priority.codec_level);
-    it = buffer_.erase(it);
+  // The new packet is to be inserted to the left of `index`. If it has the
+  // same timestamp as that packet, which has a lower priority, replace it with
+  // the new packet.
+  if (index < size_ && packet.timestamp == At(index).timestamp) {
+    LogPacketDiscarded(At(index).priority.codec_level);
+    At(index) = std::move(packet);
+    return return_val;
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+  InsertAt(index, std::move(packet));
 
   return return_val;
 }
@@ -196,7 +184,7 @@ int PacketBuffer::NextTimestamp(uint32_t* next_timestamp) const {
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  *next_timestamp = buffer_.front().timestamp;
+  *next_timestamp = At(0).timestamp;
   return kOK;
 }
 
@@ -208,11 +196,10 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (size_t i = 0; i < size_; ++i) {
+    if (At(i).timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = At(i).timestamp;
       return kOK;
     }
   }
@@ -229,16 +216,16 @@ int PacketBuffer::NextLowerTimestamp(int16_t sequence_number,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_reverse_iterator rit;
-  for (rit = buffer_.rbegin(); rit != buffer_.rend(); ++rit) {
-    if (timestamp != rit->timestamp &&
-        timestamp - rit->timestamp < (0xFFFFFFFF / 2)) {
-      uint16_t sequence_diff = sequence_number - rit->sequence_number;
+  for (size_t i = size_; i-- > 0;) {
+    const Packet& packet = At(i);
+    if (timestamp != packet.timestamp &&
+        timestamp - packet.timestamp < (0xFFFFFFFF / 2)) {
+      uint16_t sequence_diff = sequence_number - packet.sequence_number;
       if (sequence_diff > 1 && sequence_diff < (0xFFFF / 2)) {
         // Found a packet matching the search.
-        *next_timestamp = rit->timestamp;
+        *next_timestamp = packet.timestamp;
         if (duration) {
-          *duration = rit->frame->Duration();
+          *duration = packet.frame->Duration();
         }
         return kOK;
       } else {
@@ -250,7 +237,18 @@ int PacketBuffer::NextLowerTimestamp(int16_t sequence_number,
 }
 
 const Packet* PacketBuffer::PeekNextPacket() const {
-  return buffer_.empty() ? nullptr : &buffer_.front();
+  return Empty() ? nullptr : &At(0);
+}
+
+const Packet* PacketBuffer::FindPrimaryPacket(uint16_t sequence_number) const {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = At(i);
+    if (packet.sequence_number == sequence_number &&
+        packet.priority.codec_level == 0) {
+      return &packet;
+    }
+  }
+  return nullptr;
 }
 
 absl::optional<Packet> PacketBuffer::GetNextPacket() {
@@ -259,10 +257,10 @@ absl::optional<Packet> PacketBuffer::GetNextPacket() {
     return absl::nullopt;
   }
 
-  absl::optional<Packet> packet(std::move(buffer_.front()));
+  absl::optional<Packet> packet(std::move(At(0)));
   // Assert that the packet sanity checks in InsertPacket method works.
   RTC_DCHECK(!packet->empty());
-  buffer_.pop_front();
+  PopFront();
 
   return packet;
 }
@@ -272,16 +270,16 @@ int PacketBuffer::DiscardNextPacket() {
     return kBufferEmpty;
   }
   // Assert that the packet sanity checks in InsertPacket method works.
-  const Packet& packet = buffer_.front();
+  const Packet& packet = At(0);
   RTC_DCHECK(!packet.empty());
   LogPacketDiscarded(packet.priority.codec_level);
-  buffer_.pop_front();
+  PopFront();
   return kOK;
 }
 
 void PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                      uint32_t horizon_samples) {
-  buffer_.remove_if([this, timestamp_limit, horizon_samples](const Packet& p) {
+  RemoveIf([this, timestamp_limit, horizon_samples](const Packet& p) {
     if (timestamp_limit == p.timestamp ||
         !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
       return false;
@@ -296,7 +294,7 @@ void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit) {
 }
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type) {
-  buffer_.remove_if([this, payload_type](const Packet& p) {
+  RemoveIf([this, payload_type](const Packet& p) {
     if (p.payload_type != payload_type) {
       return false;
     }
@@ -306,13 +304,14 @@ void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type) {
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
-  return buffer_.size();
+  return size_;
 }
 
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = At(i);
     if (packet.frame) {
       // TODO(hlundin): Verify that it's fine to count all packets and remove
       // this check.
@@ -333,18 +332,19 @@ size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
 size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
                                     size_t sample_rate,
                                     bool count_waiting_time) const {
-  if (buffer_.size() == 0) {
+  if (size_ == 0) {
     return 0;
   }
 
-  size_t span = buffer_.back().timestamp - buffer_.front().timestamp;
+  const Packet& back = At(size_ - 1);
+  size_t span = back.timestamp - At(0).timestamp;
   size_t waiting_time_samples = rtc::dchecked_cast<size_t>(
-      buffer_.back().waiting_time->ElapsedMs() * (sample_rate / 1000));
+      back.waiting_time->ElapsedMs() * (sample_rate / 1000));
   if (count_waiting_time) {
     span += waiting_time_samples;
-  } else if (buffer_.back().frame && buffer_.back().frame->Duration() > 0) {
-    size_t duration = buffer_.back().frame->Duration();
-    if (buffer_.back().frame->IsDtxPacket()) {
+  } else if (back.frame && back.frame->Duration() > 0) {
+    size_t duration = back.frame->Duration();
+    if (back.frame->IsDtxPacket()) {
       duration = std::max(duration, waiting_time_samples);
     }
     span += duration;
@@ -357,7 +357,8 @@ size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
 bool PacketBuffer::ContainsDtxOrCngPacket(
     const DecoderDatabase* decoder_database) const {
   RTC_DCHECK(decoder_database);
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = At(i);
     if ((packet.frame && packet.frame->IsDtxPacket()) ||
         decoder_database->IsComfortNoise(packet.payload_type)) {
       return true;
@@ -366,6 +367,68 @@ bool PacketBuffer::ContainsDtxOrCngPacket(
   return false;
 }
 
+size_t PacketBuffer::UpperBound(const Packet& packet) const {
+  // The most likely case is that the new packet goes at the end of the
+  // buffer, so check that before searching.
+  if (size_ == 0 || packet >= At(size_ - 1)) {
+    return size_;
+  }
+  size_t low = 0;
+  size_t high = size_ - 1;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (packet >= At(middle)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+void PacketBuffer::InsertAt(size_t index, Packet&& packet) {
+  RTC_DCHECK_LE(index, size_);
+  RTC_DCHECK_LT(size_, slots_.size());
+  if (index < size_ - index) {
+    // Grow towards the front and move the older packets one step down.
+    head_ = (head_ + slots_.size() - 1) % slots_.size();
+    for (size_t i = 0; i < index; ++i) {
+      At(i) = std::move(At(i + 1));
+    }
+  } else {
+    for (size_t i = size_; i > index; --i) {
+      At(i) = std::move(At(i - 1));
+    }
+  }
+  At(index) = std::move(packet);
+  ++size_;
+}
+
+void PacketBuffer::PopFront() {
+  RTC_DCHECK_GT(size_, 0);
+  At(0) = Packet();
+  head_ = (head_ + 1) % slots_.size();
+  --size_;
+}
+
+template <typename Predicate>
+void PacketBuffer::RemoveIf(Predicate predicate) {
+  size_t kept = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    if (predicate(At(i))) {
+      continue;
+    }
+    if (kept != i) {
+      At(kept) = std::move(At(i));
+    }
+    ++kept;
+  }
+  for (size_t i = kept; i < size_; ++i) {
+    At(i) = Packet();
+  }
+  size_ = kept;
+}
+
 void PacketBuffer::LogPacketDiscarded(int codec_level) {
   if (codec_level > 0) {
     stats_->SecondaryPacketsDiscarded(1);
@@ -376,7 +439,8 @@ void PacketBuffer::LogPacketDiscarded(int codec_level) {
 
 void PacketBuffer::LogPacketList() const {
   std::string line = "[ ";
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = At(i);
     line += std::to_string(packet.timestamp);
     line += "{ ";
     line += std::to_string(packet.priority.codec_level);
@@ -11,6 +11,11 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
@@ -22,7 +27,9 @@ class DecoderDatabase;
 class StatisticsCalculator;
 class TickTimer;
 
-// This is the actual buffer holding the packets before decoding.
+// This is the actual buffer holding the packets before decoding. The packets
+// are kept sorted on timestamp in a ring buffer whose slots are allocated up
+// front, so that inserting and removing packets never allocates.
 class PacketBuffer {
  public:
   enum BufferReturnCodes {
@@ -95,6 +102,11 @@ class PacketBuffer {
   // NULL if the buffer is empty.
   virtual const Packet* PeekNextPacket() const;
 
+  // Returns a (constant) pointer to the primary packet, i.e. the packet not
+  // recovered from redundancy, with sequence number `sequence_number`.
+  // Returns NULL if there is no such packet in the buffer.
+  virtual const Packet* FindPrimaryPacket(uint16_t sequence_number) const;
+
   // Extracts the first packet in the buffer and returns it.
   // Returns an empty optional if the buffer is empty.
   virtual absl::optional<Packet> GetNextPacket();
@@ -157,8 +169,33 @@ class PacketBuffer {
  private:
   void LogPacketDiscarded(int codec_level);
 
+  // Returns the packet at position `index` counted from the oldest packet.
+  Packet& At(size_t index) { return slots_[(head_ + index) % slots_.size()]; }
+  const Packet& At(size_t index) const {
+    return slots_[(head_ + index) % slots_.size()];
+  }
+
+  // Returns the position of the first packet that sorts after `packet`.
+  size_t UpperBound(const Packet& packet) const;
+
+  // Inserts `packet` at position `index`, moving whichever side of the buffer
+  // is shorter to make room.
+  void InsertAt(size_t index, Packet&& packet);
+
+  // Removes the oldest packet.
+  void PopFront();
+
+  // Removes all packets for which `predicate` returns true, keeping the order
+  // of the remaining packets.
+  template <typename Predicate>
+  void RemoveIf(Predicate predicate);
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  // Ring buffer of `max_number_of_packets_` slots, of which the `size_` slots
+  // starting at `head_` hold packets.
+  std::vector<Packet> slots_;
+  size_t head_ = 0;
+  size_t size_ = 0;
   const TickTimer* tick_timer_;
   StatisticsCalculator* stats_;
   uint16_t newest_sequence_number_;
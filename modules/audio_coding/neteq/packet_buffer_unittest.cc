@@ -13,6 +13,7 @@
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <memory>
+#include <vector>
 
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/neteq/tick_timer.h"
@@ -464,6 +465,55 @@ TEST(PacketBuffer, Reordering) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Inserts redundant packets older than the ones in the buffer, after the ring
+// buffer has wrapped around, and verifies that they are sorted in.
+TEST(PacketBuffer, InsertOlderPacketsAfterWrapAround) {
+  TickTimer tick_timer;
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  PacketBuffer buffer(10, &tick_timer, &mock_stats);  // 10 packets.
+  const uint16_t start_seq_no = 17;
+  const uint32_t start_ts = 4711;
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(start_seq_no, start_ts, 0, ts_increment);
+  const int payload_len = 10;
+
+  // Move the head of the ring buffer past the start of its storage.
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(gen.NextPacket(payload_len, nullptr)));
+    EXPECT_TRUE(buffer.GetNextPacket());
+  }
+
+  // Every other packet arrives as primary, the others are recovered later
+  // from secondary payloads in reverse order.
+  std::vector<Packet> secondary;
+  const uint32_t first_ts = gen.ts_;
+  for (int i = 0; i < 8; ++i) {
+    Packet packet = gen.NextPacket(payload_len, nullptr);
+    if (i % 2) {
+      EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(std::move(packet)));
+    } else {
+      packet.priority = Packet::Priority(1, 0);
+      secondary.push_back(std::move(packet));
+    }
+  }
+  for (auto it = secondary.rbegin(); it != secondary.rend(); ++it) {
+    EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(std::move(*it)));
+  }
+  EXPECT_EQ(8u, buffer.NumPacketsInBuffer());
+
+  // Extract them and make sure that come out in the right order.
+  uint32_t current_ts = first_ts;
+  for (int i = 0; i < 8; ++i) {
+    const absl::optional<Packet> packet = buffer.GetNextPacket();
+    ASSERT_TRUE(packet);
+    EXPECT_EQ(current_ts, packet->timestamp);
+    EXPECT_EQ(i % 2 ? 0 : 1, packet->priority.codec_level);
+    current_ts += ts_increment;
+  }
+  EXPECT_TRUE(buffer.Empty());
+}
+
 // The test first inserts a packet with narrow-band CNG, then a packet with
 // wide-band speech. The expected behavior of the packet buffer is to detect a
 // change in sample rate, even though no speech packet has been inserted before,
@@ -0,0 +1,234 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/channel_model.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace test {
+
+bool NoLoss::Lost(int now_ms) {
+  return false;
+}
+
+UniformLoss::UniformLoss(double loss_rate, uint64_t seed)
+    : loss_rate_(loss_rate), random_(seed) {}
+
+bool UniformLoss::Lost(int now_ms) {
+  return random_.Rand<double>() < loss_rate_;
+}
+
+GilbertElliotLoss::GilbertElliotLoss(double prob_trans_11,
+                                     double prob_trans_01,
+                                     uint64_t seed)
+    : prob_trans_11_(prob_trans_11),
+      prob_trans_01_(prob_trans_01),
+      lost_last_(false),
+      uniform_loss_model_(new UniformLoss(0, seed)) {}
+
+GilbertElliotLoss::~GilbertElliotLoss() {}
+
+bool GilbertElliotLoss::Lost(int now_ms) {
+  // Simulate bursty channel (Gilbert model).
+  // (1st order) Markov chain model with memory of the previous/last
+  // packet state (lost or received).
+  if (lost_last_) {
+    // Previous packet was not received.
+    uniform_loss_model_->set_loss_rate(prob_trans_11_);
+    return lost_last_ = uniform_loss_model_->Lost(now_ms);
+  } else {
+    uniform_loss_model_->set_loss_rate(prob_trans_01_);
+    return lost_last_ = uniform_loss_model_->Lost(now_ms);
+  }
+}
+
+FixedLossModel::FixedLossModel(
+    std::set<FixedLossEvent, FixedLossEventCmp> loss_events)
+    : loss_events_(loss_events) {
+  loss_events_it_ = loss_events_.begin();
+}
+
+FixedLossModel::~FixedLossModel() {}
+
+bool FixedLossModel::Lost(int now_ms) {
+  if (loss_events_it_ != loss_events_.end() &&
+      now_ms > loss_events_it_->start_ms) {
+    if (now_ms <= loss_events_it_->start_ms + loss_events_it_->duration_ms) {
+      return true;
+    } else {
+      ++loss_events_it_;
+      return false;
+    }
+  }
+  return false;
+}
+
+TraceLossModel::TraceLossModel(std::vector<bool> trace)
+    : trace_(std::move(trace)) {}
+
+TraceLossModel::~TraceLossModel() {}
+
+bool TraceLossModel::Lost(int now_ms) {
+  if (next_ >= trace_.size())
+    return false;
+  return trace_[next_++];
+}
+
+double TraceLossModel::loss_rate() const {
+  if (trace_.empty())
+    return 0.0;
+  return static_cast<double>(std::count(trace_.begin(), trace_.end(), true)) /
+         trace_.size();
+}
+
+std::unique_ptr<TraceLossModel> TraceLossModel::FromFile(
+    absl::string_view file_name) {
+  FILE* file = fopen(std::string(file_name).c_str(), "r");
+  if (!file)
+    return nullptr;
+  std::vector<bool> trace;
+  char line[16];
+  while (fgets(line, sizeof(line), file)) {
+    const char* p = line;
+    while (*p && isspace(*p))
+      p++;
+    trace.push_back(*p != '0');
+  }
+  fclose(file);
+  return std::make_unique<TraceLossModel>(std::move(trace));
+}
+
+std::unique_ptr<LossModel> CreateBurstLossModel(double loss_rate,
+                                                double mean_burst_length,
+                                                uint64_t seed) {
+  RTC_CHECK_GE(loss_rate, 0.0);
+  RTC_CHECK_LT(loss_rate, 1.0);
+  RTC_CHECK_GE(mean_burst_length, 1.0);
+  if (loss_rate == 0.0)
+    return std::make_unique<NoLoss>();
+  if (mean_burst_length == 1.0)
+    return std::make_unique<UniformLoss>(loss_rate, seed);
+  // A burst ends with probability `prob_trans_10` per packet. The stationary
+  // loss probability prob_trans_01 / (prob_trans_01 + prob_trans_10) must
+  // equal `loss_rate`.
+  const double prob_trans_10 = 1.0 / mean_burst_length;
+  const double prob_trans_01 =
+      std::min(1.0, loss_rate * prob_trans_10 / (1.0 - loss_rate));
+  return std::make_unique<GilbertElliotLoss>(1.0 - prob_trans_10,
+                                             prob_trans_01, seed);
+}
+
+double ProbTrans00Solver(int units, double loss_rate, double prob_trans_10) {
+  if (units == 1)
+    return prob_trans_10 / (1.0f - loss_rate) - prob_trans_10;
+  // 0 == prob_trans_00 ^ (units - 1) + (1 - loss_rate) / prob_trans_10 *
+  //     prob_trans_00 - (1 - loss_rate) * (1 + 1 / prob_trans_10).
+  // There is a unique solution between 0.0 and 1.0, due to the monotonicity and
+  // an opposite sign at 0.0 and 1.0.
+  // For simplicity, we reformulate the equation as
+  //     f(x) = x ^ (units - 1) + a x + b.
+  // Its derivative is
+  //     f'(x) = (units - 1) x ^ (units - 2) + a.
+  // The derivative is strictly greater than 0 when x is between 0 and 1.
+  // We use Newton's method to solve the equation, iteration is
+  //     x(k+1) = x(k) - f(x) / f'(x);
+  const double kPrecision = 0.001f;
+  const int kIterations = 100;
+  const double a = (1.0f - loss_rate) / prob_trans_10;
+  const double b = (loss_rate - 1.0f) * (1.0f + 1.0f / prob_trans_10);
+  double x = 0.0;  // Starting point;
+  double f = b;
+  double f_p;
+  int iter = 0;
+  while ((f >= kPrecision || f <= -kPrecision) && iter < kIterations) {
+    f_p = (units - 1.0f) * std::pow(x, units - 2) + a;
+    x -= f / f_p;
+    if (x > 1.0f) {
+      x = 1.0f;
+    } else if (x < 0.0f) {
+      x = 0.0f;
+    }
+    f = std::pow(x, units - 1) + a * x + b;
+    iter++;
+  }
+  return x;
+}
+
+CorrelatedJitter::CorrelatedJitter(int mean_delay_ms,
+                                   int stddev_ms,
+                                   double correlation,
+                                   uint64_t seed)
+    : mean_delay_ms_(mean_delay_ms),
+      stddev_ms_(stddev_ms),
+      correlation_(correlation),
+      random_(seed) {
+  RTC_CHECK_GE(mean_delay_ms, 0);
+  RTC_CHECK_GE(stddev_ms, 0);
+  RTC_CHECK_GE(correlation, 0.0);
+  RTC_CHECK_LT(correlation, 1.0);
+}
+
+CorrelatedJitter::~CorrelatedJitter() {}
+
+int CorrelatedJitter::DelayMs(int send_time_ms) {
+  // Scale the innovation so that the deviation keeps `stddev_ms_` regardless
+  // of the correlation.
+  const double innovation_stddev =
+      stddev_ms_ * std::sqrt(1.0 - correlation_ * correlation_);
+  deviation_ms_ = correlation_ * deviation_ms_ +
+                  random_.Gaussian(0.0, innovation_stddev);
+  return std::max(0, mean_delay_ms_ + static_cast<int>(deviation_ms_));
+}
+
+TraceJitterModel::TraceJitterModel(std::vector<int> delays_ms)
+    : delays_ms_(std::move(delays_ms)) {
+  RTC_CHECK(!delays_ms_.empty());
+}
+
+TraceJitterModel::~TraceJitterModel() {}
+
+int TraceJitterModel::DelayMs(int send_time_ms) {
+  const int delay_ms = delays_ms_[next_];
+  if (next_ + 1 < delays_ms_.size())
+    ++next_;
+  return delay_ms;
+}
+
+std::unique_ptr<TraceJitterModel> TraceJitterModel::FromFile(
+    absl::string_view file_name) {
+  FILE* file = fopen(std::string(file_name).c_str(), "r");
+  if (!file)
+    return nullptr;
+  std::vector<int> delays_ms;
+  char line[32];
+  while (fgets(line, sizeof(line), file)) {
+    char* end;
+    const long delay_ms = strtol(line, &end, 10);
+    if (end != line)
+      delays_ms.push_back(std::max(0, static_cast<int>(delay_ms)));
+  }
+  fclose(file);
+  if (delays_ms.empty())
+    return nullptr;
+  return std::make_unique<TraceJitterModel>(std::move(delays_ms));
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,178 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_CHANNEL_MODEL_H_
+#define MODULES_AUDIO_CODING_NETEQ_TOOLS_CHANNEL_MODEL_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace test {
+
+// Packet loss and network jitter models shared by the NetEq quality tests and
+// the RTP tools. Random models take an explicit seed so that several
+// simulations can run side by side and still be reproducible.
+
+class LossModel {
+ public:
+  virtual ~LossModel() {}
+  virtual bool Lost(int now_ms) = 0;
+};
+
+class NoLoss : public LossModel {
+ public:
+  bool Lost(int now_ms) override;
+};
+
+class UniformLoss : public LossModel {
+ public:
+  UniformLoss(double loss_rate, uint64_t seed);
+  bool Lost(int now_ms) override;
+  void set_loss_rate(double loss_rate) { loss_rate_ = loss_rate; }
+
+ private:
+  double loss_rate_;
+  Random random_;
+};
+
+class GilbertElliotLoss : public LossModel {
+ public:
+  GilbertElliotLoss(double prob_trans_11, double prob_trans_01, uint64_t seed);
+  ~GilbertElliotLoss() override;
+  bool Lost(int now_ms) override;
+
+ private:
+  // Prob. of losing current packet, when previous packet is lost.
+  double prob_trans_11_;
+  // Prob. of losing current packet, when previous packet is not lost.
+  double prob_trans_01_;
+  bool lost_last_;
+  std::unique_ptr<UniformLoss> uniform_loss_model_;
+};
+
+struct FixedLossEvent {
+  int start_ms;
+  int duration_ms;
+  FixedLossEvent(int start_ms, int duration_ms)
+      : start_ms(start_ms), duration_ms(duration_ms) {}
+};
+
+struct FixedLossEventCmp {
+  bool operator()(const FixedLossEvent& l_event,
+                  const FixedLossEvent& r_event) const {
+    return l_event.start_ms < r_event.start_ms;
+  }
+};
+
+class FixedLossModel : public LossModel {
+ public:
+  FixedLossModel(std::set<FixedLossEvent, FixedLossEventCmp> loss_events);
+  ~FixedLossModel() override;
+  bool Lost(int now_ms) override;
+
+ private:
+  std::set<FixedLossEvent, FixedLossEventCmp> loss_events_;
+  std::set<FixedLossEvent, FixedLossEventCmp>::iterator loss_events_it_;
+};
+
+// Replays a recorded loss trace, one entry per call to Lost(). Packets past the
+// end of the trace are not lost.
+class TraceLossModel : public LossModel {
+ public:
+  explicit TraceLossModel(std::vector<bool> trace);
+  ~TraceLossModel() override;
+  bool Lost(int now_ms) override;
+
+  // Reads a trace with one packet per line, where 0 means received and
+  // anything else means lost (the format of opus_ng/high_is_lost.txt).
+  // Returns nullptr if the file can not be opened.
+  static std::unique_ptr<TraceLossModel> FromFile(absl::string_view file_name);
+
+  size_t size() const { return trace_.size(); }
+  // Fraction of lost packets in the trace.
+  double loss_rate() const;
+
+ private:
+  const std::vector<bool> trace_;
+  size_t next_ = 0;
+};
+
+// Returns a model that loses packets at `loss_rate` (0 to 1) in bursts of
+// `mean_burst_length` packets on average. A mean burst length of 1 gives
+// independent (uniform) losses; longer bursts use a two-state Gilbert-Elliot
+// chain.
+std::unique_ptr<LossModel> CreateBurstLossModel(double loss_rate,
+                                                double mean_burst_length,
+                                                uint64_t seed);
+
+// Calculates the transition probability from no-loss state to itself in a
+// modified Gilbert Elliot packet loss model. The result is to achieve the
+// target packet loss rate `loss_rate`, when a packet is not lost only if all
+// `units` drawings within the duration of the packet result in no-loss.
+double ProbTrans00Solver(int units, double loss_rate, double prob_trans_10);
+
+class JitterModel {
+ public:
+  virtual ~JitterModel() {}
+  // Returns the network delay of a packet sent at `send_time_ms`. Must be
+  // called in send order.
+  virtual int DelayMs(int send_time_ms) = 0;
+};
+
+// Delay that follows a first order autoregressive process around
+// `mean_delay_ms`, so that consecutive packets see similar delays, as on a
+// queueing network path. `correlation` (0 to 1) is the correlation between
+// the delays of consecutive packets. Delays never go below zero.
+class CorrelatedJitter : public JitterModel {
+ public:
+  CorrelatedJitter(int mean_delay_ms,
+                   int stddev_ms,
+                   double correlation,
+                   uint64_t seed);
+  ~CorrelatedJitter() override;
+  int DelayMs(int send_time_ms) override;
+
+ private:
+  const int mean_delay_ms_;
+  const double stddev_ms_;
+  const double correlation_;
+  double deviation_ms_ = 0.0;
+  Random random_;
+};
+
+// Replays a recorded delay trace, one delay in milliseconds per packet. The
+// last delay is repeated past the end of the trace.
+class TraceJitterModel : public JitterModel {
+ public:
+  explicit TraceJitterModel(std::vector<int> delays_ms);
+  ~TraceJitterModel() override;
+  int DelayMs(int send_time_ms) override;
+
+  // Reads a trace with one delay in milliseconds per line. Returns nullptr if
+  // the file can not be opened or holds no delays.
+  static std::unique_ptr<TraceJitterModel> FromFile(
+      absl::string_view file_name);
+
+ private:
+  const std::vector<int> delays_ms_;
+  size_t next_ = 0;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_TOOLS_CHANNEL_MODEL_H_
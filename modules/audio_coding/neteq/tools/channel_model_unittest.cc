@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Unit tests for the loss and jitter models in channel_model.h.
+
+#include "modules/audio_coding/neteq/tools/channel_model.h"
+
+#include <cmath>
+#include <memory>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+constexpr int kNumPackets = 100000;
+constexpr uint64_t kSeed = 17;
+}  // namespace
+
+TEST(ChannelModel, BurstLossRateAndBurstLength) {
+  constexpr double kLossRate = 0.1;
+  constexpr double kBurstLength = 4.0;
+  std::unique_ptr<LossModel> model =
+      CreateBurstLossModel(kLossRate, kBurstLength, kSeed);
+  int lost = 0;
+  int bursts = 0;
+  bool lost_last = false;
+  for (int i = 0; i < kNumPackets; ++i) {
+    const bool lost_now = model->Lost(i * 20);
+    lost += lost_now;
+    bursts += lost_now && !lost_last;
+    lost_last = lost_now;
+  }
+  EXPECT_NEAR(kLossRate, static_cast<double>(lost) / kNumPackets, 0.01);
+  ASSERT_GT(bursts, 0);
+  EXPECT_NEAR(kBurstLength, static_cast<double>(lost) / bursts, 0.3);
+}
+
+TEST(ChannelModel, NoLossForZeroLossRate) {
+  std::unique_ptr<LossModel> model = CreateBurstLossModel(0.0, 1.0, kSeed);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_FALSE(model->Lost(i * 20));
+}
+
+TEST(ChannelModel, SameSeedGivesSameLosses) {
+  std::unique_ptr<LossModel> a = CreateBurstLossModel(0.2, 2.0, kSeed);
+  std::unique_ptr<LossModel> b = CreateBurstLossModel(0.2, 2.0, kSeed);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(a->Lost(i * 20), b->Lost(i * 20));
+}
+
+TEST(ChannelModel, TraceLossReplaysTrace) {
+  TraceLossModel model({false, true, true, false});
+  EXPECT_DOUBLE_EQ(0.5, model.loss_rate());
+  EXPECT_FALSE(model.Lost(0));
+  EXPECT_TRUE(model.Lost(20));
+  EXPECT_TRUE(model.Lost(40));
+  EXPECT_FALSE(model.Lost(60));
+  // Past the end of the trace nothing is lost.
+  EXPECT_FALSE(model.Lost(80));
+}
+
+TEST(ChannelModel, CorrelatedJitterStatistics) {
+  constexpr int kMeanDelayMs = 100;
+  constexpr int kStddevMs = 20;
+  CorrelatedJitter model(kMeanDelayMs, kStddevMs, 0.9, kSeed);
+  double sum = 0.0;
+  double sum_squares = 0.0;
+  double sum_step_squares = 0.0;
+  int last_delay = kMeanDelayMs;
+  for (int i = 0; i < kNumPackets; ++i) {
+    const int delay = model.DelayMs(i * 20);
+    ASSERT_GE(delay, 0);
+    sum += delay;
+    sum_squares += delay * delay;
+    sum_step_squares += (delay - last_delay) * (delay - last_delay);
+    last_delay = delay;
+  }
+  const double mean = sum / kNumPackets;
+  EXPECT_NEAR(kMeanDelayMs, mean, 2.0);
+  EXPECT_NEAR(kStddevMs, std::sqrt(sum_squares / kNumPackets - mean * mean),
+              2.0);
+  // Consecutive delays are correlated, so steps are smaller than the spread.
+  EXPECT_LT(std::sqrt(sum_step_squares / kNumPackets), kStddevMs);
+}
+
+TEST(ChannelModel, TraceJitterRepeatsLastDelay) {
+  TraceJitterModel model({10, 30});
+  EXPECT_EQ(10, model.DelayMs(0));
+  EXPECT_EQ(30, model.DelayMs(20));
+  EXPECT_EQ(30, model.DelayMs(40));
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,531 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Encodes a PCM file with Opus, applies simulated packet loss and jitter, and
+// decodes it with NetEq, for every combination of loss profile, DRED duration
+// and FEC setting given on the command line. The combinations run in parallel
+// on all cores. For each one, the tool reports the decoder CPU use, the share
+// of concealed audio and a rough perceptual quality estimate.
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/strings/str_split.h"
+#include "api/audio/audio_frame.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/opus/audio_encoder_opus.h"
+#include "api/neteq/neteq.h"
+#include "common_audio/real_fourier.h"
+#include "modules/audio_coding/neteq/default_neteq_factory.h"
+#include "modules/audio_coding/neteq/tools/channel_model.h"
+#include "modules/audio_coding/neteq/tools/parallel_job_runner.h"
+#include "modules/audio_coding/neteq/tools/resample_input_audio_file.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/string_to_number.h"
+#include "system_wrappers/include/clock.h"
+
+ABSL_FLAG(int, input_sample_rate, 16000, "Sample rate of the input file in Hz");
+
+ABSL_FLAG(std::string,
+          loss,
+          "0,5,10,20",
+          "Comma separated packet loss percentages");
+
+ABSL_FLAG(std::string,
+          burst_length,
+          "1,4",
+          "Comma separated mean loss burst lengths in packets");
+
+ABSL_FLAG(std::string,
+          loss_file,
+          "",
+          "Comma separated loss traces to evaluate in addition to the random "
+          "loss profiles, in the format of rtp_apply_loss --loss_file");
+
+ABSL_FLAG(int,
+          jitter_ms,
+          0,
+          "Standard deviation of the network delay in milliseconds");
+
+ABSL_FLAG(float,
+          jitter_correlation,
+          0.9,
+          "Correlation between the delays of consecutive packets");
+
+ABSL_FLAG(std::string,
+          dred,
+          "0,10,50,100",
+          "Comma separated amounts of Deep REDundancy (in units of 10 msec. "
+          "frames)");
+
+ABSL_FLAG(std::string, fec, "0,1", "Comma separated Opus FEC settings");
+
+ABSL_FLAG(int, bitrate, 32000, "Opus bitrate in bps");
+
+ABSL_FLAG(int, frame_len, 20, "Opus frame length in ms");
+
+ABSL_FLAG(bool,
+          enable_lazy_dred,
+          false,
+          "Parse DRED at playout time instead of at packet insertion");
+
+ABSL_FLAG(int, threads, 0, "Number of worker threads - if 0 use all cores");
+
+ABSL_FLAG(unsigned int, seed, 1, "Seed for the loss and jitter models");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr int kRtpTimestampRateKhz = 48;
+constexpr size_t kSamplesPer10Ms = kSampleRateHz / 100;
+constexpr int kOutputPeriodMs = 10;
+constexpr int kPayloadType = 111;
+constexpr uint32_t kSsrc = 0x12345678;
+// Time to keep pulling audio after the last packet has arrived.
+constexpr int kTailMs = 500;
+
+// Quality estimate: log band energies of 20 ms frames every 10 ms.
+constexpr int kFftOrder = 10;
+constexpr size_t kFftLength = 1 << kFftOrder;
+constexpr size_t kWindowLength = 2 * kSamplesPer10Ms;
+constexpr int kNumBands = 24;
+constexpr float kMinBandHz = 100.f;
+constexpr float kMaxBandHz = 20000.f;
+// Frames more than this far below the loudest frame of the reference count as
+// silence and are not scored.
+constexpr float kActivityThresholdDb = 40.f;
+// How far, in frames, the alignment may move between consecutive frames.
+constexpr int kMaxLagStepFrames = 2;
+// Log-spectral distance mapped to the bottom of the quality scale.
+constexpr float kMaxDistanceDb = 20.f;
+
+struct LossProfile {
+  std::string name;
+  double loss_rate = 0.0;
+  double burst_length = 1.0;
+  std::string trace_file;
+};
+
+struct Job {
+  const LossProfile* profile;
+  int dred;
+  bool fec;
+};
+
+struct Result {
+  double bitrate_bps = 0.0;
+  double decode_cpu_percent = 0.0;
+  double concealment_ratio = 0.0;
+  double distance_db = 0.0;
+  double quality = 0.0;
+};
+
+struct EncodedPacket {
+  uint16_t sequence_number;
+  uint32_t timestamp;
+  int send_time_ms;
+  rtc::Buffer payload;
+};
+
+struct DecodedAudio {
+  std::vector<int16_t> samples;
+  int64_t cpu_time_ns = 0;
+  NetEqLifetimeStatistics stats;
+};
+
+using BandEnergies = std::array<float, kNumBands>;
+
+template <typename T>
+std::vector<T> ParseList(absl::string_view list) {
+  std::vector<T> values;
+  for (absl::string_view item : absl::StrSplit(list, ',', absl::SkipEmpty())) {
+    absl::optional<T> value = rtc::StringToNumber<T>(item);
+    RTC_CHECK(value) << "Invalid list entry: " << item;
+    values.push_back(*value);
+  }
+  return values;
+}
+
+std::vector<int16_t> ReadInput(absl::string_view file_name) {
+  ResampleInputAudioFile file(file_name, absl::GetFlag(FLAGS_input_sample_rate),
+                              kSampleRateHz, /*loop_at_end=*/false);
+  std::vector<int16_t> audio;
+  int16_t block[kSamplesPer10Ms];
+  while (file.Read(kSamplesPer10Ms, block)) {
+    audio.insert(audio.end(), block, block + kSamplesPer10Ms);
+  }
+  return audio;
+}
+
+std::vector<EncodedPacket> Encode(const std::vector<int16_t>& audio,
+                                  const Job& job,
+                                  double expected_loss_rate) {
+  AudioEncoderOpusConfig config;
+  config.frame_size_ms = absl::GetFlag(FLAGS_frame_len);
+  config.bitrate_bps = absl::GetFlag(FLAGS_bitrate);
+  config.fec_enabled = job.fec;
+  config.dred = job.dred;
+  RTC_CHECK(config.IsOk());
+  std::unique_ptr<AudioEncoder> encoder =
+      AudioEncoderOpus::MakeAudioEncoder(config, kPayloadType);
+  // FEC and DRED only spend bits when the encoder expects loss.
+  encoder->OnReceivedUplinkPacketLossFraction(expected_loss_rate);
+
+  std::vector<EncodedPacket> packets;
+  uint16_t sequence_number = 0;
+  uint32_t rtp_timestamp = 0;
+  for (size_t pos = 0; pos + kSamplesPer10Ms <= audio.size();
+       pos += kSamplesPer10Ms) {
+    rtc::Buffer encoded;
+    AudioEncoder::EncodedInfo info = encoder->Encode(
+        rtp_timestamp,
+        rtc::ArrayView<const int16_t>(&audio[pos], kSamplesPer10Ms), &encoded);
+    rtp_timestamp += kSamplesPer10Ms;
+    if (info.encoded_bytes == 0)
+      continue;
+    packets.push_back(
+        {sequence_number++, info.encoded_timestamp,
+         static_cast<int>(info.encoded_timestamp / kRtpTimestampRateKhz),
+         std::move(encoded)});
+  }
+  return packets;
+}
+
+// Runs the packets that are not lost through NetEq, inserting each one when
+// it arrives, and returns the output audio.
+DecodedAudio Decode(const std::vector<EncodedPacket>& packets,
+                    const std::vector<bool>& lost,
+                    const std::vector<int>& arrival_time_ms) {
+  std::vector<size_t> arrival_order;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    if (!lost[i])
+      arrival_order.push_back(i);
+  }
+  std::stable_sort(arrival_order.begin(), arrival_order.end(),
+                   [&](size_t a, size_t b) {
+                     return arrival_time_ms[a] < arrival_time_ms[b];
+                   });
+  const int end_time_ms =
+      (packets.empty()
+           ? 0
+           : *std::max_element(arrival_time_ms.begin(), arrival_time_ms.end())) +
+      kTailMs;
+
+  SimulatedClock clock(0);
+  NetEq::Config config;
+  config.sample_rate_hz = kSampleRateHz;
+  config.enable_lazy_dred = absl::GetFlag(FLAGS_enable_lazy_dred);
+  std::unique_ptr<NetEq> neteq = DefaultNetEqFactory().CreateNetEq(
+      config, CreateBuiltinAudioDecoderFactory(), &clock);
+  RTC_CHECK(neteq->RegisterPayloadType(kPayloadType,
+                                       SdpAudioFormat("opus", 48000, 2)));
+
+  DecodedAudio decoded;
+  AudioFrame frame;
+  size_t next = 0;
+  for (int now_ms = 0; now_ms < end_time_ms; now_ms += kOutputPeriodMs) {
+    const int64_t start_ns = rtc::GetThreadCpuTimeNanos();
+    for (; next < arrival_order.size() &&
+           arrival_time_ms[arrival_order[next]] <= now_ms;
+         ++next) {
+      const EncodedPacket& packet = packets[arrival_order[next]];
+      RTPHeader header;
+      header.payloadType = kPayloadType;
+      header.sequenceNumber = packet.sequence_number;
+      header.timestamp = packet.timestamp;
+      header.ssrc = kSsrc;
+      neteq->InsertPacket(header, packet.payload);
+    }
+    bool muted;
+    RTC_CHECK_EQ(neteq->GetAudio(&frame, &muted), NetEq::kOK);
+    decoded.cpu_time_ns += rtc::GetThreadCpuTimeNanos() - start_ns;
+
+    const int16_t* data = frame.data();
+    for (size_t i = 0; i < frame.samples_per_channel_; ++i) {
+      decoded.samples.push_back(data[i * frame.num_channels_]);
+    }
+    clock.AdvanceTimeMilliseconds(kOutputPeriodMs);
+  }
+  decoded.stats = neteq->GetLifetimeStatistics();
+  return decoded;
+}
+
+// Returns the log energies, in dB, of `kNumBands` log-spaced bands for 20 ms
+// Hann windowed frames every 10 ms.
+std::vector<BandEnergies> ComputeBandEnergies(
+    const std::vector<int16_t>& audio) {
+  static const std::array<size_t, kNumBands + 1> band_edges = [] {
+    std::array<size_t, kNumBands + 1> edges;
+    for (int b = 0; b <= kNumBands; ++b) {
+      const float hz =
+          kMinBandHz * std::pow(kMaxBandHz / kMinBandHz,
+                                static_cast<float>(b) / kNumBands);
+      edges[b] = static_cast<size_t>(hz * kFftLength / kSampleRateHz);
+    }
+    return edges;
+  }();
+  std::unique_ptr<RealFourier> fft = RealFourier::Create(kFftOrder);
+  RealFourier::fft_real_scoper input = RealFourier::AllocRealBuffer(kFftLength);
+  RealFourier::fft_cplx_scoper spectrum =
+      RealFourier::AllocCplxBuffer(RealFourier::ComplexLength(kFftOrder));
+
+  std::vector<BandEnergies> energies;
+  for (size_t start = 0; start + kWindowLength <= audio.size();
+       start += kSamplesPer10Ms) {
+    std::fill(input.get(), input.get() + kFftLength, 0.f);
+    for (size_t i = 0; i < kWindowLength; ++i) {
+      const float window =
+          0.5f - 0.5f * std::cos(2.f * static_cast<float>(M_PI) * i /
+                                 (kWindowLength - 1));
+      input[i] = window * audio[start + i];
+    }
+    fft->Forward(input.get(), spectrum.get());
+    BandEnergies frame_energies;
+    for (int b = 0; b < kNumBands; ++b) {
+      float energy = 1.f;
+      for (size_t k = band_edges[b]; k < std::max(band_edges[b + 1],
+                                                   band_edges[b] + 1);
+           ++k) {
+        energy += std::norm(spectrum[k]);
+      }
+      frame_energies[b] = 10.f * std::log10(energy);
+    }
+    energies.push_back(frame_energies);
+  }
+  return energies;
+}
+
+float FrameEnergyDb(const BandEnergies& energies) {
+  float energy = 0.f;
+  for (float band_db : energies)
+    energy += std::pow(10.f, band_db / 10.f);
+  return 10.f * std::log10(energy);
+}
+
+float Distance(const BandEnergies& a, const BandEnergies& b) {
+  float sum = 0.f;
+  for (int i = 0; i < kNumBands; ++i)
+    sum += (a[i] - b[i]) * (a[i] - b[i]);
+  return std::sqrt(sum / kNumBands);
+}
+
+// Returns the mean log-spectral distance, in dB, between the active frames of
+// `reference` and `degraded`. NetEq may stretch or compress time differently
+// in the two, so each degraded frame is compared with the closest matching
+// reference frame near the previous alignment.
+float MeanSpectralDistanceDb(const std::vector<int16_t>& reference,
+                             const std::vector<int16_t>& degraded) {
+  const std::vector<BandEnergies> reference_energies =
+      ComputeBandEnergies(reference);
+  const std::vector<BandEnergies> degraded_energies =
+      ComputeBandEnergies(degraded);
+  if (reference_energies.empty() || degraded_energies.empty())
+    return 0.f;
+
+  float max_energy_db = -1e9f;
+  for (const BandEnergies& energies : reference_energies)
+    max_energy_db = std::max(max_energy_db, FrameEnergyDb(energies));
+  const int num_reference_frames = static_cast<int>(reference_energies.size());
+
+  int lag = 0;
+  float distance_sum = 0.f;
+  int scored_frames = 0;
+  for (int i = 0; i < static_cast<int>(degraded_energies.size()); ++i) {
+    float best_distance = 1e9f;
+    int best_lag = lag;
+    for (int candidate = lag - kMaxLagStepFrames;
+         candidate <= lag + kMaxLagStepFrames; ++candidate) {
+      const int j = i + candidate;
+      if (j < 0 || j >= num_reference_frames)
+        continue;
+      const float distance =
+          Distance(degraded_energies[i], reference_energies[j]);
+      if (distance < best_distance) {
+        best_distance = distance;
+        best_lag = candidate;
+      }
+    }
+    const int j = i + best_lag;
+    if (j < 0 || j >= num_reference_frames)
+      continue;
+    lag = best_lag;
+    if (FrameEnergyDb(reference_energies[j]) <
+        max_energy_db - kActivityThresholdDb) {
+      continue;
+    }
+    distance_sum += best_distance;
+    ++scored_frames;
+  }
+  return scored_frames > 0 ? distance_sum / scored_frames : 0.f;
+}
+
+Result RunJob(const std::vector<int16_t>& audio, const Job& job) {
+  const LossProfile& profile = *job.profile;
+  const uint64_t seed = absl::GetFlag(FLAGS_seed);
+
+  std::unique_ptr<LossModel> loss_model;
+  double expected_loss_rate = profile.loss_rate;
+  if (!profile.trace_file.empty()) {
+    std::unique_ptr<TraceLossModel> trace =
+        TraceLossModel::FromFile(profile.trace_file);
+    RTC_CHECK(trace) << "Failed to open " << profile.trace_file;
+    expected_loss_rate = trace->loss_rate();
+    loss_model = std::move(trace);
+  } else {
+    loss_model =
+        CreateBurstLossModel(profile.loss_rate, profile.burst_length, seed);
+  }
+  std::unique_ptr<JitterModel> jitter_model;
+  const int jitter_ms = absl::GetFlag(FLAGS_jitter_ms);
+  if (jitter_ms > 0) {
+    jitter_model = std::make_unique<CorrelatedJitter>(
+        2 * jitter_ms, jitter_ms, absl::GetFlag(FLAGS_jitter_correlation),
+        seed << 32);
+  }
+
+  const std::vector<EncodedPacket> packets =
+      Encode(audio, job, expected_loss_rate);
+  std::vector<bool> lost(packets.size());
+  std::vector<int> arrival_time_ms(packets.size());
+  size_t payload_bytes = 0;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    const int send_time_ms = packets[i].send_time_ms;
+    lost[i] = loss_model->Lost(send_time_ms);
+    arrival_time_ms[i] =
+        send_time_ms + (jitter_model ? jitter_model->DelayMs(send_time_ms) : 0);
+    payload_bytes += packets[i].payload.size();
+  }
+
+  // The reference sees the same delays, but no loss.
+  const DecodedAudio reference =
+      Decode(packets, std::vector<bool>(packets.size(), false),
+             arrival_time_ms);
+  const DecodedAudio degraded = Decode(packets, lost, arrival_time_ms);
+
+  Result result;
+  const double duration_ms =
+      static_cast<double>(audio.size()) * 1000 / kSampleRateHz;
+  const double output_duration_ms =
+      static_cast<double>(degraded.samples.size()) * 1000 / kSampleRateHz;
+  result.bitrate_bps = duration_ms > 0 ? payload_bytes * 8000 / duration_ms : 0;
+  result.decode_cpu_percent =
+      output_duration_ms > 0
+          ? degraded.cpu_time_ns / (output_duration_ms * 1e4)
+          : 0;
+  result.concealment_ratio =
+      degraded.stats.total_samples_received > 0
+          ? static_cast<double>(degraded.stats.concealed_samples) /
+                degraded.stats.total_samples_received
+          : 0;
+  result.distance_db =
+      MeanSpectralDistanceDb(reference.samples, degraded.samples);
+  // Map the distance onto a MOS-like 1 to 4.5 scale, where a transparent
+  // decode scores 4.5. This is only meant for comparing settings against each
+  // other, not as an absolute quality measure.
+  result.quality =
+      1.0 + 3.5 * std::max(0.0, 1.0 - result.distance_db / kMaxDistanceDb);
+  return result;
+}
+
+int RunEvaluation(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "Runs the Opus encode, packet loss and NetEq decode pipeline for a grid "
+      "of loss profiles, DRED durations and FEC settings, and prints decode "
+      "CPU, concealment ratio and a quality estimate for each.\n\n"
+      "usage - neteq_dred_eval <input.pcm> --input_sample_rate <hz> --loss "
+      "<percent,...> --burst_length <packets,...> --dred <frames,...> --fec "
+      "<0|1,...>");
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() != 2) {
+    fwrite(absl::ProgramUsageMessage().data(),
+           absl::ProgramUsageMessage().size(), 1, stderr);
+    fprintf(stderr, "\n\nfor help - neteq_dred_eval --help\n\n");
+    return -1;
+  }
+
+  RTC_CHECK_NE(absl::GetFlag(FLAGS_seed), 0u) << "The seed must be non-zero";
+  const std::vector<int16_t> audio = ReadInput(args[1]);
+  RTC_CHECK(!audio.empty()) << "No audio in " << args[1];
+
+  std::vector<LossProfile> profiles;
+  for (double loss_percent : ParseList<double>(absl::GetFlag(FLAGS_loss))) {
+    RTC_CHECK(loss_percent >= 0 && loss_percent < 100);
+    for (double burst_length :
+         ParseList<double>(absl::GetFlag(FLAGS_burst_length))) {
+      RTC_CHECK_GE(burst_length, 1.0);
+      LossProfile profile;
+      char name[64];
+      snprintf(name, sizeof(name), "loss%g%%/burst%g", loss_percent,
+               burst_length);
+      profile.name = name;
+      profile.loss_rate = loss_percent / 100;
+      profile.burst_length = burst_length;
+      profiles.push_back(profile);
+      if (loss_percent == 0)
+        break;
+    }
+  }
+  for (absl::string_view trace_file :
+       absl::StrSplit(absl::GetFlag(FLAGS_loss_file), ',', absl::SkipEmpty())) {
+    LossProfile profile;
+    profile.name = std::string(trace_file);
+    profile.trace_file = std::string(trace_file);
+    profiles.push_back(profile);
+  }
+
+  std::vector<Job> jobs;
+  for (const LossProfile& profile : profiles) {
+    for (int dred : ParseList<int>(absl::GetFlag(FLAGS_dred))) {
+      for (int fec : ParseList<int>(absl::GetFlag(FLAGS_fec))) {
+        jobs.push_back({&profile, dred, fec != 0});
+      }
+    }
+  }
+
+  std::vector<Result> results(jobs.size());
+  RunJobsInParallel(jobs.size(), absl::GetFlag(FLAGS_threads),
+                    "neteq_dred_eval", [&](size_t job) {
+                      results[job] = RunJob(audio, jobs[job]);
+                    });
+
+  printf(
+      "loss_profile,dred_ms,fec,bitrate_bps,decode_cpu_percent,"
+      "concealment_ratio,spectral_distance_db,quality\n");
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    const Result& result = results[i];
+    printf("%s,%d,%d,%.0f,%.3f,%.4f,%.2f,%.2f\n", jobs[i].profile->name.c_str(),
+           jobs[i].dred * 10, jobs[i].fec, result.bitrate_bps,
+           result.decode_cpu_percent, result.concealment_ratio,
+           result.distance_db, result.quality);
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  return webrtc::test::RunEvaluation(argc, argv);
+}
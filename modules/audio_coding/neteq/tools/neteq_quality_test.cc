@@ -123,49 +123,6 @@ static bool ValidateFilename(absl::string_view value, bool is_output) {
   return true;
 }
 
-// ProbTrans00Solver() is to calculate the transition probability from no-loss
-// state to itself in a modified Gilbert Elliot packet loss model. The result is
-// to achieve the target packet loss rate `loss_rate`, when a packet is not
-// lost only if all `units` drawings within the duration of the packet result in
-// no-loss.
-static double ProbTrans00Solver(int units,
-                                double loss_rate,
-                                double prob_trans_10) {
-  if (units == 1)
-    return prob_trans_10 / (1.0f - loss_rate) - prob_trans_10;
-  // 0 == prob_trans_00 ^ (units - 1) + (1 - loss_rate) / prob_trans_10 *
-  //     prob_trans_00 - (1 - loss_rate) * (1 + 1 / prob_trans_10).
-  // There is a unique solution between 0.0 and 1.0, due to the monotonicity and
-  // an opposite sign at 0.0 and 1.0.
-  // For simplicity, we reformulate the equation as
-  //     f(x) = x ^ (units - 1) + a x + b.
-  // Its derivative is
-  //     f'(x) = (units - 1) x ^ (units - 2) + a.
-  // The derivative is strictly greater than 0 when x is between 0 and 1.
-  // We use Newton's method to solve the equation, iteration is
-  //     x(k+1) = x(k) - f(x) / f'(x);
-  const double kPrecision = 0.001f;
-  const int kIterations = 100;
-  const double a = (1.0f - loss_rate) / prob_trans_10;
-  const double b = (loss_rate - 1.0f) * (1.0f + 1.0f / prob_trans_10);
-  double x = 0.0;  // Starting point;
-  double f = b;
-  double f_p;
-  int iter = 0;
-  while ((f >= kPrecision || f <= -kPrecision) && iter < kIterations) {
-    f_p = (units - 1.0f) * std::pow(x, units - 2) + a;
-    x -= f / f_p;
-    if (x > 1.0f) {
-      x = 1.0f;
-    } else if (x < 0.0f) {
-      x = 0.0f;
-    }
-    f = std::pow(x, units - 1) + a * x + b;
-    iter++;
-  }
-  return x;
-}
-
 NetEqQualityTest::NetEqQualityTest(
     int block_duration_ms,
     int in_sampling_khz,
@@ -257,60 +214,6 @@ NetEqQualityTest::~NetEqQualityTest() {
   log_file_.close();
 }
 
-bool NoLoss::Lost(int now_ms) {
-  return false;
-}
-
-UniformLoss::UniformLoss(double loss_rate) : loss_rate_(loss_rate) {}
-
-bool UniformLoss::Lost(int now_ms) {
-  int drop_this = rand();
-  return (drop_this < loss_rate_ * RAND_MAX);
-}
-
-GilbertElliotLoss::GilbertElliotLoss(double prob_trans_11, double prob_trans_01)
-    : prob_trans_11_(prob_trans_11),
-      prob_trans_01_(prob_trans_01),
-      lost_last_(false),
-      uniform_loss_model_(new UniformLoss(0)) {}
-
-GilbertElliotLoss::~GilbertElliotLoss() {}
-
-bool GilbertElliotLoss::Lost(int now_ms) {
-  // Simulate bursty channel (Gilbert model).
-  // (1st order) Markov chain model with memory of the previous/last
-  // packet state (lost or received).
-  if (lost_last_) {
-    // Previous packet was not received.
-    uniform_loss_model_->set_loss_rate(prob_trans_11_);
-    return lost_last_ = uniform_loss_model_->Lost(now_ms);
-  } else {
-    uniform_loss_model_->set_loss_rate(prob_trans_01_);
-    return lost_last_ = uniform_loss_model_->Lost(now_ms);
-  }
-}
-
-FixedLossModel::FixedLossModel(
-    std::set<FixedLossEvent, FixedLossEventCmp> loss_events)
-    : loss_events_(loss_events) {
-  loss_events_it_ = loss_events_.begin();
-}
-
-FixedLossModel::~FixedLossModel() {}
-
-bool FixedLossModel::Lost(int now_ms) {
-  if (loss_events_it_ != loss_events_.end() &&
-      now_ms > loss_events_it_->start_ms) {
-    if (now_ms <= loss_events_it_->start_ms + loss_events_it_->duration_ms) {
-      return true;
-    } else {
-      ++loss_events_it_;
-      return false;
-    }
-  }
-  return false;
-}
-
 void NetEqQualityTest::SetUp() {
   ASSERT_TRUE(neteq_->RegisterPayloadType(kPayloadType, audio_format_));
   rtp_generator_->set_drift_factor(drift_factor_);
@@ -326,7 +229,7 @@ void NetEqQualityTest::SetUp() {
       // 1 - packet_loss_rate.
       double unit_loss_rate =
           (1.0 - std::pow(1.0 - 0.01 * packet_loss_rate_, 1.0 / units));
-      loss_model_.reset(new UniformLoss(unit_loss_rate));
+      loss_model_.reset(new UniformLoss(unit_loss_rate, kInitSeed));
       break;
     }
     case kGilbertElliotLoss: {
@@ -352,8 +255,8 @@ void NetEqQualityTest::SetUp() {
       double prob_trans_10 =
           1.0f * kPacketLossTimeUnitMs / absl::GetFlag(FLAGS_burst_length);
       double prob_trans_00 = ProbTrans00Solver(units, loss_rate, prob_trans_10);
-      loss_model_.reset(
-          new GilbertElliotLoss(1.0f - prob_trans_10, 1.0f - prob_trans_00));
+      loss_model_.reset(new GilbertElliotLoss(
+          1.0f - prob_trans_10, 1.0f - prob_trans_00, kInitSeed));
       break;
     }
     case kFixedLoss: {
@@ -380,9 +283,6 @@ void NetEqQualityTest::SetUp() {
       break;
     }
   }
-
-  // Make sure that the packet loss profile is same for all derived tests.
-  srand(kInitSeed);
 }
 
 std::ofstream& NetEqQualityTest::Log() {
@@ -8,15 +8,25 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "modules/audio_coding/neteq/tools/audio_checksum.h"
+#include "modules/audio_coding/neteq/tools/neteq_stats_getter.h"
 #include "modules/audio_coding/neteq/tools/neteq_test.h"
 #include "modules/audio_coding/neteq/tools/neteq_test_factory.h"
+#include "modules/audio_coding/neteq/tools/parallel_job_runner.h"
 #include "rtc_base/strings/string_builder.h"
 #include "system_wrappers/include/field_trial.h"
 #include "test/field_trial.h"
@@ -155,6 +165,30 @@ ABSL_FLAG(bool,
           enable_fast_accelerate,
           false,
           "Enables jitter buffer fast accelerate");
+ABSL_FLAG(bool,
+          enable_lazy_dred,
+          false,
+          "Defers DRED parsing until a loss is confirmed at playout time");
+ABSL_FLAG(std::string,
+          batch_manifest,
+          "",
+          "Runs a batch of simulations instead of a single one. The manifest "
+          "lists one input file per line, optionally followed by an output "
+          "audio file. Empty lines and lines starting with # are ignored.");
+ABSL_FLAG(int,
+          batch_threads,
+          0,
+          "Number of simulations to run in parallel in batch mode. 0 means "
+          "one per CPU core.");
+ABSL_FLAG(bool,
+          batch_checksum,
+          false,
+          "In batch mode, reports the MD5 checksum of each output audio.");
+ABSL_FLAG(std::string,
+          batch_report,
+          "",
+          "In batch mode, writes the CSV report to this file instead of "
+          "stdout. Other messages go to stderr in batch mode.");
 
 namespace {
 
@@ -288,6 +322,156 @@ absl::optional<std::string> CreateOptionalOutputFileName(
   return absl::nullopt;
 }
 
+struct BatchJob {
+  std::string input_filename;
+  std::string output_audio_filename;
+};
+
+struct BatchResult {
+  bool ok = false;
+  int64_t duration_ms = 0;
+  std::string checksum;
+  webrtc::test::NetEqStatsGetter::Stats stats;
+  webrtc::NetEqLifetimeStatistics lifetime_stats;
+};
+
+// Reads a batch manifest. Returns false if the file can not be opened.
+bool ReadBatchManifest(absl::string_view file_name,
+                       std::vector<BatchJob>* jobs) {
+  std::ifstream manifest{std::string(file_name)};
+  if (!manifest.good())
+    return false;
+  std::string line;
+  while (std::getline(manifest, line)) {
+    std::vector<std::string> fields =
+        absl::StrSplit(line, absl::ByAnyChar(" \t\r"), absl::SkipEmpty());
+    if (fields.empty() || fields[0][0] == '#')
+      continue;
+    jobs->push_back({fields[0], fields.size() > 1 ? fields[1] : ""});
+  }
+  return true;
+}
+
+BatchResult RunBatchJob(const BatchJob& job, TestConfig config, bool checksum) {
+  BatchResult result;
+  // Each simulation gets its own factory, which owns the callbacks and
+  // statistics of the test it creates.
+  webrtc::test::NetEqTestFactory factory;
+  config.output_audio_filename = absl::nullopt;
+  if (!job.output_audio_filename.empty())
+    config.output_audio_filename = job.output_audio_filename;
+  std::unique_ptr<webrtc::test::AudioChecksum> audio_checksum;
+  if (checksum) {
+    audio_checksum = std::make_unique<webrtc::test::AudioChecksum>();
+    config.output_tap = audio_checksum.get();
+  }
+  std::unique_ptr<webrtc::test::NetEqTest> test =
+      factory.InitializeTestFromFile(job.input_filename,
+                                     /*factory=*/nullptr, config);
+  if (!test)
+    return result;
+  result.duration_ms = test->Run();
+  result.stats = factory.stats_getter()->AverageStats();
+  result.lifetime_stats = test->LifetimeStats();
+  if (audio_checksum)
+    result.checksum = audio_checksum->Finish();
+  result.ok = true;
+  return result;
+}
+
+// Runs the jobs on `num_threads` worker threads, see RunJobsInParallel().
+std::vector<BatchResult> RunBatch(const std::vector<BatchJob>& jobs,
+                                  const TestConfig& config,
+                                  int num_threads,
+                                  bool checksum) {
+  std::vector<BatchResult> results(jobs.size());
+  webrtc::test::RunJobsInParallel(
+      jobs.size(), num_threads, "neteq_rtpplay", [&](size_t job) {
+        results[job] = RunBatchJob(jobs[job], config, checksum);
+      });
+  return results;
+}
+
+// Writes one CSV row per job, followed by a row aggregating all successful
+// jobs. Rates and mean waiting times are weighted by the output duration.
+void WriteBatchReport(const std::vector<BatchJob>& jobs,
+                      const std::vector<BatchResult>& results,
+                      FILE* out) {
+  fprintf(out,
+          "input,status,duration_ms,checksum,packet_loss_rate,expand_rate,"
+          "speech_expand_rate,preemptive_rate,accelerate_rate,"
+          "secondary_decoded_rate,secondary_discarded_rate,"
+          "mean_waiting_time_ms,max_waiting_time_ms,concealment_events,"
+          "concealed_samples,total_samples_received\n");
+  auto write_row = [out](absl::string_view input, absl::string_view status,
+                         int64_t duration_ms, absl::string_view checksum,
+                         const webrtc::test::NetEqStatsGetter::Stats& stats,
+                         const webrtc::NetEqLifetimeStatistics& lifetime) {
+    fprintf(out,
+            "%.*s,%.*s,%" PRId64
+            ",%.*s,%f,%f,%f,%f,%f,%f,%f,%.1f,%.0f,%" PRIu64 ",%" PRIu64
+            ",%" PRIu64 "\n",
+            static_cast<int>(input.size()), input.data(),
+            static_cast<int>(status.size()), status.data(), duration_ms,
+            static_cast<int>(checksum.size()), checksum.data(),
+            stats.packet_loss_rate, stats.expand_rate, stats.speech_expand_rate,
+            stats.preemptive_rate, stats.accelerate_rate,
+            stats.secondary_decoded_rate, stats.secondary_discarded_rate,
+            stats.mean_waiting_time_ms, stats.max_waiting_time_ms,
+            lifetime.concealment_events, lifetime.concealed_samples,
+            lifetime.total_samples_received);
+  };
+
+  int64_t total_duration_ms = 0;
+  webrtc::test::NetEqStatsGetter::Stats total;
+  webrtc::NetEqLifetimeStatistics total_lifetime;
+  int failed = 0;
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    const BatchResult& result = results[i];
+    write_row(jobs[i].input_filename, result.ok ? "ok" : "failed",
+              result.duration_ms, result.checksum, result.stats,
+              result.lifetime_stats);
+    if (!result.ok) {
+      ++failed;
+      continue;
+    }
+    const double weight = static_cast<double>(result.duration_ms);
+    total_duration_ms += result.duration_ms;
+    total.packet_loss_rate += weight * result.stats.packet_loss_rate;
+    total.expand_rate += weight * result.stats.expand_rate;
+    total.speech_expand_rate += weight * result.stats.speech_expand_rate;
+    total.preemptive_rate += weight * result.stats.preemptive_rate;
+    total.accelerate_rate += weight * result.stats.accelerate_rate;
+    total.secondary_decoded_rate +=
+        weight * result.stats.secondary_decoded_rate;
+    total.secondary_discarded_rate +=
+        weight * result.stats.secondary_discarded_rate;
+    total.mean_waiting_time_ms += weight * result.stats.mean_waiting_time_ms;
+    total.max_waiting_time_ms = std::max(total.max_waiting_time_ms,
+                                         result.stats.max_waiting_time_ms);
+    total_lifetime.concealment_events +=
+        result.lifetime_stats.concealment_events;
+    total_lifetime.concealed_samples += result.lifetime_stats.concealed_samples;
+    total_lifetime.total_samples_received +=
+        result.lifetime_stats.total_samples_received;
+  }
+  if (total_duration_ms > 0) {
+    const double norm = 1.0 / total_duration_ms;
+    total.packet_loss_rate *= norm;
+    total.expand_rate *= norm;
+    total.speech_expand_rate *= norm;
+    total.preemptive_rate *= norm;
+    total.accelerate_rate *= norm;
+    total.secondary_decoded_rate *= norm;
+    total.secondary_discarded_rate *= norm;
+    total.mean_waiting_time_ms *= norm;
+  }
+  rtc::StringBuilder status;
+  status << failed << " failed";
+  write_row("total", status.str(), total_duration_ms, "", total,
+            total_lifetime);
+}
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
@@ -296,12 +480,19 @@ int main(int argc, char* argv[]) {
   std::string usage =
       "Tool for decoding an RTP dump file using NetEq.\n"
       "Example usage:\n"
-      "./neteq_rtpplay input.rtp [output.{pcm, wav}]\n";
+      "./neteq_rtpplay input.rtp [output.{pcm, wav}]\n"
+      "./neteq_rtpplay --batch_manifest=manifest.txt [--batch_checksum]\n";
   if (absl::GetFlag(FLAGS_codec_map)) {
     PrintCodecMapping();
     exit(0);
   }
-  if (args.size() != 2 &&
+  const std::string batch_manifest = absl::GetFlag(FLAGS_batch_manifest);
+  if (!batch_manifest.empty() && args.size() != 1) {
+    std::cout << "Error: input files are taken from --batch_manifest."
+              << std::endl;
+    exit(1);
+  }
+  if (batch_manifest.empty() && args.size() != 2 &&
       args.size() != 3) {  // The output audio file is optional.
     // Print usage information.
     std::cout << usage;
@@ -382,6 +573,7 @@ int main(int argc, char* argv[]) {
   config.max_nr_packets_in_buffer =
       absl::GetFlag(FLAGS_max_nr_packets_in_buffer);
   config.enable_fast_accelerate = absl::GetFlag(FLAGS_enable_fast_accelerate);
+  config.enable_lazy_dred = absl::GetFlag(FLAGS_enable_lazy_dred);
   if (!output_audio_filename.empty()) {
     config.output_audio_filename = output_audio_filename;
   }
@@ -401,6 +593,31 @@ int main(int argc, char* argv[]) {
     config.ssrc_filter = absl::make_optional(ssrc);
   }
 
+  if (!batch_manifest.empty()) {
+    RTC_CHECK(!config.textlog && !config.matlabplot && !config.pythonplot)
+        << "Text logs and plots are not supported in batch mode.";
+    std::vector<BatchJob> jobs;
+    RTC_CHECK(ReadBatchManifest(batch_manifest, &jobs))
+        << "Cannot open " << batch_manifest;
+    // The report carries the statistics of each job, and may go to stdout.
+    config.quiet_stdout = true;
+    const std::vector<BatchResult> results =
+        RunBatch(jobs, config, absl::GetFlag(FLAGS_batch_threads),
+                 absl::GetFlag(FLAGS_batch_checksum));
+
+    const std::string report_filename = absl::GetFlag(FLAGS_batch_report);
+    FILE* report =
+        report_filename.empty() ? stdout : fopen(report_filename.c_str(), "w");
+    RTC_CHECK(report) << "Cannot open " << report_filename;
+    WriteBatchReport(jobs, results, report);
+    if (report != stdout)
+      fclose(report);
+    const bool all_ok = std::all_of(
+        results.begin(), results.end(),
+        [](const BatchResult& result) { return result.ok; });
+    return all_ok ? 0 : 1;
+  }
+
   std::unique_ptr<webrtc::test::NetEqTest> test =
       factory.InitializeTestFromFile(/*input_filename=*/args[1],
                                      /*factory=*/nullptr, config);
@@ -136,6 +136,28 @@ CASE4_TEXTLOG=$TMP_DIR/case4.text_log.txt
 CASE4_PYPLOT=$TMP_DIR/case4.py
 CASE4_MATPLOT=$TMP_DIR/case4.m
 
+# Case 5. Batch mode, running the same input twice in parallel.
+CASE5_1_WAV=$TMP_DIR/case5_1.wav
+CASE5_2_WAV=$TMP_DIR/case5_2.wav
+CASE5_REPORT=$TMP_DIR/case5.csv
+echo "$TEST_RTC_EVENT_LOG $CASE5_1_WAV" > $TMP_DIR/case5_manifest.txt
+echo "$TEST_RTC_EVENT_LOG $CASE5_2_WAV" >> $TMP_DIR/case5_manifest.txt
+$BIN --batch_manifest $TMP_DIR/case5_manifest.txt  \
+    --batch_threads 2 --batch_report $CASE5_REPORT  \
+    --replacement_audio_file $INPUT_PCM_FILE  \
+    > $TMP_DIR/case5.stdout 2> /dev/null
+CASE5_RETURN_CODE=$?
+
+# Case 6. Batch mode with the report written to stdout, which must then only
+# carry the report. The report matches the one of case 5.
+CASE6_REPORT=$TMP_DIR/case6.csv
+echo "$TEST_RTC_EVENT_LOG" > $TMP_DIR/case6_manifest.txt
+echo "$TEST_RTC_EVENT_LOG" >> $TMP_DIR/case6_manifest.txt
+$BIN --batch_manifest $TMP_DIR/case6_manifest.txt  \
+    --batch_threads 2 --replacement_audio_file $INPUT_PCM_FILE  \
+    > $CASE6_REPORT 2> /dev/null
+CASE6_RETURN_CODE=$?
+
 # Tests.
 
 echo Check exit codes
@@ -144,6 +166,8 @@ test_exit_code_0 $CASE2_RETURN_CODE
 test_exit_code_not_0 $CASE3_1_RETURN_CODE
 test_exit_code_0 $CASE3_2_RETURN_CODE
 test_exit_code_0 $CASE4_RETURN_CODE
+test_exit_code_0 $CASE5_RETURN_CODE
+test_exit_code_0 $CASE6_RETURN_CODE
 
 echo Check that the expected output files exist
 test_file_exists $CASE1_TEXTLOG
@@ -155,9 +179,12 @@ test_file_exists $CASE4_PYPLOT
 test_file_exists $CASE1_MATPLOT
 test_file_exists $CASE3_2_MATPLOT
 test_file_exists $CASE4_MATPLOT
+test_file_exists $CASE5_REPORT
 
 echo Check that the same WAV file is produced
 test_file_checksums_match $CASE1_WAV $CASE4_WAV
+test_file_checksums_match $CASE1_WAV $CASE5_1_WAV
+test_file_checksums_match $CASE1_WAV $CASE5_2_WAV
 
 echo Check that the same text log is produced
 test_file_checksums_match $CASE1_TEXTLOG $CASE3_2_TEXTLOG
@@ -171,6 +198,9 @@ echo Check that the same matlab plot scripts is produced
 test_file_checksums_match $CASE1_MATPLOT $CASE3_2_MATPLOT
 test_file_checksums_match $CASE1_MATPLOT $CASE4_MATPLOT
 
+echo Check that the batch report on stdout matches the report file
+test_file_checksums_match $CASE5_REPORT $CASE6_REPORT
+
 # Clean up
 rm -fr $TMP_DIR
 
@@ -69,6 +69,26 @@ absl::optional<int> CodecSampleRate(
   return absl::nullopt;
 }
 
+// Writes the output audio to an owned sink and to a tap that is not owned.
+class TappedAudioSink : public AudioSink {
+ public:
+  TappedAudioSink(std::unique_ptr<AudioSink> sink, AudioSink* tap)
+      : sink_(std::move(sink)), fork_(sink_.get(), tap) {}
+
+  bool WriteArray(const int16_t* audio, size_t num_samples) override {
+    return fork_.WriteArray(audio, num_samples);
+  }
+
+ private:
+  const std::unique_ptr<AudioSink> sink_;
+  AudioSinkFork fork_;
+};
+
+// Returns the stream for informational messages.
+std::ostream& InfoStream(const NetEqTestFactory::Config& config) {
+  return config.quiet_stdout ? std::cerr : std::cout;
+}
+
 }  // namespace
 
 // A callback class which prints whenver the inserted packet stream changes
@@ -77,18 +97,19 @@ class SsrcSwitchDetector : public NetEqPostInsertPacket {
  public:
   // Takes a pointer to another callback object, which will be invoked after
   // this object finishes. This does not transfer ownership, and null is a
-  // valid value.
-  explicit SsrcSwitchDetector(NetEqPostInsertPacket* other_callback)
-      : other_callback_(other_callback) {}
+  // valid value. Messages are printed to `info_stream`.
+  SsrcSwitchDetector(NetEqPostInsertPacket* other_callback,
+                     std::ostream& info_stream)
+      : other_callback_(other_callback), info_stream_(info_stream) {}
 
   void AfterInsertPacket(const NetEqInput::PacketData& packet,
                          NetEq* neteq) override {
     if (last_ssrc_ && packet.header.ssrc != *last_ssrc_) {
-      std::cout << "Changing streams from 0x" << std::hex << *last_ssrc_
-                << " to 0x" << std::hex << packet.header.ssrc << std::dec
-                << " (payload type "
-                << static_cast<int>(packet.header.payloadType) << ")"
-                << std::endl;
+      info_stream_ << "Changing streams from 0x" << std::hex << *last_ssrc_
+                   << " to 0x" << std::hex << packet.header.ssrc << std::dec
+                   << " (payload type "
+                   << static_cast<int>(packet.header.payloadType) << ")"
+                   << std::endl;
     }
     last_ssrc_ = packet.header.ssrc;
     if (other_callback_) {
@@ -98,6 +119,7 @@ class SsrcSwitchDetector : public NetEqPostInsertPacket {
 
  private:
   NetEqPostInsertPacket* other_callback_;
+  std::ostream& info_stream_;
   absl::optional<uint32_t> last_ssrc_;
 };
 
@@ -155,7 +177,7 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTestFromFile(
     input = CreateNetEqEventLogInput(parsed_log, config.ssrc_filter);
   }
 
-  std::cout << "Input file: " << input_file_name << std::endl;
+  InfoStream(config) << "Input file: " << input_file_name << std::endl;
   if (!input) {
     std::cerr << "Error: Cannot open input file" << std::endl;
     return nullptr;
@@ -167,6 +189,7 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
     std::unique_ptr<NetEqInput> input,
     NetEqFactory* factory,
     const Config& config) {
+  std::ostream& info = InfoStream(config);
   if (input->ended()) {
     std::cerr << "Error: Input is empty" << std::endl;
     return nullptr;
@@ -179,8 +202,8 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
 
   // Skip some initial events/packets if requested.
   if (config.skip_get_audio_events > 0) {
-    std::cout << "Skipping " << config.skip_get_audio_events
-              << " get_audio events" << std::endl;
+    info << "Skipping " << config.skip_get_audio_events
+         << " get_audio events" << std::endl;
     if (!input->NextPacketTime() || !input->NextOutputEventTime()) {
       std::cerr << "No events found" << std::endl;
       return nullptr;
@@ -208,13 +231,13 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
     RTC_DCHECK(first_rtp_header);
     sample_rate_hz = CodecSampleRate(first_rtp_header->payloadType, config);
     if (sample_rate_hz) {
-      std::cout << "Found valid packet with payload type "
-                << static_cast<int>(first_rtp_header->payloadType)
-                << " and SSRC 0x" << std::hex << first_rtp_header->ssrc
-                << std::dec << std::endl;
+      info << "Found valid packet with payload type "
+           << static_cast<int>(first_rtp_header->payloadType)
+           << " and SSRC 0x" << std::hex << first_rtp_header->ssrc
+           << std::dec << std::endl;
       if (config.initial_dummy_packets > 0) {
-        std::cout << "Nr of initial dummy packets: "
-                  << config.initial_dummy_packets << std::endl;
+        info << "Nr of initial dummy packets: "
+             << config.initial_dummy_packets << std::endl;
         input = std::make_unique<InitialPacketInserterNetEqInput>(
             std::move(input), config.initial_dummy_packets, *sample_rate_hz);
       }
@@ -227,12 +250,12 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
     input->PopPacket();
   }
   if (!discarded_pt_and_ssrc.empty()) {
-    std::cout << "Discarded initial packets with the following payload types "
-                 "and SSRCs:"
-              << std::endl;
+    info << "Discarded initial packets with the following payload types "
+            "and SSRCs:"
+         << std::endl;
     for (const auto& d : discarded_pt_and_ssrc) {
-      std::cout << "PT " << d.first << "; SSRC 0x" << std::hex
-                << static_cast<int>(d.second) << std::dec << std::endl;
+      info << "PT " << d.first << "; SSRC 0x" << std::hex
+           << static_cast<int>(d.second) << std::dec << std::endl;
     }
   }
   if (!sample_rate_hz) {
@@ -245,20 +268,24 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
   std::unique_ptr<AudioSink> output;
   if (!config.output_audio_filename.has_value()) {
     output = std::make_unique<VoidAudioSink>();
-    std::cout << "No output audio file" << std::endl;
+    info << "No output audio file" << std::endl;
   } else if (config.output_audio_filename->size() >= 4 &&
              config.output_audio_filename->substr(
                  config.output_audio_filename->size() - 4) == ".wav") {
     // Open a wav file with the known sample rate.
     output = std::make_unique<OutputWavFile>(*config.output_audio_filename,
                                              *sample_rate_hz);
-    std::cout << "Output WAV file: " << *config.output_audio_filename
-              << std::endl;
+    info << "Output WAV file: " << *config.output_audio_filename
+         << std::endl;
   } else {
     // Open a pcm file.
     output = std::make_unique<OutputAudioFile>(*config.output_audio_filename);
-    std::cout << "Output PCM file: " << *config.output_audio_filename
-              << std::endl;
+    info << "Output PCM file: " << *config.output_audio_filename
+         << std::endl;
+  }
+  if (config.output_tap) {
+    output = std::make_unique<TappedAudioSink>(std::move(output),
+                                               config.output_tap);
   }
 
   NetEqTest::DecoderMap codecs = NetEqTest::StandardDecoderMap();
@@ -336,19 +363,25 @@ std::unique_ptr<NetEqTest> NetEqTestFactory::InitializeTest(
       config.matlabplot, config.pythonplot, config.concealment_events,
       config.plot_scripts_basename.value_or(""));
 
-  ssrc_switch_detector_.reset(
-      new SsrcSwitchDetector(stats_plotter_->stats_getter()->delay_analyzer()));
+  ssrc_switch_detector_.reset(new SsrcSwitchDetector(
+      stats_plotter_->stats_getter()->delay_analyzer(), info));
   callbacks.post_insert_packet = ssrc_switch_detector_.get();
   callbacks.get_audio_callback = stats_plotter_->stats_getter();
-  callbacks.simulation_ended_callback = stats_plotter_.get();
+  if (!config.quiet_stdout)
+    callbacks.simulation_ended_callback = stats_plotter_.get();
   NetEq::Config neteq_config;
   neteq_config.sample_rate_hz = *sample_rate_hz;
   neteq_config.max_packets_in_buffer = config.max_nr_packets_in_buffer;
   neteq_config.enable_fast_accelerate = config.enable_fast_accelerate;
+  neteq_config.enable_lazy_dred = config.enable_lazy_dred;
   return std::make_unique<NetEqTest>(
       neteq_config, decoder_factory, codecs, std::move(text_log), factory,
       std::move(input), std::move(output), callbacks);
 }
 
+NetEqStatsGetter* NetEqTestFactory::stats_getter() {
+  return stats_plotter_ ? stats_plotter_->stats_getter() : nullptr;
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -133,6 +133,8 @@ class NetEqTestFactory {
     int skip_get_audio_events = default_skip_get_audio_events();
     // Enables jitter buffer fast accelerate.
     bool enable_fast_accelerate = false;
+    // Defers parsing of deep redundancy until a loss is confirmed at playout.
+    bool enable_lazy_dred = false;
     // Dumps events that describes the simulation on a step-by-step basis.
     bool textlog = false;
     // If specified and `textlog` is true, the output of `textlog` is written to
@@ -142,6 +144,13 @@ class NetEqTestFactory {
     absl::optional<std::string> plot_scripts_basename;
     // Path to the output audio file.
     absl::optional<std::string> output_audio_filename;
+    // If set, also receives the output audio, e.g. to checksum it. Not owned;
+    // must outlive the test.
+    AudioSink* output_tap = nullptr;
+    // Keeps stdout free for the caller, e.g. for a report: informational
+    // messages go to stderr and the end-of-simulation statistics are not
+    // printed. They can still be read through stats_getter().
+    bool quiet_stdout = false;
     // Field trials to use during the simulation.
     std::string field_trial_string;
   };
@@ -155,6 +164,10 @@ class NetEqTestFactory {
       NetEqFactory* neteq_factory,
       const Config& config);
 
+  // Returns the statistics collected by the most recently initialized test.
+  // Null until a test has been initialized.
+  NetEqStatsGetter* stats_getter();
+
  private:
   std::unique_ptr<NetEqTest> InitializeTest(std::unique_ptr<NetEqInput> input,
                                             NetEqFactory* neteq_factory,
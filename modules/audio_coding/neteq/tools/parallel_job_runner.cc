@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/parallel_job_runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace test {
+
+void RunJobsInParallel(size_t num_jobs,
+                       int num_threads,
+                       absl::string_view thread_name,
+                       rtc::FunctionView<void(size_t job)> run_job) {
+  if (num_threads <= 0)
+    num_threads = CpuInfo::DetectNumberOfCores();
+  num_threads = std::min<size_t>(num_threads, num_jobs);
+
+  std::atomic<size_t> next_job(0);
+  std::vector<rtc::PlatformThread> workers;
+  for (int i = 0; i < num_threads; ++i) {
+    workers.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&] {
+          for (size_t job = next_job++; job < num_jobs; job = next_job++) {
+            run_job(job);
+          }
+        },
+        thread_name));
+  }
+  for (rtc::PlatformThread& worker : workers)
+    worker.Finalize();
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,36 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_PARALLEL_JOB_RUNNER_H_
+#define MODULES_AUDIO_CODING_NETEQ_TOOLS_PARALLEL_JOB_RUNNER_H_
+
+#include <stddef.h>
+
+#include "absl/strings/string_view.h"
+#include "api/function_view.h"
+
+namespace webrtc {
+namespace test {
+
+// Calls `run_job` once for each job index in [0, `num_jobs`), on up to
+// `num_threads` worker threads named `thread_name`, and returns when all jobs
+// are done. Each worker picks the next pending job whenever it finishes one, so
+// that long jobs do not hold up the rest. If `num_threads` is not positive, one
+// worker per core is used. `run_job` must be safe to call concurrently for
+// different jobs.
+void RunJobsInParallel(size_t num_jobs,
+                       int num_threads,
+                       absl::string_view thread_name,
+                       rtc::FunctionView<void(size_t job)> run_job);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_TOOLS_PARALLEL_JOB_RUNNER_H_
@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/parallel_job_runner.h"
+
+#include <atomic>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+
+TEST(ParallelJobRunnerTest, RunsEachJobOnce) {
+  constexpr size_t kNumJobs = 100;
+  for (int num_threads : {0, 1, 4, 2 * static_cast<int>(kNumJobs)}) {
+    std::vector<std::atomic<int>> runs(kNumJobs);
+    RunJobsInParallel(kNumJobs, num_threads, "test_worker",
+                      [&](size_t job) { ++runs[job]; });
+    for (size_t job = 0; job < kNumJobs; ++job) {
+      EXPECT_EQ(runs[job], 1) << "job " << job << ", threads " << num_threads;
+    }
+  }
+}
+
+TEST(ParallelJobRunnerTest, NoJobs) {
+  RunJobsInParallel(/*num_jobs=*/0, /*num_threads=*/4, "test_worker",
+                    [](size_t job) { ADD_FAILURE() << "job " << job; });
+}
+
+}  // namespace test
+}  // namespace webrtc
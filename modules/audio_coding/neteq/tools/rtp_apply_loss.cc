@@ -9,13 +9,16 @@
  */
 
 #include <stdio.h>
+#include <algorithm>
 #include <random>
+#include <vector>
 
 #include "modules/rtp_rtcp/source/rtp_packet.h"
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
 #include "absl/flags/usage.h"
 
+#include "modules/audio_coding/neteq/tools/channel_model.h"
 #include "rtpplay_utils.h"
 
 ABSL_FLAG(float,
@@ -28,6 +31,31 @@ ABSL_FLAG(std::string,
           "",
           "Text file indicating which packets are lost - 1 packet per line, 0 indicates no loss, 1 indicates loss");
 
+ABSL_FLAG(float,
+          burst_length,
+          1,
+          "Mean length of loss bursts in packets - 1 gives independent losses, longer bursts follow a Gilbert-Elliot model");
+
+ABSL_FLAG(int,
+          jitter_ms,
+          0,
+          "Standard deviation of the added network delay in milliseconds");
+
+ABSL_FLAG(int,
+          mean_delay_ms,
+          -1,
+          "Mean added network delay in milliseconds - if negative use 2 * jitter_ms");
+
+ABSL_FLAG(float,
+          jitter_correlation,
+          0,
+          "Correlation between the delays of consecutive packets, in the range [0, 1)");
+
+ABSL_FLAG(std::string,
+          jitter_file,
+          "",
+          "Text file with the added network delay in milliseconds - 1 packet per line");
+
 ABSL_FLAG(unsigned int,
           seed,
           0,
@@ -37,10 +65,16 @@ namespace webrtc {
 namespace test {
 namespace {
 
+struct DelayedPacket {
+    RD_packet_t header;
+    std::vector<uint8_t> data;
+};
+
 int apply_loss(int argc, char **argv) {
     absl::SetProgramUsageMessage("This tool takes an input file in rtpplay format, applies packet "
-        "loss, and writes the output to a new rtpplay file.\n\n"
-        "usage - rtp_apply_loss <input.rtp> <output.rtp> --loss <percent> --loss_file <loss.txt> --seed <unsigned int>");
+        "loss and network jitter, and writes the output to a new rtpplay file.\n\n"
+        "usage - rtp_apply_loss <input.rtp> <output.rtp> --loss <percent> --burst_length <packets> --loss_file <loss.txt> "
+        "--jitter_ms <ms> --jitter_correlation <correlation> --jitter_file <delay.txt> --seed <unsigned int>");
     std::vector<char*> args = absl::ParseCommandLine(argc, argv);
     if (argc < 3) {
         fwrite(absl::ProgramUsageMessage().data(), absl::ProgramUsageMessage().size(), 1, stderr);
@@ -51,9 +85,27 @@ int apply_loss(int argc, char **argv) {
     input_name = argv[1];
     output_name = argv[2];
     const float loss_percent = absl::GetFlag(FLAGS_loss);
+    const float burst_length = absl::GetFlag(FLAGS_burst_length);
     const std::string loss_file_name(absl::GetFlag(FLAGS_loss_file));
+    const int jitter_ms = absl::GetFlag(FLAGS_jitter_ms);
+    const int mean_delay_ms = absl::GetFlag(FLAGS_mean_delay_ms) < 0 ? 2 * jitter_ms : absl::GetFlag(FLAGS_mean_delay_ms);
+    const float jitter_correlation = absl::GetFlag(FLAGS_jitter_correlation);
+    const std::string jitter_file_name(absl::GetFlag(FLAGS_jitter_file));
     unsigned int random_seed = absl::GetFlag(FLAGS_seed);
 
+    if (loss_percent < 0 || loss_percent >= 100) {
+        fprintf(stderr, "Loss percentage must be in the range [0, 100)\n");
+        return -1;
+    }
+    if (burst_length < 1) {
+        fprintf(stderr, "Burst length must be at least 1 packet\n");
+        return -1;
+    }
+    if (jitter_ms < 0 || jitter_correlation < 0 || jitter_correlation >= 1) {
+        fprintf(stderr, "Jitter must be non-negative with a correlation in the range [0, 1)\n");
+        return -1;
+    }
+
     FILE *input_file = fopen(input_name, "r");
     if (!input_file) {
         fprintf(stderr, "Failed to open %s\n", input_name);
@@ -64,13 +116,38 @@ int apply_loss(int argc, char **argv) {
         fprintf(stderr, "Failed to open %s\n", output_name);
         return -1;
     }
-    FILE *loss_file = nullptr;
+
+    if (random_seed == 0) {
+        std::random_device dev;
+        do {
+            random_seed = dev();
+        } while (random_seed == 0);
+    }
+    std::unique_ptr<LossModel> loss_model;
+    size_t loss_trace_size = 0;
     if (loss_file_name.size() > 0) {
-        loss_file = fopen(loss_file_name.c_str(), "r");
-        if (!loss_file) {
+        std::unique_ptr<TraceLossModel> trace = TraceLossModel::FromFile(loss_file_name);
+        if (!trace) {
             fprintf(stderr, "Failed to open %s\n", loss_file_name.c_str());
             return -1;
         }
+        loss_trace_size = trace->size();
+        loss_model = std::move(trace);
+    } else {
+        loss_model = CreateBurstLossModel(loss_percent / 100.0, burst_length, random_seed);
+    }
+    std::unique_ptr<JitterModel> jitter_model;
+    if (jitter_file_name.size() > 0) {
+        jitter_model = TraceJitterModel::FromFile(jitter_file_name);
+        if (!jitter_model) {
+            fprintf(stderr, "Failed to read delays from %s\n", jitter_file_name.c_str());
+            return -1;
+        }
+    } else if (jitter_ms > 0) {
+        // Use a different seed than the loss model, so that losses and delays
+        // are not correlated.
+        jitter_model = std::make_unique<CorrelatedJitter>(mean_delay_ms, jitter_ms, jitter_correlation,
+                                                          static_cast<uint64_t>(random_seed) << 32);
     }
 
     uint8_t buf[kMaxRtpPlayBufferSize];
@@ -94,50 +171,45 @@ int apply_loss(int argc, char **argv) {
         fprintf(stderr, "Failed to write header of output rtpplay file %s\n", output_name);
         return -1;
     }
-    std::unique_ptr<std::mt19937> rng;
-    std::uniform_real_distribution<float> random_pct(0.0, 100.0); // distribution in range [0, 100)
-    if (!loss_file) {
-        rng = std::make_unique<std::mt19937>();
-        if (random_seed == 0) {
-            std::random_device dev;
-            random_seed = dev();
-        }
-        rng->seed(random_seed);
-    }
 
     int count = 0;
     int writes = 0;
+    // With jitter, packets are collected and written in arrival order at the end.
+    std::vector<DelayedPacket> delayed_packets;
     while (1) {
         RD_packet_t packet_header;
         size_t packet_length;
         if (!read_packet(packet_header, buf, &packet_length, input_file))
             break;
 
-        bool should_write = true;
-        if (loss_file) {
-            char linebuf[16];
-            if (fgets(linebuf, sizeof(linebuf), loss_file)) {
-                char *p = linebuf;
-                while (*p && isspace(*p)) p++;
-                should_write = *p == '0';
-            } else {
-                fprintf(stderr, "Warning - no loss information in loss file for packet %d\n", count);
-            }
-        } else if (loss_percent > 0 && random_pct(*rng) < loss_percent) {
-            should_write = false;
+        if (loss_file_name.size() > 0 && static_cast<size_t>(count) >= loss_trace_size) {
+            fprintf(stderr, "Warning - no loss information in loss file for packet %d\n", count);
         }
+        const bool should_write = !loss_model->Lost(packet_header.offset);
         if (should_write) {
-            if (!write_packet(packet_header, buf, packet_length, output_file))
-                break;
+            if (jitter_model) {
+                packet_header.offset += jitter_model->DelayMs(packet_header.offset);
+                delayed_packets.push_back({packet_header, std::vector<uint8_t>(buf, buf + packet_length)});
+            } else {
+                if (!write_packet(packet_header, buf, packet_length, output_file))
+                    break;
+            }
             ++writes;
         }
         ++count;
     }
+    std::stable_sort(delayed_packets.begin(), delayed_packets.end(),
+                     [](const DelayedPacket& a, const DelayedPacket& b) {
+                         return a.header.offset < b.header.offset;
+                     });
+    for (DelayedPacket& packet : delayed_packets) {
+        if (!write_packet(packet.header, packet.data.data(), packet.data.size(), output_file))
+            break;
+    }
     printf("Successfully processed %d packets, wrote %d packets to output\n", count, writes);
 
     fclose(input_file);
     fclose(output_file);
-    if (loss_file) fclose(loss_file);
 
     return 0;
 }
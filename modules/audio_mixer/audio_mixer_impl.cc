@@ -13,14 +13,19 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <type_traits>
 #include <utility>
 
+#include "api/rtp_packet_infos.h"
+#include "audio/utility/audio_frame_operations.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/default_output_rate_calculator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/metrics.h"
 
@@ -32,10 +37,30 @@ struct AudioMixerImpl::SourceStatus {
 
   // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
   AudioFrame audio_frame;
+
+  // Mix of all other sources and its limiter, used by MixMinusOne().
+  AudioFrame minus_one_frame;
+  std::unique_ptr<Limiter> minus_one_limiter;
+
+  // State of the parallel fetch. A worker writes to `fetch_frame`, which is
+  // copied to `audio_frame` if it arrives in time. `fetch_done` is signaled
+  // when no worker uses the source.
+  AudioFrame fetch_frame;
+  rtc::Event fetch_done{/*manual_reset=*/true, /*initially_signaled=*/true};
+  bool fetch_dispatched = false;
+  // Whether `audio_frame` holds audio that can be faded out when the source
+  // is late, and for how many frames it has been faded out so far.
+  bool can_conceal = false;
+  int concealed_frames = 0;
 };
 
 namespace {
 
+// Concealment of sources that miss the fetch deadline. The last frame is
+// faded out over a few frames and then muted.
+constexpr int kMaxConcealedFrames = 5;
+constexpr float kConcealmentGain = 0.5f;
+
 std::vector<std::unique_ptr<AudioMixerImpl::SourceStatus>>::const_iterator
 FindSourceInList(
     AudioMixerImpl::Source const* audio_source,
@@ -53,18 +78,138 @@ struct AudioMixerImpl::HelperContainers {
   void resize(size_t size) {
     audio_to_mix.resize(size);
     preferred_rates.resize(size);
+    excluded_frames.resize(size);
+    minus_one_limiters.resize(size);
+    minus_one_frames.resize(size);
   }
 
   std::vector<AudioFrame*> audio_to_mix;
   std::vector<int> preferred_rates;
+  std::vector<const AudioFrame*> excluded_frames;
+  std::vector<Limiter*> minus_one_limiters;
+  std::vector<AudioFrame*> minus_one_frames;
+};
+
+// Worker threads for the parallel fetch. Every mixing call hands out a batch
+// with one job per source, and the workers claim jobs through a shared
+// counter. Jobs that nobody has claimed when the deadline passes are dropped;
+// jobs that are running keep running, and their sources are skipped until
+// they are done.
+class AudioMixerImpl::FetchPool {
+ public:
+  struct Job {
+    SourceStatus* status = nullptr;
+    Source::AudioFrameInfo info = Source::AudioFrameInfo::kError;
+    std::atomic<bool> done{false};
+  };
+
+  struct Batch {
+    Batch(size_t max_jobs, int sample_rate_hz)
+        : jobs(max_jobs), sample_rate_hz(sample_rate_hz) {}
+    std::vector<Job> jobs;
+    size_t num_jobs = 0;
+    const int sample_rate_hz;
+    std::atomic<size_t> next_job{0};
+    std::atomic<size_t> remaining_jobs{0};
+    rtc::Event all_done;
+  };
+
+  explicit FetchPool(int num_threads) {
+    for (int i = 0; i < num_threads; ++i) {
+      wake_events_.push_back(std::make_unique<rtc::Event>());
+      rtc::Event* wake = wake_events_.back().get();
+      threads_.push_back(rtc::PlatformThread::SpawnJoinable(
+          [this, wake] { RunWorker(wake); }, "AudioMixerFetch",
+          rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kRealtime)));
+    }
+  }
+
+  ~FetchPool() {
+    {
+      MutexLock lock(&mutex_);
+      stopping_ = true;
+    }
+    for (auto& wake : wake_events_) {
+      wake->Set();
+    }
+    for (auto& thread : threads_) {
+      thread.Finalize();
+    }
+  }
+
+  // Runs the jobs of `batch` and returns when they are done or `deadline`
+  // has passed, whichever comes first.
+  void Run(std::shared_ptr<Batch> batch, TimeDelta deadline) {
+    if (batch->num_jobs == 0) {
+      return;
+    }
+    batch->remaining_jobs = batch->num_jobs;
+    {
+      MutexLock lock(&mutex_);
+      batch_ = batch;
+    }
+    for (auto& wake : wake_events_) {
+      wake->Set();
+    }
+    batch->all_done.Wait(deadline, rtc::Event::kForever);
+
+    // Drop the jobs that have not been claimed.
+    const size_t claimed =
+        std::min(batch->next_job.exchange(batch->num_jobs), batch->num_jobs);
+    for (size_t i = claimed; i < batch->num_jobs; ++i) {
+      batch->jobs[i].status->fetch_done.Set();
+    }
+  }
+
+ private:
+  void RunWorker(rtc::Event* wake) {
+    while (true) {
+      wake->Wait(rtc::Event::kForever, rtc::Event::kForever);
+      std::shared_ptr<Batch> batch;
+      {
+        MutexLock lock(&mutex_);
+        if (stopping_) {
+          return;
+        }
+        batch = batch_;
+      }
+      if (!batch) {
+        continue;
+      }
+      for (size_t i = batch->next_job++; i < batch->num_jobs;
+           i = batch->next_job++) {
+        Job& job = batch->jobs[i];
+        SourceStatus* const status = job.status;
+        job.info = status->audio_source->GetAudioFrameWithInfo(
+            batch->sample_rate_hz, &status->fetch_frame);
+        job.done.store(true, std::memory_order_release);
+        status->fetch_done.Set();
+        if (--batch->remaining_jobs == 0) {
+          batch->all_done.Set();
+        }
+      }
+    }
+  }
+
+  Mutex mutex_;
+  bool stopping_ RTC_GUARDED_BY(mutex_) = false;
+  std::shared_ptr<Batch> batch_ RTC_GUARDED_BY(mutex_);
+  std::vector<std::unique_ptr<rtc::Event>> wake_events_;
+  std::vector<rtc::PlatformThread> threads_;
 };
 
 AudioMixerImpl::AudioMixerImpl(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-    bool use_limiter)
+    bool use_limiter,
+    int num_fetch_threads,
+    TimeDelta fetch_deadline)
     : output_rate_calculator_(std::move(output_rate_calculator)),
       audio_source_list_(),
       helper_containers_(std::make_unique<HelperContainers>()),
+      fetch_pool_(num_fetch_threads > 0
+                      ? std::make_unique<FetchPool>(num_fetch_threads)
+                      : nullptr),
+      fetch_deadline_(fetch_deadline),
       frame_combiner_(use_limiter) {}
 
 AudioMixerImpl::~AudioMixerImpl() {}
@@ -82,6 +227,17 @@ rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
       std::move(output_rate_calculator), use_limiter);
 }
 
+rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
+    std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+    bool use_limiter,
+    int num_fetch_threads,
+    TimeDelta fetch_deadline) {
+  RTC_DCHECK_GE(num_fetch_threads, 0);
+  return rtc::make_ref_counted<AudioMixerImpl>(
+      std::move(output_rate_calculator), use_limiter, num_fetch_threads,
+      fetch_deadline);
+}
+
 void AudioMixerImpl::Mix(size_t number_of_channels,
                          AudioFrame* audio_frame_for_mixing) {
   TRACE_EVENT0("webrtc", "AudioMixerImpl::Mix");
@@ -89,22 +245,52 @@ void AudioMixerImpl::Mix(size_t number_of_channels,
   MutexLock lock(&mutex_);
 
   size_t number_of_streams = audio_source_list_.size();
-
-  std::transform(audio_source_list_.begin(), audio_source_list_.end(),
-                 helper_containers_->preferred_rates.begin(),
-                 [&](std::unique_ptr<SourceStatus>& a) {
-                   return a->audio_source->PreferredSampleRate();
-                 });
-
-  int output_frequency = output_rate_calculator_->CalculateOutputRateFromRange(
-      rtc::ArrayView<const int>(helper_containers_->preferred_rates.data(),
-                                number_of_streams));
+  int output_frequency = CalculateOutputFrequency();
 
   frame_combiner_.Combine(GetAudioFromSources(output_frequency),
                           number_of_channels, output_frequency,
                           number_of_streams, audio_frame_for_mixing);
 }
 
+void AudioMixerImpl::MixMinusOne(
+    size_t number_of_channels,
+    AudioFrame* audio_frame_for_mixing,
+    rtc::FunctionView<void(Source* source, const AudioFrame& mix)> on_mix) {
+  TRACE_EVENT0("webrtc", "AudioMixerImpl::MixMinusOne");
+  RTC_DCHECK(number_of_channels >= 1);
+  MutexLock lock(&mutex_);
+
+  size_t number_of_streams = audio_source_list_.size();
+  int output_frequency = CalculateOutputFrequency();
+  rtc::ArrayView<AudioFrame* const> mix_list =
+      GetAudioFromSources(output_frequency);
+
+  for (size_t i = 0; i < number_of_streams; ++i) {
+    SourceStatus& status = *audio_source_list_[i];
+    if (!status.minus_one_limiter) {
+      status.minus_one_limiter = frame_combiner_.CreateLimiter();
+    }
+    helper_containers_->excluded_frames[i] = &status.audio_frame;
+    helper_containers_->minus_one_limiters[i] = status.minus_one_limiter.get();
+    helper_containers_->minus_one_frames[i] = &status.minus_one_frame;
+  }
+
+  frame_combiner_.CombineMinusOne(
+      mix_list,
+      rtc::ArrayView<const AudioFrame* const>(
+          helper_containers_->excluded_frames.data(), number_of_streams),
+      rtc::ArrayView<Limiter* const>(
+          helper_containers_->minus_one_limiters.data(), number_of_streams),
+      number_of_channels, output_frequency, number_of_streams,
+      audio_frame_for_mixing,
+      rtc::ArrayView<AudioFrame* const>(
+          helper_containers_->minus_one_frames.data(), number_of_streams));
+
+  for (const auto& status : audio_source_list_) {
+    on_mix(status->audio_source, status->minus_one_frame);
+  }
+}
+
 bool AudioMixerImpl::AddSource(Source* audio_source) {
   RTC_DCHECK(audio_source);
   MutexLock lock(&mutex_);
@@ -119,14 +305,26 @@ bool AudioMixerImpl::AddSource(Source* audio_source) {
 
 void AudioMixerImpl::RemoveSource(Source* audio_source) {
   RTC_DCHECK(audio_source);
-  MutexLock lock(&mutex_);
-  const auto iter = FindSourceInList(audio_source, &audio_source_list_);
-  RTC_DCHECK(iter != audio_source_list_.end()) << "Source not present in mixer";
-  audio_source_list_.erase(iter);
+  std::unique_ptr<SourceStatus> removed_status;
+  {
+    MutexLock lock(&mutex_);
+    const auto iter = FindSourceInList(audio_source, &audio_source_list_);
+    RTC_DCHECK(iter != audio_source_list_.end())
+        << "Source not present in mixer";
+    removed_status = std::move(audio_source_list_[std::distance(
+        audio_source_list_.cbegin(), iter)]);
+    audio_source_list_.erase(iter);
+  }
+  // A late parallel fetch may still be using the source. Wait for it without
+  // holding the lock, so that mixing goes on meanwhile.
+  removed_status->fetch_done.Wait(rtc::Event::kForever);
 }
 
 rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
     int output_frequency) {
+  if (fetch_pool_) {
+    return GetAudioFromSourcesInParallel(output_frequency);
+  }
   int audio_to_mix_count = 0;
   for (auto& source_and_status : audio_source_list_) {
     const auto audio_frame_info =
@@ -148,6 +346,72 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
       helper_containers_->audio_to_mix.data(), audio_to_mix_count);
 }
 
+int AudioMixerImpl::CalculateOutputFrequency() {
+  std::transform(audio_source_list_.begin(), audio_source_list_.end(),
+                 helper_containers_->preferred_rates.begin(),
+                 [&](std::unique_ptr<SourceStatus>& a) {
+                   return a->audio_source->PreferredSampleRate();
+                 });
+
+  return output_rate_calculator_->CalculateOutputRateFromRange(
+      rtc::ArrayView<const int>(helper_containers_->preferred_rates.data(),
+                                audio_source_list_.size()));
+}
+
+rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSourcesInParallel(
+    int output_frequency) {
+  auto batch = std::make_shared<FetchPool::Batch>(audio_source_list_.size(),
+                                                  output_frequency);
+  for (auto& source_and_status : audio_source_list_) {
+    // Sources that are still busy with an earlier fetch are not asked again.
+    source_and_status->fetch_dispatched =
+        source_and_status->fetch_done.Wait(TimeDelta::Zero());
+    if (source_and_status->fetch_dispatched) {
+      source_and_status->fetch_done.Reset();
+      batch->jobs[batch->num_jobs++].status = source_and_status.get();
+    }
+  }
+  fetch_pool_->Run(batch, fetch_deadline_);
+
+  int audio_to_mix_count = 0;
+  size_t job_index = 0;
+  for (auto& source_and_status : audio_source_list_) {
+    SourceStatus& status = *source_and_status;
+    const FetchPool::Job* const job =
+        status.fetch_dispatched ? &batch->jobs[job_index++] : nullptr;
+    Source::AudioFrameInfo audio_frame_info = Source::AudioFrameInfo::kMuted;
+    if (job && job->done.load(std::memory_order_acquire)) {
+      audio_frame_info = job->info;
+      status.audio_frame.CopyFrom(status.fetch_frame);
+      status.can_conceal =
+          audio_frame_info == Source::AudioFrameInfo::kNormal;
+      status.concealed_frames = 0;
+    } else if (status.can_conceal &&
+               status.concealed_frames < kMaxConcealedFrames &&
+               status.audio_frame.sample_rate_hz_ == output_frequency) {
+      // Fade out the last frame of a late source.
+      AudioFrameOperations::ScaleWithSat(kConcealmentGain,
+                                         &status.audio_frame);
+      status.audio_frame.packet_infos_ = RtpPacketInfos();
+      ++status.concealed_frames;
+      audio_frame_info = Source::AudioFrameInfo::kNormal;
+    }
+    switch (audio_frame_info) {
+      case Source::AudioFrameInfo::kError:
+        RTC_LOG_F(LS_WARNING)
+            << "failed to GetAudioFrameWithInfo() from source";
+        break;
+      case Source::AudioFrameInfo::kMuted:
+        break;
+      case Source::AudioFrameInfo::kNormal:
+        helper_containers_->audio_to_mix[audio_to_mix_count++] =
+            &status.audio_frame;
+    }
+  }
+  return rtc::ArrayView<AudioFrame* const>(
+      helper_containers_->audio_to_mix.data(), audio_to_mix_count);
+}
+
 void AudioMixerImpl::UpdateSourceCountStats() {
   size_t current_source_count = audio_source_list_.size();
   // Log to the histogram whenever the maximum number of sources increases.
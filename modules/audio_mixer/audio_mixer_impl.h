@@ -19,7 +19,9 @@
 #include "api/array_view.h"
 #include "api/audio/audio_frame.h"
 #include "api/audio/audio_mixer.h"
+#include "api/function_view.h"
 #include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
 #include "modules/audio_mixer/frame_combiner.h"
 #include "modules/audio_mixer/output_rate_calculator.h"
 #include "rtc_base/race_checker.h"
@@ -41,6 +43,18 @@ class AudioMixerImpl : public AudioMixer {
       std::unique_ptr<OutputRateCalculator> output_rate_calculator,
       bool use_limiter);
 
+  // Creates a mixer that asks its sources for audio on `num_fetch_threads`
+  // worker threads, so that the decoding work of many sources is spread over
+  // several cores. Sources that have not delivered audio `fetch_deadline`
+  // after mixing started are concealed by fading out their last frame. Each
+  // source is called from at most one thread at a time. RemoveSource() waits
+  // for a pending fetch of the source, but does not hold up mixing meanwhile.
+  static rtc::scoped_refptr<AudioMixerImpl> Create(
+      std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+      bool use_limiter,
+      int num_fetch_threads,
+      TimeDelta fetch_deadline);
+
   ~AudioMixerImpl() override;
 
   AudioMixerImpl(const AudioMixerImpl&) = delete;
@@ -54,18 +68,38 @@ class AudioMixerImpl : public AudioMixer {
            AudioFrame* audio_frame_for_mixing) override
       RTC_LOCKS_EXCLUDED(mutex_);
 
+  // N-minus-one mixing for conference servers, where every participant is
+  // both a source and a listener. Mixes all sources into
+  // `audio_frame_for_mixing` like Mix(), and calls `on_mix` once for every
+  // source with the mix of all the other sources, which carries no packet
+  // infos. Each source is asked for audio once per call. `on_mix` is called with the mixer locked and must not
+  // add or remove sources.
+  void MixMinusOne(
+      size_t number_of_channels,
+      AudioFrame* audio_frame_for_mixing,
+      rtc::FunctionView<void(Source* source, const AudioFrame& mix)> on_mix)
+      RTC_LOCKS_EXCLUDED(mutex_);
+
  protected:
   AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-                 bool use_limiter);
+                 bool use_limiter,
+                 int num_fetch_threads = 0,
+                 TimeDelta fetch_deadline = TimeDelta::Zero());
 
  private:
   struct HelperContainers;
+  class FetchPool;
 
   void UpdateSourceCountStats() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Picks the mixing rate from the preferred rates of the sources.
+  int CalculateOutputFrequency() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // Fetches audio frames to mix from sources.
   rtc::ArrayView<AudioFrame* const> GetAudioFromSources(int output_frequency)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  rtc::ArrayView<AudioFrame* const> GetAudioFromSourcesInParallel(
+      int output_frequency) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   // The critical section lock guards audio source insertion and
   // removal, which can be done from any thread. The race checker
@@ -80,6 +114,11 @@ class AudioMixerImpl : public AudioMixer {
   const std::unique_ptr<HelperContainers> helper_containers_
       RTC_GUARDED_BY(mutex_);
 
+  // Worker threads for fetching audio in parallel, or null. Declared after
+  // `audio_source_list_` so that the workers are stopped first.
+  const std::unique_ptr<FetchPool> fetch_pool_;
+  const TimeDelta fetch_deadline_;
+
   // Component that handles actual adding of audio frames.
   FrameCombiner frame_combiner_;
 
@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -23,9 +24,11 @@
 #include "api/audio/audio_mixer.h"
 #include "api/rtp_packet_info.h"
 #include "api/rtp_packet_infos.h"
+#include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "modules/audio_mixer/default_output_rate_calculator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/task_queue_for_test.h"
 #include "system_wrappers/include/metrics.h"
@@ -479,6 +482,177 @@ TEST(AudioMixer, ShouldIncludeRtpPacketInfoFromAllMixedSources) {
   EXPECT_THAT(frame_for_mixing.packet_infos_, UnorderedElementsAre(p0, p1, p2));
 }
 
+TEST(AudioMixer, MixMinusOneLeavesOutOwnSource) {
+  constexpr int16_t kValues[] = {100, 200, 400};
+  MockMixerAudioSource sources[3];
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/false);
+  for (size_t i = 0; i < 3; ++i) {
+    ResetFrame(sources[i].fake_frame());
+    std::fill(sources[i].fake_frame()->mutable_data(),
+              sources[i].fake_frame()->mutable_data() +
+                  kDefaultSampleRateHz / 100,
+              kValues[i]);
+    mixer->AddSource(&sources[i]);
+  }
+
+  std::map<AudioMixer::Source*, int16_t> mixes;
+  mixer->MixMinusOne(
+      /*number_of_channels=*/1, &frame_for_mixing,
+      [&](AudioMixer::Source* source, const AudioFrame& mix) {
+        mixes[source] = mix.data()[10];
+      });
+
+  EXPECT_EQ(frame_for_mixing.data()[10], 700);
+  ASSERT_EQ(mixes.size(), 3u);
+  EXPECT_EQ(mixes[&sources[0]], 600);
+  EXPECT_EQ(mixes[&sources[1]], 500);
+  EXPECT_EQ(mixes[&sources[2]], 300);
+}
+
+TEST(AudioMixer, MixMinusOneGivesMutedSourceTheFullMix) {
+  MockMixerAudioSource source;
+  MockMixerAudioSource muted_source;
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/false);
+  for (MockMixerAudioSource* s : {&source, &muted_source}) {
+    ResetFrame(s->fake_frame());
+    std::fill(s->fake_frame()->mutable_data(),
+              s->fake_frame()->mutable_data() + kDefaultSampleRateHz / 100,
+              1000);
+    mixer->AddSource(s);
+  }
+  muted_source.set_fake_info(AudioMixer::Source::AudioFrameInfo::kMuted);
+
+  std::vector<std::pair<AudioMixer::Source*, AudioFrame>> mixes(2);
+  size_t count = 0;
+  mixer->MixMinusOne(
+      /*number_of_channels=*/1, &frame_for_mixing,
+      [&](AudioMixer::Source* s, const AudioFrame& mix) {
+        mixes[count].first = s;
+        mixes[count++].second.CopyFrom(mix);
+      });
+
+  ASSERT_EQ(count, 2u);
+  for (const auto& [s, mix] : mixes) {
+    if (s == &source) {
+      EXPECT_TRUE(mix.muted());
+    } else {
+      EXPECT_FALSE(mix.muted());
+      EXPECT_EQ(mix.data()[10], 1000);
+    }
+  }
+  EXPECT_EQ(frame_for_mixing.data()[10], 1000);
+}
+
+TEST(AudioMixer, ParallelFetchMixesAllSources) {
+  constexpr int16_t kValues[] = {100, 200, 400};
+  MockMixerAudioSource sources[3];
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/false,
+      /*num_fetch_threads=*/2, /*fetch_deadline=*/TimeDelta::Seconds(10));
+  for (size_t i = 0; i < 3; ++i) {
+    ResetFrame(sources[i].fake_frame());
+    std::fill(sources[i].fake_frame()->mutable_data(),
+              sources[i].fake_frame()->mutable_data() +
+                  kDefaultSampleRateHz / 100,
+              kValues[i]);
+    mixer->AddSource(&sources[i]);
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+    EXPECT_EQ(frame_for_mixing.data()[10], 700);
+  }
+}
+
+TEST(AudioMixer, ParallelFetchConcealsLateSource) {
+  MockMixerAudioSource fast_source;
+  MockMixerAudioSource slow_source;
+  // Lateness is controlled by `release` below. The deadline is long enough for
+  // the other source to deliver even on a loaded machine; only the mix in
+  // which the slow source blocks waits for it.
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/false,
+      /*num_fetch_threads=*/2, /*fetch_deadline=*/TimeDelta::Seconds(2));
+  for (MockMixerAudioSource* source : {&fast_source, &slow_source}) {
+    ResetFrame(source->fake_frame());
+    std::fill(source->fake_frame()->mutable_data(),
+              source->fake_frame()->mutable_data() + kDefaultSampleRateHz / 100,
+              source == &fast_source ? 100 : 1000);
+    mixer->AddSource(source);
+  }
+
+  // The slow source only delivers its first frame in time.
+  rtc::Event release;
+  int slow_calls = 0;
+  ON_CALL(slow_source, GetAudioFrameWithInfo(_, _))
+      .WillByDefault([&](int sample_rate_hz, AudioFrame* audio_frame) {
+        if (++slow_calls > 1) {
+          release.Wait(rtc::Event::kForever);
+        }
+        audio_frame->CopyFrom(*slow_source.fake_frame());
+        return AudioMixer::Source::AudioFrameInfo::kNormal;
+      });
+
+  mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+  EXPECT_EQ(frame_for_mixing.data()[10], 1100);
+
+  // The late source is faded out while its fetch is blocked.
+  mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+  EXPECT_EQ(frame_for_mixing.data()[10], 100 + 500);
+  mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+  EXPECT_EQ(frame_for_mixing.data()[10], 100 + 250);
+
+  // Removing the source waits for the blocked fetch.
+  release.Set();
+  mixer->RemoveSource(&slow_source);
+  mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+  EXPECT_EQ(frame_for_mixing.data()[10], 100);
+}
+
+TEST(AudioMixer, ParallelFetchMixesWhileRemovingBlockedSource) {
+  MockMixerAudioSource fast_source;
+  MockMixerAudioSource slow_source;
+  // As above, `release` decides which source is late.
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/false,
+      /*num_fetch_threads=*/2, /*fetch_deadline=*/TimeDelta::Seconds(2));
+  for (MockMixerAudioSource* source : {&fast_source, &slow_source}) {
+    ResetFrame(source->fake_frame());
+    std::fill(source->fake_frame()->mutable_data(),
+              source->fake_frame()->mutable_data() + kDefaultSampleRateHz / 100,
+              source == &fast_source ? 100 : 1000);
+    mixer->AddSource(source);
+  }
+
+  rtc::Event release;
+  ON_CALL(slow_source, GetAudioFrameWithInfo(_, _))
+      .WillByDefault([&](int sample_rate_hz, AudioFrame* audio_frame) {
+        release.Wait(rtc::Event::kForever);
+        audio_frame->CopyFrom(*slow_source.fake_frame());
+        return AudioMixer::Source::AudioFrameInfo::kNormal;
+      });
+  mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+  EXPECT_EQ(frame_for_mixing.data()[10], 100);
+
+  // The removal waits for the blocked fetch, while mixing goes on without the
+  // removed source.
+  TaskQueueForTest remove_queue("remove");
+  rtc::Event removed;
+  remove_queue.PostTask([&] {
+    mixer->RemoveSource(&slow_source);
+    removed.Set();
+  });
+  EXPECT_FALSE(removed.Wait(TimeDelta::Millis(50)));
+  mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+  EXPECT_EQ(frame_for_mixing.data()[10], 100);
+  EXPECT_FALSE(removed.Wait(TimeDelta::Zero()));
+
+  release.Set();
+  EXPECT_TRUE(removed.Wait(rtc::Event::kForever));
+}
+
 class HighOutputRateCalculator : public OutputRateCalculator {
  public:
   static const int kDefaultFrequency = 76000;
@@ -138,6 +138,61 @@ void InterleaveToAudioFrame(AudioFrameView<const float> mixing_buffer_view,
     }
   }
 }
+
+// Writes `sum` minus `excluded_frame` to `mixing_buffer`. Nothing is
+// subtracted if `excluded_frame` is null.
+void SubtractFromFloatFrame(const MixingBuffer& sum,
+                            const AudioFrame* excluded_frame,
+                            size_t samples_per_channel,
+                            size_t number_of_channels,
+                            MixingBuffer* mixing_buffer) {
+  const size_t channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t samples =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+  for (size_t j = 0; j < channels; ++j) {
+    std::copy(sum[j].begin(), sum[j].begin() + samples,
+              (*mixing_buffer)[j].begin());
+  }
+  if (!excluded_frame) {
+    return;
+  }
+  const int16_t* const frame_data = excluded_frame->data();
+  for (size_t j = 0; j < channels; ++j) {
+    for (size_t k = 0; k < samples; ++k) {
+      (*mixing_buffer)[j][k] -= frame_data[number_of_channels * k + j];
+    }
+  }
+}
+
+// Runs `limiter` (unless null) on `mixing_buffer` and writes the result to
+// `audio_frame_for_mixing`.
+void LimitAndInterleave(MixingBuffer* mixing_buffer,
+                        size_t number_of_channels,
+                        size_t samples_per_channel,
+                        Limiter* limiter,
+                        AudioFrame* audio_frame_for_mixing) {
+  const size_t output_number_of_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t output_samples_per_channel =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+
+  // Put float data in an AudioFrameView.
+  std::array<float*, FrameCombiner::kMaximumNumberOfChannels>
+      channel_pointers{};
+  for (size_t i = 0; i < output_number_of_channels; ++i) {
+    channel_pointers[i] = &(*mixing_buffer)[i][0];
+  }
+  AudioFrameView<float> mixing_buffer_view(&channel_pointers[0],
+                                           output_number_of_channels,
+                                           output_samples_per_channel);
+
+  if (limiter) {
+    RunLimiter(mixing_buffer_view, limiter);
+  }
+
+  InterleaveToAudioFrame(mixing_buffer_view, audio_frame_for_mixing);
+}
 }  // namespace
 
 constexpr size_t FrameCombiner::kMaximumNumberOfChannels;
@@ -189,25 +244,91 @@ void FrameCombiner::Combine(rtc::ArrayView<AudioFrame* const> mix_list,
   MixToFloatFrame(mix_list, samples_per_channel, number_of_channels,
                   mixing_buffer_.get());
 
-  const size_t output_number_of_channels =
-      std::min(number_of_channels, kMaximumNumberOfChannels);
-  const size_t output_samples_per_channel =
-      std::min(samples_per_channel, kMaximumChannelSize);
+  LimitAndInterleave(mixing_buffer_.get(), number_of_channels,
+                     samples_per_channel, use_limiter_ ? &limiter_ : nullptr,
+                     audio_frame_for_mixing);
+}
 
-  // Put float data in an AudioFrameView.
-  std::array<float*, kMaximumNumberOfChannels> channel_pointers{};
-  for (size_t i = 0; i < output_number_of_channels; ++i) {
-    channel_pointers[i] = &(*mixing_buffer_.get())[i][0];
+void FrameCombiner::CombineMinusOne(
+    rtc::ArrayView<AudioFrame* const> mix_list,
+    rtc::ArrayView<const AudioFrame* const> excluded_frames,
+    rtc::ArrayView<Limiter* const> minus_one_limiters,
+    size_t number_of_channels,
+    int sample_rate,
+    size_t number_of_streams,
+    AudioFrame* audio_frame_for_mixing,
+    rtc::ArrayView<AudioFrame* const> minus_one_frames) {
+  RTC_DCHECK_EQ(excluded_frames.size(), minus_one_frames.size());
+  RTC_DCHECK_EQ(minus_one_limiters.size(), minus_one_frames.size());
+
+  RTC_DCHECK(audio_frame_for_mixing);
+
+  SetAudioFrameFields(mix_list, number_of_channels, sample_rate,
+                      number_of_streams, audio_frame_for_mixing);
+
+  const size_t samples_per_channel = static_cast<size_t>(
+      (sample_rate * webrtc::AudioMixerImpl::kFrameDurationInMs) / 1000);
+
+  for (auto* frame : mix_list) {
+    RTC_DCHECK_EQ(samples_per_channel, frame->samples_per_channel_);
+    RTC_DCHECK_EQ(sample_rate, frame->sample_rate_hz_);
+    RemixFrame(number_of_channels, frame);
   }
-  AudioFrameView<float> mixing_buffer_view(&channel_pointers[0],
-                                           output_number_of_channels,
-                                           output_samples_per_channel);
 
-  if (use_limiter_) {
-    RunLimiter(mixing_buffer_view, &limiter_);
+  if (!sum_buffer_) {
+    sum_buffer_ = std::make_unique<MixingBuffer>();
   }
+  MixToFloatFrame(mix_list, samples_per_channel, number_of_channels,
+                  sum_buffer_.get());
 
-  InterleaveToAudioFrame(mixing_buffer_view, audio_frame_for_mixing);
+  if (number_of_streams <= 1) {
+    MixFewFramesWithNoLimiter(mix_list, audio_frame_for_mixing);
+  } else {
+    SubtractFromFloatFrame(*sum_buffer_, nullptr, samples_per_channel,
+                           number_of_channels, mixing_buffer_.get());
+    LimitAndInterleave(mixing_buffer_.get(), number_of_channels,
+                       samples_per_channel, use_limiter_ ? &limiter_ : nullptr,
+                       audio_frame_for_mixing);
+  }
+
+  // Each output leaves out one stream, so the limiter is needed when at
+  // least two other streams can be mixed.
+  const bool use_limiter = use_limiter_ && number_of_streams > 2;
+  for (size_t i = 0; i < minus_one_frames.size(); ++i) {
+    const AudioFrame* const excluded_frame = excluded_frames[i];
+    AudioFrame* const minus_one_frame = minus_one_frames[i];
+    // The timing fields are those of the full mix. The packet infos are left
+    // empty: sharing them would list the excluded source, and building a
+    // list per output would allocate for every output.
+    minus_one_frame->UpdateFrame(
+        audio_frame_for_mixing->timestamp_, nullptr, samples_per_channel,
+        sample_rate, AudioFrame::kUndefined, AudioFrame::kVadUnknown,
+        number_of_channels);
+    minus_one_frame->elapsed_time_ms_ = audio_frame_for_mixing->elapsed_time_ms_;
+    minus_one_frame->ntp_time_ms_ = audio_frame_for_mixing->ntp_time_ms_;
+    minus_one_frame->packet_infos_ = RtpPacketInfos();
+
+    const bool excluded_frame_is_mixed =
+        std::find(mix_list.begin(), mix_list.end(), excluded_frame) !=
+        mix_list.end();
+    if (mix_list.size() == (excluded_frame_is_mixed ? 1u : 0u)) {
+      minus_one_frame->Mute();
+      continue;
+    }
+    SubtractFromFloatFrame(*sum_buffer_,
+                           excluded_frame_is_mixed ? excluded_frame : nullptr,
+                           samples_per_channel, number_of_channels,
+                           mixing_buffer_.get());
+    LimitAndInterleave(mixing_buffer_.get(), number_of_channels,
+                       samples_per_channel,
+                       use_limiter ? minus_one_limiters[i] : nullptr,
+                       minus_one_frame);
+  }
+}
+
+std::unique_ptr<Limiter> FrameCombiner::CreateLimiter() const {
+  return std::make_unique<Limiter>(static_cast<size_t>(48000),
+                                   data_dumper_.get(), "AudioMixer");
 }
 
 }  // namespace webrtc
@@ -38,6 +38,29 @@ class FrameCombiner {
                size_t number_of_streams,
                AudioFrame* audio_frame_for_mixing);
 
+  // N-minus-one version of Combine() for conference servers. Combines
+  // `mix_list` into `audio_frame_for_mixing` like Combine(), and writes to
+  // `minus_one_frames[i]` the mix of all frames in `mix_list` except
+  // `excluded_frames[i]`, limited by `minus_one_limiters[i]`. An excluded
+  // frame that is not in `mix_list` (e.g. the frame of a muted source)
+  // excludes nothing. The frames are summed once, in O(N * samples) for N
+  // frames, and every minus-one mix is derived from that sum by subtracting
+  // one frame, in O(samples). All N outputs thus cost O(N * samples) instead
+  // of the O(N^2 * samples) of N separate mixes. The minus-one frames get the
+  // timing fields of the full mix and no packet infos.
+  void CombineMinusOne(rtc::ArrayView<AudioFrame* const> mix_list,
+                       rtc::ArrayView<const AudioFrame* const> excluded_frames,
+                       rtc::ArrayView<Limiter* const> minus_one_limiters,
+                       size_t number_of_channels,
+                       int sample_rate,
+                       size_t number_of_streams,
+                       AudioFrame* audio_frame_for_mixing,
+                       rtc::ArrayView<AudioFrame* const> minus_one_frames);
+
+  // Creates a limiter for a CombineMinusOne() output. Every output needs its
+  // own limiter, since the limiter keeps state between frames.
+  std::unique_ptr<Limiter> CreateLimiter() const;
+
   // Stereo, 48 kHz, 10 ms.
   static constexpr size_t kMaximumNumberOfChannels = 8;
   static constexpr size_t kMaximumChannelSize = 48 * 10;
@@ -48,6 +71,8 @@ class FrameCombiner {
  private:
   std::unique_ptr<ApmDataDumper> data_dumper_;
   std::unique_ptr<MixingBuffer> mixing_buffer_;
+  // Sum of all frames for CombineMinusOne(). Allocated on first use.
+  std::unique_ptr<MixingBuffer> sum_buffer_;
   Limiter limiter_;
   const bool use_limiter_;
 };
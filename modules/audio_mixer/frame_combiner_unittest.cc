@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <initializer_list>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <type_traits>
@@ -276,6 +277,62 @@ TEST(FrameCombiner, CombiningOneFrameShouldNotChangeFrame) {
   }
 }
 
+// Every minus-one mix should match combining the other frames directly, and
+// only the packet infos of the other frames should be kept.
+TEST(FrameCombiner, CombineMinusOneMatchesCombiningOtherFrames) {
+  static constexpr int kSampleRateHz = 48000;
+  static constexpr int kNumChannels = 2;
+  static constexpr size_t kNumSamples = kNumChannels * kSampleRateHz / 100;
+  SetUpFrames(kSampleRateHz, kNumChannels);
+  AudioFrame frame3;
+  frame3.UpdateFrame(0, nullptr, kSampleRateHz / 100, kSampleRateHz,
+                     AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                     kNumChannels);
+  std::vector<AudioFrame*> all_frames = {&frame1, &frame2, &frame3};
+  for (size_t i = 0; i < all_frames.size(); ++i) {
+    int16_t* data = all_frames[i]->mutable_data();
+    for (size_t k = 0; k < kNumSamples; ++k) {
+      data[k] = static_cast<int16_t>((k * (i + 3) * 997) % 24000) - 12000;
+    }
+  }
+
+  FrameCombiner combiner(true);
+  std::vector<std::unique_ptr<Limiter>> limiters;
+  std::vector<Limiter*> limiter_pointers;
+  std::vector<AudioFrame> minus_one_storage(all_frames.size());
+  std::vector<AudioFrame*> minus_one_frames;
+  for (size_t i = 0; i < all_frames.size(); ++i) {
+    limiters.push_back(combiner.CreateLimiter());
+    limiter_pointers.push_back(limiters.back().get());
+    minus_one_frames.push_back(&minus_one_storage[i]);
+  }
+  const std::vector<const AudioFrame*> excluded_frames(all_frames.begin(),
+                                                       all_frames.end());
+  AudioFrame audio_frame_for_mixing;
+  combiner.CombineMinusOne(all_frames, excluded_frames, limiter_pointers,
+                           kNumChannels, kSampleRateHz, all_frames.size(),
+                           &audio_frame_for_mixing, minus_one_frames);
+
+  for (size_t i = 0; i < all_frames.size(); ++i) {
+    SCOPED_TRACE(i);
+    std::vector<AudioFrame*> other_frames;
+    for (AudioFrame* frame : all_frames) {
+      if (frame != all_frames[i]) {
+        other_frames.push_back(frame);
+      }
+    }
+    FrameCombiner reference_combiner(true);
+    AudioFrame expected;
+    reference_combiner.Combine(other_frames, kNumChannels, kSampleRateHz,
+                               other_frames.size(), &expected);
+    EXPECT_THAT(rtc::ArrayView<const int16_t>(minus_one_frames[i]->data(),
+                                              kNumSamples),
+                ElementsAreArray(expected.data(), kNumSamples));
+    EXPECT_EQ(minus_one_frames[i]->timestamp_, expected.timestamp_);
+    EXPECT_TRUE(minus_one_frames[i]->packet_infos_.empty());
+  }
+}
+
 // Send a sine wave through the FrameCombiner, and check that the
 // difference between input and output varies smoothly. Also check
 // that it is inside reasonable bounds. This is to catch issues like
@@ -15,7 +15,6 @@
 #include <iterator>
 
 #include "rtc_base/checks.h"
-#include "system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 
@@ -71,17 +70,9 @@ const float kSqrtHanning128[kFftLength] = {
     0.19509032201613f, 0.17096188876030f, 0.14673047445536f, 0.12241067519922f,
     0.09801714032956f, 0.07356456359967f, 0.04906767432742f, 0.02454122852291f};
 
-bool IsSse2Available() {
-#if defined(WEBRTC_ARCH_X86_FAMILY)
-  return GetCPUInfo(kSSE2) != 0;
-#else
-  return false;
-#endif
-}
-
 }  // namespace
 
-Aec3Fft::Aec3Fft() : ooura_fft_(IsSse2Available()) {}
+Aec3Fft::Aec3Fft() = default;
 
 // TODO(peah): Change x to be std::array once the rest of the code allows this.
 void Aec3Fft::ZeroPaddedFft(rtc::ArrayView<const float> x,
@@ -14,7 +14,7 @@
 #include <array>
 
 #include "api/array_view.h"
-#include "common_audio/third_party/ooura/fft_size_128/ooura_fft.h"
+#include "common_audio/real_fft.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "rtc_base/checks.h"
@@ -36,14 +36,14 @@ class Aec3Fft {
   void Fft(std::array<float, kFftLength>* x, FftData* X) const {
     RTC_DCHECK(x);
     RTC_DCHECK(X);
-    ooura_fft_.Fft(x->data());
+    fft_.Forward(*x);
     X->CopyFromPackedArray(*x);
   }
   // Computes the inverse Fft.
   void Ifft(const FftData& X, std::array<float, kFftLength>* x) const {
     RTC_DCHECK(x);
     X.CopyToPackedArray(x);
-    ooura_fft_.InverseFft(x->data());
+    fft_.Inverse(*x);
   }
 
   // Windows the input using a Hanning window, and then adds padding of
@@ -67,7 +67,7 @@ class Aec3Fft {
                  FftData* X) const;
 
  private:
-  const OouraFft ooura_fft_;
+  const RealFft<kFftLength> fft_;
 };
 
 }  // namespace webrtc
@@ -11,12 +11,18 @@
 #include "modules/audio_processing/aec3/block_buffer.h"
 
 #include <algorithm>
+#include <utility>
 
 namespace webrtc {
 
 BlockBuffer::BlockBuffer(size_t size, size_t num_bands, size_t num_channels)
-    : size(static_cast<int>(size)),
-      buffer(size, Block(num_bands, num_channels)) {}
+    : BlockBuffer(
+          std::make_shared<Storage>(size, Block(num_bands, num_channels))) {}
+
+BlockBuffer::BlockBuffer(std::shared_ptr<Storage> shared_storage)
+    : size(static_cast<int>(shared_storage->size())),
+      storage(std::move(shared_storage)),
+      buffer(*storage) {}
 
 BlockBuffer::~BlockBuffer() = default;
 
@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <vector>
 
 #include "modules/audio_processing/aec3/block.h"
@@ -23,7 +24,14 @@ namespace webrtc {
 // Struct for bundling a circular buffer of two dimensional vector objects
 // together with the read and write indices.
 struct BlockBuffer {
+  using Storage = std::vector<Block>;
+
   BlockBuffer(size_t size, size_t num_bands, size_t num_channels);
+  // Creates a buffer on top of `shared_storage`, which may be shared with
+  // other buffers that keep their own read and write indices.
+  explicit BlockBuffer(std::shared_ptr<Storage> shared_storage);
+  BlockBuffer(const BlockBuffer&) = delete;
+  BlockBuffer& operator=(const BlockBuffer&) = delete;
   ~BlockBuffer();
 
   int IncIndex(int index) const {
@@ -50,7 +58,8 @@ struct BlockBuffer {
   void DecReadIndex() { read = DecIndex(read); }
 
   const int size;
-  std::vector<Block> buffer;
+  const std::shared_ptr<Storage> storage;
+  Storage& buffer;
   int write = 0;
   int read = 0;
 };
@@ -255,6 +255,19 @@ BlockProcessor* BlockProcessor::Create(const EchoCanceller3Config& config,
                 std::move(delay_controller), std::move(echo_remover));
 }
 
+BlockProcessor* BlockProcessor::Create(
+    const EchoCanceller3Config& config,
+    int sample_rate_hz,
+    size_t num_render_channels,
+    size_t num_capture_channels,
+    std::shared_ptr<SharedRenderAnalyzer> shared_render_analyzer) {
+  std::unique_ptr<RenderDelayBuffer> render_buffer(RenderDelayBuffer::Create(
+      config, sample_rate_hz, num_render_channels,
+      std::move(shared_render_analyzer)));
+  return Create(config, sample_rate_hz, num_render_channels,
+                num_capture_channels, std::move(render_buffer));
+}
+
 BlockProcessor* BlockProcessor::Create(
     const EchoCanceller3Config& config,
     int sample_rate_hz,
@@ -22,6 +22,7 @@
 #include "modules/audio_processing/aec3/echo_remover.h"
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/aec3/render_delay_controller.h"
+#include "modules/audio_processing/aec3/shared_render_analyzer.h"
 
 namespace webrtc {
 
@@ -32,6 +33,14 @@ class BlockProcessor {
                                 int sample_rate_hz,
                                 size_t num_render_channels,
                                 size_t num_capture_channels);
+  // Creates a block processor that reads the render analysis from
+  // `shared_render_analyzer`, see RenderDelayBuffer::Create().
+  static BlockProcessor* Create(
+      const EchoCanceller3Config& config,
+      int sample_rate_hz,
+      size_t num_render_channels,
+      size_t num_capture_channels,
+      std::shared_ptr<SharedRenderAnalyzer> shared_render_analyzer);
   // Only used for testing purposes.
   static BlockProcessor* Create(
       const EchoCanceller3Config& config,
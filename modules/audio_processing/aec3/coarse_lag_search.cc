@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/coarse_lag_search.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr float kSmoothing = 0.05f;
+// Minimum ratio between the peak and the mean of the magnitude of the
+// cross-correlation for the peak to be reported.
+constexpr float kPeakToMeanThreshold = 8.f;
+
+}  // namespace
+
+CoarseLagSearch::CoarseLagSearch(size_t sub_block_size, size_t max_lag)
+    : sub_block_size_(sub_block_size),
+      correlation_((max_lag + kDecimationFactor - 1) / kDecimationFactor, 0.f),
+      render_sums_(correlation_.size() + sub_block_size / kDecimationFactor -
+                       1,
+                   0.f) {
+  RTC_DCHECK_EQ(0, sub_block_size % kDecimationFactor);
+  RTC_DCHECK_GE(kBlockSize, sub_block_size);
+  RTC_DCHECK_LT(0, max_lag);
+}
+
+CoarseLagSearch::~CoarseLagSearch() = default;
+
+void CoarseLagSearch::Reset() {
+  std::fill(correlation_.begin(), correlation_.end(), 0.f);
+  peak_lag_ = absl::nullopt;
+}
+
+void CoarseLagSearch::Update(const DownsampledRenderBuffer& render_buffer,
+                             rtc::ArrayView<const float> capture) {
+  RTC_DCHECK_EQ(sub_block_size_, capture.size());
+  const auto& x = render_buffer.buffer;
+  const size_t x_size = x.size();
+  RTC_DCHECK_GE(x_size, render_sums_.size() * kDecimationFactor);
+
+  // The capture sample y[sub_block_size_ - 1 - i] is aligned with the render
+  // sample x[read + i + lag]. Sum groups of samples in that order, so that the
+  // group of capture sums with index j is aligned with the group of render
+  // sums with index j + lag / kDecimationFactor.
+  std::array<float, kBlockSize / kDecimationFactor> capture_sums;
+  const size_t num_capture_sums = sub_block_size_ / kDecimationFactor;
+  for (size_t j = 0; j < num_capture_sums; ++j) {
+    float sum = 0.f;
+    for (size_t k = 0; k < kDecimationFactor; ++k) {
+      sum += capture[sub_block_size_ - 1 - (j * kDecimationFactor + k)];
+    }
+    capture_sums[j] = sum;
+  }
+
+  size_t index = render_buffer.read;
+  for (float& sum : render_sums_) {
+    sum = 0.f;
+    for (size_t k = 0; k < kDecimationFactor; ++k) {
+      sum += x[index];
+      index = index < x_size - 1 ? index + 1 : 0;
+    }
+  }
+
+  float max_magnitude = 0.f;
+  float magnitude_sum = 0.f;
+  size_t max_index = 0;
+  for (size_t m = 0; m < correlation_.size(); ++m) {
+    float c = 0.f;
+    for (size_t j = 0; j < num_capture_sums; ++j) {
+      c += capture_sums[j] * render_sums_[j + m];
+    }
+    correlation_[m] += kSmoothing * (c - correlation_[m]);
+    const float magnitude = std::fabs(correlation_[m]);
+    magnitude_sum += magnitude;
+    if (magnitude > max_magnitude) {
+      max_magnitude = magnitude;
+      max_index = m;
+    }
+  }
+
+  if (max_magnitude > 0.f && max_magnitude * correlation_.size() >
+                                 kPeakToMeanThreshold * magnitude_sum) {
+    peak_lag_ = max_index * kDecimationFactor + kDecimationFactor / 2;
+  } else {
+    peak_lag_ = absl::nullopt;
+  }
+}
+
+}  // namespace webrtc
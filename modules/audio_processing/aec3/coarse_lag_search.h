@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_COARSE_LAG_SEARCH_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_COARSE_LAG_SEARCH_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+
+namespace webrtc {
+
+struct DownsampledRenderBuffer;
+
+// Localizes the echo path delay using a recursively smoothed cross-correlation
+// between the downsampled render and capture signals, computed on signals that
+// are further decimated by summing groups of kDecimationFactor samples. The
+// estimate is coarse, but cheap enough to cover the full range of lags of the
+// matched filters, which then only need to be updated around it.
+class CoarseLagSearch {
+ public:
+  static constexpr size_t kDecimationFactor = 4;
+
+  // Searches lags up to `max_lag` downsampled samples, for capture sub-blocks
+  // of `sub_block_size` samples.
+  CoarseLagSearch(size_t sub_block_size, size_t max_lag);
+  CoarseLagSearch() = delete;
+  CoarseLagSearch(const CoarseLagSearch&) = delete;
+  CoarseLagSearch& operator=(const CoarseLagSearch&) = delete;
+  ~CoarseLagSearch();
+
+  // Resets the cross-correlation.
+  void Reset();
+
+  // Updates the cross-correlation with a sub-block of capture samples, aligned
+  // with the render buffer as in MatchedFilter::Update().
+  void Update(const DownsampledRenderBuffer& render_buffer,
+              rtc::ArrayView<const float> capture);
+
+  // Returns the lag, in downsampled samples, of the peak of the
+  // cross-correlation if the peak clearly stands out.
+  absl::optional<size_t> PeakLag() const { return peak_lag_; }
+
+ private:
+  const size_t sub_block_size_;
+  std::vector<float> correlation_;
+  std::vector<float> render_sums_;
+  absl::optional<size_t> peak_lag_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_COARSE_LAG_SEARCH_H_
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/coarse_lag_search.h"
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/decimator.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::string ProduceDebugText(size_t delay, size_t down_sampling_factor) {
+  rtc::StringBuilder ss;
+  ss << "Delay: " << delay;
+  ss << ", Down sampling factor: " << down_sampling_factor;
+  return ss.Release();
+}
+
+constexpr int kSampleRateHz = 16000;
+constexpr size_t kNumFilters = 10;
+
+// Runs the coarse lag search on a render signal and a capture signal that is
+// either the delayed render signal or uncorrelated noise.
+absl::optional<size_t> RunCoarseLagSearch(size_t down_sampling_factor,
+                                          size_t delay_samples,
+                                          bool correlated) {
+  const size_t sub_block_size = kBlockSize / down_sampling_factor;
+  EchoCanceller3Config config;
+  config.delay.down_sampling_factor = down_sampling_factor;
+  config.delay.num_filters = kNumFilters;
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, /*num_channels=*/1));
+  CoarseLagSearch search(
+      sub_block_size,
+      ((kNumFilters - 1) * kMatchedFilterAlignmentShiftSizeSubBlocks +
+       kMatchedFilterWindowSizeSubBlocks) *
+          sub_block_size);
+  Decimator capture_decimator(down_sampling_factor);
+  DelayBuffer<float> signal_delay_buffer(down_sampling_factor * delay_samples);
+  Random random_generator(42U);
+  Block render(/*num_bands=*/1, /*num_channels=*/1);
+  std::array<float, kBlockSize> capture;
+  std::array<float, kBlockSize> downsampled_capture_data;
+  rtc::ArrayView<float> downsampled_capture(downsampled_capture_data.data(),
+                                            sub_block_size);
+  for (size_t k = 0; k < 300 + delay_samples / sub_block_size; ++k) {
+    RandomizeSampleVector(&random_generator, render.View(0, 0));
+    if (correlated) {
+      signal_delay_buffer.Delay(render.View(0, 0), capture);
+    } else {
+      RandomizeSampleVector(&random_generator, capture);
+    }
+    render_delay_buffer->Insert(render);
+    if (k == 0) {
+      render_delay_buffer->Reset();
+    }
+    render_delay_buffer->PrepareCaptureProcessing();
+    capture_decimator.Decimate(capture, downsampled_capture);
+    search.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                  downsampled_capture);
+  }
+  return search.PeakLag();
+}
+
+}  // namespace
+
+// Verifies that the peak of the cross-correlation is found close to the delay.
+TEST(CoarseLagSearch, FindsDelay) {
+  for (size_t down_sampling_factor : {4, 8}) {
+    for (size_t delay_samples : {0, 100, 700, 1500}) {
+      SCOPED_TRACE(ProduceDebugText(delay_samples, down_sampling_factor));
+      absl::optional<size_t> lag =
+          RunCoarseLagSearch(down_sampling_factor, delay_samples,
+                             /*correlated=*/true);
+      ASSERT_TRUE(lag.has_value());
+      EXPECT_NEAR(delay_samples, *lag, CoarseLagSearch::kDecimationFactor);
+    }
+  }
+}
+
+// Verifies that no lag is reported for uncorrelated render and capture.
+TEST(CoarseLagSearch, NoLagForUncorrelatedSignals) {
+  for (size_t down_sampling_factor : {4, 8}) {
+    SCOPED_TRACE(ProduceDebugText(0, down_sampling_factor));
+    EXPECT_FALSE(RunCoarseLagSearch(down_sampling_factor, /*delay_samples=*/0,
+                                    /*correlated=*/false)
+                     .has_value());
+  }
+}
+
+}  // namespace webrtc
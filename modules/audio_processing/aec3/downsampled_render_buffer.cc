@@ -11,15 +11,22 @@
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 
 #include <algorithm>
+#include <utility>
 
 namespace webrtc {
 
 DownsampledRenderBuffer::DownsampledRenderBuffer(size_t downsampled_buffer_size)
-    : size(static_cast<int>(downsampled_buffer_size)),
-      buffer(downsampled_buffer_size, 0.f) {
+    : DownsampledRenderBuffer(
+          std::make_shared<Storage>(downsampled_buffer_size, 0.f)) {
   std::fill(buffer.begin(), buffer.end(), 0.f);
 }
 
+DownsampledRenderBuffer::DownsampledRenderBuffer(
+    std::shared_ptr<Storage> shared_storage)
+    : size(static_cast<int>(shared_storage->size())),
+      storage(std::move(shared_storage)),
+      buffer(*storage) {}
+
 DownsampledRenderBuffer::~DownsampledRenderBuffer() = default;
 
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <vector>
 
 #include "rtc_base/checks.h"
@@ -21,7 +22,14 @@ namespace webrtc {
 
 // Holds the circular buffer of the downsampled render data.
 struct DownsampledRenderBuffer {
+  using Storage = std::vector<float>;
+
   explicit DownsampledRenderBuffer(size_t downsampled_buffer_size);
+  // Creates a buffer on top of `shared_storage`, which may be shared with
+  // other buffers that keep their own read and write indices.
+  explicit DownsampledRenderBuffer(std::shared_ptr<Storage> shared_storage);
+  DownsampledRenderBuffer(const DownsampledRenderBuffer&) = delete;
+  DownsampledRenderBuffer& operator=(const DownsampledRenderBuffer&) = delete;
   ~DownsampledRenderBuffer();
 
   int IncIndex(int index) const {
@@ -48,7 +56,8 @@ struct DownsampledRenderBuffer {
   void DecReadIndex() { read = DecIndex(read); }
 
   const int size;
-  std::vector<float> buffer;
+  const std::shared_ptr<Storage> storage;
+  Storage& buffer;
   int write = 0;
   int read = 0;
 };
@@ -722,13 +722,15 @@ EchoCanceller3::EchoCanceller3(
     const absl::optional<EchoCanceller3Config>& multichannel_config,
     int sample_rate_hz,
     size_t num_render_channels,
-    size_t num_capture_channels)
+    size_t num_capture_channels,
+    std::shared_ptr<SharedRenderAnalyzer> shared_render_analyzer)
     : data_dumper_(new ApmDataDumper(instance_count_.fetch_add(1) + 1)),
       config_(AdjustConfig(config)),
       sample_rate_hz_(sample_rate_hz),
       num_bands_(NumBandsForRate(sample_rate_hz_)),
       num_render_input_channels_(num_render_channels),
       num_capture_channels_(num_capture_channels),
+      shared_render_analyzer_(std::move(shared_render_analyzer)),
       config_selector_(AdjustConfig(config),
                        multichannel_config,
                        num_render_input_channels_),
@@ -815,7 +817,8 @@ void EchoCanceller3::Initialize() {
 
   block_processor_.reset(BlockProcessor::Create(
       config_selector_.active_config(), sample_rate_hz_,
-      num_render_channels_to_aec_, num_capture_channels_));
+      num_render_channels_to_aec_, num_capture_channels_,
+      shared_render_analyzer_));
 
   render_sub_frame_view_ = std::vector<std::vector<rtc::ArrayView<float>>>(
       num_bands_,
@@ -28,6 +28,7 @@
 #include "modules/audio_processing/aec3/config_selector.h"
 #include "modules/audio_processing/aec3/frame_blocker.h"
 #include "modules/audio_processing/aec3/multi_channel_content_detector.h"
+#include "modules/audio_processing/aec3/shared_render_analyzer.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
@@ -86,6 +87,11 @@ class Aec3RenderQueueItemVerifier {
 //
 // The class is supposed to be used in a non-concurrent manner apart from the
 // AnalyzeRender call which can be called concurrently with the other methods.
+//
+// Echo cancellers that are created at the same time and receive the same
+// render frames may share the render analysis through
+// `shared_render_analyzer`. Their capture processing must then run on the
+// same thread.
 class EchoCanceller3 : public EchoControl {
  public:
   EchoCanceller3(
@@ -93,7 +99,8 @@ class EchoCanceller3 : public EchoControl {
       const absl::optional<EchoCanceller3Config>& multichannel_config,
       int sample_rate_hz,
       size_t num_render_channels,
-      size_t num_capture_channels);
+      size_t num_capture_channels,
+      std::shared_ptr<SharedRenderAnalyzer> shared_render_analyzer = nullptr);
 
   ~EchoCanceller3() override;
 
@@ -194,6 +201,7 @@ class EchoCanceller3 : public EchoControl {
   const size_t num_render_input_channels_;
   size_t num_render_channels_to_aec_;
   const size_t num_capture_channels_;
+  const std::shared_ptr<SharedRenderAnalyzer> shared_render_analyzer_;
   ConfigSelector config_selector_;
   MultiChannelContentDetector multichannel_content_detector_;
   std::unique_ptr<BlockFramer> linear_output_framer_
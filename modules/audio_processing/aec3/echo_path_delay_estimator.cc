@@ -44,7 +44,8 @@ EchoPathDelayEstimator::EchoPathDelayEstimator(
           config.delay.delay_estimate_smoothing,
           config.delay.delay_estimate_smoothing_delay_found,
           config.delay.delay_candidate_detection_threshold,
-          config.delay.detect_pre_echo),
+          config.delay.detect_pre_echo,
+          config.delay.coarse_lag_search),
       matched_filter_lag_aggregator_(data_dumper_,
                                      matched_filter_.GetMaxFilterLag(),
                                      config.delay) {
@@ -10,11 +10,13 @@
 
 #include "modules/audio_processing/aec3/fft_buffer.h"
 
+#include <utility>
+
 namespace webrtc {
 
 FftBuffer::FftBuffer(size_t size, size_t num_channels)
-    : size(static_cast<int>(size)),
-      buffer(size, std::vector<FftData>(num_channels)) {
+    : FftBuffer(
+          std::make_shared<Storage>(size, std::vector<FftData>(num_channels))) {
   for (auto& block : buffer) {
     for (auto& channel_fft_data : block) {
       channel_fft_data.Clear();
@@ -22,6 +24,11 @@ FftBuffer::FftBuffer(size_t size, size_t num_channels)
   }
 }
 
+FftBuffer::FftBuffer(std::shared_ptr<Storage> shared_storage)
+    : size(static_cast<int>(shared_storage->size())),
+      storage(std::move(shared_storage)),
+      buffer(*storage) {}
+
 FftBuffer::~FftBuffer() = default;
 
 }  // namespace webrtc
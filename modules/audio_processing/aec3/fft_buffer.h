@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <vector>
 
 #include "modules/audio_processing/aec3/fft_data.h"
@@ -23,7 +24,14 @@ namespace webrtc {
 // Struct for bundling a circular buffer of FftData objects together with the
 // read and write indices.
 struct FftBuffer {
+  using Storage = std::vector<std::vector<FftData>>;
+
   FftBuffer(size_t size, size_t num_channels);
+  // Creates a buffer on top of `shared_storage`, which may be shared with
+  // other buffers that keep their own read and write indices.
+  explicit FftBuffer(std::shared_ptr<Storage> shared_storage);
+  FftBuffer(const FftBuffer&) = delete;
+  FftBuffer& operator=(const FftBuffer&) = delete;
   ~FftBuffer();
 
   int IncIndex(int index) const {
@@ -50,7 +58,8 @@ struct FftBuffer {
   void DecReadIndex() { read = DecIndex(read); }
 
   const int size;
-  std::vector<std::vector<FftData>> buffer;
+  const std::shared_ptr<Storage> storage;
+  Storage& buffer;
   int write = 0;
   int read = 0;
 };
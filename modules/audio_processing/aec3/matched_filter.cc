@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
 #include <numeric>
 
 #include "absl/types/optional.h"
@@ -672,7 +673,8 @@ MatchedFilter::MatchedFilter(ApmDataDumper* data_dumper,
                              float smoothing_fast,
                              float smoothing_slow,
                              float matching_filter_threshold,
-                             bool detect_pre_echo)
+                             bool detect_pre_echo,
+                             bool coarse_lag_search)
     : data_dumper_(data_dumper),
       optimization_(optimization),
       sub_block_size_(sub_block_size),
@@ -686,7 +688,15 @@ MatchedFilter::MatchedFilter(ApmDataDumper* data_dumper,
       smoothing_slow_(smoothing_slow),
       matching_filter_threshold_(matching_filter_threshold),
       detect_pre_echo_(detect_pre_echo),
-      pre_echo_config_(FetchPreEchoConfiguration()) {
+      pre_echo_config_(FetchPreEchoConfiguration()),
+      coarse_lag_search_(
+          coarse_lag_search
+              ? std::make_unique<CoarseLagSearch>(
+                    sub_block_size_,
+                    (num_matched_filters - 1) * filter_intra_lag_shift_ +
+                        window_size_sub_blocks * sub_block_size_)
+              : nullptr),
+      filters_to_update_(num_matched_filters, true) {
   RTC_DCHECK(data_dumper);
   RTC_DCHECK_LT(0, window_size_sub_blocks);
   RTC_DCHECK((kBlockSize % sub_block_size) == 0);
@@ -717,6 +727,9 @@ void MatchedFilter::Reset(bool full_reset) {
 
   winner_lag_ = absl::nullopt;
   reported_lag_estimate_ = absl::nullopt;
+  if (coarse_lag_search_) {
+    coarse_lag_search_->Reset();
+  }
   if (pre_echo_config_.mode != 3 || full_reset) {
     for (auto& e : accumulated_error_) {
       std::fill(e.begin(), e.end(), 1.0f);
@@ -743,7 +756,12 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
     error_sum_anchor += y[k] * y[k];
   }
 
-  // Apply all matched filters.
+  if (coarse_lag_search_) {
+    coarse_lag_search_->Update(render_buffer, y);
+    SelectFiltersToUpdate();
+  }
+
+  // Apply the matched filters.
   float winner_error_sum = error_sum_anchor;
   winner_lag_ = absl::nullopt;
   reported_lag_estimate_ = absl::nullopt;
@@ -752,6 +770,11 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
   const int num_filters = static_cast<int>(filters_.size());
   int winner_index = -1;
   for (int n = 0; n < num_filters; ++n) {
+    if (!filters_to_update_[n]) {
+      previous_lag_estimate = absl::nullopt;
+      alignment_shift += filter_intra_lag_shift_;
+      continue;
+    }
     float error_sum = 0.f;
     bool filters_updated = false;
     const bool compute_pre_echo =
@@ -854,6 +877,29 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
   }
 }
 
+void MatchedFilter::SelectFiltersToUpdate() {
+  const absl::optional<size_t> coarse_lag = coarse_lag_search_->PeakLag();
+  if (!coarse_lag) {
+    std::fill(filters_to_update_.begin(), filters_to_update_.end(), true);
+    return;
+  }
+
+  std::fill(filters_to_update_.begin(), filters_to_update_.end(), false);
+  size_t alignment_shift = 0;
+  for (size_t n = 0; n < filters_.size(); ++n) {
+    filters_to_update_[n] = *coarse_lag >= alignment_shift &&
+                            *coarse_lag < alignment_shift + filters_[n].size();
+    alignment_shift += filter_intra_lag_shift_;
+  }
+  if (last_detected_best_lag_filter_ >= 0) {
+    filters_to_update_[last_detected_best_lag_filter_] = true;
+  }
+  // Keep updating all filters at a low rate, which allows the delay estimate to
+  // recover if the coarse search locks on a wrong lag.
+  filters_to_update_[next_probed_filter_] = true;
+  next_probed_filter_ = (next_probed_filter_ + 1) % filters_.size();
+}
+
 void MatchedFilter::LogFilterProperties(int sample_rate_hz,
                                         size_t shift,
                                         size_t downsampling_factor) const {
@@ -13,11 +13,13 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <vector>
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/coarse_lag_search.h"
 #include "rtc_base/gtest_prod_util.h"
 #include "rtc_base/system/arch.h"
 
@@ -93,7 +95,10 @@ size_t MaxSquarePeakIndex(rtc::ArrayView<const float> h);
 }  // namespace aec3
 
 // Produces recursively updated cross-correlation estimates for several signal
-// shifts where the intra-shift spacing is uniform.
+// shifts where the intra-shift spacing is uniform. With `coarse_lag_search`,
+// only the filters around the lag found by a CoarseLagSearch are updated, as
+// well as the filter with the most recent lag estimate and one other filter in
+// turn. All filters are updated while the coarse lag is unknown.
 class MatchedFilter {
  public:
   // Stores properties for the lag estimate corresponding to a particular signal
@@ -121,7 +126,8 @@ class MatchedFilter {
                 float smoothing_fast,
                 float smoothing_slow,
                 float matching_filter_threshold,
-                bool detect_pre_echo);
+                bool detect_pre_echo,
+                bool coarse_lag_search = false);
 
   MatchedFilter() = delete;
   MatchedFilter(const MatchedFilter&) = delete;
@@ -163,6 +169,7 @@ class MatchedFilter {
     return pre_echo_config_;
   }
   void Dump();
+  void SelectFiltersToUpdate();
 
   ApmDataDumper* const data_dumper_;
   const Aec3Optimization optimization_;
@@ -183,6 +190,9 @@ class MatchedFilter {
   const float matching_filter_threshold_;
   const bool detect_pre_echo_;
   const PreEchoConfiguration pre_echo_config_;
+  const std::unique_ptr<CoarseLagSearch> coarse_lag_search_;
+  std::vector<bool> filters_to_update_;
+  size_t next_probed_filter_ = 0;
 };
 
 }  // namespace webrtc
@@ -315,6 +315,68 @@ TEST_P(MatchedFilterTest, LagEstimation) {
   }
 }
 
+// Verifies that the matched filter produces proper lag estimates when only the
+// filters around the lag found by the coarse lag search are updated.
+TEST(MatchedFilter, LagEstimationWithCoarseLagSearch) {
+  Random random_generator(42U);
+  constexpr size_t kNumChannels = 1;
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+
+  for (auto down_sampling_factor : kDownSamplingFactors) {
+    const size_t sub_block_size = kBlockSize / down_sampling_factor;
+
+    Block render(kNumBands, kNumChannels);
+    std::vector<float> capture(kBlockSize, 0.f);
+    ApmDataDumper data_dumper(0);
+    for (size_t delay_samples : {5, 150, 800, 1000, 1800}) {
+      SCOPED_TRACE(ProduceDebugText(delay_samples, down_sampling_factor));
+      EchoCanceller3Config config;
+      config.delay.down_sampling_factor = down_sampling_factor;
+      config.delay.num_filters = kNumMatchedFilters;
+      Decimator capture_decimator(down_sampling_factor);
+      DelayBuffer<float> signal_delay_buffer(down_sampling_factor *
+                                             delay_samples);
+      MatchedFilter filter(
+          &data_dumper, DetectOptimization(), sub_block_size,
+          kWindowSizeSubBlocks, kNumMatchedFilters, kAlignmentShiftSubBlocks,
+          150, config.delay.delay_estimate_smoothing,
+          config.delay.delay_estimate_smoothing_delay_found,
+          config.delay.delay_candidate_detection_threshold,
+          /*detect_pre_echo=*/true, /*coarse_lag_search=*/true);
+
+      std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+          RenderDelayBuffer::Create(config, kSampleRateHz, kNumChannels));
+
+      // Analyze the correlation between render and capture.
+      for (size_t k = 0; k < (600 + delay_samples / sub_block_size); ++k) {
+        for (size_t band = 0; band < kNumBands; ++band) {
+          RandomizeSampleVector(&random_generator, render.View(band, 0));
+        }
+        signal_delay_buffer.Delay(render.View(/*band=*/0, /*channel=*/0),
+                                  capture);
+        render_delay_buffer->Insert(render);
+
+        if (k == 0) {
+          render_delay_buffer->Reset();
+        }
+
+        render_delay_buffer->PrepareCaptureProcessing();
+        std::array<float, kBlockSize> downsampled_capture_data;
+        rtc::ArrayView<float> downsampled_capture(
+            downsampled_capture_data.data(), sub_block_size);
+        capture_decimator.Decimate(capture, downsampled_capture);
+        filter.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                      downsampled_capture, /*use_slow_smoothing=*/false);
+      }
+
+      auto lag_estimate = filter.GetBestLagEstimate();
+      ASSERT_TRUE(lag_estimate.has_value());
+      EXPECT_EQ(delay_samples, lag_estimate->lag);
+    }
+  }
+}
+
 // Test the pre echo estimation.
 TEST_P(MatchedFilterTest, PreEchoEstimation) {
   const bool kDetectPreEcho = GetParam();
@@ -17,20 +17,18 @@
 #include <cmath>
 #include <memory>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
-#include "modules/audio_processing/aec3/aec3_fft.h"
-#include "modules/audio_processing/aec3/alignment_mixer.h"
 #include "modules/audio_processing/aec3/block_buffer.h"
-#include "modules/audio_processing/aec3/decimator.h"
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 #include "modules/audio_processing/aec3/fft_buffer.h"
-#include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
+#include "modules/audio_processing/aec3/shared_render_analyzer.h"
 #include "modules/audio_processing/aec3/spectrum_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
@@ -43,8 +41,7 @@ namespace {
 class RenderDelayBufferImpl final : public RenderDelayBuffer {
  public:
   RenderDelayBufferImpl(const EchoCanceller3Config& config,
-                        int sample_rate_hz,
-                        size_t num_render_channels);
+                        std::shared_ptr<SharedRenderAnalyzer> analyzer);
   RenderDelayBufferImpl() = delete;
   ~RenderDelayBufferImpl() override;
 
@@ -56,7 +53,7 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   void AlignFromExternalDelay() override;
   size_t Delay() const override { return ComputeDelay(); }
   size_t MaxDelay() const override {
-    return blocks_.buffer.size() - 1 - buffer_headroom_;
+    return block_capacity_ - 1 - buffer_headroom_;
   }
   RenderBuffer* GetRenderBuffer() override { return &echo_remover_buffer_; }
 
@@ -71,23 +68,22 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
  private:
   static std::atomic<int> instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
-  const Aec3Optimization optimization_;
   const EchoCanceller3Config config_;
-  const float render_linear_amplitude_gain_;
   const rtc::LoggingSeverity delay_log_level_;
-  size_t down_sampling_factor_;
   const int sub_block_size_;
+  const std::shared_ptr<SharedRenderAnalyzer> analyzer_;
+  // Number of blocks and downsampled samples that are buffered. The storage
+  // of the buffers may be larger when it is shared with other instances.
+  const int block_capacity_;
+  const int low_rate_capacity_;
   BlockBuffer blocks_;
   SpectrumBuffer spectra_;
   FftBuffer ffts_;
   absl::optional<size_t> delay_;
   RenderBuffer echo_remover_buffer_;
   DownsampledRenderBuffer low_rate_;
-  AlignmentMixer render_mixer_;
-  Decimator render_decimator_;
-  const Aec3Fft fft_;
-  std::vector<float> render_ds_;
   const int buffer_headroom_;
+  int64_t num_inserted_blocks_ = 0;
   bool last_call_was_render_ = false;
   int num_api_calls_in_a_row_ = 0;
   int max_observed_jitter_ = 1;
@@ -103,56 +99,54 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   int MapDelayToTotalDelay(size_t delay) const;
   int ComputeDelay() const;
   void ApplyTotalDelay(int delay);
-  void InsertBlock(const Block& block, int previous_write);
   bool DetectActiveRender(rtc::ArrayView<const float> x) const;
   bool DetectExcessRenderBlocks();
   void IncrementWriteIndices();
+  void SyncWriteIndicesWithAnalyzer();
   void IncrementLowRateReadIndices();
   void IncrementReadIndices();
+  int UnreadBlocks() const;
+  int UnreadLowRateSamples() const;
   bool RenderOverrun();
   bool RenderUnderrun();
 };
 
 std::atomic<int> RenderDelayBufferImpl::instance_count_ = 0;
 
-RenderDelayBufferImpl::RenderDelayBufferImpl(const EchoCanceller3Config& config,
-                                             int sample_rate_hz,
-                                             size_t num_render_channels)
+RenderDelayBufferImpl::RenderDelayBufferImpl(
+    const EchoCanceller3Config& config,
+    std::shared_ptr<SharedRenderAnalyzer> analyzer)
     : data_dumper_(new ApmDataDumper(instance_count_.fetch_add(1) + 1)),
-      optimization_(DetectOptimization()),
       config_(config),
-      render_linear_amplitude_gain_(
-          std::pow(10.0f, config_.render_levels.render_power_gain_db / 20.f)),
       delay_log_level_(config_.delay.log_warning_on_delay_changes
                            ? rtc::LS_WARNING
                            : rtc::LS_VERBOSE),
-      down_sampling_factor_(config.delay.down_sampling_factor),
-      sub_block_size_(static_cast<int>(down_sampling_factor_ > 0
-                                           ? kBlockSize / down_sampling_factor_
-                                           : kBlockSize)),
-      blocks_(GetRenderDelayBufferSize(down_sampling_factor_,
-                                       config.delay.num_filters,
-                                       config.filter.refined.length_blocks),
-              NumBandsForRate(sample_rate_hz),
-              num_render_channels),
-      spectra_(blocks_.buffer.size(), num_render_channels),
-      ffts_(blocks_.buffer.size(), num_render_channels),
+      sub_block_size_(static_cast<int>(
+          config.delay.down_sampling_factor > 0
+              ? kBlockSize / config.delay.down_sampling_factor
+              : kBlockSize)),
+      analyzer_(std::move(analyzer)),
+      block_capacity_(static_cast<int>(
+          GetRenderDelayBufferSize(config.delay.down_sampling_factor,
+                                   config.delay.num_filters,
+                                   config.filter.refined.length_blocks))),
+      low_rate_capacity_(static_cast<int>(GetDownSampledBufferSize(
+          config.delay.down_sampling_factor,
+          config.delay.num_filters))),
+      blocks_(analyzer_->blocks().storage),
+      spectra_(analyzer_->spectra().storage),
+      ffts_(analyzer_->ffts().storage),
       delay_(config_.delay.default_delay),
       echo_remover_buffer_(&blocks_, &spectra_, &ffts_),
-      low_rate_(GetDownSampledBufferSize(down_sampling_factor_,
-                                         config.delay.num_filters)),
-      render_mixer_(num_render_channels, config.delay.render_alignment_mixing),
-      render_decimator_(down_sampling_factor_),
-      fft_(),
-      render_ds_(sub_block_size_, 0.f),
+      low_rate_(analyzer_->low_rate().storage),
       buffer_headroom_(config.filter.refined.length_blocks) {
-  RTC_DCHECK_EQ(blocks_.buffer.size(), ffts_.buffer.size());
-  RTC_DCHECK_EQ(spectra_.buffer.size(), ffts_.buffer.size());
-  for (size_t i = 0; i < blocks_.buffer.size(); ++i) {
-    RTC_DCHECK_EQ(blocks_.buffer[i].NumChannels(), ffts_.buffer[i].size());
-    RTC_DCHECK_EQ(spectra_.buffer[i].size(), ffts_.buffer[i].size());
-  }
+  RTC_DCHECK_EQ(blocks_.size,
+                block_capacity_ + analyzer_->MaxRenderLagBlocks());
+  RTC_DCHECK_EQ(low_rate_.size,
+                low_rate_capacity_ +
+                    sub_block_size_ * analyzer_->MaxRenderLagBlocks());
 
+  SyncWriteIndicesWithAnalyzer();
   Reset();
 }
 
@@ -217,8 +211,8 @@ RenderDelayBuffer::BufferingEvent RenderDelayBufferImpl::Insert(
   }
 
   // Increase the write indices to where the new blocks should be written.
-  const int previous_write = blocks_.write;
   IncrementWriteIndices();
+  ++num_inserted_blocks_;
 
   // Allow overrun and do a reset when render overrun occurrs due to more render
   // data being inserted than capture data is received.
@@ -232,8 +226,26 @@ RenderDelayBuffer::BufferingEvent RenderDelayBufferImpl::Insert(
     render_activity_ = render_activity_counter_ >= 20;
   }
 
-  // Insert the new render block into the specified position.
-  InsertBlock(block, previous_write);
+  // Analyze the new render block, unless another user of the analyzer has
+  // already done that. The analyzed blocks are identical as all users receive
+  // the same render signal.
+  const int64_t render_lag =
+      analyzer_->NumAnalyzedBlocks() - num_inserted_blocks_;
+  if (render_lag < 0) {
+    RTC_DCHECK_EQ(render_lag, -1);
+    analyzer_->Insert(block);
+    RTC_DCHECK_EQ(blocks_.write, analyzer_->blocks().write);
+    RTC_DCHECK_EQ(low_rate_.write, analyzer_->low_rate().write);
+  } else if (render_lag >
+             static_cast<int64_t>(analyzer_->MaxRenderLagBlocks())) {
+    // The analysis of the block has been overwritten. Continue from the most
+    // recently analyzed block instead.
+    RTC_LOG_V(delay_log_level_)
+        << "Render analysis lag of " << render_lag
+        << " blocks exceeded at render block " << render_call_counter_;
+    SyncWriteIndicesWithAnalyzer();
+    event = BufferingEvent::kRenderOverrun;
+  }
 
   if (event != BufferingEvent::kNone) {
     Reset();
@@ -364,6 +376,9 @@ int RenderDelayBufferImpl::ComputeDelay() const {
 void RenderDelayBufferImpl::ApplyTotalDelay(int delay) {
   RTC_LOG_V(delay_log_level_)
       << "Applying total delay of " << delay << " blocks.";
+  // Wrap the delay as for a buffer of `block_capacity_` blocks, also when the
+  // storage is larger.
+  delay = (block_capacity_ + delay % block_capacity_) % block_capacity_;
   blocks_.read = blocks_.OffsetIndex(blocks_.write, -delay);
   spectra_.read = spectra_.OffsetIndex(spectra_.write, delay);
   ffts_.read = ffts_.OffsetIndex(ffts_.write, delay);
@@ -380,52 +395,6 @@ void RenderDelayBufferImpl::AlignFromExternalDelay() {
   }
 }
 
-// Inserts a block into the render buffers.
-void RenderDelayBufferImpl::InsertBlock(const Block& block,
-                                        int previous_write) {
-  auto& b = blocks_;
-  auto& lr = low_rate_;
-  auto& ds = render_ds_;
-  auto& f = ffts_;
-  auto& s = spectra_;
-  const size_t num_bands = b.buffer[b.write].NumBands();
-  const size_t num_render_channels = b.buffer[b.write].NumChannels();
-  RTC_DCHECK_EQ(block.NumBands(), num_bands);
-  RTC_DCHECK_EQ(block.NumChannels(), num_render_channels);
-  for (size_t band = 0; band < num_bands; ++band) {
-    for (size_t ch = 0; ch < num_render_channels; ++ch) {
-      std::copy(block.begin(band, ch), block.end(band, ch),
-                b.buffer[b.write].begin(band, ch));
-    }
-  }
-
-  if (render_linear_amplitude_gain_ != 1.f) {
-    for (size_t band = 0; band < num_bands; ++band) {
-      for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        rtc::ArrayView<float, kBlockSize> b_view =
-            b.buffer[b.write].View(band, ch);
-        for (float& sample : b_view) {
-          sample *= render_linear_amplitude_gain_;
-        }
-      }
-    }
-  }
-
-  std::array<float, kBlockSize> downmixed_render;
-  render_mixer_.ProduceOutput(b.buffer[b.write], downmixed_render);
-  render_decimator_.Decimate(downmixed_render, ds);
-  data_dumper_->DumpWav("aec3_render_decimator_output", ds.size(), ds.data(),
-                        16000 / down_sampling_factor_, 1);
-  std::copy(ds.rbegin(), ds.rend(), lr.buffer.begin() + lr.write);
-  for (int channel = 0; channel < b.buffer[b.write].NumChannels(); ++channel) {
-    fft_.PaddedFft(b.buffer[b.write].View(/*band=*/0, channel),
-                   b.buffer[previous_write].View(/*band=*/0, channel),
-                   &f.buffer[f.write][channel]);
-    f.buffer[f.write][channel].Spectrum(optimization_,
-                                        s.buffer[s.write][channel]);
-  }
-}
-
 bool RenderDelayBufferImpl::DetectActiveRender(
     rtc::ArrayView<const float> x) const {
   const float x_energy = std::inner_product(x.begin(), x.end(), x.begin(), 0.f);
@@ -474,6 +443,15 @@ void RenderDelayBufferImpl::IncrementWriteIndices() {
   ffts_.DecWriteIndex();
 }
 
+// Moves the write indices to the most recently analyzed block.
+void RenderDelayBufferImpl::SyncWriteIndicesWithAnalyzer() {
+  low_rate_.write = analyzer_->low_rate().write;
+  blocks_.write = analyzer_->blocks().write;
+  spectra_.write = analyzer_->spectra().write;
+  ffts_.write = analyzer_->ffts().write;
+  num_inserted_blocks_ = analyzer_->NumAnalyzedBlocks();
+}
+
 // Increments the read indices of the low rate render buffers.
 void RenderDelayBufferImpl::IncrementLowRateReadIndices() {
   low_rate_.UpdateReadIndex(-sub_block_size_);
@@ -488,9 +466,23 @@ void RenderDelayBufferImpl::IncrementReadIndices() {
   }
 }
 
-// Checks for a render buffer overrun.
+// Returns the number of blocks that have been written but not read.
+int RenderDelayBufferImpl::UnreadBlocks() const {
+  return (blocks_.size + blocks_.write - blocks_.read) % blocks_.size;
+}
+
+// Returns the number of downsampled samples that have been written but not
+// read.
+int RenderDelayBufferImpl::UnreadLowRateSamples() const {
+  return (low_rate_.size + low_rate_.read - low_rate_.write) % low_rate_.size;
+}
+
+// Checks for a render buffer overrun. The buffers overrun when the unread data
+// fills their capacity, which for storage that is not shared means that the
+// read and write indices meet.
 bool RenderDelayBufferImpl::RenderOverrun() {
-  return low_rate_.read == low_rate_.write || blocks_.read == blocks_.write;
+  return UnreadLowRateSamples() % low_rate_capacity_ == 0 ||
+         UnreadBlocks() % block_capacity_ == 0;
 }
 
 // Checks for a render buffer underrun.
@@ -503,7 +495,26 @@ bool RenderDelayBufferImpl::RenderUnderrun() {
 RenderDelayBuffer* RenderDelayBuffer::Create(const EchoCanceller3Config& config,
                                              int sample_rate_hz,
                                              size_t num_render_channels) {
-  return new RenderDelayBufferImpl(config, sample_rate_hz, num_render_channels);
+  return Create(config, sample_rate_hz, num_render_channels, nullptr);
+}
+
+RenderDelayBuffer* RenderDelayBuffer::Create(
+    const EchoCanceller3Config& config,
+    int sample_rate_hz,
+    size_t num_render_channels,
+    std::shared_ptr<SharedRenderAnalyzer> shared_render_analyzer) {
+  if (shared_render_analyzer &&
+      !shared_render_analyzer->IsCompatible(config, sample_rate_hz,
+                                            num_render_channels)) {
+    RTC_LOG(LS_INFO) << "Not using an incompatible shared render analyzer.";
+    shared_render_analyzer = nullptr;
+  }
+  if (!shared_render_analyzer) {
+    shared_render_analyzer = std::make_shared<SharedRenderAnalyzer>(
+        config, sample_rate_hz, num_render_channels,
+        /*max_render_lag_blocks=*/0);
+  }
+  return new RenderDelayBufferImpl(config, std::move(shared_render_analyzer));
 }
 
 }  // namespace webrtc
@@ -13,12 +13,14 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <vector>
 
 #include "api/audio/echo_canceller3_config.h"
 #include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
+#include "modules/audio_processing/aec3/shared_render_analyzer.h"
 
 namespace webrtc {
 
@@ -36,6 +38,15 @@ class RenderDelayBuffer {
   static RenderDelayBuffer* Create(const EchoCanceller3Config& config,
                                    int sample_rate_hz,
                                    size_t num_render_channels);
+  // Creates a buffer that reads the render analysis from
+  // `shared_render_analyzer`, if that is compatible with the specified setup,
+  // instead of analyzing the render signal itself. All buffers sharing an
+  // analyzer must be fed the same render signal.
+  static RenderDelayBuffer* Create(
+      const EchoCanceller3Config& config,
+      int sample_rate_hz,
+      size_t num_render_channels,
+      std::shared_ptr<SharedRenderAnalyzer> shared_render_analyzer);
   virtual ~RenderDelayBuffer() = default;
 
   // Resets the buffer alignment.
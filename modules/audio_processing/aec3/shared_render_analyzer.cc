@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/shared_render_analyzer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "api/array_view.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+size_t SubBlockSize(const EchoCanceller3Config& config) {
+  const size_t down_sampling_factor = config.delay.down_sampling_factor;
+  return down_sampling_factor > 0 ? kBlockSize / down_sampling_factor
+                                  : kBlockSize;
+}
+
+bool SameAlignmentMixing(
+    const EchoCanceller3Config::Delay::AlignmentMixing& a,
+    const EchoCanceller3Config::Delay::AlignmentMixing& b) {
+  return a.downmix == b.downmix &&
+         a.adaptive_selection == b.adaptive_selection &&
+         a.activity_power_threshold == b.activity_power_threshold &&
+         a.prefer_first_two_channels == b.prefer_first_two_channels;
+}
+
+}  // namespace
+
+std::atomic<int> SharedRenderAnalyzer::instance_count_ = 0;
+
+SharedRenderAnalyzer::SharedRenderAnalyzer(const EchoCanceller3Config& config,
+                                           int sample_rate_hz,
+                                           size_t num_render_channels,
+                                           size_t max_render_lag_blocks)
+    : data_dumper_(new ApmDataDumper(instance_count_.fetch_add(1) + 1)),
+      optimization_(DetectOptimization()),
+      config_(config),
+      sample_rate_hz_(sample_rate_hz),
+      max_render_lag_blocks_(max_render_lag_blocks),
+      render_linear_amplitude_gain_(
+          std::pow(10.0f, config_.render_levels.render_power_gain_db / 20.f)),
+      down_sampling_factor_(config.delay.down_sampling_factor),
+      sub_block_size_(static_cast<int>(SubBlockSize(config))),
+      blocks_(GetRenderDelayBufferSize(down_sampling_factor_,
+                                       config.delay.num_filters,
+                                       config.filter.refined.length_blocks) +
+                  max_render_lag_blocks,
+              NumBandsForRate(sample_rate_hz),
+              num_render_channels),
+      spectra_(blocks_.buffer.size(), num_render_channels),
+      ffts_(blocks_.buffer.size(), num_render_channels),
+      low_rate_(GetDownSampledBufferSize(down_sampling_factor_,
+                                         config.delay.num_filters) +
+                max_render_lag_blocks * sub_block_size_),
+      render_mixer_(num_render_channels, config.delay.render_alignment_mixing),
+      render_decimator_(down_sampling_factor_),
+      fft_(),
+      render_ds_(sub_block_size_, 0.f) {
+  RTC_DCHECK_EQ(blocks_.buffer.size(), ffts_.buffer.size());
+  RTC_DCHECK_EQ(spectra_.buffer.size(), ffts_.buffer.size());
+  for (size_t i = 0; i < blocks_.buffer.size(); ++i) {
+    RTC_DCHECK_EQ(blocks_.buffer[i].NumChannels(), ffts_.buffer[i].size());
+    RTC_DCHECK_EQ(spectra_.buffer[i].size(), ffts_.buffer[i].size());
+  }
+}
+
+SharedRenderAnalyzer::~SharedRenderAnalyzer() = default;
+
+bool SharedRenderAnalyzer::IsCompatible(const EchoCanceller3Config& config,
+                                        int sample_rate_hz,
+                                        size_t num_render_channels) const {
+  return NumBandsForRate(sample_rate_hz) == NumBandsForRate(sample_rate_hz_) &&
+         num_render_channels ==
+             static_cast<size_t>(blocks_.buffer[0].NumChannels()) &&
+         config.delay.down_sampling_factor ==
+             config_.delay.down_sampling_factor &&
+         config.delay.num_filters == config_.delay.num_filters &&
+         config.filter.refined.length_blocks ==
+             config_.filter.refined.length_blocks &&
+         config.render_levels.render_power_gain_db ==
+             config_.render_levels.render_power_gain_db &&
+         SameAlignmentMixing(config.delay.render_alignment_mixing,
+                             config_.delay.render_alignment_mixing);
+}
+
+void SharedRenderAnalyzer::Insert(const Block& block) {
+  const int previous_write = blocks_.write;
+  low_rate_.UpdateWriteIndex(-sub_block_size_);
+  blocks_.IncWriteIndex();
+  spectra_.DecWriteIndex();
+  ffts_.DecWriteIndex();
+  ++num_analyzed_blocks_;
+
+  auto& b = blocks_;
+  auto& lr = low_rate_;
+  auto& ds = render_ds_;
+  auto& f = ffts_;
+  auto& s = spectra_;
+  const size_t num_bands = b.buffer[b.write].NumBands();
+  const size_t num_render_channels = b.buffer[b.write].NumChannels();
+  RTC_DCHECK_EQ(block.NumBands(), num_bands);
+  RTC_DCHECK_EQ(block.NumChannels(), num_render_channels);
+  for (size_t band = 0; band < num_bands; ++band) {
+    for (size_t ch = 0; ch < num_render_channels; ++ch) {
+      std::copy(block.begin(band, ch), block.end(band, ch),
+                b.buffer[b.write].begin(band, ch));
+    }
+  }
+
+  if (render_linear_amplitude_gain_ != 1.f) {
+    for (size_t band = 0; band < num_bands; ++band) {
+      for (size_t ch = 0; ch < num_render_channels; ++ch) {
+        rtc::ArrayView<float, kBlockSize> b_view =
+            b.buffer[b.write].View(band, ch);
+        for (float& sample : b_view) {
+          sample *= render_linear_amplitude_gain_;
+        }
+      }
+    }
+  }
+
+  std::array<float, kBlockSize> downmixed_render;
+  render_mixer_.ProduceOutput(b.buffer[b.write], downmixed_render);
+  render_decimator_.Decimate(downmixed_render, ds);
+  data_dumper_->DumpWav("aec3_render_decimator_output", ds.size(), ds.data(),
+                        16000 / down_sampling_factor_, 1);
+  std::copy(ds.rbegin(), ds.rend(), lr.buffer.begin() + lr.write);
+  for (int channel = 0; channel < b.buffer[b.write].NumChannels(); ++channel) {
+    fft_.PaddedFft(b.buffer[b.write].View(/*band=*/0, channel),
+                   b.buffer[previous_write].View(/*band=*/0, channel),
+                   &f.buffer[f.write][channel]);
+    f.buffer[f.write][channel].Spectrum(optimization_,
+                                        s.buffer[s.write][channel]);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_SHARED_RENDER_ANALYZER_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_SHARED_RENDER_ANALYZER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/aec3_fft.h"
+#include "modules/audio_processing/aec3/alignment_mixer.h"
+#include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/block_buffer.h"
+#include "modules/audio_processing/aec3/decimator.h"
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "modules/audio_processing/aec3/fft_buffer.h"
+#include "modules/audio_processing/aec3/spectrum_buffer.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+
+namespace webrtc {
+
+// Analyzes the render signal for one or more render delay buffers that receive
+// the same render signal, e.g., echo cancellers of several capture streams
+// playing out the same far-end. Each render block is scaled, downsampled and
+// transformed once, into buffers that the render delay buffers read through
+// their own read and write indices.
+//
+// A render delay buffer may lag behind the most recently analyzed block by at
+// most `max_render_lag_blocks` blocks, which is the extra room kept in the
+// buffers for this. The class is not thread safe: the render delay buffers
+// sharing an analyzer must all be called on the same thread.
+class SharedRenderAnalyzer {
+ public:
+  SharedRenderAnalyzer(const EchoCanceller3Config& config,
+                       int sample_rate_hz,
+                       size_t num_render_channels,
+                       size_t max_render_lag_blocks);
+  SharedRenderAnalyzer() = delete;
+  SharedRenderAnalyzer(const SharedRenderAnalyzer&) = delete;
+  SharedRenderAnalyzer& operator=(const SharedRenderAnalyzer&) = delete;
+  ~SharedRenderAnalyzer();
+
+  // Returns whether a render delay buffer with the specified setup produces
+  // the same render analysis as this analyzer, and hence may use it.
+  bool IsCompatible(const EchoCanceller3Config& config,
+                    int sample_rate_hz,
+                    size_t num_render_channels) const;
+
+  // Analyzes a render block and stores the result after the most recently
+  // analyzed block.
+  void Insert(const Block& block);
+
+  // Returns the number of analyzed render blocks.
+  int64_t NumAnalyzedBlocks() const { return num_analyzed_blocks_; }
+
+  size_t MaxRenderLagBlocks() const { return max_render_lag_blocks_; }
+
+  // Returns the buffers holding the analysis. The write indices point to the
+  // most recently analyzed block.
+  const BlockBuffer& blocks() const { return blocks_; }
+  const SpectrumBuffer& spectra() const { return spectra_; }
+  const FftBuffer& ffts() const { return ffts_; }
+  const DownsampledRenderBuffer& low_rate() const { return low_rate_; }
+
+ private:
+  static std::atomic<int> instance_count_;
+  std::unique_ptr<ApmDataDumper> data_dumper_;
+  const Aec3Optimization optimization_;
+  const EchoCanceller3Config config_;
+  const int sample_rate_hz_;
+  const size_t max_render_lag_blocks_;
+  const float render_linear_amplitude_gain_;
+  const size_t down_sampling_factor_;
+  const int sub_block_size_;
+  BlockBuffer blocks_;
+  SpectrumBuffer spectra_;
+  FftBuffer ffts_;
+  DownsampledRenderBuffer low_rate_;
+  AlignmentMixer render_mixer_;
+  Decimator render_decimator_;
+  const Aec3Fft fft_;
+  std::vector<float> render_ds_;
+  int64_t num_analyzed_blocks_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_SHARED_RENDER_ANALYZER_H_
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/shared_render_analyzer.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/block_processor.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::string ProduceDebugText(int sample_rate_hz, size_t num_render_channels) {
+  rtc::StringBuilder ss;
+  ss << "Sample rate: " << sample_rate_hz
+     << ", num render channels: " << num_render_channels;
+  return ss.Release();
+}
+
+}  // namespace
+
+// Verifies that block processors sharing the render analysis produce the same
+// output as block processors that analyze the render signal themselves.
+TEST(SharedRenderAnalyzer, BitExactWithIndependentRenderAnalysis) {
+  constexpr size_t kNumStreams = 3;
+  constexpr size_t kNumCaptureChannels = 1;
+  constexpr int kNumBlocks = 1000;
+  const EchoCanceller3Config config;
+  for (auto num_render_channels : {1, 2}) {
+    for (auto rate : {16000, 48000}) {
+      SCOPED_TRACE(ProduceDebugText(rate, num_render_channels));
+      const size_t num_bands = NumBandsForRate(rate);
+      auto analyzer = std::make_shared<SharedRenderAnalyzer>(
+          config, rate, num_render_channels, /*max_render_lag_blocks=*/4);
+      std::vector<std::unique_ptr<BlockProcessor>> shared;
+      std::vector<std::unique_ptr<BlockProcessor>> independent;
+      std::vector<DelayBuffer<float>> echo_paths;
+      for (size_t k = 0; k < kNumStreams; ++k) {
+        shared.emplace_back(BlockProcessor::Create(
+            config, rate, num_render_channels, kNumCaptureChannels, analyzer));
+        independent.emplace_back(BlockProcessor::Create(
+            config, rate, num_render_channels, kNumCaptureChannels));
+        echo_paths.emplace_back(kBlockSize * (2 + 5 * k));
+      }
+
+      Random random_generator(42U);
+      Block render(num_bands, num_render_channels);
+      Block capture(num_bands, kNumCaptureChannels);
+      for (int n = 0; n < kNumBlocks; ++n) {
+        for (size_t band = 0; band < num_bands; ++band) {
+          for (size_t ch = 0; ch < num_render_channels; ++ch) {
+            RandomizeSampleVector(&random_generator, render.View(band, ch));
+          }
+        }
+        for (size_t k = 0; k < kNumStreams; ++k) {
+          shared[k]->BufferRender(render);
+          independent[k]->BufferRender(render);
+        }
+
+        for (size_t k = 0; k < kNumStreams; ++k) {
+          echo_paths[k].Delay(render.View(/*band=*/0, /*channel=*/0),
+                              capture.View(/*band=*/0, /*channel=*/0));
+          for (size_t band = 1; band < num_bands; ++band) {
+            std::fill(capture.begin(band, 0), capture.end(band, 0), 0.f);
+          }
+          Block shared_capture = capture;
+          Block independent_capture = capture;
+          shared[k]->ProcessCapture(false, false, nullptr, &shared_capture);
+          independent[k]->ProcessCapture(false, false, nullptr,
+                                         &independent_capture);
+          for (size_t band = 0; band < num_bands; ++band) {
+            ASSERT_TRUE(std::equal(shared_capture.begin(band, 0),
+                                   shared_capture.end(band, 0),
+                                   independent_capture.begin(band, 0)));
+          }
+        }
+      }
+      EXPECT_EQ(kNumBlocks, analyzer->NumAnalyzedBlocks());
+    }
+  }
+}
+
+// Verifies that a render delay buffer may lag behind the render analysis by
+// the specified number of blocks before it reports a render overrun.
+TEST(SharedRenderAnalyzer, RenderLag) {
+  constexpr size_t kNumRenderChannels = 1;
+  constexpr int kSampleRateHz = 16000;
+  constexpr size_t kMaxRenderLagBlocks = 2;
+  const EchoCanceller3Config config;
+  auto analyzer = std::make_shared<SharedRenderAnalyzer>(
+      config, kSampleRateHz, kNumRenderChannels, kMaxRenderLagBlocks);
+  std::unique_ptr<RenderDelayBuffer> leader(RenderDelayBuffer::Create(
+      config, kSampleRateHz, kNumRenderChannels, analyzer));
+  std::unique_ptr<RenderDelayBuffer> follower(RenderDelayBuffer::Create(
+      config, kSampleRateHz, kNumRenderChannels, analyzer));
+  Block block(NumBandsForRate(kSampleRateHz), kNumRenderChannels, 1000.f);
+
+  for (size_t k = 0; k <= kMaxRenderLagBlocks; ++k) {
+    EXPECT_EQ(RenderDelayBuffer::BufferingEvent::kNone, leader->Insert(block));
+  }
+  EXPECT_EQ(kMaxRenderLagBlocks + 1,
+            static_cast<size_t>(analyzer->NumAnalyzedBlocks()));
+  EXPECT_EQ(RenderDelayBuffer::BufferingEvent::kNone, follower->Insert(block));
+  EXPECT_EQ(kMaxRenderLagBlocks + 1,
+            static_cast<size_t>(analyzer->NumAnalyzedBlocks()));
+
+  EXPECT_EQ(RenderDelayBuffer::BufferingEvent::kNone, leader->Insert(block));
+  EXPECT_EQ(RenderDelayBuffer::BufferingEvent::kNone, leader->Insert(block));
+  EXPECT_EQ(RenderDelayBuffer::BufferingEvent::kRenderOverrun,
+            follower->Insert(block));
+
+  // After the overrun, the follower continues from the most recently analyzed
+  // block and in turn analyzes the next block.
+  EXPECT_EQ(RenderDelayBuffer::BufferingEvent::kNone, follower->Insert(block));
+  EXPECT_EQ(kMaxRenderLagBlocks + 4,
+            static_cast<size_t>(analyzer->NumAnalyzedBlocks()));
+}
+
+// Verifies the check for whether a render delay buffer may use an analyzer.
+TEST(SharedRenderAnalyzer, IsCompatible) {
+  const EchoCanceller3Config config;
+  SharedRenderAnalyzer analyzer(config, 48000, 2,
+                                /*max_render_lag_blocks=*/1);
+  EXPECT_TRUE(analyzer.IsCompatible(config, 48000, 2));
+  EXPECT_FALSE(analyzer.IsCompatible(config, 48000, 1));
+  EXPECT_FALSE(analyzer.IsCompatible(config, 16000, 2));
+
+  EchoCanceller3Config other_config;
+  other_config.filter.refined.length_blocks += 1;
+  EXPECT_FALSE(analyzer.IsCompatible(other_config, 48000, 2));
+  other_config = config;
+  other_config.render_levels.render_power_gain_db = 6.f;
+  EXPECT_FALSE(analyzer.IsCompatible(other_config, 48000, 2));
+  other_config = config;
+  other_config.suppressor.normal_tuning.mask_lf.enr_transparent = 0.5f;
+  EXPECT_TRUE(analyzer.IsCompatible(other_config, 48000, 2));
+}
+
+}  // namespace webrtc
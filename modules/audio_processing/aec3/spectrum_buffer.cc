@@ -11,13 +11,14 @@
 #include "modules/audio_processing/aec3/spectrum_buffer.h"
 
 #include <algorithm>
+#include <utility>
 
 namespace webrtc {
 
 SpectrumBuffer::SpectrumBuffer(size_t size, size_t num_channels)
-    : size(static_cast<int>(size)),
-      buffer(size,
-             std::vector<std::array<float, kFftLengthBy2Plus1>>(num_channels)) {
+    : SpectrumBuffer(std::make_shared<Storage>(
+          size,
+          std::vector<std::array<float, kFftLengthBy2Plus1>>(num_channels))) {
   for (auto& channel : buffer) {
     for (auto& c : channel) {
       std::fill(c.begin(), c.end(), 0.f);
@@ -25,6 +26,11 @@ SpectrumBuffer::SpectrumBuffer(size_t size, size_t num_channels)
   }
 }
 
+SpectrumBuffer::SpectrumBuffer(std::shared_ptr<Storage> shared_storage)
+    : size(static_cast<int>(shared_storage->size())),
+      storage(std::move(shared_storage)),
+      buffer(*storage) {}
+
 SpectrumBuffer::~SpectrumBuffer() = default;
 
 }  // namespace webrtc
@@ -14,6 +14,7 @@
 #include <stddef.h>
 
 #include <array>
+#include <memory>
 #include <vector>
 
 #include "modules/audio_processing/aec3/aec3_common.h"
@@ -24,7 +25,15 @@ namespace webrtc {
 // Struct for bundling a circular buffer of one dimensional vector objects
 // together with the read and write indices.
 struct SpectrumBuffer {
+  using Storage =
+      std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>;
+
   SpectrumBuffer(size_t size, size_t num_channels);
+  // Creates a buffer on top of `shared_storage`, which may be shared with
+  // other buffers that keep their own read and write indices.
+  explicit SpectrumBuffer(std::shared_ptr<Storage> shared_storage);
+  SpectrumBuffer(const SpectrumBuffer&) = delete;
+  SpectrumBuffer& operator=(const SpectrumBuffer&) = delete;
   ~SpectrumBuffer();
 
   int IncIndex(int index) const {
@@ -52,7 +61,8 @@ struct SpectrumBuffer {
   void DecReadIndex() { read = DecIndex(read); }
 
   const int size;
-  std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>> buffer;
+  const std::shared_ptr<Storage> storage;
+  Storage& buffer;
   int write = 0;
   int read = 0;
 };
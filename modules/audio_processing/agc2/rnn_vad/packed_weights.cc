@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/packed_weights.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+PackedInt8Weights::PackedInt8Weights()
+    : input_size_(0), output_size_(0), scale_(0.f) {}
+
+PackedInt8Weights::PackedInt8Weights(rtc::ArrayView<const int8_t> weights,
+                                     int input_size,
+                                     int output_size,
+                                     int stride,
+                                     float scale)
+    : input_size_(input_size), output_size_(output_size), scale_(scale) {
+  RTC_DCHECK_GT(input_size_, 0);
+  RTC_DCHECK_GT(output_size_, 0);
+  RTC_DCHECK_GE(stride, output_size_);
+  RTC_DCHECK_GE(weights.size(), (input_size_ - 1) * stride + output_size_);
+  weights_.resize(num_groups() * input_size_ * kPackedWeightsGroupSize, 0);
+  for (int o = 0; o < output_size_; ++o) {
+    const int g = o / kPackedWeightsGroupSize;
+    const int offset = g * input_size_ * kPackedWeightsGroupSize +
+                       o % kPackedWeightsGroupSize;
+    for (int i = 0; i < input_size_; ++i) {
+      weights_[offset + i * kPackedWeightsGroupSize] = weights[i * stride + o];
+    }
+  }
+}
+
+PackedInt8Weights::PackedInt8Weights(PackedInt8Weights&&) = default;
+
+PackedInt8Weights::~PackedInt8Weights() = default;
+
+}  // namespace rnn_vad
+}  // namespace webrtc
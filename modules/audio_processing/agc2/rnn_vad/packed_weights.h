@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_PACKED_WEIGHTS_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_PACKED_WEIGHTS_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+// Format in which a layer stores its weights.
+enum class WeightsFormat {
+  // Weights cast to float and scaled; one dot product per output unit.
+  kFloat,
+  // Weights kept as int8 and packed for matrix-vector products (see
+  // `PackedInt8Weights`).
+  kPackedInt8,
+};
+
+// Number of output units whose weights are interleaved in `PackedInt8Weights`.
+constexpr int kPackedWeightsGroupSize = 8;
+
+// Int8 weights matrix of a layer with the weights of groups of
+// `kPackedWeightsGroupSize` output units interleaved, so that a matrix-vector
+// product computes a whole group with one multiply-add per input. The weights
+// of the last group are zero-padded.
+class PackedInt8Weights {
+ public:
+  // Creates an empty matrix.
+  PackedInt8Weights();
+  // Packs `weights`, where the weight between input `i` and output `o` is
+  // `weights[i * stride + o]`. The weights are scaled by `scale` when used.
+  PackedInt8Weights(rtc::ArrayView<const int8_t> weights,
+                    int input_size,
+                    int output_size,
+                    int stride,
+                    float scale);
+  PackedInt8Weights(const PackedInt8Weights&) = delete;
+  PackedInt8Weights& operator=(const PackedInt8Weights&) = delete;
+  PackedInt8Weights(PackedInt8Weights&&);
+  PackedInt8Weights& operator=(PackedInt8Weights&&) = delete;
+  ~PackedInt8Weights();
+
+  int input_size() const { return input_size_; }
+  int output_size() const { return output_size_; }
+  int num_groups() const {
+    return (output_size_ + kPackedWeightsGroupSize - 1) /
+           kPackedWeightsGroupSize;
+  }
+  float scale() const { return scale_; }
+  // Returns the weights of the output units with index in
+  // [`g` * `kPackedWeightsGroupSize`, (`g` + 1) * `kPackedWeightsGroupSize`).
+  // The `kPackedWeightsGroupSize` weights for input `i` start at index
+  // `i * kPackedWeightsGroupSize`.
+  rtc::ArrayView<const int8_t> group(int g) const {
+    const int group_size = input_size_ * kPackedWeightsGroupSize;
+    return rtc::ArrayView<const int8_t>(weights_).subview(g * group_size,
+                                                          group_size);
+  }
+
+ private:
+  int input_size_;
+  int output_size_;
+  float scale_;
+  std::vector<int8_t> weights_;
+};
+
+}  // namespace rnn_vad
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_RNN_VAD_PACKED_WEIGHTS_H_
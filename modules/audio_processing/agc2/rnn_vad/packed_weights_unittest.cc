@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/packed_weights.h"
+
+#include <stdint.h>
+
+#include <array>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace rnn_vad {
+namespace {
+
+// Checks that the weights of each output unit are interleaved by group and
+// that the last group is zero-padded.
+TEST(RnnVadTest, PackedInt8WeightsLayout) {
+  constexpr int kInputSize = 3;
+  constexpr int kOutputSize = 10;
+  constexpr int kStride = 12;
+  std::array<int8_t, kInputSize * kStride> weights;
+  for (int i = 0; i < kInputSize; ++i) {
+    for (int o = 0; o < kStride; ++o) {
+      weights[i * kStride + o] = static_cast<int8_t>(10 * i + o);
+    }
+  }
+  PackedInt8Weights packed_weights(weights, kInputSize, kOutputSize, kStride,
+                                   /*scale=*/0.5f);
+  EXPECT_EQ(packed_weights.input_size(), kInputSize);
+  EXPECT_EQ(packed_weights.output_size(), kOutputSize);
+  EXPECT_EQ(packed_weights.scale(), 0.5f);
+  ASSERT_EQ(packed_weights.num_groups(), 2);
+  for (int g = 0; g < packed_weights.num_groups(); ++g) {
+    rtc::ArrayView<const int8_t> group = packed_weights.group(g);
+    ASSERT_EQ(group.size(), kInputSize * kPackedWeightsGroupSize);
+    for (int i = 0; i < kInputSize; ++i) {
+      for (int k = 0; k < kPackedWeightsGroupSize; ++k) {
+        const int o = g * kPackedWeightsGroupSize + k;
+        EXPECT_EQ(group[i * kPackedWeightsGroupSize + k],
+                  o < kOutputSize ? weights[i * kStride + o] : 0);
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace rnn_vad
+}  // namespace webrtc
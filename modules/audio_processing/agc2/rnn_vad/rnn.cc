@@ -37,21 +37,24 @@ static_assert(kOutputLayerOutputSize <= kFullyConnectedLayerMaxUnits, "");
 
 }  // namespace
 
-RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
+RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features,
+               WeightsFormat weights_format)
     : input_(kInputLayerInputSize,
              kInputLayerOutputSize,
              kInputDenseBias,
              kInputDenseWeights,
              ActivationFunction::kTansigApproximated,
              cpu_features,
-             /*layer_name=*/"FC1"),
+             /*layer_name=*/"FC1",
+             weights_format),
       hidden_(kInputLayerOutputSize,
               kHiddenLayerOutputSize,
               kHiddenGruBias,
               kHiddenGruWeights,
               kHiddenGruRecurrentWeights,
               cpu_features,
-              /*layer_name=*/"GRU1"),
+              /*layer_name=*/"GRU1",
+              weights_format),
       output_(kHiddenLayerOutputSize,
               kOutputLayerOutputSize,
               kOutputDenseBias,
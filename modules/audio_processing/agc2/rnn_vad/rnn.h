@@ -20,6 +20,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
+#include "modules/audio_processing/agc2/rnn_vad/packed_weights.h"
 #include "modules/audio_processing/agc2/rnn_vad/rnn_fc.h"
 #include "modules/audio_processing/agc2/rnn_vad/rnn_gru.h"
 
@@ -30,7 +31,11 @@ namespace rnn_vad {
 // detection.
 class RnnVad {
  public:
-  explicit RnnVad(const AvailableCpuFeatures& cpu_features);
+  // Ctor. `weights_format` is the format of the input and hidden layers
+  // weights.
+  explicit RnnVad(
+      const AvailableCpuFeatures& cpu_features,
+      WeightsFormat weights_format = WeightsFormat::kPackedInt8);
   RnnVad(const RnnVad&) = delete;
   RnnVad& operator=(const RnnVad&) = delete;
   ~RnnVad();
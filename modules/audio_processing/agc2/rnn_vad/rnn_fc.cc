@@ -52,6 +52,17 @@ std::vector<float> PreprocessWeights(rtc::ArrayView<const int8_t> weights,
   return w;
 }
 
+PackedInt8Weights PackWeights(rtc::ArrayView<const int8_t> weights,
+                              int input_size,
+                              int output_size,
+                              WeightsFormat weights_format) {
+  if (weights_format != WeightsFormat::kPackedInt8) {
+    return PackedInt8Weights();
+  }
+  return PackedInt8Weights(weights, input_size, output_size,
+                           /*stride=*/output_size, ::rnnoise::kWeightsScale);
+}
+
 rtc::FunctionView<float(float)> GetActivationFunction(
     ActivationFunction activation_function) {
   switch (activation_function) {
@@ -71,11 +82,17 @@ FullyConnectedLayer::FullyConnectedLayer(
     const rtc::ArrayView<const int8_t> weights,
     ActivationFunction activation_function,
     const AvailableCpuFeatures& cpu_features,
-    absl::string_view layer_name)
+    absl::string_view layer_name,
+    WeightsFormat weights_format)
     : input_size_(input_size),
       output_size_(output_size),
       bias_(GetScaledParams(bias)),
-      weights_(PreprocessWeights(weights, output_size)),
+      weights_format_(weights_format),
+      weights_(weights_format == WeightsFormat::kFloat
+                   ? PreprocessWeights(weights, output_size)
+                   : std::vector<float>()),
+      packed_weights_(
+          PackWeights(weights, input_size, output_size, weights_format)),
       vector_math_(cpu_features),
       activation_function_(GetActivationFunction(activation_function)) {
   RTC_DCHECK_LE(output_size_, kFullyConnectedLayerMaxUnits)
@@ -83,7 +100,7 @@ FullyConnectedLayer::FullyConnectedLayer(
   RTC_DCHECK_EQ(output_size_, bias_.size())
       << "Mismatching output size and bias terms array size (" << layer_name
       << ").";
-  RTC_DCHECK_EQ(input_size_ * output_size_, weights_.size())
+  RTC_DCHECK_EQ(input_size_ * output_size_, weights.size())
       << "Mismatching input-output size and weight coefficients array size ("
       << layer_name << ").";
 }
@@ -92,6 +109,14 @@ FullyConnectedLayer::~FullyConnectedLayer() = default;
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  if (weights_format_ == WeightsFormat::kPackedInt8) {
+    rtc::ArrayView<float> output(output_.data(), output_size_);
+    vector_math_.MatrixVectorProduct(packed_weights_, input, output);
+    for (int o = 0; o < output_size_; ++o) {
+      output_[o] = activation_function_(bias_[o] + output_[o]);
+    }
+    return;
+  }
   rtc::ArrayView<const float> weights(weights_);
   for (int o = 0; o < output_size_; ++o) {
     output_[o] = activation_function_(
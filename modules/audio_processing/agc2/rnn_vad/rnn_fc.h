@@ -18,6 +18,7 @@
 #include "api/array_view.h"
 #include "api/function_view.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/agc2/rnn_vad/packed_weights.h"
 #include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
 
 namespace webrtc {
@@ -40,7 +41,8 @@ class FullyConnectedLayer {
                       rtc::ArrayView<const int8_t> weights,
                       ActivationFunction activation_function,
                       const AvailableCpuFeatures& cpu_features,
-                      absl::string_view layer_name);
+                      absl::string_view layer_name,
+                      WeightsFormat weights_format = WeightsFormat::kFloat);
   FullyConnectedLayer(const FullyConnectedLayer&) = delete;
   FullyConnectedLayer& operator=(const FullyConnectedLayer&) = delete;
   ~FullyConnectedLayer();
@@ -59,7 +61,11 @@ class FullyConnectedLayer {
   const int input_size_;
   const int output_size_;
   const std::vector<float> bias_;
+  const WeightsFormat weights_format_;
+  // Weights used with `WeightsFormat::kFloat`, empty otherwise.
   const std::vector<float> weights_;
+  // Weights used with `WeightsFormat::kPackedInt8`, empty otherwise.
+  const PackedInt8Weights packed_weights_;
   const VectorMath vector_math_;
   rtc::FunctionView<float(float)> activation_function_;
   // Over-allocated array with size equal to `output_size_`.
@@ -61,24 +61,45 @@ TEST_P(RnnFcParametrization, CheckFullyConnectedLayerOutput) {
   ExpectNearAbsolute(kFullyConnectedExpectedOutput, fc, 1e-5f);
 }
 
-TEST_P(RnnFcParametrization, DISABLED_BenchmarkFullyConnectedLayer) {
-  const AvailableCpuFeatures cpu_features = GetParam();
+// Checks that the output of a fully connected layer with packed int8 weights is
+// within tolerance given test input data.
+TEST_P(RnnFcParametrization, CheckFullyConnectedLayerOutputPackedInt8) {
   FullyConnectedLayer fc(kInputLayerInputSize, kInputLayerOutputSize,
                          kInputDenseBias, kInputDenseWeights,
-                         ActivationFunction::kTansigApproximated, cpu_features,
-                         /*layer_name=*/"FC");
+                         ActivationFunction::kTansigApproximated,
+                         /*cpu_features=*/GetParam(),
+                         /*layer_name=*/"FC", WeightsFormat::kPackedInt8);
+  fc.ComputeOutput(kFullyConnectedInputVector);
+  ExpectNearAbsolute(kFullyConnectedExpectedOutput, fc, 1e-5f);
+}
+
+TEST_P(RnnFcParametrization, DISABLED_BenchmarkFullyConnectedLayer) {
+  const AvailableCpuFeatures cpu_features = GetParam();
+  for (WeightsFormat weights_format :
+       {WeightsFormat::kFloat, WeightsFormat::kPackedInt8}) {
+    FullyConnectedLayer fc(kInputLayerInputSize, kInputLayerOutputSize,
+                           kInputDenseBias, kInputDenseWeights,
+                           ActivationFunction::kTansigApproximated,
+                           cpu_features,
+                           /*layer_name=*/"FC", weights_format);
 
-  constexpr int kNumTests = 10000;
-  ::webrtc::test::PerformanceTimer perf_timer(kNumTests);
-  for (int k = 0; k < kNumTests; ++k) {
-    perf_timer.StartTimer();
-    fc.ComputeOutput(kFullyConnectedInputVector);
-    perf_timer.StopTimer();
+    constexpr int kNumTests = 10000;
+    ::webrtc::test::PerformanceTimer perf_timer(kNumTests);
+    for (int k = 0; k < kNumTests; ++k) {
+      perf_timer.StartTimer();
+      fc.ComputeOutput(kFullyConnectedInputVector);
+      perf_timer.StopTimer();
+    }
+    RTC_LOG(LS_INFO) << "CPU features: " << cpu_features.ToString()
+                     << " | weights: "
+                     << (weights_format == WeightsFormat::kFloat
+                             ? "float"
+                             : "packed int8")
+                     << " | " << (perf_timer.GetDurationAverage() / 1000)
+                     << " +/- "
+                     << (perf_timer.GetDurationStandardDeviation() / 1000)
+                     << " ms";
   }
-  RTC_LOG(LS_INFO) << "CPU features: " << cpu_features.ToString() << " | "
-                   << (perf_timer.GetDurationAverage() / 1000) << " +/- "
-                   << (perf_timer.GetDurationStandardDeviation() / 1000)
-                   << " ms";
 }
 
 // Finds the relevant CPU features combinations to test.
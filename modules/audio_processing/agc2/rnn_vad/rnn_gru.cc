@@ -43,6 +43,26 @@ std::vector<float> PreprocessGruTensor(rtc::ArrayView<const int8_t> tensor_src,
   return tensor_dst;
 }
 
+// Packs the weights of each gate of the 3-dim GRU tensor `tensor_src`, or
+// returns no weights if `weights_format` is not `WeightsFormat::kPackedInt8`.
+std::vector<PackedInt8Weights> PackGruTensor(
+    rtc::ArrayView<const int8_t> tensor_src,
+    int output_size,
+    WeightsFormat weights_format) {
+  std::vector<PackedInt8Weights> tensor_dst;
+  if (weights_format != WeightsFormat::kPackedInt8) {
+    return tensor_dst;
+  }
+  const int n = rtc::CheckedDivExact(rtc::dchecked_cast<int>(tensor_src.size()),
+                                     output_size * kNumGruGates);
+  for (int g = 0; g < kNumGruGates; ++g) {
+    tensor_dst.emplace_back(tensor_src.subview(g * output_size), n,
+                            output_size, kNumGruGates * output_size,
+                            ::rnnoise::kWeightsScale);
+  }
+  return tensor_dst;
+}
+
 // Computes the output for the update or the reset gate.
 // Operation: `g = sigmoid(W^T∙i + R^T∙s + b)` where
 // - `g`: output gate vector
@@ -128,23 +148,33 @@ GatedRecurrentLayer::GatedRecurrentLayer(
     const rtc::ArrayView<const int8_t> weights,
     const rtc::ArrayView<const int8_t> recurrent_weights,
     const AvailableCpuFeatures& cpu_features,
-    absl::string_view layer_name)
+    absl::string_view layer_name,
+    WeightsFormat weights_format)
     : input_size_(input_size),
       output_size_(output_size),
       bias_(PreprocessGruTensor(bias, output_size)),
-      weights_(PreprocessGruTensor(weights, output_size)),
-      recurrent_weights_(PreprocessGruTensor(recurrent_weights, output_size)),
+      weights_format_(weights_format),
+      weights_(weights_format == WeightsFormat::kFloat
+                   ? PreprocessGruTensor(weights, output_size)
+                   : std::vector<float>()),
+      recurrent_weights_(weights_format == WeightsFormat::kFloat
+                             ? PreprocessGruTensor(recurrent_weights,
+                                                   output_size)
+                             : std::vector<float>()),
+      packed_weights_(PackGruTensor(weights, output_size, weights_format)),
+      packed_recurrent_weights_(
+          PackGruTensor(recurrent_weights, output_size, weights_format)),
       vector_math_(cpu_features) {
   RTC_DCHECK_LE(output_size_, kGruLayerMaxUnits)
       << "Insufficient GRU layer over-allocation (" << layer_name << ").";
   RTC_DCHECK_EQ(kNumGruGates * output_size_, bias_.size())
       << "Mismatching output size and bias terms array size (" << layer_name
       << ").";
-  RTC_DCHECK_EQ(kNumGruGates * input_size_ * output_size_, weights_.size())
+  RTC_DCHECK_EQ(kNumGruGates * input_size_ * output_size_, weights.size())
       << "Mismatching input-output size and weight coefficients array size ("
       << layer_name << ").";
   RTC_DCHECK_EQ(kNumGruGates * output_size_ * output_size_,
-                recurrent_weights_.size())
+                recurrent_weights.size())
       << "Mismatching input-output size and recurrent weight coefficients array"
          " size ("
       << layer_name << ").";
@@ -159,6 +189,10 @@ void GatedRecurrentLayer::Reset() {
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  if (weights_format_ == WeightsFormat::kPackedInt8) {
+    ComputeOutputPackedInt8(input);
+    return;
+  }
 
   // The tensors below are organized as a sequence of flattened tensors for the
   // `update`, `reset` and `state` gates.
@@ -194,5 +228,44 @@ void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
                    state);
 }
 
+// Computes the same gates as `ComputeUpdateResetGate()` and
+// `ComputeStateGate()` with one matrix-vector product per weights matrix.
+void GatedRecurrentLayer::ComputeOutputPackedInt8(
+    rtc::ArrayView<const float> input) {
+  RTC_DCHECK_EQ(packed_weights_.size(), kNumGruGates);
+  RTC_DCHECK_EQ(packed_recurrent_weights_.size(), kNumGruGates);
+  rtc::ArrayView<float> state(state_.data(), output_size_);
+  std::array<float, kGruLayerMaxUnits> x_buffer;
+  std::array<float, kGruLayerMaxUnits> s_buffer;
+  rtc::ArrayView<float> x(x_buffer.data(), output_size_);
+  rtc::ArrayView<float> s(s_buffer.data(), output_size_);
+
+  // Update and reset gates.
+  std::array<float, kGruLayerMaxUnits> update;
+  std::array<float, kGruLayerMaxUnits> reset;
+  for (int g = 0; g < 2; ++g) {
+    float* gate = g == 0 ? update.data() : reset.data();
+    vector_math_.MatrixVectorProduct(packed_weights_[g], input, x);
+    vector_math_.MatrixVectorProduct(packed_recurrent_weights_[g], state, s);
+    for (int o = 0; o < output_size_; ++o) {
+      gate[o] = ::rnnoise::SigmoidApproximated(bias_[g * output_size_ + o] +
+                                               x[o] + s[o]);
+    }
+  }
+  // State gate.
+  std::array<float, kGruLayerMaxUnits> reset_x_state;
+  for (int o = 0; o < output_size_; ++o) {
+    reset_x_state[o] = state[o] * reset[o];
+  }
+  vector_math_.MatrixVectorProduct(packed_weights_[2], input, x);
+  vector_math_.MatrixVectorProduct(
+      packed_recurrent_weights_[2],
+      {reset_x_state.data(), static_cast<size_t>(output_size_)}, s);
+  for (int o = 0; o < output_size_; ++o) {
+    const float y = bias_[2 * output_size_ + o] + x[o] + s[o];
+    state[o] = update[o] * state[o] + (1.f - update[o]) * std::max(0.f, y);
+  }
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -17,6 +17,7 @@
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/agc2/rnn_vad/packed_weights.h"
 #include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
 
 namespace webrtc {
@@ -36,7 +37,8 @@ class GatedRecurrentLayer {
                       rtc::ArrayView<const int8_t> weights,
                       rtc::ArrayView<const int8_t> recurrent_weights,
                       const AvailableCpuFeatures& cpu_features,
-                      absl::string_view layer_name);
+                      absl::string_view layer_name,
+                      WeightsFormat weights_format = WeightsFormat::kFloat);
   GatedRecurrentLayer(const GatedRecurrentLayer&) = delete;
   GatedRecurrentLayer& operator=(const GatedRecurrentLayer&) = delete;
   ~GatedRecurrentLayer();
@@ -54,11 +56,19 @@ class GatedRecurrentLayer {
   void ComputeOutput(rtc::ArrayView<const float> input);
 
  private:
+  void ComputeOutputPackedInt8(rtc::ArrayView<const float> input);
+
   const int input_size_;
   const int output_size_;
   const std::vector<float> bias_;
+  const WeightsFormat weights_format_;
+  // Weights used with `WeightsFormat::kFloat`, empty otherwise.
   const std::vector<float> weights_;
   const std::vector<float> recurrent_weights_;
+  // Weights for the `update`, `reset` and `state` gates used with
+  // `WeightsFormat::kPackedInt8`, empty otherwise.
+  const std::vector<PackedInt8Weights> packed_weights_;
+  const std::vector<PackedInt8Weights> packed_recurrent_weights_;
   const VectorMath vector_math_;
   // Over-allocated array with size equal to `output_size_`.
   std::array<float, kGruLayerMaxUnits> state_;
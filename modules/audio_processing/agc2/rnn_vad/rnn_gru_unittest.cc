@@ -117,6 +117,16 @@ TEST_P(RnnGruParametrization, CheckGatedRecurrentLayer) {
   TestGatedRecurrentLayer(gru, kGruInputSequence, kGruExpectedOutputSequence);
 }
 
+// Checks that the output of a GRU layer with packed int8 weights is within
+// tolerance given test input data.
+TEST_P(RnnGruParametrization, CheckGatedRecurrentLayerPackedInt8) {
+  GatedRecurrentLayer gru(kGruInputSize, kGruOutputSize, kGruBias, kGruWeights,
+                          kGruRecurrentWeights,
+                          /*cpu_features=*/GetParam(),
+                          /*layer_name=*/"GRU", WeightsFormat::kPackedInt8);
+  TestGatedRecurrentLayer(gru, kGruInputSequence, kGruExpectedOutputSequence);
+}
+
 TEST_P(RnnGruParametrization, DISABLED_BenchmarkGatedRecurrentLayer) {
   // Prefetch test data.
   std::unique_ptr<FileReader> reader = CreateGruInputReader();
@@ -129,31 +139,39 @@ TEST_P(RnnGruParametrization, DISABLED_BenchmarkGatedRecurrentLayer) {
   using ::rnnoise::kHiddenLayerOutputSize;
   using ::rnnoise::kInputLayerOutputSize;
 
-  GatedRecurrentLayer gru(kInputLayerOutputSize, kHiddenLayerOutputSize,
-                          kHiddenGruBias, kHiddenGruWeights,
-                          kHiddenGruRecurrentWeights,
-                          /*cpu_features=*/GetParam(),
-                          /*layer_name=*/"GRU");
-
   rtc::ArrayView<const float> input_sequence(gru_input_sequence);
   ASSERT_EQ(input_sequence.size() % kInputLayerOutputSize,
             static_cast<size_t>(0));
   const int input_sequence_length =
       input_sequence.size() / kInputLayerOutputSize;
 
-  constexpr int kNumTests = 100;
-  ::webrtc::test::PerformanceTimer perf_timer(kNumTests);
-  for (int k = 0; k < kNumTests; ++k) {
-    perf_timer.StartTimer();
-    for (int i = 0; i < input_sequence_length; ++i) {
-      gru.ComputeOutput(
-          input_sequence.subview(i * gru.input_size(), gru.input_size()));
+  for (WeightsFormat weights_format :
+       {WeightsFormat::kFloat, WeightsFormat::kPackedInt8}) {
+    GatedRecurrentLayer gru(kInputLayerOutputSize, kHiddenLayerOutputSize,
+                            kHiddenGruBias, kHiddenGruWeights,
+                            kHiddenGruRecurrentWeights,
+                            /*cpu_features=*/GetParam(),
+                            /*layer_name=*/"GRU", weights_format);
+
+    constexpr int kNumTests = 100;
+    ::webrtc::test::PerformanceTimer perf_timer(kNumTests);
+    for (int k = 0; k < kNumTests; ++k) {
+      perf_timer.StartTimer();
+      for (int i = 0; i < input_sequence_length; ++i) {
+        gru.ComputeOutput(
+            input_sequence.subview(i * gru.input_size(), gru.input_size()));
+      }
+      perf_timer.StopTimer();
     }
-    perf_timer.StopTimer();
+    RTC_LOG(LS_INFO) << "weights: "
+                     << (weights_format == WeightsFormat::kFloat
+                             ? "float"
+                             : "packed int8")
+                     << " | " << (perf_timer.GetDurationAverage() / 1000)
+                     << " +/- "
+                     << (perf_timer.GetDurationStandardDeviation() / 1000)
+                     << " ms";
   }
-  RTC_LOG(LS_INFO) << (perf_timer.GetDurationAverage() / 1000) << " +/- "
-                   << (perf_timer.GetDurationStandardDeviation() / 1000)
-                   << " ms";
 }
 
 // Finds the relevant CPU features combinations to test.
@@ -8,7 +8,9 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <vector>
@@ -108,6 +110,36 @@ TEST_P(RnnVadProbabilityParametrization, RnnVadProbabilityWithinTolerance) {
   }
 }
 
+// Checks that the VAD probability computed with packed int8 weights matches the
+// one computed with float weights.
+TEST_P(RnnVadProbabilityParametrization, PackedInt8WeightsMatchFloatWeights) {
+  PushSincResampler decimator(kFrameSize10ms48kHz, kFrameSize10ms24kHz);
+  const AvailableCpuFeatures cpu_features = GetParam();
+  FeaturesExtractor features_extractor(cpu_features);
+  RnnVad rnn_vad_float(cpu_features, WeightsFormat::kFloat);
+  RnnVad rnn_vad_int8(cpu_features, WeightsFormat::kPackedInt8);
+  std::unique_ptr<FileReader> samples_reader = CreatePcmSamplesReader();
+  const int num_frames = samples_reader->size() / kFrameSize10ms48kHz;
+  std::vector<float> samples_48k(kFrameSize10ms48kHz);
+  std::vector<float> samples_24k(kFrameSize10ms24kHz);
+  std::vector<float> feature_vector(kFeatureVectorSize);
+  float max_error = 0.f;
+  for (int i = 0; i < num_frames; ++i) {
+    ASSERT_TRUE(samples_reader->ReadChunk(samples_48k));
+    decimator.Resample(samples_48k.data(), samples_48k.size(),
+                       samples_24k.data(), samples_24k.size());
+    bool is_silence = features_extractor.CheckSilenceComputeFeatures(
+        {samples_24k.data(), kFrameSize10ms24kHz},
+        {feature_vector.data(), kFeatureVectorSize});
+    const float vad_prob_float = rnn_vad_float.ComputeVadProbability(
+        {feature_vector.data(), kFeatureVectorSize}, is_silence);
+    const float vad_prob_int8 = rnn_vad_int8.ComputeVadProbability(
+        {feature_vector.data(), kFeatureVectorSize}, is_silence);
+    max_error = std::max(max_error, std::abs(vad_prob_float - vad_prob_int8));
+  }
+  EXPECT_LT(max_error, 1e-5f);
+}
+
 // Performance test for the RNN VAD (pre-fetching and downsampling are
 // excluded). Keep disabled and only enable locally to measure performance as
 // follows:
@@ -133,26 +165,33 @@ TEST_P(RnnVadProbabilityParametrization, DISABLED_RnnVadPerformance) {
   const AvailableCpuFeatures cpu_features = GetParam();
   FeaturesExtractor features_extractor(cpu_features);
   std::array<float, kFeatureVectorSize> feature_vector;
-  RnnVad rnn_vad(cpu_features);
-  constexpr int number_of_tests = 100;
-  ::webrtc::test::PerformanceTimer perf_timer(number_of_tests);
-  for (int k = 0; k < number_of_tests; ++k) {
-    features_extractor.Reset();
-    rnn_vad.Reset();
-    // Process frames.
-    perf_timer.StartTimer();
-    for (int i = 0; i < num_frames; ++i) {
-      bool is_silence = features_extractor.CheckSilenceComputeFeatures(
-          {&prefetched_decimated_samples[i * kFrameSize10ms24kHz],
-           kFrameSize10ms24kHz},
-          feature_vector);
-      rnn_vad.ComputeVadProbability(feature_vector, is_silence);
+  for (WeightsFormat weights_format :
+       {WeightsFormat::kFloat, WeightsFormat::kPackedInt8}) {
+    RnnVad rnn_vad(cpu_features, weights_format);
+    constexpr int number_of_tests = 100;
+    ::webrtc::test::PerformanceTimer perf_timer(number_of_tests);
+    for (int k = 0; k < number_of_tests; ++k) {
+      features_extractor.Reset();
+      rnn_vad.Reset();
+      // Process frames.
+      perf_timer.StartTimer();
+      for (int i = 0; i < num_frames; ++i) {
+        bool is_silence = features_extractor.CheckSilenceComputeFeatures(
+            {&prefetched_decimated_samples[i * kFrameSize10ms24kHz],
+             kFrameSize10ms24kHz},
+            feature_vector);
+        rnn_vad.ComputeVadProbability(feature_vector, is_silence);
+      }
+      perf_timer.StopTimer();
     }
-    perf_timer.StopTimer();
+    RTC_LOG(LS_INFO) << "weights: "
+                     << (weights_format == WeightsFormat::kFloat
+                             ? "float"
+                             : "packed int8");
+    DumpPerfStats(num_frames * kFrameSize10ms24kHz, kSampleRate24kHz,
+                  perf_timer.GetDurationAverage(),
+                  perf_timer.GetDurationStandardDeviation());
   }
-  DumpPerfStats(num_frames * kFrameSize10ms24kHz, kSampleRate24kHz,
-                perf_timer.GetDurationAverage(),
-                perf_timer.GetDurationStandardDeviation());
 }
 
 // Finds the relevant CPU features combinations to test.
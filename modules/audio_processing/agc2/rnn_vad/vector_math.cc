@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
+
+#include <algorithm>
+#include <array>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace rnn_vad {
+namespace {
+
+// Scales the `kPackedWeightsGroupSize` products computed for group `g` and
+// writes those of the non-padding output units into `y`.
+void StoreGroup(const float* products,
+                float scale,
+                int g,
+                rtc::ArrayView<float> y) {
+  const int first = g * kPackedWeightsGroupSize;
+  const int last = std::min(first + kPackedWeightsGroupSize,
+                            static_cast<int>(y.size()));
+  for (int o = first; o < last; ++o) {
+    y[o] = scale * products[o - first];
+  }
+}
+
+}  // namespace
+
+void VectorMath::MatrixVectorProduct(const PackedInt8Weights& weights,
+                                     rtc::ArrayView<const float> x,
+                                     rtc::ArrayView<float> y) const {
+  RTC_DCHECK_EQ(x.size(), weights.input_size());
+  RTC_DCHECK_EQ(y.size(), weights.output_size());
+  static_assert(kPackedWeightsGroupSize == 8, "");
+  const int input_size = weights.input_size();
+  std::array<float, kPackedWeightsGroupSize> products;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    MatrixVectorProductAvx2(weights, x, y);
+    return;
+  } else if (cpu_features_.sse2) {
+    for (int g = 0; g < weights.num_groups(); ++g) {
+      const int8_t* w = weights.group(g).data();
+      __m128 accumulator_low = _mm_setzero_ps();
+      __m128 accumulator_high = _mm_setzero_ps();
+      for (int i = 0; i < input_size; ++i) {
+        // Sign-extend the 8 weights for input `i` to 32 bits.
+        const __m128i w_8 = _mm_loadl_epi64(
+            reinterpret_cast<const __m128i*>(&w[i * kPackedWeightsGroupSize]));
+        const __m128i w_16 = _mm_srai_epi16(_mm_unpacklo_epi8(w_8, w_8), 8);
+        const __m128 w_low =
+            _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(w_16, w_16), 16));
+        const __m128 w_high =
+            _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(w_16, w_16), 16));
+        const __m128 x_i = _mm_set1_ps(x[i]);
+        accumulator_low = _mm_add_ps(accumulator_low, _mm_mul_ps(x_i, w_low));
+        accumulator_high =
+            _mm_add_ps(accumulator_high, _mm_mul_ps(x_i, w_high));
+      }
+      _mm_storeu_ps(&products[0], accumulator_low);
+      _mm_storeu_ps(&products[4], accumulator_high);
+      StoreGroup(products.data(), weights.scale(), g, y);
+    }
+    return;
+  }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  if (cpu_features_.neon) {
+    for (int g = 0; g < weights.num_groups(); ++g) {
+      const int8_t* w = weights.group(g).data();
+      float32x4_t accumulator_low = vdupq_n_f32(0.f);
+      float32x4_t accumulator_high = vdupq_n_f32(0.f);
+      for (int i = 0; i < input_size; ++i) {
+        const int16x8_t w_16 =
+            vmovl_s8(vld1_s8(&w[i * kPackedWeightsGroupSize]));
+        const float32x4_t w_low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(w_16)));
+        const float32x4_t w_high =
+            vcvtq_f32_s32(vmovl_s16(vget_high_s16(w_16)));
+        accumulator_low = vfmaq_n_f32(accumulator_low, w_low, x[i]);
+        accumulator_high = vfmaq_n_f32(accumulator_high, w_high, x[i]);
+      }
+      vst1q_f32(&products[0], accumulator_low);
+      vst1q_f32(&products[4], accumulator_high);
+      StoreGroup(products.data(), weights.scale(), g, y);
+    }
+    return;
+  }
+#endif
+  for (int g = 0; g < weights.num_groups(); ++g) {
+    const int8_t* w = weights.group(g).data();
+    products.fill(0.f);
+    for (int i = 0; i < input_size; ++i) {
+      for (int k = 0; k < kPackedWeightsGroupSize; ++k) {
+        products[k] += x[i] * w[i * kPackedWeightsGroupSize + k];
+      }
+    }
+    StoreGroup(products.data(), weights.scale(), g, y);
+  }
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
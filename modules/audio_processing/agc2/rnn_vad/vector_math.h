@@ -25,6 +25,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/agc2/rnn_vad/packed_weights.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/system/arch.h"
@@ -101,9 +102,18 @@ class VectorMath {
     return std::inner_product(x.begin(), x.end(), y.begin(), 0.f);
   }
 
+  // Computes the product between the transposed `weights` matrix and `x`, that
+  // is one dot product for each output unit, and writes it into `y`.
+  void MatrixVectorProduct(const PackedInt8Weights& weights,
+                           rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y) const;
+
  private:
   float DotProductAvx2(rtc::ArrayView<const float> x,
                        rtc::ArrayView<const float> y) const;
+  void MatrixVectorProductAvx2(const PackedInt8Weights& weights,
+                               rtc::ArrayView<const float> x,
+                               rtc::ArrayView<float> y) const;
 
   const AvailableCpuFeatures cpu_features_;
 };
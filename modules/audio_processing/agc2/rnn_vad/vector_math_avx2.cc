@@ -10,6 +10,8 @@
 
 #include <immintrin.h>
 
+#include <algorithm>
+
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
 #include "rtc_base/checks.h"
@@ -50,5 +52,37 @@ float VectorMath::DotProductAvx2(rtc::ArrayView<const float> x,
   return dot_product;
 }
 
+void VectorMath::MatrixVectorProductAvx2(const PackedInt8Weights& weights,
+                                         rtc::ArrayView<const float> x,
+                                         rtc::ArrayView<float> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), weights.input_size());
+  RTC_DCHECK_EQ(y.size(), weights.output_size());
+  static_assert(kPackedWeightsGroupSize == 8, "");
+  const int input_size = weights.input_size();
+  const int output_size = weights.output_size();
+  const __m256 scale = _mm256_set1_ps(weights.scale());
+  for (int g = 0; g < weights.num_groups(); ++g) {
+    const int8_t* w = weights.group(g).data();
+    __m256 accumulator = _mm256_setzero_ps();
+    for (int i = 0; i < input_size; ++i) {
+      const __m256 w_i = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(
+              &w[i * kPackedWeightsGroupSize]))));
+      accumulator = _mm256_fmadd_ps(w_i, _mm256_set1_ps(x[i]), accumulator);
+    }
+    accumulator = _mm256_mul_ps(scale, accumulator);
+    const int first = g * kPackedWeightsGroupSize;
+    if (first + kPackedWeightsGroupSize <= output_size) {
+      _mm256_storeu_ps(&y[first], accumulator);
+    } else {
+      // Drop the products of the padding output units.
+      float products[kPackedWeightsGroupSize];
+      _mm256_storeu_ps(products, accumulator);
+      std::copy(products, products + output_size - first, &y[first]);
+    }
+  }
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
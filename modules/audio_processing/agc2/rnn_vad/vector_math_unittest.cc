@@ -10,9 +10,12 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
 
+#include <stdint.h>
+
 #include <vector>
 
 #include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/agc2/rnn_vad/packed_weights.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -41,6 +44,32 @@ TEST_P(VectorMathParametrization, TestDotProduct) {
       kEnergyOfXSubspan);
 }
 
+// Checks that the matrix-vector product with packed int8 weights matches the
+// dot products between `kX` and the scaled weights of each output unit.
+TEST_P(VectorMathParametrization, TestMatrixVectorProduct) {
+  VectorMath vector_math(/*cpu_features=*/GetParam());
+  constexpr float kScale = 1.f / 256.f;
+  for (int output_size : {1, 8, 13, 24}) {
+    SCOPED_TRACE(output_size);
+    const int stride = output_size + 3;
+    std::vector<int8_t> weights(kSizeOfX * stride);
+    for (int k = 0; k < static_cast<int>(weights.size()); ++k) {
+      weights[k] = static_cast<int8_t>((37 * k) % 256 - 128);
+    }
+    PackedInt8Weights packed_weights(weights, kSizeOfX, output_size, stride,
+                                     kScale);
+    std::vector<float> y(output_size);
+    vector_math.MatrixVectorProduct(packed_weights, kX, y);
+    for (int o = 0; o < output_size; ++o) {
+      std::vector<float> w(kSizeOfX);
+      for (int i = 0; i < kSizeOfX; ++i) {
+        w[i] = kScale * weights[i * stride + o];
+      }
+      EXPECT_NEAR(y[o], vector_math.DotProduct(kX, w), 1e-5f);
+    }
+  }
+}
+
 // Finds the relevant CPU features combinations to test.
 std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
   std::vector<AvailableCpuFeatures> v;
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/audio_processing_batch.h"
+
+#include "absl/types/optional.h"
+#include "modules/audio_processing/agc2/input_volume_controller.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/gain_controller2.h"
+#include "modules/audio_processing/high_pass_filter.h"
+#include "modules/audio_processing/ns/noise_suppressor.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+AudioProcessingBatch::Config AdjustConfig(AudioProcessingBatch::Config config) {
+  config.gain_controller2.input_volume_controller.enabled = false;
+  return config;
+}
+
+}  // namespace
+
+struct AudioProcessingBatch::Stream {
+  Stream(const Config& config, NrFft* fft)
+      : buffer(config.sample_rate_hz,
+               config.num_channels,
+               config.sample_rate_hz,
+               config.num_channels,
+               config.sample_rate_hz,
+               config.num_channels) {
+    if (config.noise_suppression_enabled) {
+      // AudioProcessing always high-pass filters the input of the noise
+      // suppressor.
+      high_pass_filter = std::make_unique<HighPassFilter>(
+          config.sample_rate_hz, config.num_channels);
+      noise_suppressor = std::make_unique<NoiseSuppressor>(
+          config.noise_suppression, config.sample_rate_hz, config.num_channels,
+          fft);
+    }
+    if (config.gain_controller2.enabled) {
+      gain_controller2 = std::make_unique<GainController2>(
+          config.gain_controller2, InputVolumeController::Config{},
+          config.sample_rate_hz, config.num_channels,
+          /*use_internal_vad=*/true);
+    }
+  }
+
+  AudioBuffer buffer;
+  std::unique_ptr<HighPassFilter> high_pass_filter;
+  std::unique_ptr<NoiseSuppressor> noise_suppressor;
+  std::unique_ptr<GainController2> gain_controller2;
+};
+
+AudioProcessingBatch::AudioProcessingBatch(const Config& config,
+                                           size_t num_streams)
+    : config_(AdjustConfig(config)),
+      stream_config_(config.sample_rate_hz, config.num_channels),
+      multi_band_(config.noise_suppression_enabled &&
+                  (config.sample_rate_hz == AudioProcessing::kSampleRate32kHz ||
+                   config.sample_rate_hz == AudioProcessing::kSampleRate48kHz)),
+      streams_(num_streams) {
+  RTC_DCHECK(GainController2::Validate(config_.gain_controller2));
+  for (auto& stream : streams_) {
+    stream = std::make_unique<Stream>(config_, &fft_);
+  }
+}
+
+AudioProcessingBatch::~AudioProcessingBatch() = default;
+
+void AudioProcessingBatch::ResetStream(size_t stream) {
+  RTC_DCHECK_LT(stream, streams_.size());
+  streams_[stream] = std::make_unique<Stream>(config_, &fft_);
+}
+
+void AudioProcessingBatch::ProcessStreams(
+    rtc::ArrayView<int16_t* const> frames) {
+  RTC_DCHECK_EQ(frames.size(), streams_.size());
+
+  for (size_t i = 0; i < streams_.size(); ++i) {
+    AudioBuffer& buffer = streams_[i]->buffer;
+    buffer.CopyFrom(frames[i], stream_config_);
+  }
+
+  if (config_.noise_suppression_enabled) {
+    for (auto& stream : streams_) {
+      stream->high_pass_filter->Process(&stream->buffer,
+                                        /*use_split_band_data=*/false);
+    }
+  }
+
+  if (multi_band_) {
+    for (auto& stream : streams_) {
+      stream->buffer.SplitIntoFrequencyBands();
+    }
+  }
+
+  if (config_.noise_suppression_enabled) {
+    for (auto& stream : streams_) {
+      stream->noise_suppressor->Analyze(stream->buffer);
+    }
+    for (auto& stream : streams_) {
+      stream->noise_suppressor->Process(&stream->buffer);
+    }
+  }
+
+  if (multi_band_) {
+    for (auto& stream : streams_) {
+      stream->buffer.MergeFrequencyBands();
+    }
+  }
+
+  if (config_.gain_controller2.enabled) {
+    for (auto& stream : streams_) {
+      stream->gain_controller2->Process(
+          /*speech_probability=*/absl::nullopt,
+          /*input_volume_changed=*/false, &stream->buffer);
+    }
+  }
+
+  for (size_t i = 0; i < streams_.size(); ++i) {
+    streams_[i]->buffer.CopyTo(stream_config_, frames[i]);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
+#define MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "modules/audio_processing/ns/ns_config.h"
+#include "modules/audio_processing/ns/ns_fft.h"
+
+namespace webrtc {
+
+class AudioBuffer;
+class GainController2;
+class NoiseSuppressor;
+
+// Runs noise suppression and AGC2 on many independent capture streams of the
+// same format, e.g. the incoming streams of a conference server. Compared to
+// one AudioProcessing instance per stream, the streams are processed without
+// any locking, one processing stage at a time over all streams so that the
+// code and tables of each stage stay in cache, and the noise suppressors
+// share their FFT tables. The output is bit-exact with that of one
+// AudioProcessing instance per stream with the same configuration.
+//
+// The class is not thread-safe; a server is expected to give every worker
+// thread its own batch.
+class AudioProcessingBatch {
+ public:
+  struct Config {
+    int sample_rate_hz = 48000;
+    size_t num_channels = 1;
+    bool noise_suppression_enabled = true;
+    NsConfig noise_suppression;
+    // The input volume controller is not supported, since there is no capture
+    // device to control.
+    AudioProcessing::Config::GainController2 gain_controller2;
+  };
+
+  AudioProcessingBatch(const Config& config, size_t num_streams);
+  AudioProcessingBatch(const AudioProcessingBatch&) = delete;
+  AudioProcessingBatch& operator=(const AudioProcessingBatch&) = delete;
+  ~AudioProcessingBatch();
+
+  size_t num_streams() const { return streams_.size(); }
+
+  // Resets the state of `stream`, e.g. when it is handed to a new sender.
+  void ResetStream(size_t stream);
+
+  // Processes one 10 ms frame of every stream in place. `frames[i]` holds the
+  // interleaved samples of stream i.
+  void ProcessStreams(rtc::ArrayView<int16_t* const> frames);
+
+ private:
+  struct Stream;
+
+  const Config config_;
+  const StreamConfig stream_config_;
+  const bool multi_band_;
+  NrFft fft_;
+  std::vector<std::unique_ptr<Stream>> streams_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_BATCH_H_
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/audio_processing_batch.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "modules/audio_processing/test/audio_processing_builder_for_testing.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumChannels = 1;
+constexpr size_t kFrameSize = kSampleRateHz / 100;
+constexpr int kNumFrames = 200;
+
+// The signal of one stream: a tone plus uniform noise.
+struct StreamSignal {
+  float tone_amplitude;
+  float tone_frequency_hz;
+  float noise_amplitude;
+};
+
+AudioProcessing::Config CreateApmConfig() {
+  AudioProcessing::Config config;
+  config.noise_suppression.enabled = true;
+  config.noise_suppression.level =
+      AudioProcessing::Config::NoiseSuppression::kHigh;
+  config.gain_controller2.enabled = true;
+  config.gain_controller2.adaptive_digital.enabled = true;
+  return config;
+}
+
+// The batch configuration matching `CreateApmConfig()`.
+AudioProcessingBatch::Config CreateBatchConfig() {
+  AudioProcessingBatch::Config config;
+  config.sample_rate_hz = kSampleRateHz;
+  config.num_channels = kNumChannels;
+  config.noise_suppression_enabled = true;
+  config.noise_suppression.target_level = NsConfig::SuppressionLevel::k18dB;
+  config.gain_controller2 = CreateApmConfig().gain_controller2;
+  return config;
+}
+
+rtc::scoped_refptr<AudioProcessing> CreateApm() {
+  return AudioProcessingBuilderForTesting()
+      .SetConfig(CreateApmConfig())
+      .Create();
+}
+
+// Streams that differ in level and noise, so that processing a stream with the
+// state of another one changes the output.
+std::vector<StreamSignal> CreateDifferentSignals() {
+  return {{.tone_amplitude = 300.f,
+           .tone_frequency_hz = 440.f,
+           .noise_amplitude = 30.f},
+          {.tone_amplitude = 8000.f,
+           .tone_frequency_hz = 1000.f,
+           .noise_amplitude = 100.f},
+          {.tone_amplitude = 1000.f,
+           .tone_frequency_hz = 250.f,
+           .noise_amplitude = 2000.f}};
+}
+
+void GenerateFrame(const StreamSignal& signal,
+                   int frame_index,
+                   Random* random,
+                   rtc::ArrayView<int16_t> frame) {
+  for (size_t k = 0; k < frame.size(); ++k) {
+    const float t = (frame_index * kFrameSize + k) / float{kSampleRateHz};
+    const float tone = signal.tone_amplitude *
+                       std::sin(2.f * 3.14159f * signal.tone_frequency_hz * t);
+    const float noise =
+        signal.noise_amplitude * (2.f * random->Rand<float>() - 1.f);
+    frame[k] = static_cast<int16_t>(tone + noise);
+  }
+}
+
+// Processes the streams with `signals` through a batch and through one
+// AudioProcessing instance per stream, and checks that the outputs are
+// bit-exact. If `reset_stream` is set, that stream is reset half way through,
+// and its AudioProcessing instance replaced. `frames` receives the output of
+// the last frame of every stream.
+void ProcessAndCompare(const std::vector<StreamSignal>& signals,
+                       absl::optional<size_t> reset_stream,
+                       std::vector<std::vector<int16_t>>* frames) {
+  const size_t num_streams = signals.size();
+  AudioProcessingBatch batch(CreateBatchConfig(), num_streams);
+  EXPECT_EQ(batch.num_streams(), num_streams);
+  std::vector<rtc::scoped_refptr<AudioProcessing>> apms;
+  for (size_t i = 0; i < num_streams; ++i) {
+    apms.push_back(CreateApm());
+  }
+  const StreamConfig stream_config(kSampleRateHz, kNumChannels);
+
+  Random random(42);
+  frames->assign(num_streams, std::vector<int16_t>(kFrameSize * kNumChannels));
+  std::vector<int16_t*> frame_pointers;
+  for (auto& frame : *frames) {
+    frame_pointers.push_back(frame.data());
+  }
+  std::vector<std::vector<int16_t>> expected(num_streams);
+  for (int n = 0; n < kNumFrames; ++n) {
+    if (reset_stream && n == kNumFrames / 2) {
+      batch.ResetStream(*reset_stream);
+      apms[*reset_stream] = CreateApm();
+    }
+    for (size_t i = 0; i < num_streams; ++i) {
+      GenerateFrame(signals[i], n, &random, (*frames)[i]);
+      expected[i] = (*frames)[i];
+      EXPECT_EQ(apms[i]->ProcessStream(expected[i].data(), stream_config,
+                                       stream_config, expected[i].data()),
+                AudioProcessing::kNoError);
+    }
+    batch.ProcessStreams(frame_pointers);
+    for (size_t i = 0; i < num_streams; ++i) {
+      ASSERT_EQ((*frames)[i], expected[i])
+          << "stream " << i << ", frame " << n;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(AudioProcessingBatch, MatchesAudioProcessingPerStream) {
+  const StreamSignal signal = {.tone_amplitude = 3000.f,
+                               .tone_frequency_hz = 440.f,
+                               .noise_amplitude = 500.f};
+  std::vector<std::vector<int16_t>> frames;
+  ProcessAndCompare({signal, signal, signal}, /*reset_stream=*/absl::nullopt,
+                    &frames);
+}
+
+// Checks that the streams are not mixed up, see CreateDifferentSignals().
+TEST(AudioProcessingBatch, MatchesAudioProcessingPerStreamForDifferentStreams) {
+  const std::vector<StreamSignal> signals = CreateDifferentSignals();
+  std::vector<std::vector<int16_t>> frames;
+  ProcessAndCompare(signals, /*reset_stream=*/absl::nullopt, &frames);
+  ASSERT_EQ(frames.size(), signals.size());
+  EXPECT_NE(frames[0], frames[1]);
+  EXPECT_NE(frames[1], frames[2]);
+  EXPECT_NE(frames[0], frames[2]);
+}
+
+TEST(AudioProcessingBatch, ResetStreamOnlyResetsThatStream) {
+  const std::vector<StreamSignal> signals = CreateDifferentSignals();
+  std::vector<std::vector<int16_t>> frames;
+  ProcessAndCompare(signals, /*reset_stream=*/1, &frames);
+}
+
+}  // namespace webrtc
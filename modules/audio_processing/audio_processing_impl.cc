@@ -672,6 +672,7 @@ AudioProcessingImpl::AudioProcessingImpl(
       render_runtime_settings_enqueuer_(&render_runtime_settings_),
       echo_control_factory_(std::move(echo_control_factory)),
       config_(AdjustConfig(config, gain_controller2_experiment_params_)),
+      config_snapshot_(config_),
       submodule_states_(!!capture_post_processor,
                         !!render_pre_processor,
                         !!capture_analyzer),
@@ -994,6 +995,13 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
   if (pipeline_config_changed) {
     InitializeLocked(formats_.api_format);
   }
+
+  PublishConfigSnapshot();
+}
+
+void AudioProcessingImpl::PublishConfigSnapshot() {
+  MutexLock lock(&mutex_config_snapshot_);
+  config_snapshot_ = config_;
 }
 
 void AudioProcessingImpl::OverrideSubmoduleCreationForTesting(
@@ -1195,6 +1203,7 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
 void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
   RuntimeSetting setting;
   int num_settings_processed = 0;
+  bool config_changed = false;
   while (capture_runtime_settings_.Remove(&setting)) {
     if (aec_dump_) {
       aec_dump_->WriteRuntimeSetting(setting);
@@ -1214,6 +1223,7 @@ void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
           } else {
             config_.capture_level_adjustment.pre_gain_factor = value;
           }
+          config_changed = true;
 
           // Use both the pre-amplifier and the capture level adjustment gains
           // as pre-gains.
@@ -1234,6 +1244,7 @@ void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
           float value;
           setting.GetFloat(&value);
           config_.capture_level_adjustment.post_gain_factor = value;
+          config_changed = true;
           submodules_.capture_levels_adjuster->SetPostGain(
               config_.capture_level_adjustment.post_gain_factor);
         }
@@ -1247,6 +1258,7 @@ void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
           setting.GetFloat(&value);
           int int_value = static_cast<int>(value + .5f);
           config_.gain_controller1.compression_gain_db = int_value;
+          config_changed = true;
           if (submodules_.gain_control) {
             int error =
                 submodules_.gain_control->set_compression_gain_db(int_value);
@@ -1260,6 +1272,7 @@ void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
           float value;
           setting.GetFloat(&value);
           config_.gain_controller2.fixed_digital.gain_db = value;
+          config_changed = true;
           submodules_.gain_controller2->SetFixedGainDb(value);
         }
         break;
@@ -1288,6 +1301,10 @@ void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
     ++num_settings_processed;
   }
 
+  if (config_changed) {
+    PublishConfigSnapshot();
+  }
+
   if (num_settings_processed >= RuntimeSettingQueueSize()) {
     // Handle overrun of the runtime settings queue, which likely will has
     // caused settings to be discarded.
@@ -1337,13 +1354,17 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
     RTC_DCHECK(aecm_render_signal_queue_);
     // Insert the samples into the queue.
     if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result =
-          aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
-      RTC_DCHECK(result);
+      // The data queue is full and needs to be emptied. The frame is dropped
+      // rather than blocking this thread if the capture side is busy, as the
+      // capture thread empties the queue on its next call.
+      if (TryEmptyQueuedRenderAudio()) {
+        // Retry the insert (should always work).
+        bool result =
+            aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
+        RTC_DCHECK(result);
+      } else {
+        CountDroppedRenderFrame();
+      }
     }
   }
 
@@ -1351,12 +1372,17 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
     GainControlImpl::PackRenderAudioBuffer(*audio, &agc_render_queue_buffer_);
     // Insert the samples into the queue.
     if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
-      RTC_DCHECK(result);
+      // The data queue is full and needs to be emptied. The frame is dropped
+      // rather than blocking this thread if the capture side is busy, as the
+      // capture thread empties the queue on its next call.
+      if (TryEmptyQueuedRenderAudio()) {
+        // Retry the insert (should always work).
+        bool result =
+            agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
+        RTC_DCHECK(result);
+      } else {
+        CountDroppedRenderFrame();
+      }
     }
   }
 }
@@ -1367,12 +1393,17 @@ void AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
     RTC_DCHECK(red_render_signal_queue_);
     // Insert the samples into the queue.
     if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = red_render_signal_queue_->Insert(&red_render_queue_buffer_);
-      RTC_DCHECK(result);
+      // The data queue is full and needs to be emptied. The frame is dropped
+      // rather than blocking this thread if the capture side is busy, as the
+      // capture thread empties the queue on its next call.
+      if (TryEmptyQueuedRenderAudio()) {
+        // Retry the insert (should always work).
+        bool result =
+            red_render_signal_queue_->Insert(&red_render_queue_buffer_);
+        RTC_DCHECK(result);
+      } else {
+        CountDroppedRenderFrame();
+      }
     }
   }
 }
@@ -1429,9 +1460,29 @@ void AudioProcessingImpl::AllocateRenderQueue() {
   }
 }
 
-void AudioProcessingImpl::EmptyQueuedRenderAudio() {
-  MutexLock lock_capture(&mutex_capture_);
+bool AudioProcessingImpl::TryEmptyQueuedRenderAudio() {
+  if (!mutex_capture_.TryLock()) {
+    return false;
+  }
   EmptyQueuedRenderAudioLocked();
+  mutex_capture_.Unlock();
+  return true;
+}
+
+void AudioProcessingImpl::CountDroppedRenderFrame() {
+  ++render_.num_dropped_frames;
+  // Drops come in bursts while the capture side is busy, so only the first
+  // one and then every 100th are logged.
+  if (render_.num_dropped_frames % 100 == 1) {
+    RTC_LOG(LS_WARNING) << "Dropped a render frame as the capture side is "
+                           "busy ("
+                        << render_.num_dropped_frames << " in total).";
+  }
+}
+
+int AudioProcessingImpl::num_dropped_render_frames() const {
+  MutexLock lock(&mutex_render_);
+  return render_.num_dropped_frames;
 }
 
 void AudioProcessingImpl::EmptyQueuedRenderAudioLocked() {
@@ -2133,9 +2184,8 @@ void AudioProcessingImpl::DetachAecDump() {
 }
 
 AudioProcessing::Config AudioProcessingImpl::GetConfig() const {
-  MutexLock lock_render(&mutex_render_);
-  MutexLock lock_capture(&mutex_capture_);
-  return config_;
+  MutexLock lock(&mutex_config_snapshot_);
+  return config_snapshot_;
 }
 
 bool AudioProcessingImpl::UpdateActiveSubmoduleStates() {
@@ -137,6 +137,10 @@ class AudioProcessingImpl : public AudioProcessing {
 
   AudioProcessing::Config GetConfig() const override;
 
+  // Returns the number of render frames that were dropped because a render
+  // queue was full while the capture side was busy.
+  int num_dropped_render_frames() const RTC_LOCKS_EXCLUDED(mutex_render_);
+
  protected:
   // Overridden in a mock.
   virtual void InitializeLocked()
@@ -342,13 +346,22 @@ class AudioProcessingImpl : public AudioProcessing {
   int proc_fullband_sample_rate_hz() const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
 
+  // Copies `config_` into the snapshot returned by GetConfig().
+  void PublishConfigSnapshot() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+
   // Empties and handles the respective RuntimeSetting queues.
   void HandleCaptureRuntimeSettings()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void HandleRenderRuntimeSettings()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
 
-  void EmptyQueuedRenderAudio() RTC_LOCKS_EXCLUDED(mutex_capture_);
+  // Empties the render queues unless the capture lock is held, in which case
+  // it returns false without waiting for it. Called by the render thread when
+  // a queue is full.
+  bool TryEmptyQueuedRenderAudio() RTC_LOCKS_EXCLUDED(mutex_capture_);
+  // Counts and logs a render frame dropped when TryEmptyQueuedRenderAudio()
+  // fails.
+  void CountDroppedRenderFrame() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
   void EmptyQueuedRenderAudioLocked()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void AllocateRenderQueue()
@@ -422,6 +435,12 @@ class AudioProcessingImpl : public AudioProcessing {
   // Struct containing the Config specifying the behavior of APM.
   AudioProcessing::Config config_;
 
+  // Copy of `config_` returned by GetConfig(), so that reading the config does
+  // not wait for the render and capture threads nor block them.
+  mutable Mutex mutex_config_snapshot_ RTC_ACQUIRED_AFTER(mutex_capture_);
+  AudioProcessing::Config config_snapshot_
+      RTC_GUARDED_BY(mutex_config_snapshot_);
+
   // Overrides for testing the exclusion of some submodules from the build.
   ApmSubmoduleCreationOverrides submodule_creation_overrides_
       RTC_GUARDED_BY(mutex_capture_);
@@ -542,6 +561,7 @@ class AudioProcessingImpl : public AudioProcessing {
     ~ApmRenderState();
     std::unique_ptr<AudioConverter> render_converter;
     std::unique_ptr<AudioBuffer> render_audio;
+    int num_dropped_frames = 0;
   } render_ RTC_GUARDED_BY(mutex_render_);
 
   // Class for statistics reporting. The class is thread-safe and no lock is
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <memory>
 #include <tuple>
 
@@ -25,8 +26,10 @@
 #include "modules/audio_processing/test/echo_control_mock.h"
 #include "modules/audio_processing/test/test_utils.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/task_queue_for_test.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -109,6 +112,40 @@ class TestEchoDetector : public EchoDetector {
   float last_render_audio_first_sample_;
 };
 
+// EchoDetector whose capture analysis can be made to block, so that a test
+// can hold the capture lock of an APM.
+class BlockingEchoDetector : public EchoDetector {
+ public:
+  void AnalyzeRenderAudio(rtc::ArrayView<const float> render_audio) override {}
+  void AnalyzeCaptureAudio(rtc::ArrayView<const float> capture_audio) override {
+    if (block_capture_) {
+      capture_blocked_.Set();
+      release_capture_.Wait(rtc::Event::kForever);
+    }
+  }
+  void Initialize(int capture_sample_rate_hz,
+                  int num_capture_channels,
+                  int render_sample_rate_hz,
+                  int num_render_channels) override {}
+  EchoDetector::Metrics GetMetrics() const override { return {}; }
+
+  // Makes the next capture analysis block until ReleaseCapture() is called.
+  void BlockCapture() { block_capture_ = true; }
+  // Waits until a capture analysis is blocked.
+  bool WaitForBlockedCapture() {
+    return capture_blocked_.Wait(rtc::Event::kForever);
+  }
+  void ReleaseCapture() {
+    block_capture_ = false;
+    release_capture_.Set();
+  }
+
+ private:
+  std::atomic<bool> block_capture_{false};
+  rtc::Event capture_blocked_;
+  rtc::Event release_capture_;
+};
+
 // Mocks CustomProcessing and applies ProcessSample() to all the samples.
 // Meant to be injected into an APM to modify samples in a known and detectable
 // way.
@@ -230,6 +267,26 @@ TEST(AudioProcessingImplTest, UpdateCapturePreGainRuntimeSetting) {
       << "Frame should be amplified.";
 }
 
+TEST(AudioProcessingImplTest, GetConfigReflectsCaptureRuntimeSettings) {
+  rtc::scoped_refptr<AudioProcessing> apm =
+      AudioProcessingBuilderForTesting().Create();
+  webrtc::AudioProcessing::Config apm_config;
+  apm_config.pre_amplifier.enabled = true;
+  apm_config.pre_amplifier.fixed_gain_factor = 1.f;
+  apm->ApplyConfig(apm_config);
+  EXPECT_EQ(apm->GetConfig().pre_amplifier.fixed_gain_factor, 1.f);
+
+  constexpr float kGainFactor = 2.f;
+  apm->SetRuntimeSetting(
+      AudioProcessing::RuntimeSetting::CreateCapturePreGain(kGainFactor));
+  // The setting is applied by the next capture call.
+  std::array<int16_t, 480> frame;
+  frame.fill(0);
+  StreamConfig config(/*sample_rate_hz=*/48000, /*num_channels=*/1);
+  apm->ProcessStream(frame.data(), config, config, frame.data());
+  EXPECT_EQ(apm->GetConfig().pre_amplifier.fixed_gain_factor, kGainFactor);
+}
+
 TEST(AudioProcessingImplTest,
      LevelAdjustmentUpdateCapturePreGainRuntimeSetting) {
   rtc::scoped_refptr<AudioProcessing> apm =
@@ -691,6 +748,58 @@ TEST(AudioProcessingImplTest, RenderPreProcessorBeforeEchoDetector) {
             test_echo_detector->last_render_audio_first_sample());
 }
 
+TEST(AudioProcessingImplTest, CountsRenderFramesDroppedWhileCaptureIsBusy) {
+  auto echo_detector = rtc::make_ref_counted<BlockingEchoDetector>();
+  auto apm = rtc::make_ref_counted<AudioProcessingImpl>(
+      AudioProcessing::Config(), /*capture_post_processor=*/nullptr,
+      /*render_pre_processor=*/nullptr, /*echo_control_factory=*/nullptr,
+      echo_detector, /*capture_analyzer=*/nullptr);
+  constexpr int kSampleRateHz = 16000;
+  constexpr size_t kNumChannels = 1;
+  const ProcessingConfig processing_config = {{
+      {kSampleRateHz, kNumChannels},
+      {kSampleRateHz, kNumChannels},
+      {kSampleRateHz, kNumChannels},
+      {kSampleRateHz, kNumChannels},
+  }};
+  apm->Initialize(processing_config);
+  std::array<int16_t, kNumChannels * kSampleRateHz / 100> capture_frame;
+  capture_frame.fill(0);
+  std::array<int16_t, kNumChannels * kSampleRateHz / 100> render_frame;
+  render_frame.fill(0);
+  StreamConfig stream_config(kSampleRateHz, kNumChannels);
+
+  // Hold the capture lock inside ProcessStream() on another thread.
+  echo_detector->BlockCapture();
+  TaskQueueForTest capture_queue("capture");
+  capture_queue.PostTask([&] {
+    apm->ProcessStream(capture_frame.data(), stream_config, stream_config,
+                       capture_frame.data());
+  });
+  ASSERT_TRUE(echo_detector->WaitForBlockedCapture());
+
+  // Render more frames than the render queue holds. Once it is full, frames
+  // are dropped instead of waiting for the capture lock.
+  constexpr int kNumRenderFrames = 200;
+  for (int i = 0; i < kNumRenderFrames; ++i) {
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->ProcessReverseStream(render_frame.data(), stream_config,
+                                        stream_config, render_frame.data()));
+  }
+  const int num_dropped_frames = apm->num_dropped_render_frames();
+  EXPECT_GT(num_dropped_frames, 0);
+  EXPECT_LT(num_dropped_frames, kNumRenderFrames);
+
+  // Once the capture side is done, the render thread empties the full queue
+  // itself and no more frames are dropped.
+  echo_detector->ReleaseCapture();
+  capture_queue.SendTask([] {});
+  ASSERT_EQ(AudioProcessing::kNoError,
+            apm->ProcessReverseStream(render_frame.data(), stream_config,
+                                      stream_config, render_frame.data()));
+  EXPECT_EQ(apm->num_dropped_render_frames(), num_dropped_frames);
+}
+
 // Disabling build-optional submodules and trying to enable them via the APM
 // config should be bit-exact with running APM with said submodules disabled.
 // This mainly tests that SetCreateOptionalSubmodulesForTesting has an effect.
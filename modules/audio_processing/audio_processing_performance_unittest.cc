@@ -371,18 +371,21 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
       : rand_gen_(42U),
         simulation_config_(static_cast<SimulationConfig>(GetParam())) {}
 
-  // Run the call simulation with a timeout.
-  bool Run() {
-    StartThreads();
+  // Run the call simulation with a timeout. If `with_control_thread` is true,
+  // a third thread concurrently queries and applies the APM config and queries
+  // the statistics, as done by the signaling and stats threads in a call.
+  bool Run(bool with_control_thread) {
+    StartThreads(with_control_thread);
 
     bool result = test_complete_.Wait(kTestTimeout);
 
     StopThreads();
 
+    const std::string suffix = with_control_thread ? "_contended" : "";
     render_thread_state_->print_processor_statistics(
-        simulation_config_.SettingsDescription() + "_render");
+        simulation_config_.SettingsDescription() + "_render" + suffix);
     capture_thread_state_->print_processor_statistics(
-        simulation_config_.SettingsDescription() + "_capture");
+        simulation_config_.SettingsDescription() + "_capture" + suffix);
 
     return result;
   }
@@ -403,11 +406,26 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
   static const int kMinNumFramesToProcess = 150;
   static constexpr TimeDelta kTestTimeout =
       TimeDelta::Millis(3 * 10 * kMinNumFramesToProcess);
+  static const int kNumControlCallsPerApplyConfig = 100;
 
   // Stop all running threads.
   void StopThreads() {
+    stop_control_thread_.set_flag();
     render_thread_.Finalize();
     capture_thread_.Finalize();
+    control_thread_.Finalize();
+  }
+
+  // Implements the callback functionality for the control thread.
+  void ProcessControl() {
+    const AudioProcessing::Config config = apm_->GetConfig();
+    for (int i = 0; !stop_control_thread_.get_flag(); ++i) {
+      apm_->GetConfig();
+      apm_->GetStatistics();
+      if (i % kNumControlCallsPerApplyConfig == 0) {
+        apm_->ApplyConfig(config);
+      }
+    }
   }
 
   // Simulator and APM setup.
@@ -490,7 +508,7 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
   }
 
   // Start the threads used in the test.
-  void StartThreads() {
+  void StartThreads(bool with_control_thread) {
     const auto attributes =
         rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kRealtime);
     render_thread_ = rtc::PlatformThread::SpawnJoinable(
@@ -505,6 +523,10 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
           }
         },
         "capture", attributes);
+    if (with_control_thread) {
+      control_thread_ = rtc::PlatformThread::SpawnJoinable(
+          [this] { ProcessControl(); }, "control");
+    }
   }
 
   // Event handler for the test.
@@ -517,10 +539,12 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
   const SimulationConfig simulation_config_;
   FrameCounters frame_counters_;
   LockedFlag capture_call_checker_;
+  LockedFlag stop_control_thread_;
   std::unique_ptr<TimedThreadApiProcessor> render_thread_state_;
   std::unique_ptr<TimedThreadApiProcessor> capture_thread_state_;
   rtc::PlatformThread render_thread_;
   rtc::PlatformThread capture_thread_;
+  rtc::PlatformThread control_thread_;
 };
 
 // Implements the callback functionality for the threads.
@@ -557,7 +581,14 @@ const float CallSimulator::kCaptureInputFloatLevel = 0.03125f;
 // TODO(peah): Reactivate once issue 7712 has been resolved.
 TEST_P(CallSimulator, DISABLED_ApiCallDurationTest) {
   // Run test and verify that it did not time out.
-  EXPECT_TRUE(Run());
+  EXPECT_TRUE(Run(/*with_control_thread=*/false));
+}
+
+// Measures the render and capture call durations while the config and the
+// statistics are concurrently accessed.
+TEST_P(CallSimulator, DISABLED_ApiCallDurationWithContentionTest) {
+  // Run test and verify that it did not time out.
+  EXPECT_TRUE(Run(/*with_control_thread=*/true));
 }
 
 INSTANTIATE_TEST_SUITE_P(
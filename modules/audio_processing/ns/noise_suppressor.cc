@@ -16,6 +16,7 @@
 
 #include <algorithm>
 
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/ns/fast_math.h"
 #include "rtc_base/checks.h"
 
@@ -144,21 +145,6 @@ float ComputeEnergyOfExtendedFrame(
   return energy;
 }
 
-// Computes the magnitude spectrum based on an FFT output.
-void ComputeMagnitudeSpectrum(
-    rtc::ArrayView<const float, kFftSize> real,
-    rtc::ArrayView<const float, kFftSize> imag,
-    rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum) {
-  signal_spectrum[0] = fabsf(real[0]) + 1.f;
-  signal_spectrum[kFftSizeBy2Plus1 - 1] =
-      fabsf(real[kFftSizeBy2Plus1 - 1]) + 1.f;
-
-  for (size_t i = 1; i < kFftSizeBy2Plus1 - 1; ++i) {
-    signal_spectrum[i] =
-        SqrtFastApproximation(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
-  }
-}
-
 // Compute prior and post SNR.
 void ComputeSnr(rtc::ArrayView<const float, kFftSizeBy2Plus1> filter,
                 rtc::ArrayView<const float> prev_signal_spectrum,
@@ -240,9 +226,10 @@ float ComputeUpperBandsGain(
 
 NoiseSuppressor::ChannelState::ChannelState(
     const SuppressionParams& suppression_params,
+    const NsVectorMath& vector_math,
     size_t num_bands)
-    : wiener_filter(suppression_params),
-      noise_estimator(suppression_params),
+    : wiener_filter(suppression_params, vector_math),
+      noise_estimator(suppression_params, vector_math),
       process_delay_memory(num_bands > 1 ? num_bands - 1 : 0) {
   analyze_analysis_memory.fill(0.f);
   prev_analysis_signal_spectrum.fill(1.f);
@@ -256,17 +243,26 @@ NoiseSuppressor::ChannelState::ChannelState(
 NoiseSuppressor::NoiseSuppressor(const NsConfig& config,
                                  size_t sample_rate_hz,
                                  size_t num_channels)
+    : NoiseSuppressor(config, sample_rate_hz, num_channels, nullptr) {}
+
+NoiseSuppressor::NoiseSuppressor(const NsConfig& config,
+                                 size_t sample_rate_hz,
+                                 size_t num_channels,
+                                 NrFft* fft)
     : num_bands_(NumBandsForRate(sample_rate_hz)),
       num_channels_(num_channels),
       suppression_params_(config.target_level),
+      owned_fft_(fft ? nullptr : std::make_unique<NrFft>()),
+      fft_(fft ? fft : owned_fft_.get()),
+      vector_math_(GetAvailableCpuFeatures()),
       filter_bank_states_heap_(NumChannelsOnHeap(num_channels_)),
       upper_band_gains_heap_(NumChannelsOnHeap(num_channels_)),
       energies_before_filtering_heap_(NumChannelsOnHeap(num_channels_)),
       gain_adjustments_heap_(NumChannelsOnHeap(num_channels_)),
       channels_(num_channels_) {
   for (size_t ch = 0; ch < num_channels_; ++ch) {
-    channels_[ch] =
-        std::make_unique<ChannelState>(suppression_params_, num_bands_);
+    channels_[ch] = std::make_unique<ChannelState>(suppression_params_,
+                                                   vector_math_, num_bands_);
   }
 }
 
@@ -336,10 +332,10 @@ void NoiseSuppressor::Analyze(const AudioBuffer& audio) {
     // Compute the magnitude spectrum.
     std::array<float, kFftSize> real;
     std::array<float, kFftSize> imag;
-    fft_.Fft(extended_frame, real, imag);
+    fft_->Fft(extended_frame, real, imag);
 
     std::array<float, kFftSizeBy2Plus1> signal_spectrum;
-    ComputeMagnitudeSpectrum(real, imag, signal_spectrum);
+    vector_math_.MagnitudeSpectrum(real, imag, signal_spectrum);
 
     // Compute energies.
     float signal_energy = 0.f;
@@ -422,12 +418,13 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
         ComputeEnergyOfExtendedFrame(filter_bank_states[ch].extended_frame);
 
     // Perform filter bank analysis and compute the magnitude spectrum.
-    fft_.Fft(filter_bank_states[ch].extended_frame, filter_bank_states[ch].real,
-             filter_bank_states[ch].imag);
+    fft_->Fft(filter_bank_states[ch].extended_frame,
+              filter_bank_states[ch].real, filter_bank_states[ch].imag);
 
     std::array<float, kFftSizeBy2Plus1> signal_spectrum;
-    ComputeMagnitudeSpectrum(filter_bank_states[ch].real,
-                             filter_bank_states[ch].imag, signal_spectrum);
+    vector_math_.MagnitudeSpectrum(filter_bank_states[ch].real,
+                                   filter_bank_states[ch].imag,
+                                   signal_spectrum);
 
     // Compute the frequency domain gain filter for noise attenuation.
     channels_[ch]->wiener_filter.Update(
@@ -474,8 +471,8 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
 
   // Perform filter bank synthesis
   for (size_t ch = 0; ch < num_channels_; ++ch) {
-    fft_.Ifft(filter_bank_states[ch].real, filter_bank_states[ch].imag,
-              filter_bank_states[ch].extended_frame);
+    fft_->Ifft(filter_bank_states[ch].real, filter_bank_states[ch].imag,
+               filter_bank_states[ch].extended_frame);
   }
 
   for (size_t ch = 0; ch < num_channels_; ++ch) {
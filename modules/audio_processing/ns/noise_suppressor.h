@@ -20,6 +20,7 @@
 #include "modules/audio_processing/ns/ns_common.h"
 #include "modules/audio_processing/ns/ns_config.h"
 #include "modules/audio_processing/ns/ns_fft.h"
+#include "modules/audio_processing/ns/ns_vector_math.h"
 #include "modules/audio_processing/ns/speech_probability_estimator.h"
 #include "modules/audio_processing/ns/wiener_filter.h"
 
@@ -31,6 +32,12 @@ class NoiseSuppressor {
   NoiseSuppressor(const NsConfig& config,
                   size_t sample_rate_hz,
                   size_t num_channels);
+  // Uses the FFT tables of `fft` instead of its own, so that suppressors that
+  // run on the same thread can share them. `fft` must outlive the suppressor.
+  NoiseSuppressor(const NsConfig& config,
+                  size_t sample_rate_hz,
+                  size_t num_channels,
+                  NrFft* fft);
   NoiseSuppressor(const NoiseSuppressor&) = delete;
   NoiseSuppressor& operator=(const NoiseSuppressor&) = delete;
 
@@ -54,11 +61,15 @@ class NoiseSuppressor {
   const size_t num_channels_;
   const SuppressionParams suppression_params_;
   int32_t num_analyzed_frames_ = -1;
-  NrFft fft_;
+  std::unique_ptr<NrFft> owned_fft_;
+  NrFft* const fft_;
+  const NsVectorMath vector_math_;
   bool capture_output_used_ = true;
 
   struct ChannelState {
-    ChannelState(const SuppressionParams& suppression_params, size_t num_bands);
+    ChannelState(const SuppressionParams& suppression_params,
+                 const NsVectorMath& vector_math,
+                 size_t num_bands);
 
     SpeechProbabilityEstimator speech_probability_estimator;
     WienerFilter wiener_filter;
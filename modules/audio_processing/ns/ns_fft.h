@@ -11,9 +11,8 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NS_FFT_H_
 #define MODULES_AUDIO_PROCESSING_NS_NS_FFT_H_
 
-#include <vector>
-
 #include "api/array_view.h"
+#include "common_audio/real_fft.h"
 #include "modules/audio_processing/ns/ns_common.h"
 
 namespace webrtc {
@@ -36,8 +35,7 @@ class NrFft {
             rtc::ArrayView<float> time_data);
 
  private:
-  std::vector<size_t> bit_reversal_state_;
-  std::vector<float> tables_;
+  const RealFft<kFftSize> fft_;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,267 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/ns_vector_math.h"
+
+#include <math.h>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+namespace webrtc {
+
+void NsVectorMath::LogApproximation(rtc::ArrayView<const float> x,
+                                    rtc::ArrayView<float> y) const {
+  RTC_DCHECK_EQ(x.size(), y.size());
+  size_t k = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    LogApproximationAvx2(x, y);
+    return;
+  }
+  if (cpu_features_.sse2) {
+    // See FastLog2f() in fast_math.cc: the float bits read as an integer give
+    // a scaled and biased log2.
+    const __m128 scale = _mm_set1_ps(1.1920929e-7f);
+    const __m128 bias = _mm_set1_ps(126.942695f);
+    const __m128 log_of_2 = _mm_set1_ps(0.69314718056f);
+    for (; k + 4 <= x.size(); k += 4) {
+      __m128 v = _mm_cvtepi32_ps(_mm_castps_si128(_mm_loadu_ps(&x[k])));
+      v = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(v, scale), bias), log_of_2);
+      _mm_storeu_ps(&y[k], v);
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  if (cpu_features_.neon) {
+    const float32x4_t scale = vdupq_n_f32(1.1920929e-7f);
+    const float32x4_t bias = vdupq_n_f32(126.942695f);
+    const float32x4_t log_of_2 = vdupq_n_f32(0.69314718056f);
+    for (; k + 4 <= x.size(); k += 4) {
+      float32x4_t v =
+          vcvtq_f32_s32(vreinterpretq_s32_f32(vld1q_f32(&x[k])));
+      v = vmulq_f32(vsubq_f32(vmulq_f32(v, scale), bias), log_of_2);
+      vst1q_f32(&y[k], v);
+    }
+  }
+#endif
+  LogApproximationScalar(k, x, y);
+}
+
+void NsVectorMath::MagnitudeSpectrum(
+    rtc::ArrayView<const float, kFftSize> real,
+    rtc::ArrayView<const float, kFftSize> imag,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum) const {
+  signal_spectrum[0] = fabsf(real[0]) + 1.f;
+  signal_spectrum[kFftSizeBy2Plus1 - 1] =
+      fabsf(real[kFftSizeBy2Plus1 - 1]) + 1.f;
+
+  size_t i = 1;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    MagnitudeSpectrumAvx2(real, imag, signal_spectrum);
+    return;
+  }
+  if (cpu_features_.sse2) {
+    const __m128 one = _mm_set1_ps(1.f);
+    for (; i + 4 <= kFftSizeBy2Plus1 - 1; i += 4) {
+      const __m128 re = _mm_loadu_ps(&real[i]);
+      const __m128 im = _mm_loadu_ps(&imag[i]);
+      const __m128 power = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+      _mm_storeu_ps(&signal_spectrum[i], _mm_add_ps(_mm_sqrt_ps(power), one));
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  if (cpu_features_.neon) {
+    const float32x4_t one = vdupq_n_f32(1.f);
+    for (; i + 4 <= kFftSizeBy2Plus1 - 1; i += 4) {
+      const float32x4_t re = vld1q_f32(&real[i]);
+      const float32x4_t im = vld1q_f32(&imag[i]);
+      const float32x4_t power =
+          vaddq_f32(vmulq_f32(re, re), vmulq_f32(im, im));
+      vst1q_f32(&signal_spectrum[i], vaddq_f32(vsqrtq_f32(power), one));
+    }
+  }
+#endif
+  MagnitudeSpectrumScalar(i, real, imag, signal_spectrum);
+}
+
+void NsVectorMath::UpdateWienerFilter(
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_signal_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+    float over_subtraction_factor,
+    float minimum_attenuating_gain,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> filter) const {
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    UpdateWienerFilterAvx2(prev_signal_spectrum, prev_noise_spectrum,
+                           noise_spectrum, signal_spectrum,
+                           over_subtraction_factor, minimum_attenuating_gain,
+                           filter);
+    return;
+  }
+  if (cpu_features_.sse2) {
+    const __m128 epsilon = _mm_set1_ps(0.0001f);
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 prev_weight = _mm_set1_ps(0.98f);
+    const __m128 current_weight = _mm_set1_ps(1.f - 0.98f);
+    const __m128 over_subtraction = _mm_set1_ps(over_subtraction_factor);
+    const __m128 min_gain = _mm_set1_ps(minimum_attenuating_gain);
+    for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+      const __m128 prev_tsa = _mm_mul_ps(
+          _mm_div_ps(_mm_loadu_ps(&prev_signal_spectrum[i]),
+                     _mm_add_ps(_mm_loadu_ps(&prev_noise_spectrum[i]),
+                                epsilon)),
+          _mm_loadu_ps(&filter[i]));
+      const __m128 signal = _mm_loadu_ps(&signal_spectrum[i]);
+      const __m128 noise = _mm_loadu_ps(&noise_spectrum[i]);
+      const __m128 current_tsa = _mm_and_ps(
+          _mm_cmpgt_ps(signal, noise),
+          _mm_sub_ps(_mm_div_ps(signal, _mm_add_ps(noise, epsilon)), one));
+      const __m128 snr_prior =
+          _mm_add_ps(_mm_mul_ps(prev_weight, prev_tsa),
+                     _mm_mul_ps(current_weight, current_tsa));
+      __m128 gain =
+          _mm_div_ps(snr_prior, _mm_add_ps(over_subtraction, snr_prior));
+      gain = _mm_max_ps(_mm_min_ps(gain, one), min_gain);
+      _mm_storeu_ps(&filter[i], gain);
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  if (cpu_features_.neon) {
+    const float32x4_t epsilon = vdupq_n_f32(0.0001f);
+    const float32x4_t one = vdupq_n_f32(1.f);
+    const float32x4_t zero = vdupq_n_f32(0.f);
+    const float32x4_t prev_weight = vdupq_n_f32(0.98f);
+    const float32x4_t current_weight = vdupq_n_f32(1.f - 0.98f);
+    const float32x4_t over_subtraction = vdupq_n_f32(over_subtraction_factor);
+    const float32x4_t min_gain = vdupq_n_f32(minimum_attenuating_gain);
+    for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+      const float32x4_t prev_tsa = vmulq_f32(
+          vdivq_f32(vld1q_f32(&prev_signal_spectrum[i]),
+                    vaddq_f32(vld1q_f32(&prev_noise_spectrum[i]), epsilon)),
+          vld1q_f32(&filter[i]));
+      const float32x4_t signal = vld1q_f32(&signal_spectrum[i]);
+      const float32x4_t noise = vld1q_f32(&noise_spectrum[i]);
+      const float32x4_t current_tsa = vbslq_f32(
+          vcgtq_f32(signal, noise),
+          vsubq_f32(vdivq_f32(signal, vaddq_f32(noise, epsilon)), one), zero);
+      const float32x4_t snr_prior =
+          vaddq_f32(vmulq_f32(prev_weight, prev_tsa),
+                    vmulq_f32(current_weight, current_tsa));
+      float32x4_t gain =
+          vdivq_f32(snr_prior, vaddq_f32(over_subtraction, snr_prior));
+      gain = vmaxq_f32(vminq_f32(gain, one), min_gain);
+      vst1q_f32(&filter[i], gain);
+    }
+  }
+#endif
+  UpdateWienerFilterScalar(i, prev_signal_spectrum, prev_noise_spectrum,
+                           noise_spectrum, signal_spectrum,
+                           over_subtraction_factor, minimum_attenuating_gain,
+                           filter);
+}
+
+void NsVectorMath::UpdateQuantiles(
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> log_spectrum,
+    int counter,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> log_quantile,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> density) const {
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    UpdateQuantilesAvx2(log_spectrum, counter, log_quantile, density);
+    return;
+  }
+  if (cpu_features_.sse2) {
+    constexpr float kWidth = 0.01f;
+    constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 forty = _mm_set1_ps(40.f);
+    const __m128 up_step = _mm_set1_ps(0.25f);
+    const __m128 down_step = _mm_set1_ps(0.75f);
+    const __m128 width = _mm_set1_ps(kWidth);
+    const __m128 one_by_width_plus_2 = _mm_set1_ps(kOneByWidthPlus2);
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 counter_f = _mm_set1_ps(static_cast<float>(counter));
+    const __m128 one_by_counter_plus_1 = _mm_set1_ps(1.f / (counter + 1.f));
+    for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+      __m128 d = _mm_loadu_ps(&density[i]);
+      const __m128 dense = _mm_cmpgt_ps(d, one);
+      const __m128 delta = _mm_or_ps(_mm_and_ps(dense, _mm_div_ps(forty, d)),
+                                     _mm_andnot_ps(dense, forty));
+      const __m128 multiplier = _mm_mul_ps(delta, one_by_counter_plus_1);
+
+      const __m128 log_s = _mm_loadu_ps(&log_spectrum[i]);
+      __m128 log_q = _mm_loadu_ps(&log_quantile[i]);
+      const __m128 above = _mm_cmpgt_ps(log_s, log_q);
+      log_q = _mm_or_ps(
+          _mm_and_ps(above, _mm_add_ps(log_q, _mm_mul_ps(up_step, multiplier))),
+          _mm_andnot_ps(above,
+                        _mm_sub_ps(log_q, _mm_mul_ps(down_step, multiplier))));
+      _mm_storeu_ps(&log_quantile[i], log_q);
+
+      const __m128 close = _mm_cmplt_ps(
+          _mm_and_ps(_mm_sub_ps(log_s, log_q), abs_mask), width);
+      const __m128 new_d = _mm_mul_ps(
+          _mm_add_ps(_mm_mul_ps(counter_f, d), one_by_width_plus_2),
+          one_by_counter_plus_1);
+      d = _mm_or_ps(_mm_and_ps(close, new_d), _mm_andnot_ps(close, d));
+      _mm_storeu_ps(&density[i], d);
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  if (cpu_features_.neon) {
+    constexpr float kWidth = 0.01f;
+    constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
+    const float32x4_t one = vdupq_n_f32(1.f);
+    const float32x4_t forty = vdupq_n_f32(40.f);
+    const float32x4_t up_step = vdupq_n_f32(0.25f);
+    const float32x4_t down_step = vdupq_n_f32(0.75f);
+    const float32x4_t width = vdupq_n_f32(kWidth);
+    const float32x4_t one_by_width_plus_2 = vdupq_n_f32(kOneByWidthPlus2);
+    const float32x4_t counter_f = vdupq_n_f32(static_cast<float>(counter));
+    const float32x4_t one_by_counter_plus_1 =
+        vdupq_n_f32(1.f / (counter + 1.f));
+    for (; i + 4 <= kFftSizeBy2Plus1; i += 4) {
+      float32x4_t d = vld1q_f32(&density[i]);
+      const float32x4_t delta =
+          vbslq_f32(vcgtq_f32(d, one), vdivq_f32(forty, d), forty);
+      const float32x4_t multiplier = vmulq_f32(delta, one_by_counter_plus_1);
+
+      const float32x4_t log_s = vld1q_f32(&log_spectrum[i]);
+      float32x4_t log_q = vld1q_f32(&log_quantile[i]);
+      log_q = vbslq_f32(vcgtq_f32(log_s, log_q),
+                        vaddq_f32(log_q, vmulq_f32(up_step, multiplier)),
+                        vsubq_f32(log_q, vmulq_f32(down_step, multiplier)));
+      vst1q_f32(&log_quantile[i], log_q);
+
+      const float32x4_t new_d =
+          vmulq_f32(vaddq_f32(vmulq_f32(counter_f, d), one_by_width_plus_2),
+                    one_by_counter_plus_1);
+      d = vbslq_f32(vcltq_f32(vabsq_f32(vsubq_f32(log_s, log_q)), width),
+                    new_d, d);
+      vst1q_f32(&density[i], d);
+    }
+  }
+#endif
+  UpdateQuantilesScalar(i, log_spectrum, counter, log_quantile, density);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_NS_NS_VECTOR_MATH_H_
+#define MODULES_AUDIO_PROCESSING_NS_NS_VECTOR_MATH_H_
+
+#include <stddef.h>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/ns/ns_common.h"
+
+namespace webrtc {
+
+// Provides SIMD implementations of the per-bin operations of the noise
+// suppressor, selected at runtime from `cpu_features`. Without any CPU
+// features the operations run the original scalar code, which the SIMD
+// versions match up to rounding.
+class NsVectorMath {
+ public:
+  explicit NsVectorMath(AvailableCpuFeatures cpu_features)
+      : cpu_features_(cpu_features) {}
+
+  // Computes y[k] = LogApproximation(x[k]) for positive x[k].
+  void LogApproximation(rtc::ArrayView<const float> x,
+                        rtc::ArrayView<float> y) const;
+
+  // Computes the magnitude spectrum of the FFT output `real`, `imag`, plus one.
+  void MagnitudeSpectrum(
+      rtc::ArrayView<const float, kFftSize> real,
+      rtc::ArrayView<const float, kFftSize> imag,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum) const;
+
+  // Updates the Wiener filter `filter` with the decision directed estimate of
+  // the prior SNR, and limits it to [`minimum_attenuating_gain`, 1].
+  void UpdateWienerFilter(
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_signal_spectrum,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+      float over_subtraction_factor,
+      float minimum_attenuating_gain,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> filter) const;
+
+  // Updates one set of log quantile and density estimates of the quantile
+  // noise estimator with the log spectrum of a new frame. `counter` is the
+  // number of frames the set has been updated with.
+  void UpdateQuantiles(
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> log_spectrum,
+      int counter,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> log_quantile,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> density) const;
+
+ private:
+  // Scalar versions that start at index `first`. The SIMD versions use them
+  // for the bins that do not fill a whole register. They live in the
+  // ns_vector_math target, which the AVX2 target depends on.
+  static void LogApproximationScalar(size_t first,
+                                     rtc::ArrayView<const float> x,
+                                     rtc::ArrayView<float> y);
+  static void MagnitudeSpectrumScalar(
+      size_t first,
+      rtc::ArrayView<const float, kFftSize> real,
+      rtc::ArrayView<const float, kFftSize> imag,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum);
+  static void UpdateWienerFilterScalar(
+      size_t first,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_signal_spectrum,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+      float over_subtraction_factor,
+      float minimum_attenuating_gain,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> filter);
+  static void UpdateQuantilesScalar(
+      size_t first,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> log_spectrum,
+      int counter,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> log_quantile,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> density);
+
+  void LogApproximationAvx2(rtc::ArrayView<const float> x,
+                            rtc::ArrayView<float> y) const;
+  void MagnitudeSpectrumAvx2(
+      rtc::ArrayView<const float, kFftSize> real,
+      rtc::ArrayView<const float, kFftSize> imag,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum) const;
+  void UpdateWienerFilterAvx2(
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_signal_spectrum,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+      float over_subtraction_factor,
+      float minimum_attenuating_gain,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> filter) const;
+  void UpdateQuantilesAvx2(
+      rtc::ArrayView<const float, kFftSizeBy2Plus1> log_spectrum,
+      int counter,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> log_quantile,
+      rtc::ArrayView<float, kFftSizeBy2Plus1> density) const;
+
+  const AvailableCpuFeatures cpu_features_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_NS_NS_VECTOR_MATH_H_
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/ns/ns_vector_math.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// The operations below use separate multiplies and adds rather than fused
+// ones, so that the results stay as close as possible to the scalar code.
+
+void NsVectorMath::LogApproximationAvx2(rtc::ArrayView<const float> x,
+                                        rtc::ArrayView<float> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), y.size());
+  const __m256 scale = _mm256_set1_ps(1.1920929e-7f);
+  const __m256 bias = _mm256_set1_ps(126.942695f);
+  const __m256 log_of_2 = _mm256_set1_ps(0.69314718056f);
+  size_t k = 0;
+  for (; k + 8 <= x.size(); k += 8) {
+    __m256 v =
+        _mm256_cvtepi32_ps(_mm256_castps_si256(_mm256_loadu_ps(&x[k])));
+    v = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(v, scale), bias), log_of_2);
+    _mm256_storeu_ps(&y[k], v);
+  }
+  LogApproximationScalar(k, x, y);
+}
+
+void NsVectorMath::MagnitudeSpectrumAvx2(
+    rtc::ArrayView<const float, kFftSize> real,
+    rtc::ArrayView<const float, kFftSize> imag,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  const __m256 one = _mm256_set1_ps(1.f);
+  size_t i = 1;
+  for (; i + 8 <= kFftSizeBy2Plus1 - 1; i += 8) {
+    const __m256 re = _mm256_loadu_ps(&real[i]);
+    const __m256 im = _mm256_loadu_ps(&imag[i]);
+    const __m256 power =
+        _mm256_add_ps(_mm256_mul_ps(re, re), _mm256_mul_ps(im, im));
+    _mm256_storeu_ps(&signal_spectrum[i],
+                     _mm256_add_ps(_mm256_sqrt_ps(power), one));
+  }
+  MagnitudeSpectrumScalar(i, real, imag, signal_spectrum);
+}
+
+void NsVectorMath::UpdateWienerFilterAvx2(
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_signal_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+    float over_subtraction_factor,
+    float minimum_attenuating_gain,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> filter) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  const __m256 epsilon = _mm256_set1_ps(0.0001f);
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 prev_weight = _mm256_set1_ps(0.98f);
+  const __m256 current_weight = _mm256_set1_ps(1.f - 0.98f);
+  const __m256 over_subtraction = _mm256_set1_ps(over_subtraction_factor);
+  const __m256 min_gain = _mm256_set1_ps(minimum_attenuating_gain);
+  size_t i = 0;
+  for (; i + 8 <= kFftSizeBy2Plus1; i += 8) {
+    const __m256 prev_tsa = _mm256_mul_ps(
+        _mm256_div_ps(
+            _mm256_loadu_ps(&prev_signal_spectrum[i]),
+            _mm256_add_ps(_mm256_loadu_ps(&prev_noise_spectrum[i]), epsilon)),
+        _mm256_loadu_ps(&filter[i]));
+    const __m256 signal = _mm256_loadu_ps(&signal_spectrum[i]);
+    const __m256 noise = _mm256_loadu_ps(&noise_spectrum[i]);
+    const __m256 current_tsa = _mm256_and_ps(
+        _mm256_cmp_ps(signal, noise, _CMP_GT_OQ),
+        _mm256_sub_ps(_mm256_div_ps(signal, _mm256_add_ps(noise, epsilon)),
+                      one));
+    const __m256 snr_prior =
+        _mm256_add_ps(_mm256_mul_ps(prev_weight, prev_tsa),
+                      _mm256_mul_ps(current_weight, current_tsa));
+    __m256 gain =
+        _mm256_div_ps(snr_prior, _mm256_add_ps(over_subtraction, snr_prior));
+    gain = _mm256_max_ps(_mm256_min_ps(gain, one), min_gain);
+    _mm256_storeu_ps(&filter[i], gain);
+  }
+  UpdateWienerFilterScalar(i, prev_signal_spectrum, prev_noise_spectrum,
+                           noise_spectrum, signal_spectrum,
+                           over_subtraction_factor, minimum_attenuating_gain,
+                           filter);
+}
+
+void NsVectorMath::UpdateQuantilesAvx2(
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> log_spectrum,
+    int counter,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> log_quantile,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> density) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  constexpr float kWidth = 0.01f;
+  constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 forty = _mm256_set1_ps(40.f);
+  const __m256 up_step = _mm256_set1_ps(0.25f);
+  const __m256 down_step = _mm256_set1_ps(0.75f);
+  const __m256 width = _mm256_set1_ps(kWidth);
+  const __m256 one_by_width_plus_2 = _mm256_set1_ps(kOneByWidthPlus2);
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+  const __m256 counter_f = _mm256_set1_ps(static_cast<float>(counter));
+  const __m256 one_by_counter_plus_1 = _mm256_set1_ps(1.f / (counter + 1.f));
+  size_t i = 0;
+  for (; i + 8 <= kFftSizeBy2Plus1; i += 8) {
+    __m256 d = _mm256_loadu_ps(&density[i]);
+    const __m256 delta = _mm256_blendv_ps(forty, _mm256_div_ps(forty, d),
+                                          _mm256_cmp_ps(d, one, _CMP_GT_OQ));
+    const __m256 multiplier = _mm256_mul_ps(delta, one_by_counter_plus_1);
+
+    const __m256 log_s = _mm256_loadu_ps(&log_spectrum[i]);
+    __m256 log_q = _mm256_loadu_ps(&log_quantile[i]);
+    log_q = _mm256_blendv_ps(
+        _mm256_sub_ps(log_q, _mm256_mul_ps(down_step, multiplier)),
+        _mm256_add_ps(log_q, _mm256_mul_ps(up_step, multiplier)),
+        _mm256_cmp_ps(log_s, log_q, _CMP_GT_OQ));
+    _mm256_storeu_ps(&log_quantile[i], log_q);
+
+    const __m256 close = _mm256_cmp_ps(
+        _mm256_and_ps(_mm256_sub_ps(log_s, log_q), abs_mask), width,
+        _CMP_LT_OQ);
+    const __m256 new_d = _mm256_mul_ps(
+        _mm256_add_ps(_mm256_mul_ps(counter_f, d), one_by_width_plus_2),
+        one_by_counter_plus_1);
+    d = _mm256_blendv_ps(d, new_d, close);
+    _mm256_storeu_ps(&density[i], d);
+  }
+  UpdateQuantilesScalar(i, log_spectrum, counter, log_quantile, density);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/ns/fast_math.h"
+#include "modules/audio_processing/ns/ns_vector_math.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+void NsVectorMath::LogApproximationScalar(size_t first,
+                                          rtc::ArrayView<const float> x,
+                                          rtc::ArrayView<float> y) {
+  for (size_t k = first; k < x.size(); ++k) {
+    y[k] = ::webrtc::LogApproximation(x[k]);
+  }
+}
+
+void NsVectorMath::MagnitudeSpectrumScalar(
+    size_t first,
+    rtc::ArrayView<const float, kFftSize> real,
+    rtc::ArrayView<const float, kFftSize> imag,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum) {
+  RTC_DCHECK_GE(first, 1);
+  for (size_t i = first; i < kFftSizeBy2Plus1 - 1; ++i) {
+    signal_spectrum[i] =
+        SqrtFastApproximation(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
+  }
+}
+
+void NsVectorMath::UpdateWienerFilterScalar(
+    size_t first,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_signal_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+    float over_subtraction_factor,
+    float minimum_attenuating_gain,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> filter) {
+  for (size_t i = first; i < kFftSizeBy2Plus1; ++i) {
+    // Previous estimate based on previous frame with gain filter.
+    float prev_tsa = prev_signal_spectrum[i] /
+                     (prev_noise_spectrum[i] + 0.0001f) * filter[i];
+
+    // Current estimate.
+    float current_tsa;
+    if (signal_spectrum[i] > noise_spectrum[i]) {
+      current_tsa = signal_spectrum[i] / (noise_spectrum[i] + 0.0001f) - 1.f;
+    } else {
+      current_tsa = 0.f;
+    }
+
+    // Directed decision estimate is sum of two terms: current estimate and
+    // previous estimate.
+    float snr_prior = 0.98f * prev_tsa + (1.f - 0.98f) * current_tsa;
+    filter[i] = snr_prior / (over_subtraction_factor + snr_prior);
+    filter[i] =
+        std::max(std::min(filter[i], 1.f), minimum_attenuating_gain);
+  }
+}
+
+void NsVectorMath::UpdateQuantilesScalar(
+    size_t first,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> log_spectrum,
+    int counter,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> log_quantile,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> density) {
+  const float one_by_counter_plus_1 = 1.f / (counter + 1.f);
+  for (size_t i = first; i < kFftSizeBy2Plus1; ++i) {
+    // Update log quantile estimate.
+    const float delta = density[i] > 1.f ? 40.f / density[i] : 40.f;
+
+    const float multiplier = delta * one_by_counter_plus_1;
+    if (log_spectrum[i] > log_quantile[i]) {
+      log_quantile[i] += 0.25f * multiplier;
+    } else {
+      log_quantile[i] -= 0.75f * multiplier;
+    }
+
+    // Update density estimate.
+    constexpr float kWidth = 0.01f;
+    constexpr float kOneByWidthPlus2 = 1.f / (2.f * kWidth);
+    if (fabs(log_spectrum[i] - log_quantile[i]) < kWidth) {
+      density[i] =
+          (counter * density[i] + kOneByWidthPlus2) * one_by_counter_plus_1;
+    }
+  }
+}
+
+}  // namespace webrtc
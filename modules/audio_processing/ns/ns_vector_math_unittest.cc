@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/ns_vector_math.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/ns/ns_common.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// The SIMD versions may differ from the scalar ones in the last bits, e.g.,
+// because of a different square root approximation.
+constexpr float kRelativeTolerance = 1e-5f;
+
+void ExpectNear(rtc::ArrayView<const float> expected,
+                rtc::ArrayView<const float> actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i],
+                kRelativeTolerance * std::max(1.f, std::fabs(expected[i])))
+        << "index " << i;
+  }
+}
+
+template <size_t N>
+void FillRandom(Random* random,
+                float min_value,
+                float max_value,
+                std::array<float, N>* x) {
+  for (float& v : *x) {
+    v = min_value + (max_value - min_value) * random->Rand<float>();
+  }
+}
+
+class NsVectorMathParametrization
+    : public ::testing::TestWithParam<AvailableCpuFeatures> {};
+
+TEST_P(NsVectorMathParametrization, LogApproximationMatchesScalar) {
+  const NsVectorMath scalar(NoAvailableCpuFeatures());
+  const NsVectorMath vector_math(GetParam());
+  Random random(42);
+  std::array<float, kFftSizeBy2Plus1> x;
+  FillRandom(&random, 1.f, 1e6f, &x);
+  std::array<float, kFftSizeBy2Plus1> expected;
+  std::array<float, kFftSizeBy2Plus1> actual;
+  scalar.LogApproximation(x, expected);
+  vector_math.LogApproximation(x, actual);
+  ExpectNear(expected, actual);
+
+  // Sizes that do not fill a whole register.
+  constexpr size_t kOddSize = 13;
+  scalar.LogApproximation({x.data(), kOddSize}, {expected.data(), kOddSize});
+  vector_math.LogApproximation({x.data(), kOddSize}, {actual.data(), kOddSize});
+  ExpectNear(expected, actual);
+}
+
+TEST_P(NsVectorMathParametrization, MagnitudeSpectrumMatchesScalar) {
+  const NsVectorMath scalar(NoAvailableCpuFeatures());
+  const NsVectorMath vector_math(GetParam());
+  Random random(17);
+  std::array<float, kFftSize> real;
+  std::array<float, kFftSize> imag;
+  for (int n = 0; n < 10; ++n) {
+    FillRandom(&random, -1000.f, 1000.f, &real);
+    FillRandom(&random, -1000.f, 1000.f, &imag);
+    std::array<float, kFftSizeBy2Plus1> expected;
+    std::array<float, kFftSizeBy2Plus1> actual;
+    scalar.MagnitudeSpectrum(real, imag, expected);
+    vector_math.MagnitudeSpectrum(real, imag, actual);
+    ExpectNear(expected, actual);
+  }
+}
+
+TEST_P(NsVectorMathParametrization, UpdateWienerFilterMatchesScalar) {
+  const NsVectorMath scalar(NoAvailableCpuFeatures());
+  const NsVectorMath vector_math(GetParam());
+  Random random(7);
+  std::array<float, kFftSizeBy2Plus1> expected;
+  expected.fill(1.f);
+  std::array<float, kFftSizeBy2Plus1> actual = expected;
+  for (int n = 0; n < 50; ++n) {
+    std::array<float, kFftSizeBy2Plus1> prev_signal_spectrum;
+    std::array<float, kFftSizeBy2Plus1> prev_noise_spectrum;
+    std::array<float, kFftSizeBy2Plus1> noise_spectrum;
+    std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+    FillRandom(&random, 1.f, 1000.f, &prev_signal_spectrum);
+    FillRandom(&random, 1.f, 1000.f, &prev_noise_spectrum);
+    FillRandom(&random, 1.f, 1000.f, &noise_spectrum);
+    FillRandom(&random, 1.f, 1000.f, &signal_spectrum);
+    scalar.UpdateWienerFilter(prev_signal_spectrum, prev_noise_spectrum,
+                              noise_spectrum, signal_spectrum,
+                              /*over_subtraction_factor=*/1.1f,
+                              /*minimum_attenuating_gain=*/0.1f, expected);
+    vector_math.UpdateWienerFilter(prev_signal_spectrum, prev_noise_spectrum,
+                                   noise_spectrum, signal_spectrum,
+                                   /*over_subtraction_factor=*/1.1f,
+                                   /*minimum_attenuating_gain=*/0.1f, actual);
+    ExpectNear(expected, actual);
+  }
+}
+
+TEST_P(NsVectorMathParametrization, UpdateQuantilesMatchesScalar) {
+  const NsVectorMath scalar(NoAvailableCpuFeatures());
+  const NsVectorMath vector_math(GetParam());
+  Random random(3);
+  std::array<float, kFftSizeBy2Plus1> expected_log_quantile;
+  std::array<float, kFftSizeBy2Plus1> expected_density;
+  expected_log_quantile.fill(8.f);
+  expected_density.fill(0.3f);
+  std::array<float, kFftSizeBy2Plus1> actual_log_quantile =
+      expected_log_quantile;
+  std::array<float, kFftSizeBy2Plus1> actual_density = expected_density;
+  for (int counter = 1; counter <= kLongStartupPhaseBlocks; ++counter) {
+    std::array<float, kFftSizeBy2Plus1> log_spectrum;
+    FillRandom(&random, 7.f, 9.f, &log_spectrum);
+    scalar.UpdateQuantiles(log_spectrum, counter, expected_log_quantile,
+                           expected_density);
+    vector_math.UpdateQuantiles(log_spectrum, counter, actual_log_quantile,
+                                actual_density);
+    ExpectNear(expected_log_quantile, actual_log_quantile);
+    ExpectNear(expected_density, actual_density);
+  }
+}
+
+// Finds the relevant CPU features combinations to test.
+std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
+  std::vector<AvailableCpuFeatures> v;
+  v.push_back(NoAvailableCpuFeatures());
+  AvailableCpuFeatures available = GetAvailableCpuFeatures();
+  if (available.avx2) {
+    v.push_back({/*sse2=*/false, /*avx2=*/true, /*neon=*/false});
+  }
+  if (available.sse2) {
+    v.push_back({/*sse2=*/true, /*avx2=*/false, /*neon=*/false});
+  }
+  if (available.neon) {
+    v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/true});
+  }
+  return v;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    NoiseSuppressor,
+    NsVectorMathParametrization,
+    ::testing::ValuesIn(GetCpuFeaturesToTest()),
+    [](const ::testing::TestParamInfo<AvailableCpuFeatures>& info) {
+      return info.param.ToString();
+    });
+
+}  // namespace
+}  // namespace webrtc
@@ -221,6 +221,7 @@ void Aec3ConfigFromJsonString(absl::string_view json_string,
     ReadParam(section, "capture_alignment_mixing",
               &cfg.delay.capture_alignment_mixing);
     ReadParam(section, "detect_pre_echo", &cfg.delay.detect_pre_echo);
+    ReadParam(section, "coarse_lag_search", &cfg.delay.coarse_lag_search);
   }
 
   if (rtc::GetValueFromJsonObject(aec3_root, "filter", &section)) {
@@ -501,7 +502,9 @@ std::string Aec3ConfigToJsonString(const EchoCanceller3Config& config) {
               : "false");
   ost << "},";
   ost << "\"detect_pre_echo\": "
-      << (config.delay.detect_pre_echo ? "true" : "false");
+      << (config.delay.detect_pre_echo ? "true" : "false") << ",";
+  ost << "\"coarse_lag_search\": "
+      << (config.delay.coarse_lag_search ? "true" : "false");
   ost << "},";
 
   ost << "\"filter\": {";
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Micro benchmarks for the XOR based FEC: the XOR kernels, and ULPFEC
+// encoding and recovery of kUlpfecMaxMediaPackets-sized protection groups.
+//
+// Run through the `benchmarks` target.
+
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kMediaSsrc = 83542;
+constexpr size_t kMinPacketSize = 1000;
+constexpr size_t kMaxPacketSize = 1200;
+constexpr int kNumMediaPackets =
+    static_cast<int>(kUlpfecMaxMediaPackets);
+
+void BM_FecXorBytesScalar(benchmark::State& state) {
+  std::vector<uint8_t> src(state.range(0), 0x5a);
+  std::vector<uint8_t> dst(state.range(0), 0xa5);
+  for (auto _ : state) {
+    internal::XorBytesScalar(src.data(), src.size(), dst.data());
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FecXorBytesScalar)->Arg(1200);
+
+void BM_FecXorBytes(benchmark::State& state) {
+  std::vector<uint8_t> src(state.range(0), 0x5a);
+  std::vector<uint8_t> dst(state.range(0), 0xa5);
+  for (auto _ : state) {
+    internal::XorBytes(src.data(), src.size(), dst.data());
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FecXorBytes)->Arg(1200);
+
+// Encodes one full group of media packets at the protection factor (in Q8)
+// given by the argument.
+void BM_UlpfecEncode(benchmark::State& state) {
+  Random random(0xabcdef123456);
+  test::fec::MediaPacketGenerator generator(kMinPacketSize, kMaxPacketSize,
+                                            kMediaSsrc, &random);
+  ForwardErrorCorrection::PacketList media_packets =
+      generator.ConstructMediaPackets(kNumMediaPackets);
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+  const uint8_t protection_factor = static_cast<uint8_t>(state.range(0));
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+  for (auto _ : state) {
+    fec_packets.clear();
+    RTC_CHECK_EQ(fec->EncodeFec(media_packets, protection_factor,
+                                /*num_important_packets=*/0,
+                                /*use_unequal_protection=*/false,
+                                kFecMaskBursty, &fec_packets),
+                 0);
+    benchmark::DoNotOptimize(fec_packets.front());
+  }
+}
+BENCHMARK(BM_UlpfecEncode)
+    ->ArgName("protection_factor")
+    ->Arg(32)
+    ->Arg(128)
+    ->Arg(255);
+
+// Recovers a group of media packets of which every fourth one is lost, from
+// the FEC packets generated at the protection factor given by the argument.
+void BM_UlpfecRecover(benchmark::State& state) {
+  Random random(0xabcdef123456);
+  test::fec::MediaPacketGenerator generator(kMinPacketSize, kMaxPacketSize,
+                                            kMediaSsrc, &random);
+  ForwardErrorCorrection::PacketList media_packets =
+      generator.ConstructMediaPackets(kNumMediaPackets);
+  std::unique_ptr<ForwardErrorCorrection> encoder =
+      ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+  RTC_CHECK_EQ(encoder->EncodeFec(media_packets,
+                                  static_cast<uint8_t>(state.range(0)),
+                                  /*num_important_packets=*/0,
+                                  /*use_unequal_protection=*/false,
+                                  kFecMaskBursty, &fec_packets),
+               0);
+
+  std::vector<std::unique_ptr<ForwardErrorCorrection::ReceivedPacket>>
+      received_packets;
+  int media_index = 0;
+  for (const auto& media_packet : media_packets) {
+    if (media_index++ % 4 == 0) {
+      continue;
+    }
+    auto received_packet =
+        std::make_unique<ForwardErrorCorrection::ReceivedPacket>();
+    received_packet->pkt = new ForwardErrorCorrection::Packet();
+    received_packet->pkt->data = media_packet->data;
+    received_packet->ssrc = kMediaSsrc;
+    received_packet->seq_num =
+        ByteReader<uint16_t>::ReadBigEndian(media_packet->data.data() + 2);
+    received_packet->is_fec = false;
+    received_packets.push_back(std::move(received_packet));
+  }
+  // ULPFEC packets follow the media packets in sequence number order.
+  uint16_t fec_seq_num = generator.GetNextSeqNum();
+  for (const ForwardErrorCorrection::Packet* fec_packet : fec_packets) {
+    auto received_packet =
+        std::make_unique<ForwardErrorCorrection::ReceivedPacket>();
+    received_packet->pkt = new ForwardErrorCorrection::Packet();
+    received_packet->pkt->data = fec_packet->data;
+    received_packet->ssrc = kMediaSsrc;
+    received_packet->seq_num = fec_seq_num++;
+    received_packet->is_fec = true;
+    received_packets.push_back(std::move(received_packet));
+  }
+
+  for (auto _ : state) {
+    std::unique_ptr<ForwardErrorCorrection> decoder =
+        ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+    ForwardErrorCorrection::RecoveredPacketList recovered_packets;
+    size_t num_recovered_packets = 0;
+    for (const auto& received_packet : received_packets) {
+      num_recovered_packets +=
+          decoder->DecodeFec(*received_packet, &recovered_packets)
+              .num_recovered_packets;
+    }
+    benchmark::DoNotOptimize(num_recovered_packets);
+  }
+}
+BENCHMARK(BM_UlpfecRecover)
+    ->ArgName("protection_factor")
+    ->Arg(64)
+    ->Arg(128)
+    ->Arg(255);
+
+}  // namespace
+}  // namespace webrtc
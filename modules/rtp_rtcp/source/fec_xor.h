@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace internal {
+
+// Computes dst[i] ^= src[i] for i in [0, length). The buffers must not
+// overlap. Uses AVX2, SSE2 or NEON when available; the result is the same for
+// every implementation.
+void XorBytes(const uint8_t* src, size_t length, uint8_t* dst);
+
+// Portable version of XorBytes(), exposed for tests and benchmarks. Defined in
+// fec_xor_scalar.cc, which the SIMD versions also use for the tail.
+void XorBytesScalar(const uint8_t* src, size_t length, uint8_t* dst);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// AVX2 version of XorBytes(), defined in fec_xor_avx2.cc. Must only be called
+// if the CPU supports AVX2.
+void XorBytesAvx2(const uint8_t* src, size_t length, uint8_t* dst);
+#endif
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+std::vector<uint8_t> RandomBytes(Random& random, size_t length) {
+  std::vector<uint8_t> bytes(length);
+  for (uint8_t& byte : bytes) {
+    byte = random.Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+std::vector<uint8_t> ReferenceXor(const std::vector<uint8_t>& src,
+                                  std::vector<uint8_t> dst) {
+  for (size_t i = 0; i < src.size(); ++i) {
+    dst[i] ^= src[i];
+  }
+  return dst;
+}
+
+// Lengths that cover the empty case, the tails of all register widths and a
+// full-size packet.
+constexpr size_t kLengths[] = {0, 1, 7, 8, 15, 16, 31, 32, 33, 63, 1500};
+
+TEST(FecXorTest, ScalarMatchesReference) {
+  Random random(42);
+  for (size_t length : kLengths) {
+    const std::vector<uint8_t> src = RandomBytes(random, length);
+    std::vector<uint8_t> dst = RandomBytes(random, length);
+    const std::vector<uint8_t> expected = ReferenceXor(src, dst);
+    XorBytesScalar(src.data(), length, dst.data());
+    EXPECT_EQ(expected, dst) << "length " << length;
+  }
+}
+
+TEST(FecXorTest, XorBytesMatchesReference) {
+  Random random(42);
+  for (size_t length : kLengths) {
+    const std::vector<uint8_t> src = RandomBytes(random, length);
+    std::vector<uint8_t> dst = RandomBytes(random, length);
+    const std::vector<uint8_t> expected = ReferenceXor(src, dst);
+    XorBytes(src.data(), length, dst.data());
+    EXPECT_EQ(expected, dst) << "length " << length;
+  }
+}
+
+TEST(FecXorTest, XorBytesHandlesUnalignedBuffers) {
+  Random random(42);
+  const std::vector<uint8_t> src = RandomBytes(random, 1001);
+  std::vector<uint8_t> dst = RandomBytes(random, 1003);
+  std::vector<uint8_t> expected = dst;
+  for (size_t i = 0; i < 1000; ++i) {
+    expected[i + 3] ^= src[i + 1];
+  }
+  XorBytes(src.data() + 1, 1000, dst.data() + 3);
+  EXPECT_EQ(expected, dst);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(FecXorTest, Avx2MatchesReference) {
+  if (GetCPUInfo(kAVX2) == 0) {
+    GTEST_SKIP() << "AVX2 is not supported.";
+  }
+  Random random(42);
+  for (size_t length : kLengths) {
+    const std::vector<uint8_t> src = RandomBytes(random, length);
+    std::vector<uint8_t> dst = RandomBytes(random, length);
+    const std::vector<uint8_t> expected = ReferenceXor(src, dst);
+    XorBytesAvx2(src.data(), length, dst.data());
+    EXPECT_EQ(expected, dst) << "length " << length;
+  }
+}
+#endif
+
+}  // namespace
+}  // namespace internal
+}  // namespace webrtc
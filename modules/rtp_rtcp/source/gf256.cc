@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256.h"
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+#if defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+bool UseAvx2() {
+  static const bool use_avx2 = GetCPUInfo(kAVX2) != 0;
+  return use_avx2;
+}
+#endif
+
+}  // namespace
+
+void Gf256MultiplyAdd(uint8_t coefficient,
+                      const uint8_t* src,
+                      size_t length,
+                      uint8_t* dst) {
+  if (coefficient == 0) {
+    return;
+  }
+  if (coefficient == 1) {
+    XorBytes(src, length, dst);
+    return;
+  }
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (UseAvx2()) {
+    Gf256MultiplyAddAvx2(coefficient, src, length, dst);
+    return;
+  }
+#elif defined(WEBRTC_HAS_NEON) && defined(WEBRTC_ARCH_ARM64)
+  uint8_t low[16];
+  uint8_t high[16];
+  Gf256NibbleTables(coefficient, low, high);
+  const uint8x16_t low_table = vld1q_u8(low);
+  const uint8x16_t high_table = vld1q_u8(high);
+  const uint8x16_t nibble_mask = vdupq_n_u8(0x0f);
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t s = vld1q_u8(src + i);
+    const uint8x16_t product =
+        veorq_u8(vqtbl1q_u8(low_table, vandq_u8(s, nibble_mask)),
+                 vqtbl1q_u8(high_table, vshrq_n_u8(s, 4)));
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), product));
+  }
+#endif
+  Gf256MultiplyAddScalar(coefficient, src + i, length - i, dst + i);
+}
+
+}  // namespace internal
+}  // namespace webrtc
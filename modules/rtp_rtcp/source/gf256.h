@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_GF256_H_
+#define MODULES_RTP_RTCP_SOURCE_GF256_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace internal {
+
+// Arithmetic in GF(2^8) with the polynomial x^8 + x^4 + x^3 + x^2 + 1 (0x11d).
+// Addition is XOR, see XorBytes() in fec_xor.h.
+
+uint8_t Gf256Multiply(uint8_t a, uint8_t b);
+
+// Returns the multiplicative inverse of `a`, which must not be zero.
+uint8_t Gf256Inverse(uint8_t a);
+
+// Computes dst[i] ^= coefficient * src[i] for i in [0, length). The buffers
+// must not overlap. Uses AVX2 or NEON when available; the result is the same
+// for every implementation.
+void Gf256MultiplyAdd(uint8_t coefficient,
+                      const uint8_t* src,
+                      size_t length,
+                      uint8_t* dst);
+
+// Portable version of Gf256MultiplyAdd(), exposed for tests and benchmarks.
+// This, Gf256Multiply(), Gf256Inverse() and Gf256NibbleTables() are defined in
+// gf256_scalar.cc, which the SIMD versions also use. The dispatching
+// Gf256MultiplyAdd() is defined in gf256.cc.
+void Gf256MultiplyAddScalar(uint8_t coefficient,
+                            const uint8_t* src,
+                            size_t length,
+                            uint8_t* dst);
+
+// Fills `low` and `high` with the products of `coefficient` and every value
+// of the low and the high nibble of a byte, so that
+// coefficient * x == low[x & 0xf] ^ high[x >> 4]. The SIMD versions look the
+// products up with byte shuffles.
+void Gf256NibbleTables(uint8_t coefficient, uint8_t low[16], uint8_t high[16]);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// AVX2 version of Gf256MultiplyAdd(), defined in gf256_avx2.cc. Must only be
+// called if the CPU supports AVX2.
+void Gf256MultiplyAddAvx2(uint8_t coefficient,
+                          const uint8_t* src,
+                          size_t length,
+                          uint8_t* dst);
+#endif
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_GF256_H_
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/rtp_rtcp/source/gf256.h"
+
+namespace webrtc {
+namespace internal {
+
+void Gf256MultiplyAddAvx2(uint8_t coefficient,
+                          const uint8_t* src,
+                          size_t length,
+                          uint8_t* dst) {
+  uint8_t low[16];
+  uint8_t high[16];
+  Gf256NibbleTables(coefficient, low, high);
+  // The byte shuffle looks up within each 128-bit lane, so both lanes get a
+  // copy of the tables.
+  const __m256i low_table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(low)));
+  const __m256i high_table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(high)));
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    const __m256i s =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i low_nibbles = _mm256_and_si256(s, nibble_mask);
+    const __m256i high_nibbles =
+        _mm256_and_si256(_mm256_srli_epi16(s, 4), nibble_mask);
+    const __m256i product =
+        _mm256_xor_si256(_mm256_shuffle_epi8(low_table, low_nibbles),
+                         _mm256_shuffle_epi8(high_table, high_nibbles));
+    const __m256i d =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_xor_si256(d, product));
+  }
+  Gf256MultiplyAddScalar(coefficient, src + i, length - i, dst + i);
+}
+
+}  // namespace internal
+}  // namespace webrtc
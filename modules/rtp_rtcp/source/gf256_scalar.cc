@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256.h"
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+constexpr int kPolynomial = 0x11d;
+// The log of zero, which is not otherwise defined. It points into a run of
+// zeros in the exp table, so that exp[log[a] + log[b]] is zero when b is.
+constexpr int kLogZero = 510;
+
+struct Tables {
+  Tables() {
+    int x = 1;
+    for (int i = 0; i < 255; ++i) {
+      exp[i] = static_cast<uint8_t>(x);
+      exp[i + 255] = static_cast<uint8_t>(x);
+      log[x] = static_cast<uint16_t>(i);
+      x <<= 1;
+      if (x & 0x100) {
+        x ^= kPolynomial;
+      }
+    }
+    for (int i = kLogZero; i < kLogZero + 255; ++i) {
+      exp[i] = 0;
+    }
+    log[0] = kLogZero;
+  }
+
+  // Twice the period, so that exp[log[a] + log[b]] needs no modulo, followed
+  // by the zeros that the log of zero points to.
+  uint8_t exp[kLogZero + 255];
+  uint16_t log[256];
+};
+
+const Tables& GetTables() {
+  static const Tables* const tables = new Tables();
+  return *tables;
+}
+
+}  // namespace
+
+uint8_t Gf256Multiply(uint8_t a, uint8_t b) {
+  if (a == 0 || b == 0) {
+    return 0;
+  }
+  const Tables& tables = GetTables();
+  return tables.exp[tables.log[a] + tables.log[b]];
+}
+
+uint8_t Gf256Inverse(uint8_t a) {
+  RTC_DCHECK_NE(a, 0);
+  const Tables& tables = GetTables();
+  return tables.exp[255 - tables.log[a]];
+}
+
+void Gf256NibbleTables(uint8_t coefficient, uint8_t low[16], uint8_t high[16]) {
+  for (int i = 0; i < 16; ++i) {
+    low[i] = Gf256Multiply(coefficient, static_cast<uint8_t>(i));
+    high[i] = Gf256Multiply(coefficient, static_cast<uint8_t>(i << 4));
+  }
+}
+
+void Gf256MultiplyAddScalar(uint8_t coefficient,
+                            const uint8_t* src,
+                            size_t length,
+                            uint8_t* dst) {
+  if (coefficient == 0) {
+    return;
+  }
+  if (coefficient == 1) {
+    XorBytesScalar(src, length, dst);
+    return;
+  }
+  const Tables& tables = GetTables();
+  const uint8_t* const exp = &tables.exp[tables.log[coefficient]];
+  for (size_t i = 0; i < length; ++i) {
+    dst[i] ^= exp[tables.log[src[i]]];
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
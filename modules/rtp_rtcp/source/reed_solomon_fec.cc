@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec.h"
+
+#include <string.h>
+
+#include <utility>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/gf256.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+using internal::Gf256Inverse;
+using internal::Gf256Multiply;
+using internal::Gf256MultiplyAdd;
+
+uint8_t ReedSolomonCode::Coefficient(size_t num_source_shards,
+                                     size_t repair_index,
+                                     size_t source_index) {
+  RTC_DCHECK_LT(source_index, num_source_shards);
+  RTC_DCHECK_LE(num_source_shards + repair_index, 255);
+  // Cauchy matrix entry 1 / (x_j + y_i), with x_j = k + j and y_i = i. The
+  // x_j and y_i are distinct, so every square submatrix is invertible.
+  const uint8_t x = static_cast<uint8_t>(num_source_shards + repair_index);
+  const uint8_t y = static_cast<uint8_t>(source_index);
+  return Gf256Inverse(x ^ y);
+}
+
+void ReedSolomonCode::Encode(
+    size_t shard_length,
+    rtc::ArrayView<const uint8_t* const> source_shards,
+    rtc::ArrayView<uint8_t* const> repair_shards) {
+  const size_t num_source_shards = source_shards.size();
+  RTC_DCHECK_GT(num_source_shards, 0);
+  RTC_DCHECK_LE(num_source_shards, kMaxSourceShards);
+  RTC_DCHECK_LE(repair_shards.size(), kMaxRepairShards);
+  for (uint8_t* repair_shard : repair_shards) {
+    memset(repair_shard, 0, shard_length);
+  }
+  // Source shard outer, so that each one is read while it is in cache.
+  for (size_t i = 0; i < num_source_shards; ++i) {
+    for (size_t j = 0; j < repair_shards.size(); ++j) {
+      Gf256MultiplyAdd(Coefficient(num_source_shards, j, i), source_shards[i],
+                       shard_length, repair_shards[j]);
+    }
+  }
+}
+
+bool ReedSolomonCode::Decode(size_t shard_length,
+                             rtc::ArrayView<const uint8_t* const> source_shards,
+                             rtc::ArrayView<const RepairShard> repair_shards,
+                             rtc::ArrayView<uint8_t* const> missing_shards) {
+  const size_t num_source_shards = source_shards.size();
+  RTC_DCHECK_GT(num_source_shards, 0);
+  RTC_DCHECK_LE(num_source_shards, kMaxSourceShards);
+  size_t missing_indices[kMaxSourceShards];
+  size_t num_missing = 0;
+  for (size_t i = 0; i < num_source_shards; ++i) {
+    if (source_shards[i] == nullptr) {
+      missing_indices[num_missing++] = i;
+    }
+  }
+  RTC_DCHECK_EQ(num_missing, missing_shards.size());
+  if (num_missing == 0) {
+    return true;
+  }
+  if (repair_shards.size() < num_missing) {
+    return false;
+  }
+
+  // Remove the contribution of the received source shards from the first
+  // `num_missing` repair shards. What is left is a square system in the
+  // missing shards.
+  std::vector<uint8_t> syndromes(num_missing * shard_length);
+  for (size_t r = 0; r < num_missing; ++r) {
+    RTC_DCHECK_LT(repair_shards[r].index, kMaxRepairShards);
+    uint8_t* syndrome = &syndromes[r * shard_length];
+    memcpy(syndrome, repair_shards[r].data, shard_length);
+    for (size_t i = 0; i < num_source_shards; ++i) {
+      if (source_shards[i] != nullptr) {
+        Gf256MultiplyAdd(
+            Coefficient(num_source_shards, repair_shards[r].index, i),
+            source_shards[i], shard_length, syndrome);
+      }
+    }
+  }
+
+  // Invert the Cauchy submatrix of the missing shards with Gauss-Jordan
+  // elimination. Row r belongs to repair shard r, column c to missing shard c.
+  std::vector<uint8_t> matrix(num_missing * num_missing);
+  std::vector<uint8_t> inverse(num_missing * num_missing, 0);
+  for (size_t r = 0; r < num_missing; ++r) {
+    for (size_t c = 0; c < num_missing; ++c) {
+      matrix[r * num_missing + c] = Coefficient(
+          num_source_shards, repair_shards[r].index, missing_indices[c]);
+    }
+    inverse[r * num_missing + r] = 1;
+  }
+  for (size_t c = 0; c < num_missing; ++c) {
+    size_t pivot = c;
+    while (pivot < num_missing && matrix[pivot * num_missing + c] == 0) {
+      ++pivot;
+    }
+    if (pivot == num_missing) {
+      // Only possible if two repair shards have the same index.
+      return false;
+    }
+    if (pivot != c) {
+      for (size_t k = 0; k < num_missing; ++k) {
+        std::swap(matrix[pivot * num_missing + k], matrix[c * num_missing + k]);
+        std::swap(inverse[pivot * num_missing + k],
+                  inverse[c * num_missing + k]);
+      }
+    }
+    const uint8_t scale = Gf256Inverse(matrix[c * num_missing + c]);
+    for (size_t k = 0; k < num_missing; ++k) {
+      matrix[c * num_missing + k] =
+          Gf256Multiply(matrix[c * num_missing + k], scale);
+      inverse[c * num_missing + k] =
+          Gf256Multiply(inverse[c * num_missing + k], scale);
+    }
+    for (size_t r = 0; r < num_missing; ++r) {
+      const uint8_t factor = matrix[r * num_missing + c];
+      if (r == c || factor == 0) {
+        continue;
+      }
+      for (size_t k = 0; k < num_missing; ++k) {
+        matrix[r * num_missing + k] ^=
+            Gf256Multiply(factor, matrix[c * num_missing + k]);
+        inverse[r * num_missing + k] ^=
+            Gf256Multiply(factor, inverse[c * num_missing + k]);
+      }
+    }
+  }
+
+  for (size_t c = 0; c < num_missing; ++c) {
+    memset(missing_shards[c], 0, shard_length);
+    for (size_t r = 0; r < num_missing; ++r) {
+      Gf256MultiplyAdd(inverse[c * num_missing + r],
+                       &syndromes[r * shard_length], shard_length,
+                       missing_shards[c]);
+    }
+  }
+  return true;
+}
+
+}  // namespace webrtc
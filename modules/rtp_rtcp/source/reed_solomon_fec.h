@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Systematic Reed-Solomon erasure code over GF(2^8), built from a Cauchy
+// matrix. A group of k source shards is protected by m repair shards, and
+// any k of the k + m shards recover the whole group. The XOR codes of
+// ForwardErrorCorrection can only recover the losses that their packet masks
+// were designed for, which makes them weak against bursts for a given
+// overhead.
+//
+// All shards of a group have the same length. Repair shard j is
+// sum_i Coefficient(k, j, i) * source shard i.
+class ReedSolomonCode {
+ public:
+  // The groups use the same limits as the XOR codes, so that the FEC
+  // controllers can drive either kind of code.
+  static constexpr size_t kMaxSourceShards = 48;
+  static constexpr size_t kMaxRepairShards = kMaxSourceShards;
+
+  struct RepairShard {
+    size_t index;
+    const uint8_t* data;
+  };
+
+  // Returns the coefficient of source shard `source_index` in repair shard
+  // `repair_index`, for groups of `num_source_shards`.
+  static uint8_t Coefficient(size_t num_source_shards,
+                             size_t repair_index,
+                             size_t source_index);
+
+  // Computes `repair_shards.size()` repair shards of `shard_length` bytes
+  // from `source_shards`.
+  static void Encode(size_t shard_length,
+                     rtc::ArrayView<const uint8_t* const> source_shards,
+                     rtc::ArrayView<uint8_t* const> repair_shards);
+
+  // Recovers the missing source shards of a group. `source_shards` holds one
+  // entry per source shard of the group, null for the missing ones, and the
+  // recovered shards are written, in order, to `missing_shards`, which must
+  // have one entry per null source shard. Returns false if there are fewer
+  // repair shards than missing source shards.
+  static bool Decode(size_t shard_length,
+                     rtc::ArrayView<const uint8_t* const> source_shards,
+                     rtc::ArrayView<const RepairShard> repair_shards,
+                     rtc::ArrayView<uint8_t* const> missing_shards);
+};
+
+// Payload format of the repair packets, sent on their own SSRC like FlexFEC:
+//
+//   0                   1                   2                   3
+//   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |                      Protected media SSRC                     |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |       Sequence number base    |  Source count |  Repair index |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |                         Repair shard                          |
+//
+// The group protects the media packets with sequence numbers base to
+// base + source count - 1. The source shard of a media packet is its first two
+// RTP header bytes, its length after the 12 byte base header as a 16-bit big
+// endian number, its timestamp, and then everything after the base header.
+// Shards shorter than the repair shard are zero padded.
+constexpr size_t kReedSolomonFecHeaderSize = 8;
+constexpr size_t kReedSolomonShardHeaderSize = 8;
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_H_
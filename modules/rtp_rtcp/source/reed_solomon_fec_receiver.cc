@@ -0,0 +1,289 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_receiver.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+// Number of media packets kept for recovery, counted back from the newest
+// one. Groups that reach further back are discarded.
+constexpr int64_t kMaxMediaPacketHistory =
+    4 * ReedSolomonCode::kMaxSourceShards;
+
+// Bound on the groups kept while waiting for more packets.
+constexpr size_t kMaxGroups = 64;
+
+constexpr uint8_t kRtpVersionMask = 0xc0;
+constexpr uint8_t kRtpVersion2 = 0x80;
+
+}  // namespace
+
+ReedSolomonFecReceiver::ReedSolomonFecReceiver(
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    RecoveredPacketReceiver* recovered_packet_receiver)
+    : ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      recovered_packet_receiver_(recovered_packet_receiver) {
+  // It's OK to create this object on a different thread/task queue than
+  // the one used during main operation.
+  sequence_checker_.Detach();
+}
+
+ReedSolomonFecReceiver::~ReedSolomonFecReceiver() = default;
+
+void ReedSolomonFecReceiver::OnRtpPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  // Recovered packets may come back here through the callback. They are
+  // already in `media_packets_`.
+  if (packet.recovered()) {
+    return;
+  }
+  if (packet.Ssrc() == ssrc_) {
+    AddRepairPacket(packet);
+  } else if (packet.Ssrc() == protected_media_ssrc_) {
+    AddMediaPacket(packet);
+  } else {
+    return;
+  }
+  ++packet_counter_.num_packets;
+
+  // Hand the packets over only once the state is consistent, since the
+  // callback may end up here again.
+  for (const RtpPacketReceived& recovered_packet : RecoverPackets()) {
+    ++packet_counter_.num_recovered_packets;
+    recovered_packet_receiver_->OnRecoveredPacket(recovered_packet);
+  }
+}
+
+FecPacketCounter ReedSolomonFecReceiver::GetPacketCounter() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return packet_counter_;
+}
+
+void ReedSolomonFecReceiver::AddRepairPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  rtc::ArrayView<const uint8_t> payload = packet.payload();
+  if (payload.size() <
+      kReedSolomonFecHeaderSize + kReedSolomonShardHeaderSize) {
+    RTC_LOG(LS_WARNING) << "Truncated Reed-Solomon FEC packet, discarding.";
+    return;
+  }
+  ++packet_counter_.num_fec_packets;
+  if (ByteReader<uint32_t>::ReadBigEndian(&payload[0]) !=
+      protected_media_ssrc_) {
+    return;
+  }
+  const size_t num_source_packets = payload[6];
+  const size_t repair_index = payload[7];
+  if (num_source_packets == 0 ||
+      num_source_packets > ReedSolomonCode::kMaxSourceShards ||
+      repair_index >= ReedSolomonCode::kMaxRepairShards) {
+    RTC_LOG(LS_WARNING) << "Invalid Reed-Solomon FEC header, discarding.";
+    return;
+  }
+  const int64_t base_seq_num = seq_num_unwrapper_.Unwrap(
+      ByteReader<uint16_t>::ReadBigEndian(&payload[4]));
+  if (!media_packets_.empty() &&
+      base_seq_num + static_cast<int64_t>(num_source_packets) <=
+          media_packets_.rbegin()->first - kMaxMediaPacketHistory) {
+    // Too old to be of any use.
+    return;
+  }
+
+  Group& group = groups_[base_seq_num];
+  if (group.repair_shards.empty()) {
+    group.num_source_packets = num_source_packets;
+  } else if (group.num_source_packets != num_source_packets ||
+             group.repair_shards.front().data.size() !=
+                 payload.size() - kReedSolomonFecHeaderSize) {
+    RTC_LOG(LS_WARNING) << "Inconsistent Reed-Solomon FEC group, discarding.";
+    return;
+  }
+  for (const RepairShard& repair_shard : group.repair_shards) {
+    if (repair_shard.index == repair_index) {
+      return;
+    }
+  }
+  group.repair_shards.push_back(
+      {repair_index, packet.Buffer().Slice(
+                         packet.headers_size() + kReedSolomonFecHeaderSize,
+                         payload.size() - kReedSolomonFecHeaderSize)});
+  while (groups_.size() > kMaxGroups) {
+    groups_.erase(groups_.begin());
+  }
+}
+
+void ReedSolomonFecReceiver::AddMediaPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK_GE(packet.size(), kRtpHeaderSize);
+  const int64_t seq_num = seq_num_unwrapper_.Unwrap(packet.SequenceNumber());
+  extensions_ = packet.extension_manager();
+  // The sender protects the packets before the mutable extensions are
+  // written, so compare with the same zeroed extensions.
+  RtpPacketReceived packet_copy(packet);
+  packet_copy.ZeroMutableExtensions();
+  media_packets_[seq_num] = packet_copy.Buffer();
+  DiscardOldPackets(media_packets_.rbegin()->first);
+}
+
+std::vector<RtpPacketReceived> ReedSolomonFecReceiver::RecoverPackets() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  std::vector<RtpPacketReceived> recovered_packets;
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    auto it = groups_.begin();
+    while (it != groups_.end()) {
+      const size_t num_recovered_before = recovered_packets.size();
+      if (RecoverGroup(it->first, it->second, &recovered_packets)) {
+        it = groups_.erase(it);
+        // Recovered packets may complete the groups before this one.
+        progress |= recovered_packets.size() > num_recovered_before;
+      } else {
+        ++it;
+      }
+    }
+  }
+  return recovered_packets;
+}
+
+bool ReedSolomonFecReceiver::RecoverGroup(
+    int64_t base_seq_num,
+    const Group& group,
+    std::vector<RtpPacketReceived>* recovered_packets) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const size_t num_source_packets = group.num_source_packets;
+  const uint8_t* source_shards[ReedSolomonCode::kMaxSourceShards] = {};
+  size_t num_missing = 0;
+  for (size_t i = 0; i < num_source_packets; ++i) {
+    if (media_packets_.find(base_seq_num + i) == media_packets_.end() &&
+        ++num_missing > group.repair_shards.size()) {
+      return false;
+    }
+  }
+  if (num_missing == 0) {
+    // Everything arrived; the group is of no further use.
+    return true;
+  }
+
+  // Build the source shards of the received packets, see reed_solomon_fec.h.
+  const size_t shard_length = group.repair_shards.front().data.size();
+  source_shards_.resize(num_source_packets * shard_length);
+  missing_shards_.resize(num_missing * shard_length);
+  uint8_t* missing_shards[ReedSolomonCode::kMaxSourceShards];
+  size_t missing_indices[ReedSolomonCode::kMaxSourceShards];
+  size_t next_missing = 0;
+  for (size_t i = 0; i < num_source_packets; ++i) {
+    auto media_it = media_packets_.find(base_seq_num + i);
+    if (media_it == media_packets_.end()) {
+      missing_indices[next_missing] = i;
+      missing_shards[next_missing] =
+          &missing_shards_[next_missing * shard_length];
+      ++next_missing;
+      continue;
+    }
+    const rtc::CopyOnWriteBuffer& media_packet = media_it->second;
+    const size_t length = media_packet.size() - kRtpHeaderSize;
+    if (kReedSolomonShardHeaderSize + length > shard_length) {
+      RTC_LOG(LS_WARNING) << "Media packet does not fit the Reed-Solomon FEC "
+                             "group, discarding the group.";
+      return true;
+    }
+    uint8_t* shard = &source_shards_[i * shard_length];
+    const uint8_t* data = media_packet.cdata();
+    shard[0] = data[0];
+    shard[1] = data[1];
+    ByteWriter<uint16_t>::WriteBigEndian(&shard[2],
+                                         static_cast<uint16_t>(length));
+    memcpy(&shard[4], &data[4], 4);
+    memcpy(&shard[kReedSolomonShardHeaderSize], &data[kRtpHeaderSize], length);
+    memset(&shard[kReedSolomonShardHeaderSize + length], 0,
+           shard_length - kReedSolomonShardHeaderSize - length);
+    source_shards[i] = shard;
+  }
+
+  ReedSolomonCode::RepairShard repair_shards[ReedSolomonCode::kMaxRepairShards];
+  for (size_t r = 0; r < group.repair_shards.size(); ++r) {
+    repair_shards[r] = {group.repair_shards[r].index,
+                        group.repair_shards[r].data.cdata()};
+  }
+  if (!ReedSolomonCode::Decode(
+          shard_length,
+          rtc::ArrayView<const uint8_t* const>(source_shards,
+                                               num_source_packets),
+          rtc::ArrayView<const ReedSolomonCode::RepairShard>(
+              repair_shards, group.repair_shards.size()),
+          rtc::ArrayView<uint8_t* const>(missing_shards, num_missing))) {
+    return true;
+  }
+
+  for (size_t m = 0; m < num_missing; ++m) {
+    const uint8_t* shard = missing_shards[m];
+    const size_t length = ByteReader<uint16_t>::ReadBigEndian(&shard[2]);
+    if (kReedSolomonShardHeaderSize + length > shard_length ||
+        (shard[0] & kRtpVersionMask) != kRtpVersion2) {
+      RTC_LOG(LS_WARNING) << "Recovered an invalid packet, discarding it.";
+      continue;
+    }
+    const int64_t seq_num = base_seq_num + missing_indices[m];
+    rtc::CopyOnWriteBuffer buffer(kRtpHeaderSize + length);
+    uint8_t* data = buffer.MutableData();
+    data[0] = shard[0];
+    data[1] = shard[1];
+    ByteWriter<uint16_t>::WriteBigEndian(&data[2],
+                                         static_cast<uint16_t>(seq_num));
+    memcpy(&data[4], &shard[4], 4);
+    ByteWriter<uint32_t>::WriteBigEndian(&data[8], protected_media_ssrc_);
+    memcpy(&data[kRtpHeaderSize], &shard[kReedSolomonShardHeaderSize], length);
+
+    RtpPacketReceived recovered_packet(&extensions_);
+    if (!recovered_packet.Parse(buffer)) {
+      continue;
+    }
+    recovered_packet.set_recovered(true);
+    // Only video is protected.
+    recovered_packet.set_payload_type_frequency(kVideoPayloadTypeFrequency);
+    media_packets_[seq_num] = std::move(buffer);
+    recovered_packets->push_back(std::move(recovered_packet));
+  }
+  return true;
+}
+
+void ReedSolomonFecReceiver::DiscardOldPackets(int64_t newest_seq_num) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const int64_t oldest_seq_num = newest_seq_num - kMaxMediaPacketHistory;
+  while (!media_packets_.empty() &&
+         media_packets_.begin()->first < oldest_seq_num) {
+    media_packets_.erase(media_packets_.begin());
+  }
+  while (!groups_.empty()) {
+    const auto& [base_seq_num, group] = *groups_.begin();
+    if (base_seq_num + static_cast<int64_t>(group.num_source_packets) >
+        oldest_seq_num) {
+      break;
+    }
+    groups_.erase(groups_.begin());
+  }
+}
+
+}  // namespace webrtc
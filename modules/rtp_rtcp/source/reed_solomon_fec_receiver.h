@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_RECEIVER_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_RECEIVER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include "api/sequence_checker.h"
+#include "modules/rtp_rtcp/include/recovered_packet_receiver.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/ulpfec_receiver.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/numerics/sequence_number_unwrapper.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Receives the repair packets of ReedSolomonFecSender and the media packets
+// they protect, and returns the media packets it recovers through
+// `recovered_packet_receiver`. Like FlexfecReceiver, only recovered packets
+// are returned; received media packets go their usual way.
+class ReedSolomonFecReceiver {
+ public:
+  ReedSolomonFecReceiver(uint32_t ssrc,
+                         uint32_t protected_media_ssrc,
+                         RecoveredPacketReceiver* recovered_packet_receiver);
+  ~ReedSolomonFecReceiver();
+
+  // Inserts a received packet, either media or repair. All newly recovered
+  // packets are sent back through the callback.
+  void OnRtpPacket(const RtpPacketReceived& packet);
+
+  // Returns a counter describing the added and recovered packets.
+  FecPacketCounter GetPacketCounter() const;
+
+ private:
+  struct RepairShard {
+    size_t index;
+    rtc::CopyOnWriteBuffer data;
+  };
+  struct Group {
+    size_t num_source_packets;
+    std::vector<RepairShard> repair_shards;
+  };
+
+  void AddRepairPacket(const RtpPacketReceived& packet);
+  void AddMediaPacket(const RtpPacketReceived& packet);
+  // Tries to recover the missing packets of all groups, until no more packets
+  // can be recovered, and returns the recovered packets.
+  std::vector<RtpPacketReceived> RecoverPackets();
+  // Recovers the group at `base_seq_num` if possible. Returns false if the
+  // group still misses packets.
+  bool RecoverGroup(int64_t base_seq_num,
+                    const Group& group,
+                    std::vector<RtpPacketReceived>* recovered_packets);
+  void DiscardOldPackets(int64_t newest_seq_num);
+
+  // Config.
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+  RecoveredPacketReceiver* const recovered_packet_receiver_;
+
+  RtpSequenceNumberUnwrapper seq_num_unwrapper_
+      RTC_GUARDED_BY(sequence_checker_);
+  // Header extensions of the protected stream, to parse recovered packets.
+  RtpHeaderExtensionMap extensions_ RTC_GUARDED_BY(sequence_checker_);
+  // Received and recovered media packets, by unwrapped sequence number.
+  std::map<int64_t, rtc::CopyOnWriteBuffer> media_packets_
+      RTC_GUARDED_BY(sequence_checker_);
+  // Groups with at least one repair packet, by unwrapped base sequence number.
+  std::map<int64_t, Group> groups_ RTC_GUARDED_BY(sequence_checker_);
+  // Scratch space for decoding.
+  std::vector<uint8_t> source_shards_ RTC_GUARDED_BY(sequence_checker_);
+  std::vector<uint8_t> missing_shards_ RTC_GUARDED_BY(sequence_checker_);
+
+  FecPacketCounter packet_counter_ RTC_GUARDED_BY(sequence_checker_);
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_RECEIVER_H_
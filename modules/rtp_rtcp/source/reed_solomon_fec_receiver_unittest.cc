@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_receiver.h"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "api/rtp_parameters.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/mocks/mock_recovered_packet_receiver.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_sender.h"
+#include "modules/rtp_rtcp/source/rtp_header_extension_size.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::_;
+using ::testing::Invoke;
+
+using test::fec::AugmentedPacket;
+using test::fec::AugmentedPacketGenerator;
+
+constexpr int kFecPayloadType = 123;
+constexpr uint32_t kMediaSsrc = 1234;
+constexpr uint32_t kFecSsrc = 5678;
+const char kNoMid[] = "";
+const std::vector<RtpExtension> kNoRtpHeaderExtensions;
+const std::vector<RtpExtensionSize> kNoRtpHeaderExtensionSizes;
+
+class ReedSolomonFecReceiverTest : public ::testing::Test {
+ protected:
+  ReedSolomonFecReceiverTest()
+      : clock_(1),
+        sender_(kFecPayloadType,
+                kFecSsrc,
+                kMediaSsrc,
+                kNoMid,
+                kNoRtpHeaderExtensions,
+                kNoRtpHeaderExtensionSizes,
+                /*rtp_state=*/nullptr,
+                &clock_),
+        receiver_(kFecSsrc, kMediaSsrc, &recovered_packet_receiver_),
+        packet_generator_(kMediaSsrc) {}
+
+  // Sends a frame of `num_packets` packets of different lengths through the
+  // sender, protected with `fec_rate` (Q8).
+  void SendFrame(size_t num_packets, int fec_rate) {
+    FecProtectionParams params;
+    params.fec_rate = fec_rate;
+    params.max_fec_frames = 1;
+    sender_.SetProtectionParameters(params, params);
+    packet_generator_.NewFrame(num_packets);
+    for (size_t i = 0; i < num_packets; ++i) {
+      std::unique_ptr<AugmentedPacket> packet =
+          packet_generator_.NextPacket(i, 100 + 37 * i);
+      RtpPacketToSend rtp_packet(nullptr);
+      ASSERT_TRUE(rtp_packet.Parse(packet->data));
+      sender_.AddPacketAndGenerateFec(rtp_packet);
+      media_packets_.push_back(packet->data);
+      for (auto& fec_packet : sender_.GetFecPackets()) {
+        fec_packets_.push_back(fec_packet->Buffer());
+      }
+    }
+  }
+
+  void Receive(const rtc::CopyOnWriteBuffer& data) {
+    RtpPacketReceived packet;
+    ASSERT_TRUE(packet.Parse(data));
+    receiver_.OnRtpPacket(packet);
+  }
+
+  // Receives all packets except the media packets in `lost`, and returns the
+  // sequence numbers of the recovered packets, checking their contents.
+  std::set<uint16_t> ReceiveWithLoss(const std::set<size_t>& lost) {
+    std::set<uint16_t> recovered;
+    EXPECT_CALL(recovered_packet_receiver_, OnRecoveredPacket(_))
+        .WillRepeatedly(Invoke([&](const RtpPacketReceived& packet) {
+          EXPECT_TRUE(packet.recovered());
+          recovered.insert(packet.SequenceNumber());
+          bool found = false;
+          for (const auto& media_packet : media_packets_) {
+            if (media_packet == packet.Buffer()) {
+              found = true;
+            }
+          }
+          EXPECT_TRUE(found) << "Recovered packet does not match.";
+        }));
+    for (size_t i = 0; i < media_packets_.size(); ++i) {
+      if (lost.count(i) == 0) {
+        Receive(media_packets_[i]);
+      }
+    }
+    for (const auto& fec_packet : fec_packets_) {
+      Receive(fec_packet);
+    }
+    return recovered;
+  }
+
+  uint16_t SeqNum(size_t index) const {
+    return ByteReader<uint16_t>::ReadBigEndian(
+        media_packets_[index].cdata() + 2);
+  }
+
+  SimulatedClock clock_;
+  ReedSolomonFecSender sender_;
+  ::testing::StrictMock<MockRecoveredPacketReceiver> recovered_packet_receiver_;
+  ReedSolomonFecReceiver receiver_;
+  AugmentedPacketGenerator packet_generator_;
+  std::vector<rtc::CopyOnWriteBuffer> media_packets_;
+  std::vector<rtc::CopyOnWriteBuffer> fec_packets_;
+};
+
+TEST_F(ReedSolomonFecReceiverTest, GeneratesRequestedNumberOfRepairPackets) {
+  SendFrame(/*num_packets=*/8, /*fec_rate=*/128);
+  EXPECT_EQ(fec_packets_.size(), 4u);
+  for (const auto& fec_packet : fec_packets_) {
+    RtpPacketReceived packet;
+    ASSERT_TRUE(packet.Parse(fec_packet));
+    EXPECT_EQ(packet.Ssrc(), kFecSsrc);
+    EXPECT_EQ(packet.PayloadType(), kFecPayloadType);
+  }
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversBurstAsLargeAsRepairPackets) {
+  SendFrame(/*num_packets=*/8, /*fec_rate=*/128);
+  ASSERT_EQ(fec_packets_.size(), 4u);
+  EXPECT_EQ(ReceiveWithLoss({2, 3, 4, 5}),
+            (std::set<uint16_t>{SeqNum(2), SeqNum(3), SeqNum(4), SeqNum(5)}));
+  EXPECT_EQ(receiver_.GetPacketCounter().num_recovered_packets, 4u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversLastPacketOfFrame) {
+  SendFrame(/*num_packets=*/5, /*fec_rate=*/50);
+  ASSERT_EQ(fec_packets_.size(), 1u);
+  EXPECT_EQ(ReceiveWithLoss({4}), std::set<uint16_t>{SeqNum(4)});
+}
+
+TEST_F(ReedSolomonFecReceiverTest, DoesNotRecoverMoreThanRepairPackets) {
+  SendFrame(/*num_packets=*/8, /*fec_rate=*/64);
+  ASSERT_EQ(fec_packets_.size(), 2u);
+  EXPECT_TRUE(ReceiveWithLoss({0, 1, 2}).empty());
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversAcrossFrames) {
+  SendFrame(/*num_packets=*/6, /*fec_rate=*/86);
+  SendFrame(/*num_packets=*/6, /*fec_rate=*/86);
+  ASSERT_EQ(fec_packets_.size(), 4u);
+  EXPECT_EQ(ReceiveWithLoss({0, 1, 10, 11}),
+            (std::set<uint16_t>{SeqNum(0), SeqNum(1), SeqNum(10), SeqNum(11)}));
+}
+
+TEST_F(ReedSolomonFecReceiverTest, IgnoresUnrelatedSsrc) {
+  AugmentedPacketGenerator other_generator(kMediaSsrc + 1);
+  other_generator.NewFrame(1);
+  Receive(other_generator.NextPacket(0, 100)->data);
+  EXPECT_EQ(receiver_.GetPacketCounter().num_packets, 0u);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,305 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_sender.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Let first sequence number be in the first half of the interval.
+constexpr uint16_t kMaxInitRtpSeqNumber = 0x7fff;
+
+// Repair packets use a 90 kHz clock for their RTP timestamps, like FlexFEC.
+const int kMsToRtpTimestamp = kVideoPayloadTypeFrequency / 1000;
+
+// Media packets are at most IP_PACKET_SIZE bytes, so their source shards,
+// which drop the SSRC and the sequence number, fit in this.
+constexpr size_t kMaxShardLength = IP_PACKET_SIZE;
+
+// Same as in UlpfecGenerator: above `kHighProtectionThreshold`, a group is
+// only closed early once it has `kMinMediaPackets` packets, and it is closed
+// early only if the rounding of the number of repair packets does not
+// overshoot the requested rate by more than `kMaxExcessOverhead` (Q8).
+constexpr int kMaxExcessOverhead = 50;
+constexpr size_t kMinMediaPackets = 4;
+constexpr int kHighProtectionThreshold = 80;
+
+RtpHeaderExtensionMap RegisterSupportedExtensions(
+    const std::vector<RtpExtension>& rtp_header_extensions) {
+  RtpHeaderExtensionMap map;
+  for (const auto& extension : rtp_header_extensions) {
+    if (extension.uri == TransportSequenceNumber::Uri()) {
+      map.Register<TransportSequenceNumber>(extension.id);
+    } else if (extension.uri == AbsoluteSendTime::Uri()) {
+      map.Register<AbsoluteSendTime>(extension.id);
+    } else if (extension.uri == TransmissionOffset::Uri()) {
+      map.Register<TransmissionOffset>(extension.id);
+    } else if (extension.uri == RtpMid::Uri()) {
+      map.Register<RtpMid>(extension.id);
+    }
+  }
+  return map;
+}
+
+}  // namespace
+
+ReedSolomonFecSender::ReedSolomonFecSender(
+    int payload_type,
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    absl::string_view mid,
+    const std::vector<RtpExtension>& rtp_header_extensions,
+    rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+    const RtpState* rtp_state,
+    Clock* clock)
+    : clock_(clock),
+      random_(clock_->TimeInMicroseconds()),
+      payload_type_(payload_type),
+      timestamp_offset_(rtp_state ? rtp_state->start_timestamp
+                                  : random_.Rand<uint32_t>()),
+      ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      mid_(mid),
+      rtp_header_extension_map_(
+          RegisterSupportedExtensions(rtp_header_extensions)),
+      header_extensions_size_(
+          RtpHeaderExtensionSize(extension_sizes, rtp_header_extension_map_)),
+      seq_num_(rtp_state ? rtp_state->sequence_number
+                         : random_.Rand(1, kMaxInitRtpSeqNumber)),
+      source_shards_(ReedSolomonCode::kMaxSourceShards * kMaxShardLength),
+      fec_bitrate_(/*max_window_size=*/TimeDelta::Seconds(1)) {
+  RTC_DCHECK_GE(payload_type, 0);
+  RTC_DCHECK_LE(payload_type, 127);
+  source_shard_lengths_.reserve(ReedSolomonCode::kMaxSourceShards);
+}
+
+ReedSolomonFecSender::~ReedSolomonFecSender() = default;
+
+void ReedSolomonFecSender::SetProtectionParameters(
+    const FecProtectionParams& delta_params,
+    const FecProtectionParams& key_params) {
+  RTC_DCHECK_GE(delta_params.fec_rate, 0);
+  RTC_DCHECK_LE(delta_params.fec_rate, 255);
+  RTC_DCHECK_GE(key_params.fec_rate, 0);
+  RTC_DCHECK_LE(key_params.fec_rate, 255);
+  // Apply the new params to the next group.
+  MutexLock lock(&mutex_);
+  pending_params_ = Params{delta_params, key_params};
+}
+
+void ReedSolomonFecSender::AddPacketAndGenerateFec(
+    const RtpPacketToSend& packet) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  RTC_DCHECK_EQ(packet.Ssrc(), protected_media_ssrc_);
+  // A group covers consecutive sequence numbers. Close the current group if
+  // this packet does not continue it.
+  const size_t num_media_packets = source_shard_lengths_.size();
+  if (num_media_packets > 0 &&
+      packet.SequenceNumber() !=
+          static_cast<uint16_t>(base_seq_num_ + num_media_packets)) {
+    GenerateRepairPackets();
+  }
+  if (packet.size() > kMaxShardLength) {
+    RTC_LOG(LS_WARNING) << "Media packet of " << packet.size()
+                        << " bytes is too large to protect.";
+    return;
+  }
+
+  if (source_shard_lengths_.empty()) {
+    // New group, which gets the latest protection parameters.
+    base_seq_num_ = packet.SequenceNumber();
+    MutexLock lock(&mutex_);
+    if (pending_params_) {
+      current_params_ = *pending_params_;
+      pending_params_.reset();
+    }
+  }
+  if (packet.is_key_frame()) {
+    media_contains_keyframe_ = true;
+  }
+
+  // Write the source shard, see reed_solomon_fec.h.
+  const uint8_t* data = packet.data();
+  const size_t length = packet.size() - kRtpHeaderSize;
+  uint8_t* shard = &source_shards_[source_shard_lengths_.size() *
+                                   kMaxShardLength];
+  shard[0] = data[0];
+  shard[1] = data[1];
+  ByteWriter<uint16_t>::WriteBigEndian(&shard[2],
+                                       static_cast<uint16_t>(length));
+  memcpy(&shard[4], &data[4], 4);
+  memcpy(&shard[kReedSolomonShardHeaderSize], &data[kRtpHeaderSize], length);
+  source_shard_lengths_.push_back(kReedSolomonShardHeaderSize + length);
+
+  const bool complete_frame = packet.Marker();
+  if (complete_frame) {
+    ++num_protected_frames_;
+  }
+  if (source_shard_lengths_.size() == ReedSolomonCode::kMaxSourceShards) {
+    GenerateRepairPackets();
+    return;
+  }
+  if (!complete_frame) {
+    return;
+  }
+
+  const FecProtectionParams& params = CurrentParams();
+  const size_t num_packets = source_shard_lengths_.size();
+  const int overhead =
+      static_cast<int>((NumRepairPackets() << 8) / num_packets);
+  const size_t min_num_media_packets =
+      params.fec_rate > kHighProtectionThreshold ? kMinMediaPackets : 1;
+  if (num_protected_frames_ >= params.max_fec_frames ||
+      (overhead - params.fec_rate < kMaxExcessOverhead &&
+       num_packets >= min_num_media_packets)) {
+    GenerateRepairPackets();
+  }
+}
+
+const FecProtectionParams& ReedSolomonFecSender::CurrentParams() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  return media_contains_keyframe_ ? current_params_.keyframe_params
+                                  : current_params_.delta_params;
+}
+
+size_t ReedSolomonFecSender::NumRepairPackets() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  const int fec_rate = CurrentParams().fec_rate;
+  const size_t num_media_packets = source_shard_lengths_.size();
+  // Same rounding as ForwardErrorCorrection::NumFecPackets().
+  size_t num_repair_packets = (num_media_packets * fec_rate + (1 << 7)) >> 8;
+  if (fec_rate > 0 && num_repair_packets == 0) {
+    num_repair_packets = 1;
+  }
+  return std::min(num_repair_packets, num_media_packets);
+}
+
+void ReedSolomonFecSender::GenerateRepairPackets() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  const size_t num_media_packets = source_shard_lengths_.size();
+  const size_t num_repair_packets = NumRepairPackets();
+  if (num_media_packets == 0 || num_repair_packets == 0) {
+    ResetGroup();
+    return;
+  }
+
+  const size_t shard_length = *std::max_element(
+      source_shard_lengths_.begin(), source_shard_lengths_.end());
+  const uint8_t* source_shards[ReedSolomonCode::kMaxSourceShards];
+  for (size_t i = 0; i < num_media_packets; ++i) {
+    uint8_t* shard = &source_shards_[i * kMaxShardLength];
+    memset(shard + source_shard_lengths_[i], 0,
+           shard_length - source_shard_lengths_[i]);
+    source_shards[i] = shard;
+  }
+
+  uint8_t* repair_shards[ReedSolomonCode::kMaxRepairShards];
+  const uint32_t timestamp =
+      timestamp_offset_ +
+      static_cast<uint32_t>(kMsToRtpTimestamp * clock_->TimeInMilliseconds());
+  const size_t first_new_packet = generated_fec_packets_.size();
+  for (size_t j = 0; j < num_repair_packets; ++j) {
+    auto fec_packet =
+        std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_);
+    fec_packet->set_packet_type(RtpPacketMediaType::kForwardErrorCorrection);
+    fec_packet->set_allow_retransmission(false);
+
+    // RTP header.
+    fec_packet->SetMarker(false);
+    fec_packet->SetPayloadType(payload_type_);
+    fec_packet->SetSequenceNumber(seq_num_++);
+    fec_packet->SetTimestamp(timestamp);
+    // Set "capture time" so that the TransmissionOffset header extension
+    // can be set by the RTPSender.
+    fec_packet->set_capture_time(clock_->CurrentTime());
+    fec_packet->SetSsrc(ssrc_);
+    // Reserve extensions, if registered. These will be set by the RTPSender.
+    fec_packet->ReserveExtension<AbsoluteSendTime>();
+    fec_packet->ReserveExtension<TransmissionOffset>();
+    fec_packet->ReserveExtension<TransportSequenceNumber>();
+    if (!mid_.empty()) {
+      // This is a no-op if the MID header extension is not registered.
+      fec_packet->SetExtension<RtpMid>(mid_);
+    }
+
+    // Repair header, see reed_solomon_fec.h.
+    uint8_t* payload = fec_packet->AllocatePayload(kReedSolomonFecHeaderSize +
+                                                   shard_length);
+    ByteWriter<uint32_t>::WriteBigEndian(&payload[0], protected_media_ssrc_);
+    ByteWriter<uint16_t>::WriteBigEndian(&payload[4], base_seq_num_);
+    payload[6] = static_cast<uint8_t>(num_media_packets);
+    payload[7] = static_cast<uint8_t>(j);
+    repair_shards[j] = &payload[kReedSolomonFecHeaderSize];
+    generated_fec_packets_.push_back(std::move(fec_packet));
+  }
+  ReedSolomonCode::Encode(
+      shard_length,
+      rtc::ArrayView<const uint8_t* const>(source_shards, num_media_packets),
+      rtc::ArrayView<uint8_t* const>(repair_shards, num_repair_packets));
+
+  size_t total_fec_size_bytes = 0;
+  for (size_t i = first_new_packet; i < generated_fec_packets_.size(); ++i) {
+    total_fec_size_bytes += generated_fec_packets_[i]->size();
+  }
+  ResetGroup();
+
+  MutexLock lock(&mutex_);
+  fec_bitrate_.Update(total_fec_size_bytes, clock_->CurrentTime());
+}
+
+void ReedSolomonFecSender::ResetGroup() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  source_shard_lengths_.clear();
+  num_protected_frames_ = 0;
+  media_contains_keyframe_ = false;
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>>
+ReedSolomonFecSender::GetFecPackets() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets;
+  fec_packets.swap(generated_fec_packets_);
+  return fec_packets;
+}
+
+// The overhead is BWE RTP header extensions and the repair and shard headers.
+size_t ReedSolomonFecSender::MaxPacketOverhead() const {
+  return header_extensions_size_ + kReedSolomonFecHeaderSize +
+         kReedSolomonShardHeaderSize;
+}
+
+DataRate ReedSolomonFecSender::CurrentFecRate() const {
+  MutexLock lock(&mutex_);
+  return fec_bitrate_.Rate(clock_->CurrentTime()).value_or(DataRate::Zero());
+}
+
+absl::optional<RtpState> ReedSolomonFecSender::GetRtpState() {
+  RtpState rtp_state;
+  rtp_state.sequence_number = seq_num_;
+  rtp_state.start_timestamp = timestamp_offset_;
+  return rtp_state;
+}
+
+}  // namespace webrtc
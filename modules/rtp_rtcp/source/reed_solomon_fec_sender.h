@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_SENDER_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_SENDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/rtp_parameters.h"
+#include "api/units/timestamp.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_header_extension_size.h"
+#include "modules/rtp_rtcp/source/video_fec_generator.h"
+#include "rtc_base/bitrate_tracker.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/random.h"
+#include "rtc_base/synchronization/mutex.h"
+
+namespace webrtc {
+
+class Clock;
+class RtpPacketToSend;
+
+// Protects a media stream with the Reed-Solomon code in reed_solomon_fec.h,
+// sending the repair packets on their own SSRC like FlexfecSender. The
+// protection parameters are interpreted as for the XOR codes: the FEC rate
+// gives the number of repair packets per media packet in Q8, and a group
+// spans at most `max_fec_frames` frames. The packet mask type is unused,
+// since any k packets of a group recover it.
+//
+// Note that this class is not thread safe, and thus requires external
+// synchronization, like the other VideoFecGenerators.
+class ReedSolomonFecSender : public VideoFecGenerator {
+ public:
+  ReedSolomonFecSender(int payload_type,
+                       uint32_t ssrc,
+                       uint32_t protected_media_ssrc,
+                       absl::string_view mid,
+                       const std::vector<RtpExtension>& rtp_header_extensions,
+                       rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+                       const RtpState* rtp_state,
+                       Clock* clock);
+  ~ReedSolomonFecSender() override;
+
+  FecType GetFecType() const override {
+    return VideoFecGenerator::FecType::kReedSolomon;
+  }
+  absl::optional<uint32_t> FecSsrc() override { return ssrc_; }
+
+  void SetProtectionParameters(const FecProtectionParams& delta_params,
+                               const FecProtectionParams& key_params) override;
+
+  // Adds a media packet to the current group. When the group is complete, the
+  // repair packets are generated and stored until GetFecPackets() is called.
+  void AddPacketAndGenerateFec(const RtpPacketToSend& packet) override;
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> GetFecPackets() override;
+
+  // Returns the overhead, per packet, of the repair packets.
+  size_t MaxPacketOverhead() const override;
+
+  DataRate CurrentFecRate() const override;
+
+  // Only called on the VideoSendStream queue, after operation has shut down.
+  absl::optional<RtpState> GetRtpState() override;
+
+ private:
+  struct Params {
+    FecProtectionParams delta_params;
+    FecProtectionParams keyframe_params;
+  };
+
+  const FecProtectionParams& CurrentParams() const;
+  // Returns the number of repair packets for the current group.
+  size_t NumRepairPackets() const;
+  void GenerateRepairPackets();
+  void ResetGroup();
+
+  // Utility.
+  Clock* const clock_;
+  Random random_;
+
+  // Config.
+  const int payload_type_;
+  const uint32_t timestamp_offset_;
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+  // MID value to send in the MID header extension.
+  const std::string mid_;
+  const RtpHeaderExtensionMap rtp_header_extension_map_;
+  const size_t header_extensions_size_;
+
+  rtc::RaceChecker race_checker_;
+  // Sequence number of next packet to generate.
+  uint16_t seq_num_ RTC_GUARDED_BY(race_checker_);
+  // Source shards of the current group, `shard_stride_` bytes apart.
+  std::vector<uint8_t> source_shards_ RTC_GUARDED_BY(race_checker_);
+  std::vector<size_t> source_shard_lengths_ RTC_GUARDED_BY(race_checker_);
+  uint16_t base_seq_num_ RTC_GUARDED_BY(race_checker_) = 0;
+  int num_protected_frames_ RTC_GUARDED_BY(race_checker_) = 0;
+  bool media_contains_keyframe_ RTC_GUARDED_BY(race_checker_) = false;
+  Params current_params_ RTC_GUARDED_BY(race_checker_);
+  std::vector<std::unique_ptr<RtpPacketToSend>> generated_fec_packets_
+      RTC_GUARDED_BY(race_checker_);
+
+  mutable Mutex mutex_;
+  absl::optional<Params> pending_params_ RTC_GUARDED_BY(mutex_);
+  BitrateTracker fec_bitrate_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_SENDER_H_
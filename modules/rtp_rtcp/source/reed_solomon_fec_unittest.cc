@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/gf256.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using internal::Gf256Inverse;
+using internal::Gf256Multiply;
+using internal::Gf256MultiplyAdd;
+using internal::Gf256MultiplyAddScalar;
+
+constexpr size_t kShardLength = 1031;
+
+std::vector<uint8_t> RandomBytes(Random& random, size_t length) {
+  std::vector<uint8_t> bytes(length);
+  for (uint8_t& byte : bytes) {
+    byte = random.Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+std::vector<uint8_t> ReferenceMultiplyAdd(uint8_t coefficient,
+                                          const std::vector<uint8_t>& src,
+                                          std::vector<uint8_t> dst) {
+  for (size_t i = 0; i < src.size(); ++i) {
+    dst[i] ^= Gf256Multiply(coefficient, src[i]);
+  }
+  return dst;
+}
+
+TEST(Gf256Test, MultiplyByInverseIsOne) {
+  for (int a = 1; a < 256; ++a) {
+    EXPECT_EQ(Gf256Multiply(a, Gf256Inverse(a)), 1) << "a = " << a;
+  }
+}
+
+TEST(Gf256Test, MultiplyMatchesCarrylessMultiplication) {
+  for (int a = 0; a < 256; ++a) {
+    for (int b = 0; b < 256; ++b) {
+      int product = 0;
+      for (int bit = 0; bit < 8; ++bit) {
+        if (b & (1 << bit)) {
+          product ^= a << bit;
+        }
+      }
+      for (int bit = 15; bit >= 8; --bit) {
+        if (product & (1 << bit)) {
+          product ^= 0x11d << (bit - 8);
+        }
+      }
+      ASSERT_EQ(Gf256Multiply(a, b), product) << a << " * " << b;
+    }
+  }
+}
+
+TEST(Gf256Test, MultiplyAddMatchesReference) {
+  Random random(42);
+  for (int coefficient : {0, 1, 2, 0x53, 0xff}) {
+    for (size_t length : {0, 1, 15, 16, 31, 32, 33, 1500}) {
+      const std::vector<uint8_t> src = RandomBytes(random, length);
+      const std::vector<uint8_t> dst = RandomBytes(random, length);
+      const std::vector<uint8_t> expected =
+          ReferenceMultiplyAdd(coefficient, src, dst);
+      std::vector<uint8_t> scalar_dst = dst;
+      Gf256MultiplyAddScalar(coefficient, src.data(), length,
+                             scalar_dst.data());
+      EXPECT_EQ(expected, scalar_dst);
+      std::vector<uint8_t> dispatched_dst = dst;
+      Gf256MultiplyAdd(coefficient, src.data(), length, dispatched_dst.data());
+      EXPECT_EQ(expected, dispatched_dst);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      if (GetCPUInfo(kAVX2) != 0) {
+        std::vector<uint8_t> avx2_dst = dst;
+        internal::Gf256MultiplyAddAvx2(coefficient, src.data(), length,
+                                       avx2_dst.data());
+        EXPECT_EQ(expected, avx2_dst);
+      }
+#endif
+    }
+  }
+}
+
+class ReedSolomonCodeTest : public ::testing::Test {
+ protected:
+  ReedSolomonCodeTest() : random_(0xabcdef123456) {}
+
+  void Encode(size_t num_source_shards, size_t num_repair_shards) {
+    source_shards_.clear();
+    repair_shards_.assign(num_repair_shards,
+                          std::vector<uint8_t>(kShardLength));
+    std::vector<const uint8_t*> sources;
+    std::vector<uint8_t*> repairs;
+    for (size_t i = 0; i < num_source_shards; ++i) {
+      source_shards_.push_back(RandomBytes(random_, kShardLength));
+      sources.push_back(source_shards_.back().data());
+    }
+    for (auto& repair_shard : repair_shards_) {
+      repairs.push_back(repair_shard.data());
+    }
+    ReedSolomonCode::Encode(kShardLength, sources, repairs);
+  }
+
+  // Decodes with the source shards in `lost_sources` and the repair shards in
+  // `lost_repairs` missing, and checks the recovered shards.
+  bool DecodeAndVerify(const std::vector<size_t>& lost_sources,
+                       const std::vector<size_t>& lost_repairs) {
+    std::vector<const uint8_t*> sources;
+    for (const auto& shard : source_shards_) {
+      sources.push_back(shard.data());
+    }
+    for (size_t i : lost_sources) {
+      sources[i] = nullptr;
+    }
+    std::vector<ReedSolomonCode::RepairShard> repairs;
+    for (size_t j = 0; j < repair_shards_.size(); ++j) {
+      if (std::find(lost_repairs.begin(), lost_repairs.end(), j) ==
+          lost_repairs.end()) {
+        repairs.push_back({j, repair_shards_[j].data()});
+      }
+    }
+    std::vector<std::vector<uint8_t>> recovered(
+        lost_sources.size(), std::vector<uint8_t>(kShardLength));
+    std::vector<uint8_t*> outputs;
+    for (auto& shard : recovered) {
+      outputs.push_back(shard.data());
+    }
+    if (!ReedSolomonCode::Decode(kShardLength, sources, repairs, outputs)) {
+      return false;
+    }
+    std::vector<size_t> sorted_lost_sources = lost_sources;
+    std::sort(sorted_lost_sources.begin(), sorted_lost_sources.end());
+    for (size_t m = 0; m < sorted_lost_sources.size(); ++m) {
+      EXPECT_EQ(source_shards_[sorted_lost_sources[m]], recovered[m]);
+    }
+    return true;
+  }
+
+  Random random_;
+  std::vector<std::vector<uint8_t>> source_shards_;
+  std::vector<std::vector<uint8_t>> repair_shards_;
+};
+
+TEST_F(ReedSolomonCodeTest, RecoversBurstLoss) {
+  Encode(/*num_source_shards=*/10, /*num_repair_shards=*/4);
+  EXPECT_TRUE(DecodeAndVerify({3, 4, 5, 6}, {}));
+}
+
+TEST_F(ReedSolomonCodeTest, RecoversWithAnySubsetOfRepairShards) {
+  Encode(/*num_source_shards=*/10, /*num_repair_shards=*/4);
+  EXPECT_TRUE(DecodeAndVerify({0, 9}, {0, 2}));
+  EXPECT_TRUE(DecodeAndVerify({7}, {0, 1, 2}));
+  EXPECT_TRUE(DecodeAndVerify({1, 2, 8}, {1}));
+}
+
+TEST_F(ReedSolomonCodeTest, RecoversMaximumGroup) {
+  Encode(ReedSolomonCode::kMaxSourceShards, ReedSolomonCode::kMaxRepairShards);
+  std::vector<size_t> lost_sources;
+  for (size_t i = 0; i < ReedSolomonCode::kMaxSourceShards; i += 2) {
+    lost_sources.push_back(i);
+  }
+  EXPECT_TRUE(DecodeAndVerify(lost_sources, {1, 5, 9}));
+}
+
+TEST_F(ReedSolomonCodeTest, FailsWithTooFewRepairShards) {
+  Encode(/*num_source_shards=*/10, /*num_repair_shards=*/2);
+  EXPECT_FALSE(DecodeAndVerify({1, 2, 3}, {}));
+  EXPECT_FALSE(DecodeAndVerify({1, 2}, {0}));
+}
+
+TEST_F(ReedSolomonCodeTest, NothingToRecover) {
+  Encode(/*num_source_shards=*/5, /*num_repair_shards=*/1);
+  EXPECT_TRUE(DecodeAndVerify({}, {0}));
+}
+
+}  // namespace
+}  // namespace webrtc
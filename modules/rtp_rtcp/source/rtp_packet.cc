@@ -63,7 +63,7 @@ RtpPacket::RtpPacket(const ExtensionManager* extensions)
 RtpPacket::RtpPacket(const ExtensionManager* extensions, size_t capacity)
     : extensions_(extensions ? *extensions : ExtensionManager()),
       buffer_(capacity) {
-  RTC_DCHECK_GE(capacity, kFixedHeaderSize);
+  RTC_DCHECK(capacity == 0 || capacity >= kFixedHeaderSize);
   Clear();
 }
 
@@ -102,6 +102,15 @@ bool RtpPacket::Parse(rtc::CopyOnWriteBuffer buffer) {
   return true;
 }
 
+rtc::CopyOnWriteBuffer RtpPacket::ReleaseBuffer() {
+  payload_offset_ = 0;
+  payload_size_ = 0;
+  padding_size_ = 0;
+  extensions_size_ = 0;
+  extension_entries_.clear();
+  return std::move(buffer_);
+}
+
 std::vector<uint32_t> RtpPacket::Csrcs() const {
   size_t num_csrc = data()[0] & 0x0F;
   RTC_DCHECK_GE(capacity(), kFixedHeaderSize + num_csrc * 4);
@@ -437,6 +446,13 @@ void RtpPacket::Clear() {
   extensions_size_ = 0;
   extension_entries_.clear();
 
+  if (buffer_.capacity() == 0) {
+    // No buffer to write the header to, e.g., for a packet that is about to be
+    // parsed.
+    payload_offset_ = 0;
+    buffer_.Clear();
+    return;
+  }
   memset(WriteAt(0), 0, kFixedHeaderSize);
   buffer_.SetSize(kFixedHeaderSize);
   WriteAt(0, kRtpVersion << 6);
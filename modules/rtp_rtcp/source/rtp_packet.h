@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
@@ -32,6 +33,8 @@ class RtpPacket {
   // provided via constructor or IdentifyExtensions function.
   // |*extensions| is only accessed during construction; the pointer is not
   // stored.
+  // A packet constructed with zero `capacity` does not allocate a buffer and
+  // must be parsed before it is used.
   RtpPacket();
   explicit RtpPacket(const ExtensionManager* extensions);
   RtpPacket(const ExtensionManager* extensions, size_t capacity);
@@ -53,6 +56,11 @@ class RtpPacket {
   // Parse and move given buffer into Packet.
   bool Parse(rtc::CopyOnWriteBuffer packet);
 
+  // Moves the buffer out of the packet, e.g., to reuse it for the next
+  // received packet. The packet is left empty and must be parsed again before
+  // it is used.
+  rtc::CopyOnWriteBuffer ReleaseBuffer();
+
   // Maps extensions id to their types.
   void IdentifyExtensions(ExtensionManager extensions);
 
@@ -167,6 +175,8 @@ class RtpPacket {
   std::string ToString() const;
 
  private:
+  static constexpr size_t kMaxInlinedExtensions = 8;
+
   struct ExtensionInfo {
     explicit ExtensionInfo(uint8_t id) : ExtensionInfo(id, 0, 0) {}
     ExtensionInfo(uint8_t id, uint8_t length, uint16_t offset)
@@ -215,7 +225,9 @@ class RtpPacket {
   size_t payload_size_;
 
   ExtensionManager extensions_;
-  std::vector<ExtensionInfo> extension_entries_;
+  // Stored inline for the typical number of extensions, so that parsing a
+  // packet does not allocate.
+  absl::InlinedVector<ExtensionInfo, kMaxInlinedExtensions> extension_entries_;
   size_t extensions_size_ = 0;  // Unaligned.
   rtc::CopyOnWriteBuffer buffer_;
 };
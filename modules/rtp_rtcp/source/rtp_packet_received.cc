@@ -25,6 +25,9 @@ RtpPacketReceived::RtpPacketReceived(
     const ExtensionManager* extensions,
     webrtc::Timestamp arrival_time /*= webrtc::Timestamp::MinusInfinity()*/)
     : RtpPacket(extensions), arrival_time_(arrival_time) {}
+RtpPacketReceived::RtpPacketReceived(const ExtensionManager* extensions,
+                                     size_t capacity)
+    : RtpPacket(extensions, capacity) {}
 RtpPacketReceived::RtpPacketReceived(const RtpPacketReceived& packet) = default;
 RtpPacketReceived::RtpPacketReceived(RtpPacketReceived&& packet) = default;
 
@@ -31,6 +31,7 @@ class RtpPacketReceived : public RtpPacket {
   explicit RtpPacketReceived(
       const ExtensionManager* extensions,
       webrtc::Timestamp arrival_time = webrtc::Timestamp::MinusInfinity());
+  RtpPacketReceived(const ExtensionManager* extensions, size_t capacity);
   RtpPacketReceived(const RtpPacketReceived& packet);
   RtpPacketReceived(RtpPacketReceived&& packet);
 
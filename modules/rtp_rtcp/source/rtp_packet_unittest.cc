@@ -501,6 +501,34 @@ TEST(RtpPacketTest, ParseBuffer) {
   EXPECT_EQ(0u, packet.payload_size());
 }
 
+TEST(RtpPacketTest, ReleaseBufferReturnsParsedBufferWithoutCopy) {
+  rtc::CopyOnWriteBuffer unparsed(kMinimumPacket);
+  const uint8_t* raw = unparsed.data();
+
+  RtpPacketReceived packet;
+  EXPECT_TRUE(packet.Parse(std::move(unparsed)));
+  rtc::CopyOnWriteBuffer released = packet.ReleaseBuffer();
+  EXPECT_EQ(raw, released.cdata());
+  EXPECT_EQ(sizeof(kMinimumPacket), released.size());
+  EXPECT_EQ(0u, packet.size());
+  EXPECT_EQ(0u, packet.payload_size());
+}
+
+TEST(RtpPacketTest, ParsesIntoPacketWithoutBuffer) {
+  RtpPacketReceived packet(/*extensions=*/nullptr, /*capacity=*/0);
+  EXPECT_EQ(0u, packet.capacity());
+
+  rtc::CopyOnWriteBuffer unparsed(kMinimumPacket);
+  const uint8_t* raw = unparsed.data();
+  EXPECT_TRUE(packet.Parse(std::move(unparsed)));
+  EXPECT_EQ(raw, packet.data());
+  EXPECT_EQ(kSeqNum, packet.SequenceNumber());
+
+  RtpPacketReceived invalid_packet(/*extensions=*/nullptr, /*capacity=*/0);
+  EXPECT_FALSE(invalid_packet.Parse(rtc::CopyOnWriteBuffer(3)));
+  EXPECT_EQ(0u, invalid_packet.size());
+}
+
 TEST(RtpPacketTest, ParseWithExtension) {
   RtpPacketToSend::ExtensionManager extensions;
   extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
@@ -186,10 +186,12 @@ flat_set<uint32_t> RtpTransport::GetSsrcsForSink(RtpPacketSinkInterface* sink) {
 
 void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
                                int64_t packet_time_us) {
-  RtpPacketReceived parsed_packet(&header_extension_map_,
-                                  packet_time_us == -1
-                                      ? Timestamp::MinusInfinity()
-                                      : Timestamp::Micros(packet_time_us));
+  // The packet takes over the buffer of `packet`, so it does not need one of
+  // its own.
+  RtpPacketReceived parsed_packet(&header_extension_map_, /*capacity=*/0);
+  parsed_packet.set_arrival_time(packet_time_us == -1
+                                     ? Timestamp::MinusInfinity()
+                                     : Timestamp::Micros(packet_time_us));
   if (!parsed_packet.Parse(std::move(packet))) {
     RTC_LOG(LS_ERROR)
         << "Failed to parse the incoming RTP packet before demuxing. Drop it.";
@@ -201,6 +203,7 @@ void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
                         << RtpDemuxer::DescribePacket(parsed_packet);
     NotifyUnDemuxableRtpPacketReceived(parsed_packet);
   }
+  receive_buffer_ = parsed_packet.ReleaseBuffer();
 }
 
 bool RtpTransport::IsTransportWritable() {
@@ -242,7 +245,7 @@ void RtpTransport::OnSentPacket(rtc::PacketTransportInternal* packet_transport,
 
 void RtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
                                        int64_t packet_time_us) {
-  DemuxPacket(packet, packet_time_us);
+  DemuxPacket(std::move(packet), packet_time_us);
 }
 
 void RtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
@@ -274,7 +277,14 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
     return;
   }
 
-  rtc::CopyOnWriteBuffer packet(data, len);
+  // Reuse the buffer of the previous RTP packet, so that receiving a packet
+  // does not allocate in the common case where no sink kept it.
+  rtc::CopyOnWriteBuffer packet = std::move(receive_buffer_);
+  if (packet.capacity() == 0) {
+    packet = rtc::CopyOnWriteBuffer(data, len, cricket::kMaxRtpPacketLen);
+  } else {
+    packet.SetData(data, len);
+  }
   if (packet_type == cricket::RtpPacketType::kRtcp) {
     OnRtcpPacketReceived(std::move(packet), packet_time_us);
   } else {
@@ -139,6 +139,10 @@ class RtpTransport : public RtpTransportInternal {
 
   // Used for identifying the MID for RtpDemuxer.
   RtpHeaderExtensionMap header_extension_map_;
+  // Buffer of the last demuxed RTP packet, reused for the next received one.
+  // If a sink kept a reference to it, CopyOnWriteBuffer::SetData() allocates
+  // a new buffer instead of overwriting it.
+  rtc::CopyOnWriteBuffer receive_buffer_;
   // Guard against recursive "ready to send" signals
   bool processing_ready_to_send_ = false;
   bool processing_sent_packet_ = false;
@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// These tests count heap allocations and are built into their own test binary,
+// rtp_transport_allocation_unittests, since ScopedAllocationCounter replaces
+// the global operator new of the binary that links it.
+
+#include <vector>
+
+#include "call/rtp_demuxer.h"
+#include "media/base/fake_rtp.h"
+#include "p2p/base/dtls_transport_internal.h"
+#include "p2p/base/fake_packet_transport.h"
+#include "pc/rtp_transport.h"
+#include "pc/srtp_transport.h"
+#include "pc/test/rtp_transport_test_util.h"
+#include "pc/test/scoped_allocation_counter.h"
+#include "pc/test/srtp_test_util.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/ssl_stream_adapter.h"
+#include "test/gtest.h"
+#include "test/scoped_key_value_config.h"
+
+namespace webrtc {
+namespace {
+
+// Packets received before counting, so that lazily created state, e.g., in
+// the demuxer, does not show up in the count.
+constexpr int kNumWarmUpPackets = 2;
+constexpr int kNumCountedPackets = 10;
+
+constexpr unsigned char kRtpData[] = {0x80, 0x11, 0, 0, 0, 0,
+                                      0,    0,    0, 0, 0, 0};
+constexpr int kRtpLen = 12;
+
+// Test that receiving RTP packets does not allocate once warmed up, when no
+// sink keeps a reference to the packets.
+TEST(RtpTransportAllocationTest, ReusesReceiveBufferWhenNotRetained) {
+  RtpTransport transport(/*rtcp_mux_enabled=*/false);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  transport.SetRtpPacketTransport(&fake_rtp);
+  PacketCountingObserver observer;
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types().insert(0x11);
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  rtc::Buffer rtp_data(kRtpData, kRtpLen);
+  auto receive = [&] {
+    fake_rtp.SignalReadPacket(&fake_rtp, rtp_data.data<char>(), kRtpLen,
+                              /*packet_time_us=*/-1, /*flags=*/0);
+  };
+  for (int i = 0; i < kNumWarmUpPackets; ++i) {
+    receive();
+  }
+  int allocations;
+  {
+    ScopedAllocationCounter counter;
+    for (int i = 0; i < kNumCountedPackets; ++i) {
+      receive();
+    }
+    allocations = counter.count();
+  }
+  EXPECT_EQ(0, allocations);
+  EXPECT_EQ(kNumWarmUpPackets + kNumCountedPackets, observer.count());
+  // Remove the sink before destroying the transport.
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
+// Test that receiving SRTP packets does not allocate once warmed up, when no
+// sink keeps a reference to the packets. The packets are unprotected in place
+// and parsed without a copy.
+TEST(RtpTransportAllocationTest, SrtpReusesReceiveBufferWhenNotRetained) {
+  test::ScopedKeyValueConfig field_trials;
+  std::vector<int> extension_ids;
+
+  // Protect the packets with a sending transport whose packets go nowhere.
+  rtc::FakePacketTransport send_packet_transport("send");
+  rtc::FakePacketTransport unconnected_transport("unconnected");
+  send_packet_transport.SetDestination(&unconnected_transport,
+                                       /*asymmetric=*/true);
+  SrtpTransport send_transport(/*rtcp_mux_enabled=*/true, field_trials);
+  send_transport.SetRtpPacketTransport(&send_packet_transport);
+  ASSERT_TRUE(send_transport.SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, rtc::kTestKey1, rtc::kTestKeyLen,
+      extension_ids, rtc::kSrtpAes128CmSha1_80, rtc::kTestKey2,
+      rtc::kTestKeyLen, extension_ids));
+
+  constexpr int kNumPackets = kNumWarmUpPackets + kNumCountedPackets;
+  const size_t rtp_len = sizeof(kPcmuFrame);
+  const size_t packet_size =
+      rtp_len + rtc::rtp_auth_tag_len(rtc::kCsAesCm128HmacSha1_80);
+  std::vector<rtc::CopyOnWriteBuffer> srtp_packets;
+  for (int i = 0; i < kNumPackets; ++i) {
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, rtp_len, packet_size);
+    rtc::SetBE16(packet.MutableData() + 2, i);
+    ASSERT_TRUE(send_transport.SendRtpPacket(&packet, rtc::PacketOptions(),
+                                             cricket::PF_SRTP_BYPASS));
+    srtp_packets.push_back(*send_packet_transport.last_sent_packet());
+  }
+
+  rtc::FakePacketTransport receive_packet_transport("receive");
+  SrtpTransport receive_transport(/*rtcp_mux_enabled=*/true, field_trials);
+  receive_transport.SetRtpPacketTransport(&receive_packet_transport);
+  ASSERT_TRUE(receive_transport.SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, rtc::kTestKey2, rtc::kTestKeyLen,
+      extension_ids, rtc::kSrtpAes128CmSha1_80, rtc::kTestKey1,
+      rtc::kTestKeyLen, extension_ids));
+  PacketCountingObserver observer;
+  RtpDemuxerCriteria demuxer_criteria;
+  // 0x00 is the payload type used in kPcmuFrame.
+  demuxer_criteria.payload_types().insert(0x00);
+  receive_transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  auto receive = [&](const rtc::CopyOnWriteBuffer& packet) {
+    receive_packet_transport.SignalReadPacket(
+        &receive_packet_transport, packet.data<char>(), packet.size(),
+        /*packet_time_us=*/-1, /*flags=*/0);
+  };
+  for (int i = 0; i < kNumWarmUpPackets; ++i) {
+    receive(srtp_packets[i]);
+  }
+  int allocations;
+  {
+    ScopedAllocationCounter counter;
+    for (int i = kNumWarmUpPackets; i < kNumPackets; ++i) {
+      receive(srtp_packets[i]);
+    }
+    allocations = counter.count();
+  }
+  EXPECT_EQ(0, allocations);
+  EXPECT_EQ(kNumPackets, observer.count());
+  // Remove the sink before destroying the transport.
+  receive_transport.UnregisterRtpDemuxerSink(&observer);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -325,6 +325,33 @@ TEST(RtpTransportTest, DontSignalUnhandledRtpPayloadType) {
   transport.UnregisterRtpDemuxerSink(&observer);
 }
 
+// Test that a packet kept by a sink is not overwritten by the next one.
+TEST(RtpTransportTest, RetainedPacketIsNotOverwritten) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  fake_rtp.SetDestination(&fake_rtp, true);
+  transport.SetRtpPacketTransport(&fake_rtp);
+  TransportObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types().insert(0x11);
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  const rtc::PacketOptions options;
+  const int flags = 0;
+  rtc::Buffer rtp_data(kRtpData, kRtpLen);
+  fake_rtp.SendPacket(rtp_data.data<char>(), kRtpLen, options, flags);
+  rtc::CopyOnWriteBuffer first_packet = observer.last_recv_rtp_packet();
+  ASSERT_EQ(first_packet.size(), static_cast<size_t>(kRtpLen));
+
+  rtp_data[3] = 0x01;  // Different sequence number.
+  fake_rtp.SendPacket(rtp_data.data<char>(), kRtpLen, options, flags);
+  EXPECT_EQ(2, observer.rtp_count());
+  EXPECT_EQ(first_packet.cdata()[3], 0);
+  EXPECT_EQ(observer.last_recv_rtp_packet().cdata()[3], 0x01);
+  // Remove the sink before destroying the transport.
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
 TEST(RtpTransportTest, RecursiveSetSendDoesNotCrash) {
   const int kShortTimeout = 100;
   test::RunLoop loop;
@@ -104,6 +104,17 @@ class TransportObserver : public RtpPacketSinkInterface {
   absl::AnyInvocable<void()> action_on_sent_packet_;
 };
 
+// Counts the received RTP packets without keeping a reference to their
+// buffers.
+class PacketCountingObserver : public RtpPacketSinkInterface {
+ public:
+  void OnRtpPacket(const RtpPacketReceived& packet) override { ++count_; }
+  int count() const { return count_; }
+
+ private:
+  int count_ = 0;
+};
+
 }  // namespace webrtc
 
 #endif  // PC_TEST_RTP_TRANSPORT_TEST_UTIL_H_
@@ -0,0 +1,60 @@
+/*
+ *  Copyright 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/test/scoped_allocation_counter.h"
+
+#include <stdlib.h>
+
+#include <cstddef>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+thread_local int* current_count = nullptr;
+
+void* CountedAllocate(std::size_t size) {
+  if (current_count) {
+    ++*current_count;
+  }
+  void* p = malloc(size == 0 ? 1 : size);
+  RTC_CHECK(p);
+  return p;
+}
+
+}  // namespace
+
+ScopedAllocationCounter::ScopedAllocationCounter() {
+  RTC_CHECK(!current_count);
+  current_count = &count_;
+}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() {
+  current_count = nullptr;
+}
+
+}  // namespace webrtc
+
+void* operator new(std::size_t size) {
+  return webrtc::CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+  return webrtc::CountedAllocate(size);
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete[](void* p) noexcept {
+  free(p);
+}
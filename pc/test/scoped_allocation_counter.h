@@ -0,0 +1,36 @@
+/*
+ *  Copyright 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_TEST_SCOPED_ALLOCATION_COUNTER_H_
+#define PC_TEST_SCOPED_ALLOCATION_COUNTER_H_
+
+namespace webrtc {
+
+// Counts the calls to the global operator new made on the current thread while
+// it is alive, e.g., to check that a receive path does not allocate per packet.
+// Counters can not be nested. The counting replaces the global operator new of
+// the test binary that links scoped_allocation_counter.cc, so only link it into
+// small test binaries dedicated to allocation tests.
+class ScopedAllocationCounter {
+ public:
+  ScopedAllocationCounter();
+  ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+  ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+  ~ScopedAllocationCounter();
+
+  int count() const { return count_; }
+
+ private:
+  int count_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // PC_TEST_SCOPED_ALLOCATION_COUNTER_H_
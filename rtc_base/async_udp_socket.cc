@@ -25,6 +25,11 @@ static bool IsScmTimeStampExperimentDisabled() {
   return webrtc::field_trial::IsDisabled("WebRTC-SCM-Timestamp");
 }
 
+// Returns true if the experiment "WebRTC-BatchedUdpReceive" is enabled.
+static bool IsBatchedReceiveExperimentEnabled() {
+  return webrtc::field_trial::IsEnabled("WebRTC-BatchedUdpReceive");
+}
+
 AsyncUDPSocket* AsyncUDPSocket::Create(Socket* socket,
                                        const SocketAddress& bind_address) {
   std::unique_ptr<Socket> owned_socket(socket);
@@ -43,7 +48,9 @@ AsyncUDPSocket* AsyncUDPSocket::Create(SocketFactory* factory,
   return Create(socket, bind_address);
 }
 
-AsyncUDPSocket::AsyncUDPSocket(Socket* socket) : socket_(socket) {
+AsyncUDPSocket::AsyncUDPSocket(Socket* socket)
+    : socket_(socket),
+      batched_receive_(IsBatchedReceiveExperimentEnabled()) {
   sequence_checker_.Detach();
   // The socket should start out readable but not writable.
   socket_->SignalReadEvent.connect(this, &AsyncUDPSocket::OnReadEvent);
@@ -81,6 +88,22 @@ int AsyncUDPSocket::SendTo(const void* pv,
   return ret;
 }
 
+int AsyncUDPSocket::SendToBatch(
+    rtc::ArrayView<const Socket::SendBuffer> packets,
+    rtc::ArrayView<const rtc::PacketOptions> options) {
+  RTC_DCHECK_EQ(packets.size(), options.size());
+  const int64_t send_time_ms = rtc::TimeMillis();
+  int ret = socket_->SendToBatch(packets);
+  for (int i = 0; i < ret; ++i) {
+    rtc::SentPacket sent_packet(options[i].packet_id, send_time_ms,
+                                options[i].info_signaled_after_sent);
+    CopySocketInformationToPacketInfo(packets[i].size, *this, true,
+                                      &sent_packet.info);
+    SignalSentPacket(this, sent_packet);
+  }
+  return ret;
+}
+
 int AsyncUDPSocket::Close() {
   return socket_->Close();
 }
@@ -109,6 +132,11 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
   RTC_DCHECK_RUN_ON(&sequence_checker_);
 
+  if (batched_receive_) {
+    ReadBatch();
+    return;
+  }
+
   SocketAddress remote_addr;
   int64_t timestamp = -1;
   int len = socket_->RecvFrom(buf_, BUF_SIZE, &remote_addr, &timestamp);
@@ -123,6 +151,51 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
                      << "] receive failed with error " << socket_->GetError();
     return;
   }
+
+  // TODO: Make sure that we got all of the packet.
+  // If we did not, then we should resize our buffer to be large enough.
+  OnPacketReceived(buf_, len, timestamp, remote_addr);
+}
+
+void AsyncUDPSocket::ReadBatch() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (batch_.empty()) {
+    batch_buf_.resize((kReceiveBatchSize - 1) * kBatchedPacketBufferSize);
+    batch_.resize(kReceiveBatchSize);
+    batch_[0].data = buf_;
+    batch_[0].capacity = BUF_SIZE;
+    for (size_t i = 1; i < kReceiveBatchSize; ++i) {
+      batch_[i].data = &batch_buf_[(i - 1) * kBatchedPacketBufferSize];
+      batch_[i].capacity = kBatchedPacketBufferSize;
+    }
+  }
+
+  const int num_received = socket_->RecvFromBatch(batch_);
+  if (num_received < 0) {
+    // See OnReadEvent().
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] receive failed with error " << socket_->GetError();
+    return;
+  }
+
+  for (int i = 0; i < num_received; ++i) {
+    const Socket::ReceiveBuffer& buffer = batch_[i];
+    if (buffer.truncated) {
+      RTC_LOG(LS_WARNING) << "AsyncUDPSocket dropped a datagram larger than "
+                          << buffer.capacity << " bytes.";
+      continue;
+    }
+    OnPacketReceived(buffer.data, buffer.size, buffer.timestamp,
+                     buffer.address);
+  }
+}
+
+void AsyncUDPSocket::OnPacketReceived(const char* data,
+                                      size_t size,
+                                      int64_t timestamp,
+                                      const SocketAddress& remote_addr) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
   if (timestamp == -1) {
     // Timestamp from socket is not available.
     timestamp = TimeMicros();
@@ -134,10 +207,8 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
     timestamp += *socket_time_offset_;
   }
 
-  // TODO: Make sure that we got all of the packet.
-  // If we did not, then we should resize our buffer to be large enough.
-  NotifyPacketReceived(
-      rtc::ReceivedPacket::CreateFromLegacy(buf_, len, timestamp, remote_addr));
+  NotifyPacketReceived(rtc::ReceivedPacket::CreateFromLegacy(
+      data, size, timestamp, remote_addr));
 }
 
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
@@ -15,8 +15,10 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/socket.h"
@@ -52,6 +54,12 @@ class AsyncUDPSocket : public AsyncPacketSocket {
              size_t cb,
              const SocketAddress& addr,
              const rtc::PacketOptions& options) override;
+  // Sends `packets` with as few system calls as the socket allows and signals
+  // SignalSentPacket for each packet sent. `options` holds the options of
+  // each packet. Returns the number of packets sent, or a negative value if
+  // the first one could not be sent.
+  int SendToBatch(rtc::ArrayView<const Socket::SendBuffer> packets,
+                  rtc::ArrayView<const rtc::PacketOptions> options);
   int Close() override;
 
   State GetState() const override;
@@ -61,8 +69,23 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   void SetError(int error) override;
 
  private:
-  // Called when the underlying socket is ready to be read from.
+  // Number of datagrams read per read event with the
+  // "WebRTC-BatchedUdpReceive" field trial, and the buffer size of all but the
+  // first of them, which uses `buf_`. Larger datagrams in these buffers are
+  // dropped.
+  static constexpr size_t kReceiveBatchSize = 32;
+  static constexpr size_t kBatchedPacketBufferSize = 2048;
+
+  // Called when the underlying socket is ready to be read from. Listeners
+  // must not delete this socket from the received packet callback, since the
+  // read event of `socket_` is still being emitted.
   void OnReadEvent(Socket* socket);
+  void ReadBatch();
+  // Delivers a received datagram to the listeners.
+  void OnPacketReceived(const char* data,
+                        size_t size,
+                        int64_t timestamp,
+                        const SocketAddress& remote_addr);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
 
@@ -71,6 +94,9 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   static constexpr int BUF_SIZE = 64 * 1024;
   char buf_[BUF_SIZE] RTC_GUARDED_BY(sequence_checker_);
   absl::optional<int64_t> socket_time_offset_ RTC_GUARDED_BY(sequence_checker_);
+  const bool batched_receive_;
+  std::vector<char> batch_buf_ RTC_GUARDED_BY(sequence_checker_);
+  std::vector<Socket::ReceiveBuffer> batch_ RTC_GUARDED_BY(sequence_checker_);
 };
 
 }  // namespace rtc
@@ -10,21 +10,30 @@
 
 #include "rtc_base/async_udp_socket.h"
 
+#include <errno.h>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "api/units/timestamp.h"
+#include "rtc_base/fake_clock.h"
 #include "rtc_base/gunit.h"
-#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/network/sent_packet.h"
 #include "rtc_base/virtual_socket_server.h"
+#include "test/field_trial.h"
 
 namespace rtc {
 
 class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
  public:
   AsyncUdpSocketTest()
-      : pss_(new rtc::PhysicalSocketServer),
-        vss_(new rtc::VirtualSocketServer(pss_.get())),
-        socket_(vss_->CreateSocket(SOCK_DGRAM)),
+      : vss_(new rtc::VirtualSocketServer()),
+        socket_(vss_->CreateSocket(AF_INET, SOCK_DGRAM)),
         udp_socket_(new AsyncUDPSocket(socket_)),
         ready_to_send_(false) {
     udp_socket_->SignalReadyToSend.connect(this,
@@ -34,7 +43,6 @@ class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
   void OnReadyToSend(rtc::AsyncPacketSocket* socket) { ready_to_send_ = true; }
 
  protected:
-  std::unique_ptr<PhysicalSocketServer> pss_;
   std::unique_ptr<VirtualSocketServer> vss_;
   Socket* socket_;
   std::unique_ptr<AsyncUDPSocket> udp_socket_;
@@ -47,4 +55,202 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+namespace {
+
+const SocketAddress kLocalAddress("192.168.1.1", 5000);
+const SocketAddress kRemoteAddress("192.168.1.2", 6000);
+
+// Socket that returns scripted datagrams from RecvFromBatch() and records the
+// datagrams given to SendToBatch().
+class FakeBatchSocket : public Socket {
+ public:
+  struct Datagram {
+    std::string data;
+    int64_t timestamp = -1;
+  };
+
+  void AddDatagram(std::string data, int64_t timestamp) {
+    datagrams_.push_back({std::move(data), timestamp});
+  }
+  void set_max_packets_to_send(int max_packets) {
+    max_packets_to_send_ = max_packets;
+  }
+  const std::vector<std::string>& sent() const { return sent_; }
+
+  int RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) override {
+    if (datagrams_.empty()) {
+      error_ = EWOULDBLOCK;
+      return -1;
+    }
+    size_t num_received = 0;
+    for (; num_received < buffers.size() && !datagrams_.empty();
+         ++num_received) {
+      const Datagram& datagram = datagrams_.front();
+      ReceiveBuffer& buffer = buffers[num_received];
+      buffer.size = std::min(datagram.data.size(), buffer.capacity);
+      memcpy(buffer.data, datagram.data.data(), buffer.size);
+      buffer.truncated = datagram.data.size() > buffer.capacity;
+      buffer.address = kRemoteAddress;
+      buffer.timestamp = datagram.timestamp;
+      datagrams_.pop_front();
+    }
+    return static_cast<int>(num_received);
+  }
+
+  int SendToBatch(rtc::ArrayView<const SendBuffer> buffers) override {
+    if (max_packets_to_send_ == 0) {
+      error_ = EWOULDBLOCK;
+      return -1;
+    }
+    const size_t num_sent =
+        std::min(buffers.size(), static_cast<size_t>(max_packets_to_send_));
+    for (size_t i = 0; i < num_sent; ++i) {
+      sent_.emplace_back(buffers[i].data, buffers[i].size);
+    }
+    return static_cast<int>(num_sent);
+  }
+
+  SocketAddress GetLocalAddress() const override { return kLocalAddress; }
+  SocketAddress GetRemoteAddress() const override { return SocketAddress(); }
+  int Bind(const SocketAddress& addr) override { return 0; }
+  int Connect(const SocketAddress& addr) override { return -1; }
+  int Send(const void* pv, size_t cb) override { return -1; }
+  int SendTo(const void* pv, size_t cb, const SocketAddress& addr) override {
+    return -1;
+  }
+  int Recv(void* pv, size_t cb, int64_t* timestamp) override { return -1; }
+  int RecvFrom(void* pv,
+               size_t cb,
+               SocketAddress* paddr,
+               int64_t* timestamp) override {
+    return -1;
+  }
+  int Listen(int backlog) override { return -1; }
+  Socket* Accept(SocketAddress* paddr) override { return nullptr; }
+  int Close() override { return 0; }
+  int GetError() const override { return error_; }
+  void SetError(int error) override { error_ = error; }
+  ConnState GetState() const override { return CS_CONNECTED; }
+  int GetOption(Option opt, int* value) override { return -1; }
+  int SetOption(Option opt, int value) override { return -1; }
+
+ private:
+  std::deque<Datagram> datagrams_;
+  int max_packets_to_send_ = 1000;
+  std::vector<std::string> sent_;
+  int error_ = 0;
+};
+
+}  // namespace
+
+class AsyncUdpSocketBatchTest : public ::testing::Test,
+                                public sigslot::has_slots<> {
+ public:
+  AsyncUdpSocketBatchTest()
+      : field_trials_("WebRTC-BatchedUdpReceive/Enabled/"),
+        socket_(new FakeBatchSocket),
+        udp_socket_(new AsyncUDPSocket(socket_)) {
+    clock_.SetTime(webrtc::Timestamp::Seconds(10));
+    udp_socket_->RegisterReceivedPacketCallback(
+        [this](AsyncPacketSocket* socket, const ReceivedPacket& packet) {
+          received_.emplace_back(
+              reinterpret_cast<const char*>(packet.payload().data()),
+              packet.payload().size());
+          arrival_times_.push_back(*packet.arrival_time());
+        });
+    udp_socket_->SignalSentPacket.connect(
+        this, &AsyncUdpSocketBatchTest::OnSentPacket);
+  }
+
+  void OnSentPacket(AsyncPacketSocket* socket, const SentPacket& packet) {
+    sent_packets_.push_back(packet);
+  }
+
+ protected:
+  webrtc::test::ScopedFieldTrials field_trials_;
+  ScopedBaseFakeClock clock_;
+  // Owned by `udp_socket_`.
+  FakeBatchSocket* socket_;
+  std::unique_ptr<AsyncUDPSocket> udp_socket_;
+  std::vector<std::string> received_;
+  std::vector<webrtc::Timestamp> arrival_times_;
+  std::vector<SentPacket> sent_packets_;
+};
+
+TEST_F(AsyncUdpSocketBatchTest, DeliversAllDatagramsOfAReadEvent) {
+  socket_->AddDatagram("first", -1);
+  socket_->AddDatagram("second", -1);
+  socket_->AddDatagram("third", -1);
+  socket_->SignalReadEvent(socket_);
+  EXPECT_EQ(received_,
+            std::vector<std::string>({"first", "second", "third"}));
+
+  // No datagrams left.
+  socket_->SignalReadEvent(socket_);
+  EXPECT_EQ(3u, received_.size());
+}
+
+TEST_F(AsyncUdpSocketBatchTest, DropsTruncatedDatagrams) {
+  // Only the first datagram of a batch is received into the full size buffer.
+  socket_->AddDatagram("first", -1);
+  socket_->AddDatagram(std::string(3000, 'x'), -1);
+  socket_->AddDatagram("third", -1);
+  socket_->SignalReadEvent(socket_);
+  EXPECT_EQ(received_, std::vector<std::string>({"first", "third"}));
+
+  // A large datagram at the start of a batch is delivered.
+  socket_->AddDatagram(std::string(3000, 'y'), -1);
+  socket_->SignalReadEvent(socket_);
+  ASSERT_EQ(3u, received_.size());
+  EXPECT_EQ(std::string(3000, 'y'), received_[2]);
+}
+
+TEST_F(AsyncUdpSocketBatchTest, MapsSocketTimestampsToLocalTime) {
+  // The first socket timestamp is mapped to the current time and later ones
+  // keep their distance to it.
+  socket_->AddDatagram("first", 1000);
+  socket_->AddDatagram("second", 1500);
+  socket_->AddDatagram("third", 3000);
+  socket_->SignalReadEvent(socket_);
+  EXPECT_EQ(arrival_times_, std::vector<webrtc::Timestamp>(
+                                {webrtc::Timestamp::Micros(10'000'000),
+                                 webrtc::Timestamp::Micros(10'000'500),
+                                 webrtc::Timestamp::Micros(10'002'000)}));
+}
+
+TEST_F(AsyncUdpSocketBatchTest, UsesCurrentTimeWithoutSocketTimestamp) {
+  socket_->AddDatagram("first", -1);
+  socket_->SignalReadEvent(socket_);
+  EXPECT_EQ(arrival_times_,
+            std::vector<webrtc::Timestamp>({webrtc::Timestamp::Seconds(10)}));
+}
+
+TEST_F(AsyncUdpSocketBatchTest, SignalsSentPacketForEachPacketSent) {
+  const std::string packets[] = {"a", "bb", "ccc"};
+  std::vector<Socket::SendBuffer> buffers(3);
+  std::vector<PacketOptions> options(3);
+  for (int i = 0; i < 3; ++i) {
+    buffers[i].data = packets[i].data();
+    buffers[i].size = packets[i].size();
+    buffers[i].address = kRemoteAddress;
+    options[i].packet_id = 10 + i;
+  }
+
+  // Only two of the packets fit in the socket.
+  socket_->set_max_packets_to_send(2);
+  EXPECT_EQ(2, udp_socket_->SendToBatch(buffers, options));
+  EXPECT_EQ(socket_->sent(), std::vector<std::string>({"a", "bb"}));
+  ASSERT_EQ(2u, sent_packets_.size());
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(10 + i, sent_packets_[i].packet_id);
+    EXPECT_EQ(packets[i].size(), sent_packets_[i].info.packet_size_bytes);
+    EXPECT_EQ(10'000, sent_packets_[i].send_time_ms);
+  }
+
+  // Nothing is signaled if no packet is sent.
+  socket_->set_max_packets_to_send(0);
+  EXPECT_LT(udp_socket_->SendToBatch(buffers, options), 0);
+  EXPECT_EQ(2u, sent_packets_.size());
+}
+
 }  // namespace rtc
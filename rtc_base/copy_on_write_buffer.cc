@@ -33,6 +33,14 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(CopyOnWriteBuffer&& buf) noexcept
 CopyOnWriteBuffer::CopyOnWriteBuffer(absl::string_view s)
     : CopyOnWriteBuffer(s.data(), s.length()) {}
 
+CopyOnWriteBuffer::CopyOnWriteBuffer(Buffer&& buf)
+    : offset_(0), size_(buf.size()) {
+  if (buf.capacity() > 0) {
+    buffer_ = new RefCountedBuffer(std::move(buf));
+  }
+  RTC_DCHECK(IsConsistent());
+}
+
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size)
     : buffer_(size > 0 ? new RefCountedBuffer(size) : nullptr),
       offset_(0),
@@ -68,6 +68,20 @@ TEST(CopyOnWriteBufferTest, TestMoveConstruct) {
   EXPECT_EQ(buf2.data(), buf1_data);
 }
 
+TEST(CopyOnWriteBufferTest, TestConstructFromBuffer) {
+  Buffer buf1(kTestData, 3, 10);
+  const uint8_t* buf1_data = buf1.data();
+
+  CopyOnWriteBuffer buf2(std::move(buf1));
+  EXPECT_EQ(buf2.size(), 3u);
+  EXPECT_EQ(buf2.capacity(), 10u);
+  EXPECT_EQ(buf2.cdata(), buf1_data);
+
+  CopyOnWriteBuffer buf3(Buffer{});
+  EXPECT_EQ(buf3.size(), 0u);
+  EXPECT_EQ(buf3.data(), nullptr);
+}
+
 TEST(CopyOnWriteBufferTest, TestMoveAssign) {
   CopyOnWriteBuffer buf1(kTestData, 3, 10);
   size_t buf1_size = buf1.size();
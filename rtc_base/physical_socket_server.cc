@@ -43,6 +43,9 @@
 
 #include <errno.h>
 
+#include <algorithm>
+#include <array>
+
 #include "rtc_base/async_dns_resolver.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
@@ -125,6 +128,24 @@ class ScopedSetTrue {
 bool IsScmTimeStampExperimentDisabled() {
   return webrtc::field_trial::IsDisabled("WebRTC-SCM-Timestamp");
 }
+
+#if defined(WEBRTC_POSIX)
+// Returns the SCM_TIMESTAMP of the datagram received with `msg` in
+// microseconds, or -1 if there is none.
+int64_t GetScmTimestamp(msghdr* msg) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET)
+      continue;
+    if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+      timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
+      return rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
+             static_cast<int64_t>(ts->tv_usec);
+    }
+  }
+  return -1;
+}
+#endif
 }  // namespace
 
 namespace rtc {
@@ -400,6 +421,46 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+int PhysicalSocket::SendToBatch(rtc::ArrayView<const SendBuffer> buffers) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  if (!udp_ || buffers.size() <= 1) {
+    return Socket::SendToBatch(buffers);
+  }
+  const size_t num_buffers = std::min(buffers.size(), kMaxBatchSize);
+  std::array<mmsghdr, kMaxBatchSize> messages = {};
+  std::array<iovec, kMaxBatchSize> iovs;
+  std::array<sockaddr_storage, kMaxBatchSize> addrs;
+  for (size_t i = 0; i < num_buffers; ++i) {
+    iovs[i] = {.iov_base = const_cast<char*>(buffers[i].data),
+               .iov_len = buffers[i].size};
+    msghdr& msg = messages[i].msg_hdr;
+    msg.msg_iov = &iovs[i];
+    msg.msg_iovlen = 1;
+    msg.msg_name = &addrs[i];
+    msg.msg_namelen =
+        static_cast<socklen_t>(buffers[i].address.ToSockAddrStorage(&addrs[i]));
+  }
+  // Suppress SIGPIPE. See Send() for explanation.
+  const int sent = ::sendmmsg(s_, messages.data(),
+                              static_cast<unsigned int>(num_buffers),
+                              MSG_NOSIGNAL);
+  UpdateLastError();
+  MaybeRemapSendError();
+  if (sent < 0 && IsBlockingError(GetError())) {
+    EnableEvents(DE_WRITE);
+  }
+  if (sent < 0 || static_cast<size_t>(sent) < num_buffers ||
+      num_buffers == buffers.size()) {
+    return sent;
+  }
+  // Send the datagrams beyond `kMaxBatchSize` with further calls.
+  const int sent_rest = SendToBatch(buffers.subview(num_buffers));
+  return sent + std::max(sent_rest, 0);
+#else
+  return Socket::SendToBatch(buffers);
+#endif
+}
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
       DoReadFromSocket(buffer, length, /*out_addr*/ nullptr, timestamp);
@@ -444,6 +505,53 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+int PhysicalSocket::RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // Without the SCM timestamp experiment, the receive timestamp is read with
+  // an ioctl which only reports that of the last datagram.
+  if (!udp_ || !read_scm_timestamp_experiment_ || buffers.size() <= 1) {
+    return Socket::RecvFromBatch(buffers);
+  }
+  const size_t num_buffers = std::min(buffers.size(), kMaxBatchSize);
+  std::array<mmsghdr, kMaxBatchSize> messages = {};
+  std::array<iovec, kMaxBatchSize> iovs;
+  std::array<sockaddr_storage, kMaxBatchSize> addrs;
+  std::array<char[CMSG_SPACE(sizeof(struct timeval))], kMaxBatchSize>
+      controls = {};
+  for (size_t i = 0; i < num_buffers; ++i) {
+    iovs[i] = {.iov_base = buffers[i].data, .iov_len = buffers[i].capacity};
+    msghdr& msg = messages[i].msg_hdr;
+    msg.msg_iov = &iovs[i];
+    msg.msg_iovlen = 1;
+    msg.msg_name = &addrs[i];
+    msg.msg_namelen = sizeof(addrs[i]);
+    msg.msg_control = controls[i];
+    msg.msg_controllen = sizeof(controls[i]);
+  }
+  const int received = ::recvmmsg(s_, messages.data(),
+                                  static_cast<unsigned int>(num_buffers),
+                                  /*flags=*/0, /*timeout=*/nullptr);
+  UpdateLastError();
+  int error = GetError();
+  bool success = (received >= 0) || IsBlockingError(error);
+  EnableEvents(DE_READ);
+  if (!success) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+  for (int i = 0; i < received; ++i) {
+    ReceiveBuffer& buffer = buffers[i];
+    msghdr& msg = messages[i].msg_hdr;
+    buffer.size = messages[i].msg_len;
+    buffer.truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+    buffer.timestamp = GetScmTimestamp(&msg);
+    SocketAddressFromSockAddrStorage(addrs[i], &buffer.address);
+  }
+  return received;
+#else
+  return Socket::RecvFromBatch(buffers);
+#endif
+}
+
 int PhysicalSocket::DoReadFromSocket(void* buffer,
                                      size_t length,
                                      SocketAddress* out_addr,
@@ -474,18 +582,7 @@ int PhysicalSocket::DoReadFromSocket(void* buffer,
       return received;
     }
     if (timestamp) {
-      struct cmsghdr* cmsg;
-      for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
-        if (cmsg->cmsg_level != SOL_SOCKET)
-          continue;
-        if (cmsg->cmsg_type == SCM_TIMESTAMP) {
-          timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
-          *timestamp =
-              rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
-              static_cast<int64_t>(ts->tv_usec);
-          break;
-        }
-      }
+      *timestamp = GetScmTimestamp(&msg);
     }
     if (out_addr) {
       SocketAddressFromSockAddrStorage(addr_storage, out_addr);
@@ -677,6 +774,15 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
 #endif
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_REUSEPORT:
+#if defined(WEBRTC_POSIX) && defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
     default:
       RTC_DCHECK_NOTREACHED();
       return -1;
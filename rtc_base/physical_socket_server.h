@@ -195,6 +195,12 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                SocketAddress* out_addr,
                int64_t* timestamp) override;
 
+  // Use recvmmsg() and sendmmsg() for UDP sockets on Linux, with up to
+  // `kMaxBatchSize` datagrams per call.
+  static constexpr size_t kMaxBatchSize = 64;
+  int RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) override;
+  int SendToBatch(rtc::ArrayView<const SendBuffer> buffers) override;
+
   int Listen(int backlog) override;
   Socket* Accept(SocketAddress* out_addr) override;
 
@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/physical_socket_server_pool.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/strings/string_builder.h"
+
+namespace rtc {
+namespace {
+
+// Mixes `value` into `hash`. SocketAddress::Hash() alone is a plain XOR of the
+// address words, which cancels out for flows between addresses that only
+// differ in the port, such as loopback flows.
+uint64_t MixHash(uint64_t hash, uint64_t value) {
+  hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+}  // namespace
+
+PhysicalSocketServerPool::PhysicalSocketServerPool(size_t num_threads,
+                                                   absl::string_view name) {
+  RTC_DCHECK_GT(num_threads, 0);
+  threads_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    auto thread = std::make_unique<Thread>(
+        std::make_unique<PhysicalSocketServer>());
+    StringBuilder thread_name;
+    thread_name << name << i;
+    thread->SetName(thread_name.str(), nullptr);
+    thread->Start();
+    threads_.push_back(std::move(thread));
+  }
+}
+
+PhysicalSocketServerPool::~PhysicalSocketServerPool() {
+  for (auto& thread : threads_) {
+    thread->Stop();
+  }
+}
+
+Thread* PhysicalSocketServerPool::ThreadForFlow(
+    const SocketAddress& local_address,
+    const SocketAddress& remote_address,
+    int protocol) const {
+  uint64_t hash = MixHash(0, HashIP(local_address.ipaddr()));
+  hash = MixHash(hash, local_address.port());
+  hash = MixHash(hash, HashIP(remote_address.ipaddr()));
+  hash = MixHash(hash, remote_address.port());
+  hash = MixHash(hash, static_cast<uint64_t>(protocol));
+  return threads_[hash % threads_.size()].get();
+}
+
+std::vector<std::unique_ptr<Socket>>
+PhysicalSocketServerPool::CreateReusePortSockets(const SocketAddress& address,
+                                                 int type) {
+#if !defined(WEBRTC_LINUX)
+  // SO_REUSEPORT does not spread unicast flows over the sockets here.
+  RTC_LOG(LS_WARNING) << "Reuseport sockets are only supported on Linux.";
+  return {};
+#else
+  std::vector<std::unique_ptr<Socket>> sockets;
+  SocketAddress bind_address = address;
+  for (auto& thread : threads_) {
+    std::unique_ptr<Socket> socket = thread->BlockingCall([&] {
+      std::unique_ptr<Socket> socket(
+          thread->socketserver()->CreateSocket(address.family(), type));
+      if (!socket) {
+        return socket;
+      }
+      if (socket->SetOption(Socket::OPT_REUSEPORT, 1) != 0 ||
+          socket->Bind(bind_address) != 0) {
+        RTC_LOG(LS_WARNING) << "Failed to bind a reuseport socket to "
+                            << bind_address.ToSensitiveString()
+                            << ", error = " << socket->GetError();
+        socket.reset();
+      }
+      return socket;
+    });
+    if (!socket) {
+      // Destroy the sockets created so far on their threads.
+      for (size_t i = 0; i < sockets.size(); ++i) {
+        threads_[i]->BlockingCall([&] { sockets[i].reset(); });
+      }
+      return {};
+    }
+    bind_address.SetPort(socket->GetLocalAddress().port());
+    sockets.push_back(std::move(socket));
+  }
+  return sockets;
+#endif
+}
+
+}  // namespace rtc
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_PHYSICAL_SOCKET_SERVER_POOL_H_
+#define RTC_BASE_PHYSICAL_SOCKET_SERVER_POOL_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/socket.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread.h"
+
+namespace rtc {
+
+// A set of network threads, each running its own PhysicalSocketServer, for
+// spreading the sockets of a process over several cores. A single network
+// thread multiplexes all its sockets through one epoll loop, which caps the
+// number of connections it can serve; with a pool, each flow is assigned to
+// one of the threads and all its socket I/O happens there.
+//
+// Flows can be assigned to threads either by the application, with
+// ThreadForFlow(), or by the kernel, by binding one socket per thread to the
+// same address with CreateReusePortSockets().
+class RTC_EXPORT PhysicalSocketServerPool {
+ public:
+  // Creates and starts `num_threads` threads, named `name` followed by their
+  // index. Typically `num_threads` is the number of cores available for
+  // networking.
+  PhysicalSocketServerPool(size_t num_threads, absl::string_view name);
+  // Stops the threads. All sockets created on them must have been destroyed.
+  ~PhysicalSocketServerPool();
+
+  PhysicalSocketServerPool(const PhysicalSocketServerPool&) = delete;
+  PhysicalSocketServerPool& operator=(const PhysicalSocketServerPool&) =
+      delete;
+
+  size_t size() const { return threads_.size(); }
+  Thread* thread(size_t index) const { return threads_[index].get(); }
+
+  // Returns the thread serving the flow between `local_address` and
+  // `remote_address` over `protocol`. The same flow always maps to the same
+  // thread, and flows are spread evenly over the threads.
+  Thread* ThreadForFlow(const SocketAddress& local_address,
+                        const SocketAddress& remote_address,
+                        int protocol) const;
+
+  // Creates one socket of `type` on each thread, with OPT_REUSEPORT set, and
+  // binds them all to `address`. If the port of `address` is 0, the sockets
+  // are bound to the port picked for the first one. The kernel then spreads
+  // the incoming flows over the sockets by hashing their addresses, so that
+  // each thread only handles its share. Socket i belongs to thread(i) and
+  // must only be used and destroyed there. Returns an empty vector if the
+  // sockets cannot be created or bound.
+  //
+  // Only supported on Linux (and Android). Other platforms, such as macOS and
+  // the BSDs, accept SO_REUSEPORT but deliver the datagrams of all flows to a
+  // single socket, so there this returns an empty vector and flows must be
+  // assigned with ThreadForFlow() instead.
+  std::vector<std::unique_ptr<Socket>> CreateReusePortSockets(
+      const SocketAddress& address,
+      int type);
+
+ private:
+  std::vector<std::unique_ptr<Thread>> threads_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_PHYSICAL_SOCKET_SERVER_POOL_H_
@@ -0,0 +1,214 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/physical_socket_server_pool.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "rtc_base/ip_address.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+const IPAddress kIPv4Loopback(INADDR_LOOPBACK);
+
+// Counts the datagrams received on the sockets it is connected to.
+class PacketCounter : public sigslot::has_slots<> {
+ public:
+  void OnReadEvent(Socket* socket) {
+    char buffer[2048];
+    while (socket->Recv(buffer, sizeof(buffer), nullptr) >= 0) {
+      count_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  int count() const { return count_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int> count_{0};
+};
+
+// Destroys `sockets`, each on its thread in `pool`.
+void DestroySockets(PhysicalSocketServerPool& pool,
+                    std::vector<std::unique_ptr<Socket>>& sockets) {
+  for (size_t i = 0; i < sockets.size(); ++i) {
+    pool.thread(i)->BlockingCall([&] { sockets[i].reset(); });
+  }
+  sockets.clear();
+}
+
+}  // namespace
+
+TEST(PhysicalSocketServerPoolTest, RunsOneSocketServerPerThread) {
+  PhysicalSocketServerPool pool(3, "network");
+  ASSERT_EQ(3u, pool.size());
+  std::set<Thread*> threads;
+  std::set<SocketServer*> socket_servers;
+  for (size_t i = 0; i < pool.size(); ++i) {
+    EXPECT_TRUE(pool.thread(i)->BlockingCall(
+        [&] { return pool.thread(i)->IsCurrent(); }));
+    threads.insert(pool.thread(i));
+    socket_servers.insert(pool.thread(i)->socketserver());
+  }
+  EXPECT_EQ(3u, threads.size());
+  EXPECT_EQ(3u, socket_servers.size());
+}
+
+TEST(PhysicalSocketServerPoolTest, ThreadForFlowIsStableAndBalanced) {
+  PhysicalSocketServerPool pool(4, "network");
+  const SocketAddress local_address(kIPv4Loopback, 5000);
+  std::map<Thread*, int> flows_per_thread;
+  constexpr int kNumFlows = 4000;
+  for (int i = 0; i < kNumFlows; ++i) {
+    const SocketAddress remote_address(kIPv4Loopback, 10000 + i);
+    Thread* thread =
+        pool.ThreadForFlow(local_address, remote_address, IPPROTO_UDP);
+    EXPECT_EQ(thread,
+              pool.ThreadForFlow(local_address, remote_address, IPPROTO_UDP));
+    ++flows_per_thread[thread];
+  }
+  ASSERT_EQ(4u, flows_per_thread.size());
+  for (const auto& [thread, num_flows] : flows_per_thread) {
+    EXPECT_GT(num_flows, kNumFlows / 4 * 8 / 10);
+    EXPECT_LT(num_flows, kNumFlows / 4 * 12 / 10);
+  }
+}
+
+#if defined(WEBRTC_LINUX)
+
+TEST(PhysicalSocketServerPoolTest, ReusePortSocketsShareAPort) {
+  PhysicalSocketServerPool pool(4, "network");
+  std::vector<std::unique_ptr<Socket>> sockets =
+      pool.CreateReusePortSockets(SocketAddress(kIPv4Loopback, 0), SOCK_DGRAM);
+  ASSERT_EQ(pool.size(), sockets.size());
+  const SocketAddress address = sockets[0]->GetLocalAddress();
+  EXPECT_NE(0, address.port());
+  std::vector<std::unique_ptr<PacketCounter>> counters;
+  for (size_t i = 0; i < sockets.size(); ++i) {
+    EXPECT_EQ(address, sockets[i]->GetLocalAddress());
+    counters.push_back(std::make_unique<PacketCounter>());
+    pool.thread(i)->BlockingCall([&] {
+      sockets[i]->SignalReadEvent.connect(counters[i].get(),
+                                          &PacketCounter::OnReadEvent);
+    });
+  }
+  auto total_count = [&] {
+    int count = 0;
+    for (const auto& counter : counters) {
+      count += counter->count();
+    }
+    return count;
+  };
+
+  // Send one datagram from each of many flows. Every datagram must be received
+  // by exactly one of the sockets, and the flows must be spread over them.
+  constexpr int kNumFlows = 64;
+  PhysicalSocketServer client_server;
+  for (int i = 0; i < kNumFlows; ++i) {
+    std::unique_ptr<Socket> client(
+        client_server.CreateSocket(AF_INET, SOCK_DGRAM));
+    ASSERT_EQ(0, client->Bind(SocketAddress(kIPv4Loopback, 0)));
+    ASSERT_EQ(1, client->SendTo("x", 1, address));
+  }
+  const int64_t stop_ms = TimeMillis() + 5000;
+  while (total_count() < kNumFlows && TimeMillis() < stop_ms) {
+    Thread::SleepMs(1);
+  }
+  EXPECT_EQ(kNumFlows, total_count());
+  int num_receiving_sockets = 0;
+  for (const auto& counter : counters) {
+    if (counter->count() > 0) {
+      ++num_receiving_sockets;
+    }
+  }
+  EXPECT_GT(num_receiving_sockets, 1);
+  DestroySockets(pool, sockets);
+}
+
+// Sends datagrams from `num_senders` threads, each with its own flows, to a
+// pool of `num_threads` reactors sharing a port, and logs the rate at which
+// they are received.
+void ReusePortThroughput(size_t num_threads, int num_senders) {
+  PhysicalSocketServerPool pool(num_threads, "network");
+  std::vector<std::unique_ptr<Socket>> sockets =
+      pool.CreateReusePortSockets(SocketAddress(kIPv4Loopback, 0), SOCK_DGRAM);
+  ASSERT_EQ(num_threads, sockets.size());
+  const SocketAddress address = sockets[0]->GetLocalAddress();
+  PacketCounter counter;
+  for (size_t i = 0; i < sockets.size(); ++i) {
+    pool.thread(i)->BlockingCall([&] {
+      sockets[i]->SignalReadEvent.connect(&counter,
+                                          &PacketCounter::OnReadEvent);
+    });
+  }
+
+  constexpr int kFlowsPerSender = 16;
+  constexpr int64_t kDurationMs = 2000;
+  std::atomic<bool> stop(false);
+  std::vector<PlatformThread> senders;
+  for (int i = 0; i < num_senders; ++i) {
+    senders.push_back(PlatformThread::SpawnJoinable(
+        [&] {
+          PhysicalSocketServer client_server;
+          std::vector<std::unique_ptr<Socket>> clients;
+          for (int j = 0; j < kFlowsPerSender; ++j) {
+            clients.emplace_back(
+                client_server.CreateSocket(AF_INET, SOCK_DGRAM));
+            clients.back()->Bind(SocketAddress(kIPv4Loopback, 0));
+          }
+          const char data[1200] = {};
+          while (!stop.load(std::memory_order_relaxed)) {
+            for (auto& client : clients) {
+              client->SendTo(data, sizeof(data), address);
+            }
+          }
+        },
+        "sender"));
+  }
+  Thread::SleepMs(kDurationMs / 4);
+  const int start_count = counter.count();
+  Thread::SleepMs(kDurationMs);
+  const int received = counter.count() - start_count;
+  stop = true;
+  senders.clear();
+  DestroySockets(pool, sockets);
+  RTC_LOG(LS_INFO) << num_threads << " reactors, " << num_senders
+                   << " senders: " << received * 1000LL / kDurationMs
+                   << " packets/s";
+}
+
+TEST(PhysicalSocketServerPoolTest, DISABLED_BenchmarkReusePortScaling) {
+  for (size_t num_threads : {1, 2, 4}) {
+    ReusePortThroughput(num_threads, /*num_senders=*/4);
+  }
+}
+
+#else  // defined(WEBRTC_LINUX)
+
+TEST(PhysicalSocketServerPoolTest, ReusePortSocketsNotSupported) {
+  PhysicalSocketServerPool pool(2, "network");
+  EXPECT_TRUE(
+      pool.CreateReusePortSockets(SocketAddress(kIPv4Loopback, 0), SOCK_DGRAM)
+          .empty());
+}
+
+#endif  // defined(WEBRTC_LINUX)
+
+}  // namespace rtc
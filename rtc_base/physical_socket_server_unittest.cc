@@ -14,6 +14,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "rtc_base/gunit.h"
 #include "rtc_base/ip_address.h"
@@ -24,6 +26,7 @@
 #include "rtc_base/socket_unittest.h"
 #include "rtc_base/test_utils.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 #include "test/field_trial.h"
 #include "test/gtest.h"
 
@@ -126,6 +129,8 @@ class PhysicalSocketTest : public SocketTest {
 
   void ConnectInternalAcceptError(const IPAddress& loopback);
   void WritableAfterPartialWrite(const IPAddress& loopback);
+  void UdpBatch(const IPAddress& loopback);
+  void UdpBatchThroughput(const IPAddress& loopback, size_t batch_size);
 
   FakePhysicalSocketServer server_;
   rtc::AutoSocketServerThread thread_;
@@ -451,6 +456,121 @@ TEST_F(PhysicalSocketTest, MAYBE_TestUdpReadyToSendIPv6) {
   SocketTest::TestUdpReadyToSendIPv6();
 }
 
+void PhysicalSocketTest::UdpBatch(const IPAddress& loopback) {
+  std::unique_ptr<Socket> sender(
+      server_.CreateSocket(loopback.family(), SOCK_DGRAM));
+  std::unique_ptr<Socket> receiver(
+      server_.CreateSocket(loopback.family(), SOCK_DGRAM));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(loopback, 0)));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(loopback, 0)));
+
+  // Send datagrams of different sizes and contents.
+  constexpr int kNumPackets = 5;
+  std::vector<std::string> packets;
+  std::vector<Socket::SendBuffer> send_buffers(kNumPackets);
+  for (int i = 0; i < kNumPackets; ++i) {
+    packets.push_back(std::string(100 + i, static_cast<char>('a' + i)));
+  }
+  for (int i = 0; i < kNumPackets; ++i) {
+    send_buffers[i].data = packets[i].data();
+    send_buffers[i].size = packets[i].size();
+    send_buffers[i].address = receiver->GetLocalAddress();
+  }
+  EXPECT_EQ(kNumPackets, sender->SendToBatch(send_buffers));
+
+  // Receive them in batches of up to 3.
+  char data[3][256];
+  std::vector<Socket::ReceiveBuffer> receive_buffers(3);
+  for (int i = 0; i < 3; ++i) {
+    receive_buffers[i].data = data[i];
+    receive_buffers[i].capacity = sizeof(data[i]);
+  }
+  int num_received = 0;
+  for (int attempt = 0; attempt < 100 && num_received < kNumPackets;
+       ++attempt) {
+    const int received = receiver->RecvFromBatch(receive_buffers);
+    if (received < 0) {
+      ASSERT_TRUE(receiver->IsBlocking());
+      Thread::SleepMs(10);
+      continue;
+    }
+    for (int i = 0; i < received; ++i, ++num_received) {
+      const std::string& packet = packets[num_received];
+      const Socket::ReceiveBuffer& buffer = receive_buffers[i];
+      EXPECT_EQ(sender->GetLocalAddress(), buffer.address);
+      EXPECT_FALSE(buffer.truncated);
+      EXPECT_EQ(packet, std::string(buffer.data, buffer.size));
+    }
+  }
+  EXPECT_EQ(kNumPackets, num_received);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpBatchIPv4) {
+  MAYBE_SKIP_IPV4;
+  UdpBatch(kIPv4Loopback);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpBatchIPv6) {
+  MAYBE_SKIP_IPV6;
+  UdpBatch(kIPv6Loopback);
+}
+
+// Sends and receives datagrams in batches of `batch_size` on loopback and logs
+// the achieved packet rate.
+void PhysicalSocketTest::UdpBatchThroughput(const IPAddress& loopback,
+                                            size_t batch_size) {
+  constexpr int kNumPackets = 200000;
+  constexpr size_t kPacketSize = 1200;
+  std::unique_ptr<Socket> sender(
+      server_.CreateSocket(loopback.family(), SOCK_DGRAM));
+  std::unique_ptr<Socket> receiver(
+      server_.CreateSocket(loopback.family(), SOCK_DGRAM));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(loopback, 0)));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(loopback, 0)));
+
+  std::vector<char> send_data(kPacketSize);
+  std::vector<Socket::SendBuffer> send_buffers(batch_size);
+  for (Socket::SendBuffer& buffer : send_buffers) {
+    buffer.data = send_data.data();
+    buffer.size = send_data.size();
+    buffer.address = receiver->GetLocalAddress();
+  }
+  std::vector<char> receive_data(batch_size * kPacketSize);
+  std::vector<Socket::ReceiveBuffer> receive_buffers(batch_size);
+  for (size_t i = 0; i < batch_size; ++i) {
+    receive_buffers[i].data = &receive_data[i * kPacketSize];
+    receive_buffers[i].capacity = kPacketSize;
+  }
+
+  int num_received = 0;
+  const int64_t start_us = TimeMicros();
+  while (num_received < kNumPackets) {
+    ASSERT_EQ(static_cast<int>(batch_size),
+              sender->SendToBatch(send_buffers));
+    size_t num_received_batch = 0;
+    while (num_received_batch < batch_size) {
+      const int received = receiver->RecvFromBatch(
+          rtc::ArrayView<Socket::ReceiveBuffer>(receive_buffers)
+              .subview(num_received_batch));
+      ASSERT_GT(received, 0);
+      num_received_batch += received;
+    }
+    num_received += static_cast<int>(batch_size);
+  }
+  const int64_t elapsed_us = TimeMicros() - start_us;
+  RTC_LOG(LS_INFO) << "Batch size " << batch_size << ": "
+                   << num_received * 1000000LL /
+                          std::max<int64_t>(elapsed_us, 1)
+                   << " packets/s";
+}
+
+TEST_F(PhysicalSocketTest, DISABLED_BenchmarkUdpBatchThroughputIPv4) {
+  MAYBE_SKIP_IPV4;
+  for (size_t batch_size : {1, 8, 32}) {
+    UdpBatchThroughput(kIPv4Loopback, batch_size);
+  }
+}
+
 TEST_F(PhysicalSocketTest, TestGetSetOptionsIPv4) {
   MAYBE_SKIP_IPV4;
   SocketTest::TestGetSetOptionsIPv4();
@@ -10,4 +10,33 @@
 
 #include "rtc_base/socket.h"
 
-namespace rtc {}  // namespace rtc
+namespace rtc {
+
+int Socket::RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers) {
+  if (buffers.empty()) {
+    return 0;
+  }
+  ReceiveBuffer& buffer = buffers[0];
+  const int received = RecvFrom(buffer.data, buffer.capacity, &buffer.address,
+                                &buffer.timestamp);
+  if (received < 0) {
+    return received;
+  }
+  buffer.size = static_cast<size_t>(received);
+  buffer.truncated = false;
+  return 1;
+}
+
+int Socket::SendToBatch(rtc::ArrayView<const SendBuffer> buffers) {
+  int num_sent = 0;
+  for (const SendBuffer& buffer : buffers) {
+    const int sent = SendTo(buffer.data, buffer.size, buffer.address);
+    if (sent < 0) {
+      return num_sent > 0 ? num_sent : sent;
+    }
+    ++num_sent;
+  }
+  return num_sent;
+}
+
+}  // namespace rtc
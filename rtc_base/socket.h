@@ -25,6 +25,7 @@
 #include "rtc_base/win32.h"
 #endif
 
+#include "api/array_view.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 
@@ -103,6 +104,40 @@ class Socket {
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+
+  // Buffer for one of the datagrams received by RecvFromBatch().
+  struct ReceiveBuffer {
+    // Set by the caller.
+    char* data = nullptr;
+    size_t capacity = 0;
+    // Set by RecvFromBatch().
+    size_t size = 0;
+    SocketAddress address;
+    // In units of microseconds, -1 if not available.
+    int64_t timestamp = -1;
+    // True if the datagram did not fit in `capacity` bytes and was truncated.
+    bool truncated = false;
+  };
+  // Receives up to `buffers.size()` datagrams, like as many calls to
+  // RecvFrom() would, but with a single system call where supported. Returns
+  // the number of datagrams received, or a negative value on error like
+  // RecvFrom(). The default implementation receives one datagram with
+  // RecvFrom().
+  virtual int RecvFromBatch(rtc::ArrayView<ReceiveBuffer> buffers);
+
+  // Datagram sent by SendToBatch().
+  struct SendBuffer {
+    const char* data = nullptr;
+    size_t size = 0;
+    SocketAddress address;
+  };
+  // Sends the datagrams in `buffers` in order, like as many calls to SendTo()
+  // would, but with a single system call where supported. Returns the number
+  // of datagrams sent, which is smaller than `buffers.size()` if one could not
+  // be sent, or a negative value if the first one could not be sent. The
+  // default implementation calls SendTo() for each datagram.
+  virtual int SendToBatch(rtc::ArrayView<const SendBuffer> buffers);
+
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -123,6 +158,9 @@ class Socket {
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
+    OPT_REUSEPORT,             // Whether several sockets can bind the same
+                               // address, with the incoming flows spread over
+                               // them (SO_REUSEPORT). Must be set before Bind.
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;